@@ -64,10 +64,10 @@ namespace AnimationPlugin
         // get the current pose from the animation
         if ( dt > 0 && m_animations.size() > 0)
         {
-            Ra::Core::Animation::Pose currentPose = m_animations[m_animationID].getPose(m_animationTime);
+            m_animations[m_animationID].getPose(m_animationTime, m_animationCursor, m_animationPose);
 
             // update the pose of the skeleton
-            m_skel.setPose(currentPose, Ra::Core::Animation::Handle::SpaceType::LOCAL);
+            m_skel.setPose(m_animationPose, Ra::Core::Animation::Handle::SpaceType::LOCAL);
         }
 
         // update the render objects
@@ -337,6 +337,7 @@ namespace AnimationPlugin
     void AnimationComponent::setAnimation( const uint i ) {
         if( i < m_animations.size() ) {
             m_animationID = i;
+            m_animationCursor = Ra::Core::Animation::AnimationCursor();
         }
     }
 
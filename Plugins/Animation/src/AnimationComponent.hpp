@@ -106,6 +106,8 @@ namespace AnimationPlugin
         Ra::Core::Animation::Skeleton m_skel; // Skeleton
         Ra::Core::Animation::RefPose m_refPose; // Ref pose in model space.
         std::vector<Ra::Core::Animation::Animation> m_animations;
+        Ra::Core::Animation::AnimationCursor m_animationCursor; // Playback position in the current animation.
+        Ra::Core::Animation::Pose m_animationPose; // Pose sampled from the current animation.
         Ra::Core::Animation::WeightMatrix m_weights; // Skinning weights ( should go in skinning )
 
         std::vector<SkeletonBoneRenderObject*> m_boneDrawables ; // Vector of bone display objects
@@ -26,18 +26,34 @@ namespace AnimationPlugin
 
     void AnimationSystem::generateTasks(Ra::Core::TaskQueue* taskQueue, const Ra::Engine::FrameInfo& frameInfo)
     {
-        const bool playFrame = m_isPlaying || m_oneStep;
-
-        Scalar currentDelta = playFrame ? frameInfo.m_dt : 0;
+        const Scalar currentDelta = getCurrentDelta( frameInfo );
 
+        m_tasks.clear();
         for (auto compEntry : this->m_components)
         {
             AnimationComponent* component = static_cast<AnimationComponent*>(compEntry.second);
             AnimatorTask* task = new AnimatorTask(component, currentDelta);
-            taskQueue->registerTask( task );
+            // Scoped by entity for the skinning tasks which depend on it.
+            taskQueue->registerTask( task, compEntry.first );
+            m_tasks.push_back( task );
         }
+    }
 
+    void AnimationSystem::updateTasks( const Ra::Engine::FrameInfo& frameInfo )
+    {
+        const Scalar currentDelta = getCurrentDelta( frameInfo );
+
+        for (auto task : m_tasks)
+        {
+            task->setDt( currentDelta );
+        }
+    }
+
+    Scalar AnimationSystem::getCurrentDelta( const Ra::Engine::FrameInfo& frameInfo )
+    {
+        const bool playFrame = m_isPlaying || m_oneStep;
         m_oneStep = false;
+        return playFrame ? frameInfo.m_dt : 0;
     }
 
     void AnimationSystem::reset()
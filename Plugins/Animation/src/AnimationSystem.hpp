@@ -7,6 +7,8 @@
 
 namespace AnimationPlugin
 {
+    class AnimatorTask;
+
     class ANIM_PLUGIN_API AnimationSystem :  public Ra::Engine::System
     {
     public:
@@ -18,6 +20,12 @@ namespace AnimationPlugin
         virtual void generateTasks( Ra::Core::TaskQueue* taskQueue,
                                     const Ra::Engine::FrameInfo& frameInfo ) override;
 
+        /// Animator tasks only need their time step updated from one frame to the next.
+        virtual bool hasPersistentTasks() const override { return true; }
+
+        /// Update the time step of the animator tasks.
+        virtual void updateTasks( const Ra::Engine::FrameInfo& frameInfo ) override;
+
         /// Load a skeleton and an animation from a file.
         void handleAssetLoading( Ra::Engine::Entity* entity, const Ra::Asset::FileData* fileData) override;
 
@@ -42,6 +50,11 @@ namespace AnimationPlugin
         void toggleSlowMotion( const bool status );
 
     private:
+        /// Return the time step of the frame, according to the play status.
+        Scalar getCurrentDelta( const Ra::Engine::FrameInfo& frameInfo );
+
+    private:
+        std::vector<AnimatorTask*> m_tasks; /// Tasks registered in the task queue (owned by the queue).
         bool m_isPlaying; /// See if animation is playing or paused
         bool m_oneStep;   /// True if one step has been required to play.
         bool m_xrayOn;    /// True if we want to show xray-bones
@@ -16,4 +16,9 @@ void AnimatorTask::process()
     m_component->update(m_dt);
 }
 
+void AnimatorTask::setDt(Scalar dt)
+{
+    m_dt = dt;
+}
+
 }
@@ -17,6 +17,9 @@ public:
     virtual std::string getName() const override;
     virtual void process() override;
 
+    /// Set the time step used by the next process() call.
+    void setDt(Scalar dt);
+
 private:
     AnimationComponent* m_component;
     Scalar m_dt;
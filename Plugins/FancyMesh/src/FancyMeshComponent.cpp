@@ -26,11 +26,13 @@ using Ra::Core::TriangleMesh;
 using Ra::Engine::ComponentMessenger;
 
 typedef Ra::Core::VectorArray<Ra::Core::Triangle> TriangleArray;
+typedef Ra::Engine::Mesh::RangeList RangeList;
 
 namespace FancyMeshPlugin
 {
     FancyMeshComponent::FancyMeshComponent(const std::string& name , bool deformable)
         : Ra::Engine::Component( name  ) , m_deformable(deformable)
+        , m_bvhNeedsBuild( true ), m_bvhNeedsRefit( false )
     {
     }
 
@@ -53,7 +55,28 @@ namespace FancyMeshPlugin
         addRenderObject(renderObject);
     }
 
+    void FancyMeshComponent::buildMesh( const Ra::Asset::GeometryData* data, Ra::Core::TriangleMesh& mesh )
+    {
+        // Vertices and normals are written transformed, in a single pass.
+        Ra::Core::MeshUtils::transformPoints( data->getVertices(), data->getFrame(), mesh.m_vertices );
+        Ra::Core::MeshUtils::transformNormals( data->getNormals(), data->getFrame(), mesh.m_normals );
+
+        const auto& faces = data->getFaces();
+        mesh.m_triangles.resize( faces.size() );
+        for ( uint i = 0; i < faces.size(); ++i )
+        {
+            mesh.m_triangles[i] = faces[i].head<3>();
+        }
+    }
+
     void FancyMeshComponent::handleMeshLoading( const Ra::Asset::GeometryData* data )
+    {
+        Ra::Core::TriangleMesh mesh;
+        buildMesh( data, mesh );
+        handleMeshLoading( data, std::move( mesh ) );
+    }
+
+    void FancyMeshComponent::handleMeshLoading( const Ra::Asset::GeometryData* data, Ra::Core::TriangleMesh&& mesh )
     {
         std::string name( m_name );
         name.append( "_" + data->getName() );
@@ -71,41 +94,22 @@ namespace FancyMeshPlugin
         m_contentName = data->getName();
 
         std::shared_ptr<Ra::Engine::Mesh> displayMesh( new Ra::Engine::Mesh( meshName ) );
-
-        Ra::Core::TriangleMesh mesh;
-        Ra::Core::Transform T = data->getFrame();
-        Ra::Core::Transform N;
-        N.matrix() = (T.matrix()).inverse().transpose();
-
-        for (size_t i = 0; i < data->getVerticesSize(); ++i)
+        displayMesh->loadGeometry( std::move( mesh ) );
+
+        // The attribute arrays are shared with the asset data.
+        displayMesh->addData( Ra::Engine::Mesh::VERTEX_TANGENT, data->getSharedTangents() );
+        displayMesh->addData( Ra::Engine::Mesh::VERTEX_BITANGENT, data->getSharedBiTangents() );
+        displayMesh->addData( Ra::Engine::Mesh::VERTEX_TEXCOORD, data->getSharedTexCoords() );
+        displayMesh->addData( Ra::Engine::Mesh::VERTEX_COLOR, data->getSharedColors() );
+
+        // Meshes which are never deformed are uploaded once, packed in a single buffer. The
+        // skinned ones keep a buffer per attribute, so that only the deformed vertices are
+        // uploaded again.
+        if ( !m_deformable )
         {
-            mesh.m_vertices.push_back(T * data->getVertices()[i]);
-            mesh.m_normals.push_back((N * data->getNormals()[i]).normalized());
+            displayMesh->setVertexFormat( Ra::Engine::Mesh::VertexFormat::PACKED );
         }
 
-        for (const auto& face : data->getFaces())
-        {
-            mesh.m_triangles.push_back(face.head<3>());
-        }
-
-        displayMesh->loadGeometry(mesh);
-
-        Ra::Core::Vector3Array tangents;
-        Ra::Core::Vector3Array bitangents;
-        Ra::Core::Vector3Array texcoords;
-
-        Ra::Core::Vector4Array colors;
-
-        for ( const auto& v : data->getTangents() )     tangents.push_back( v );
-        for ( const auto& v : data->getBiTangents() )   bitangents.push_back( v );
-        for ( const auto& v : data->getTexCoords() )    texcoords.push_back( v );
-        for ( const auto& v : data->getColors() )       colors.push_back( v );
-
-        displayMesh->addData( Ra::Engine::Mesh::VERTEX_TANGENT, tangents );
-        displayMesh->addData( Ra::Engine::Mesh::VERTEX_BITANGENT, bitangents );
-        displayMesh->addData( Ra::Engine::Mesh::VERTEX_TEXCOORD, texcoords );
-        displayMesh->addData( Ra::Engine::Mesh::VERTEX_COLOR, colors );
-
         // FIXME(Charly): Should not weights be part of the geometry ?
         //        mesh->addData( Ra::Engine::Mesh::VERTEX_WEIGHTS, meshData.weights );
 
@@ -164,6 +168,15 @@ namespace FancyMeshPlugin
 
             ComponentMessenger::CallbackTypes<TriangleArray>::ReadWrite tRW = std::bind( &FancyMeshComponent::getTrianglesRw, this);
             ComponentMessenger::getInstance()->registerReadWrite<TriangleArray>( getEntity(), this, id+"t", tRW);
+
+            ComponentMessenger::CallbackTypes<RangeList>::Setter vrIn = std::bind( &FancyMeshComponent::setVerticesDirtyRanges, this, std::placeholders::_1 );
+            ComponentMessenger::getInstance()->registerInput<RangeList>( getEntity(), this, id+"vr", vrIn);
+
+            ComponentMessenger::CallbackTypes<RangeList>::Setter nrIn = std::bind( &FancyMeshComponent::setNormalsDirtyRanges, this, std::placeholders::_1 );
+            ComponentMessenger::getInstance()->registerInput<RangeList>( getEntity(), this, id+"nr", nrIn);
+
+            ComponentMessenger::CallbackTypes<bool>::Setter streamIn = std::bind( &FancyMeshComponent::setStreamingInput, this, std::placeholders::_1 );
+            ComponentMessenger::getInstance()->registerInput<bool>( getEntity(), this, id+"stream", streamIn);
         }
 
     }
@@ -190,11 +203,13 @@ namespace FancyMeshPlugin
 
         Ra::Engine::Mesh& displayMesh = getDisplayMesh();
         displayMesh.loadGeometry( *meshptr );
+        m_bvhNeedsBuild = true;
     }
 
     Ra::Core::Vector3Array* FancyMeshComponent::getVerticesRw()
     {
         getDisplayMesh().setDirty( Ra::Engine::Mesh::VERTEX_POSITION);
+        m_bvhNeedsRefit = true;
         return &(getDisplayMesh().getGeometry().m_vertices);
     }
 
@@ -207,12 +222,42 @@ namespace FancyMeshPlugin
     Ra::Core::VectorArray<Ra::Core::Triangle>* FancyMeshComponent::getTrianglesRw()
     {
         getDisplayMesh().setDirty( Ra::Engine::Mesh::INDEX);
+        m_bvhNeedsBuild = true;
         return &(getDisplayMesh().getGeometry().m_triangles);
     }
 
+    void FancyMeshComponent::setVerticesDirtyRanges( const RangeList* ranges )
+    {
+        CORE_ASSERT( ranges, " Input is null");
+        getDisplayMesh().setDirtyRanges( Ra::Engine::Mesh::VERTEX_POSITION, *ranges );
+    }
+
+    void FancyMeshComponent::setNormalsDirtyRanges( const RangeList* ranges )
+    {
+        CORE_ASSERT( ranges, " Input is null");
+        getDisplayMesh().setDirtyRanges( Ra::Engine::Mesh::VERTEX_NORMAL, *ranges );
+    }
+
+    void FancyMeshComponent::setStreamingInput( const bool* streaming )
+    {
+        CORE_ASSERT( streaming, " Input is null");
+        getDisplayMesh().setStreaming( *streaming );
+    }
+
     void FancyMeshComponent::rayCastQuery( const Ra::Core::Ray& r) const
     {
-        auto result  = Ra::Core::MeshUtils::castRay( getMesh(), r );
+        if ( m_bvhNeedsBuild )
+        {
+            m_bvh.build( getMesh() );
+        }
+        else if ( m_bvhNeedsRefit )
+        {
+            m_bvh.refit( getMesh() );
+        }
+        m_bvhNeedsBuild = false;
+        m_bvhNeedsRefit = false;
+
+        auto result  = Ra::Core::MeshUtils::castRay( getMesh(), m_bvh, r );
         int tidx = result.m_hitTriangle;
         if (tidx >= 0)
         {
@@ -5,6 +5,7 @@
 
 #include <Core/Mesh/MeshTypes.hpp>
 #include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/TreeStructures/TriangleMeshBVH.hpp>
 
 #include <Engine/Component/Component.hpp>
 
@@ -37,6 +38,15 @@ namespace FancyMeshPlugin
         void addMeshRenderObject(const Ra::Core::TriangleMesh& mesh, const std::string& name);
         void handleMeshLoading(const Ra::Asset::GeometryData* data);
 
+        /// Creates the render object of data, displaying the given mesh built by buildMesh().
+        /// The mesh is moved into the render object, and the other attributes of data are
+        /// shared with it without copy.
+        void handleMeshLoading(const Ra::Asset::GeometryData* data, Ra::Core::TriangleMesh&& mesh);
+
+        /// Builds the world space geometry of data. Does not touch any engine state,
+        /// so meshes can be built by several threads while loading a file.
+        static void buildMesh(const Ra::Asset::GeometryData* data, Ra::Core::TriangleMesh& mesh);
+
         /// Returns the index of the associated RO (the display mesh)
         Ra::Core::Index getRenderObjectIndex() const;
 
@@ -58,11 +68,22 @@ namespace FancyMeshPlugin
         Ra::Core::Vector3Array * getNormalsRw();
         Ra::Core::VectorArray<Ra::Core::Triangle>* getTrianglesRw();
 
+        // Writers which modify only part of the vertices can restrict the GPU upload.
+        void setVerticesDirtyRanges( const std::vector<std::pair<uint, uint>>* ranges );
+        void setNormalsDirtyRanges( const std::vector<std::pair<uint, uint>>* ranges );
+        // Meshes deformed every frame are streamed to the GPU.
+        void setStreamingInput( const bool* streaming );
+
     private:
         Ra::Core::Index m_meshIndex;
         Ra::Core::Index m_aabbIndex;
         std::string m_contentName;
         bool m_deformable;
+
+        // Hierarchy accelerating ray casts, updated lazily when a ray is cast.
+        mutable Ra::Core::TriangleMeshBVH m_bvh;
+        mutable bool m_bvhNeedsBuild; /// The triangles changed.
+        mutable bool m_bvhNeedsRefit; /// Only the vertices moved.
     };
 
 } // namespace FancyMeshPlugin
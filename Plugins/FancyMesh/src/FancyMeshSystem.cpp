@@ -1,8 +1,11 @@
 #include <FancyMeshSystem.hpp>
 
 #include <Core/String/StringUtils.hpp>
+#include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Core/Tasks/Task.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Time/Profiler.hpp>
 
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Entity/Entity.hpp>
@@ -14,6 +17,8 @@
 
 #include <FancyMeshComponent.hpp>
 
+#include <atomic>
+
 namespace FancyMeshPlugin
 {
 
@@ -29,16 +34,32 @@ namespace FancyMeshPlugin
     void FancyMeshSystem::handleAssetLoading( Ra::Engine::Entity* entity, const Ra::Asset::FileData* fileData )
     {
         auto geomData = fileData->getGeometryData();
+        const uint numMeshes = geomData.size();
+        auto engine = Ra::Engine::RadiumEngine::getInstance();
 
-        uint id = 0;
+        // The geometry of each mesh is built by its own task on the task queue threads.
+        std::vector<Ra::Core::TriangleMesh> meshes( numMeshes );
+        std::atomic<uint> numBuilt( 0 );
+        Ra::Core::parallelFor( 0, numMeshes, 1, [&]( uint begin, uint end )
+        {
+            for ( uint i = begin; i < end; ++i )
+            {
+                RA_PROFILE_ZONE( "Build mesh" );
+                FancyMeshComponent::buildMesh( geomData[i], meshes[i] );
+                engine->reportLoadingProgress( "Building meshes", ++numBuilt, numMeshes );
+            }
+        } );
 
-        for ( const auto& data : geomData )
+        // Components and render objects are registered in the engine managers, one at a time.
+        for ( uint i = 0; i < numMeshes; ++i )
         {
-            std::string componentName = "FMC_" + entity->getName() + std::to_string( id++ );
+            std::string componentName = "FMC_" + entity->getName() + std::to_string( i );
             FancyMeshComponent * comp = new FancyMeshComponent( componentName, fileData->hasHandle() );
             entity->addComponent( comp );
-            comp->handleMeshLoading(data);
+            comp->handleMeshLoading( geomData[i], std::move( meshes[i] ) );
             registerComponent( entity, comp );
+
+            engine->reportLoadingProgress( "Creating render objects", i + 1, numMeshes );
         }
     }
 
@@ -40,6 +40,8 @@ namespace FancyMeshPlugin
 
         virtual void generateTasks( Ra::Core::TaskQueue* taskQueue, const Ra::Engine::FrameInfo& frameInfo ) override;
 
+        virtual bool hasPersistentTasks() const override { return true; }
+
         // Specialized factory method for this systems.
         static FancyMeshComponent* makeFancyMeshFromGeometry( const Ra::Core::TriangleMesh& mesh, const std::string& name,
                                                               Ra::Engine::RenderTechnique* technique = nullptr );
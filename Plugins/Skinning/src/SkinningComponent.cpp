@@ -4,8 +4,11 @@
 #include <Core/Animation/Pose/PoseOperation.hpp>
 
 #include <Core/Animation/Skinning/DualQuaternionSkinning.hpp>
+#include <Core/Animation/Skinning/LinearBlendSkinning.hpp>
 #include <Core/Animation/Skinning/RotationCenterSkinning.hpp>
 
+#include <algorithm>
+
 using Ra::Core::Quaternion;
 using Ra::Core::DualQuaternion;
 
@@ -24,6 +27,12 @@ using Ra::Engine::ComponentMessenger;
 namespace SkinningPlugin
 {
 
+// Maximum number of bones influencing a vertex in linear blend and dual quaternion skinning.
+static const uint MAX_SKINNING_INFLUENCES = 8;
+
+// Dirty vertex ranges closer than this are merged when skinning incrementally.
+static const uint DIRTY_RANGES_MERGE_GAP = 64;
+
 void SkinningComponent::setupSkinning()
 {
     // get the current animation data.
@@ -39,10 +48,22 @@ void SkinningComponent::setupSkinning()
         m_verticesWriter = ComponentMessenger::getInstance()->ComponentMessenger::rwCallback<Ra::Core::Vector3Array>( getEntity(), m_contentsName+"v" );
         m_normalsWriter  = ComponentMessenger::getInstance()->ComponentMessenger::rwCallback<Ra::Core::Vector3Array>( getEntity(), m_contentsName+"n" );
 
+        // Optional inputs to reduce the upload of the skinned mesh.
+        if ( ComponentMessenger::getInstance()->canSet<Ra::Core::Animation::VertexRangeList>( getEntity(), m_contentsName+"vr" ) )
+        {
+            m_verticesRangesWriter = ComponentMessenger::getInstance()->setterCallback<Ra::Core::Animation::VertexRangeList>( getEntity(), m_contentsName+"vr" );
+            m_normalsRangesWriter  = ComponentMessenger::getInstance()->setterCallback<Ra::Core::Animation::VertexRangeList>( getEntity(), m_contentsName+"nr" );
+        }
+        if ( ComponentMessenger::getInstance()->canSet<bool>( getEntity(), m_contentsName+"stream" ) )
+        {
+            m_streamingWriter = ComponentMessenger::getInstance()->setterCallback<bool>( getEntity(), m_contentsName+"stream" );
+        }
+
         m_refData.m_skeleton        = ComponentMessenger::getInstance()->get<Skeleton>( getEntity(), m_contentsName );
         m_refData.m_referenceMesh   = ComponentMessenger::getInstance()->get<TriangleMesh>( getEntity(), m_contentsName );
         m_refData.m_refPose         = ComponentMessenger::getInstance()->get<RefPose> ( getEntity(), m_contentsName );
         m_refData.m_weights         = ComponentMessenger::getInstance()->get<WeightMatrix> ( getEntity(), m_contentsName );
+        m_refData.m_inverseRefPose  = Ra::Core::Animation::inversePose( m_refData.m_refPose );
 
         m_frameData.m_previousPose = m_refData.m_refPose;
         m_frameData.m_doSkinning = false;
@@ -61,6 +82,7 @@ void SkinningComponent::setupSkinning()
 
         m_isReady = true;
         setupSkinningType( m_skinningType );
+        updateMeshStreaming();
     }
 }
 void SkinningComponent::skin()
@@ -82,45 +104,182 @@ void SkinningComponent::skin()
         if ( !Ra::Core::Animation::areEqual( m_frameData.m_currentPose, m_frameData.m_previousPose))
         {
             m_frameData.m_doSkinning = true;
-            m_frameData.m_refToCurrentRelPose = Ra::Core::Animation::relativePose(m_frameData.m_currentPose, m_refData.m_refPose);
+            Ra::Core::Animation::relativePoseFromInverse(m_frameData.m_currentPose, m_refData.m_inverseRefPose, m_frameData.m_refToCurrentRelPose);
             m_frameData.m_prevToCurrentRelPose = Ra::Core::Animation::relativePose(m_frameData.m_currentPose, m_frameData.m_previousPose);
 
-            switch ( m_skinningType )
-            {
-            case LBS:
+            if ( m_incrementalSkinning && m_skinningType != COR )
             {
-                Ra::Core::Animation::linearBlendSkinning( m_refData.m_referenceMesh.m_vertices, m_frameData.m_refToCurrentRelPose, m_refData.m_weights, m_frameData.m_currentPos );
-                break;
+                skinIncremental( m_forceFullSkinning );
+                m_forceFullSkinning = false;
             }
-            case DQS:
+            else
             {
-                Ra::Core::AlignedStdVector< DualQuaternion > DQ;
-                //computeDQ( m_frameData.m_prevToCurrentRelPose, m_refData.m_weights, DQ );
-                Ra::Core::Animation::computeDQ( m_frameData.m_refToCurrentRelPose, m_refData.m_weights, DQ );
-                Ra::Core::Animation::dualQuaternionSkinning( m_refData.m_referenceMesh.m_vertices, DQ, m_frameData.m_currentPos );
-                break;
-            }
-            case COR:
-            {
-                Ra::Core::Animation::corSkinning( m_refData.m_referenceMesh.m_vertices, m_frameData.m_refToCurrentRelPose, m_refData.m_weights, m_refData.m_CoR, m_frameData.m_currentPos );
-                break;
-            }
+                // Positions are swapped at the end of a full skinning, so the
+                // next incremental one must start over from the whole mesh.
+                m_frameData.m_dirtyRanges.clear();
+                m_forceFullSkinning = true;
+                switch ( m_skinningType )
+                {
+                case LBS:
+                {
+                    Ra::Core::Animation::linearBlendSkinning( m_refData.m_referenceMesh.m_vertices, m_frameData.m_refToCurrentRelPose, m_refData.m_packedWeights, m_frameData.m_currentPos );
+                    break;
+                }
+                case DQS:
+                {
+                    // Normals are skinned along with the vertices.
+                    Ra::Core::Animation::dualQuaternionSkinning( m_refData.m_referenceMesh.m_vertices, m_refData.m_referenceMesh.m_normals,
+                                                                 m_frameData.m_refToCurrentRelPose, m_refData.m_packedWeights,
+                                                                 m_frameData.m_currentPos, m_frameData.m_currentNormal );
+                    break;
+                }
+                case COR:
+                {
+                    Ra::Core::Animation::corSkinning( m_refData.m_referenceMesh.m_vertices, m_frameData.m_refToCurrentRelPose, m_refData.m_weights, m_refData.m_CoR, m_frameData.m_currentPos );
+                    break;
+                }
+                }
+                Ra::Core::Animation::computeDQ( m_frameData.m_refToCurrentRelPose, m_refData.m_weights, m_DQ );
             }
-            Ra::Core::Animation::computeDQ( m_frameData.m_refToCurrentRelPose, m_refData.m_weights, m_DQ );
         }
     }
 }
 
+void SkinningComponent::skinIncremental( bool fullSkinning )
+{
+    const uint numVertices = m_refData.m_referenceMesh.m_vertices.size();
+
+    // The dual quaternions are only updated on the skinned vertices as well.
+    if ( m_DQ.size() != numVertices )
+    {
+        m_DQ.resize( numVertices );
+        fullSkinning = true;
+    }
+
+    // Previous and current positions only differ on the last dirty ranges.
+    for ( const auto& range : m_frameData.m_dirtyRanges )
+    {
+        std::copy( m_frameData.m_currentPos.begin() + range.first, m_frameData.m_currentPos.begin() + range.second,
+                   m_frameData.m_previousPos.begin() + range.first );
+    }
+
+    Ra::Core::Animation::getChangedHandles( m_frameData.m_previousPose, m_frameData.m_currentPose, m_changedHandles );
+    if ( fullSkinning || m_changedHandles.size() == m_frameData.m_currentPose.size() )
+    {
+        // No need to look for the influenced vertices when all the bones moved.
+        m_changedHandles.resize( m_frameData.m_currentPose.size() );
+        for ( uint j = 0; j < m_changedHandles.size(); ++j )
+        {
+            m_changedHandles[j] = j;
+        }
+        m_frameData.m_dirtyRanges.assign( 1, std::make_pair( 0u, numVertices ) );
+    }
+    else
+    {
+        Ra::Core::Animation::getInfluencedRanges( m_refData.m_weights, m_changedHandles, DIRTY_RANGES_MERGE_GAP,
+                                                  m_frameData.m_dirtyRanges );
+    }
+
+    switch ( m_skinningType )
+    {
+    case LBS:
+    {
+        Ra::Core::Animation::linearBlendSkinning( m_refData.m_referenceMesh.m_vertices, m_frameData.m_refToCurrentRelPose,
+                                                  m_refData.m_packedWeights, m_frameData.m_dirtyRanges, m_frameData.m_currentPos );
+        break;
+    }
+    case DQS:
+    {
+        Ra::Core::Animation::dualQuaternionSkinning( m_refData.m_referenceMesh.m_vertices, m_refData.m_referenceMesh.m_normals,
+                                                     m_frameData.m_refToCurrentRelPose, m_refData.m_packedWeights,
+                                                     m_frameData.m_dirtyRanges, m_frameData.m_currentPos, m_frameData.m_currentNormal );
+        break;
+    }
+    case COR:
+    {
+        CORE_ASSERT( false, "CoR skinning cannot be done incrementally" );
+        break;
+    }
+    }
+    Ra::Core::Animation::computeDQ( m_frameData.m_refToCurrentRelPose, m_refData.m_packedWeights,
+                                    m_frameData.m_dirtyRanges, m_DQ );
+}
+
 void SkinningComponent::endSkinning()
 {
-    if (m_frameData.m_doSkinning)
+    if (m_frameData.m_doSkinning && m_incrementalSkinning && m_skinningType != COR)
+    {
+        Ra::Core::Vector3Array& vertices = *(m_verticesWriter());
+        Ra::Core::Vector3Array& normals = *(m_normalsWriter());
+
+        // Only write the vertices which were skinned.
+        const bool skinnedNormals = m_skinningType == DQS && m_frameData.m_currentNormal.size() == vertices.size();
+        const bool rangedNormals = skinnedNormals || normals.size() == vertices.size();
+        for ( const auto& range : m_frameData.m_dirtyRanges )
+        {
+            std::copy( m_frameData.m_currentPos.begin() + range.first, m_frameData.m_currentPos.begin() + range.second,
+                       vertices.begin() + range.first );
+            if ( skinnedNormals )
+            {
+                std::copy( m_frameData.m_currentNormal.begin() + range.first, m_frameData.m_currentNormal.begin() + range.second,
+                           normals.begin() + range.first );
+            }
+        }
+        if ( skinnedNormals )
+        {
+            m_normalRanges = m_frameData.m_dirtyRanges;
+        }
+        else if ( rangedNormals )
+        {
+            // The normal of a vertex depends on its triangles, so the normals to update are the ones
+            // of the vertices sharing a triangle with a skinned vertex.
+            const auto& triangles = m_refData.m_referenceMesh.m_triangles;
+            if ( uint( m_refData.m_triangleAdjacency.cols() ) != vertices.size() )
+            {
+                m_refData.m_triangleAdjacency = Ra::Core::Geometry::triangleUniformAdjacency( vertices, triangles );
+            }
+            Ra::Core::Animation::getNormalRanges( m_refData.m_triangleAdjacency, triangles, m_frameData.m_dirtyRanges,
+                                                  DIRTY_RANGES_MERGE_GAP, m_normalRanges );
+            Ra::Core::Animation::uniformNormal( vertices, triangles, m_refData.m_triangleAdjacency, m_normalRanges, normals );
+        }
+        else
+        {
+            Ra::Core::Geometry::uniformNormal( vertices, m_refData.m_referenceMesh.m_triangles, normals );
+        }
+
+        // Only upload the skinned ranges.
+        if ( m_verticesRangesWriter )
+        {
+            m_verticesRangesWriter( &m_frameData.m_dirtyRanges );
+            if ( rangedNormals )
+            {
+                m_normalsRangesWriter( &m_normalRanges );
+            }
+        }
+
+        // Positions are not swapped, m_currentPos keeps the latest result for the next incremental skinning.
+        for ( uint j : m_changedHandles )
+        {
+            m_frameData.m_previousPose[j] = m_frameData.m_currentPose[j];
+        }
+
+        m_frameData.m_doSkinning = false;
+    }
+    else if (m_frameData.m_doSkinning)
     {
         Ra::Core::Vector3Array& vertices = *(m_verticesWriter());
         Ra::Core::Vector3Array& normals = *(m_normalsWriter());
 
         vertices = m_frameData.m_currentPos;
 
-        Ra::Core::Geometry::uniformNormal( vertices, m_refData.m_referenceMesh.m_triangles, normals );
+        if ( m_skinningType == DQS && m_frameData.m_currentNormal.size() == vertices.size() )
+        {
+            normals = m_frameData.m_currentNormal;
+        }
+        else
+        {
+            Ra::Core::Geometry::uniformNormal( vertices, m_refData.m_referenceMesh.m_triangles, normals );
+        }
 
         std::swap( m_frameData.m_previousPose, m_frameData.m_currentPose );
         std::swap( m_frameData.m_previousPos, m_frameData.m_currentPos );
@@ -143,6 +302,7 @@ void SkinningComponent::endSkinning()
         m_frameData.m_currentPos    = m_refData.m_referenceMesh.m_vertices;
         m_frameData.m_previousPos   = m_refData.m_referenceMesh.m_vertices;
         m_frameData.m_currentNormal = m_refData.m_referenceMesh.m_normals;
+        m_frameData.m_dirtyRanges.clear();
     }
 }
 
@@ -169,9 +329,36 @@ void SkinningComponent::setupIO( const std::string& id )
 void SkinningComponent::setSkinningType( SkinningType type )
 {
     m_skinningType = type;
+    m_forceFullSkinning = true;
     if ( m_isReady )
     {
         setupSkinningType( type );
+        updateMeshStreaming();
+    }
+}
+
+void SkinningComponent::setIncrementalSkinning( bool incremental )
+{
+    if ( incremental && !m_incrementalSkinning )
+    {
+        // The whole mesh is skinned once before only skinning the changes.
+        m_frameData.m_dirtyRanges.clear();
+        m_forceFullSkinning = true;
+    }
+    m_incrementalSkinning = incremental;
+    if ( m_isReady )
+    {
+        updateMeshStreaming();
+    }
+}
+
+void SkinningComponent::updateMeshStreaming()
+{
+    if ( m_streamingWriter )
+    {
+        // Incremental skinning only uploads the vertices which moved.
+        const bool streaming = !m_incrementalSkinning || m_skinningType == COR;
+        m_streamingWriter( &streaming );
     }
 }
 
@@ -180,9 +367,20 @@ void SkinningComponent::setupSkinningType( SkinningType type )
     CORE_ASSERT( m_isReady, "component is not ready" );
     switch ( type )
     {
-    case LBS: break;
+    case LBS:
+    {
+        if ( m_refData.m_packedWeights.empty() )
+        {
+            Ra::Core::Animation::packWeights( m_refData.m_weights, MAX_SKINNING_INFLUENCES, m_refData.m_packedWeights );
+        }
+        break;
+    }
     case DQS:
     {
+        if ( m_refData.m_packedWeights.empty() )
+        {
+            Ra::Core::Animation::packWeights( m_refData.m_weights, MAX_SKINNING_INFLUENCES, m_refData.m_packedWeights );
+        }
         if ( m_DQ.empty() )
         {
             m_DQ.resize( m_refData.m_weights.rows(), DualQuaternion( Quaternion( 0.0, 0.0, 0.0, 0.0 ),
@@ -30,7 +30,9 @@ namespace SkinningPlugin
         SkinningComponent( const std::string& name, SkinningType type = DQS)
             : Component(name),
             m_skinningType( type ),
-            m_isReady(false) {}
+            m_isReady(false),
+            m_incrementalSkinning( false ),
+            m_forceFullSkinning( true ) {}
         virtual ~SkinningComponent() {}
 
         virtual void initialize() override { setupSkinning();}
@@ -42,6 +44,14 @@ namespace SkinningPlugin
         void setSkinningType( SkinningType type  );
         inline SkinningType getSkinningType() const { return m_skinningType; }
 
+        /// In incremental mode, only the vertices influenced by the bones which moved
+        /// since the last frame are skinned and written to the mesh.
+        /// CoR skinning always skins the whole mesh.
+        /// The normals and the per-vertex dual quaternions returned by getDQ() are only
+        /// updated around the skinned vertices, the latter with the packed weights.
+        void setIncrementalSkinning( bool incremental );
+        inline bool isIncrementalSkinning() const { return m_incrementalSkinning; }
+
 
         virtual void handleWeightsLoading( const Ra::Asset::HandleData* data );
 
@@ -53,6 +63,12 @@ namespace SkinningPlugin
         void setupIO(const std::string &id);
         void setupSkinningType( SkinningType type);
 
+        /// Skins the vertices influenced by m_changedHandles, or all the vertices if fullSkinning is true.
+        void skinIncremental( bool fullSkinning );
+
+        /// Stream the mesh to the GPU when the whole mesh is written every frame.
+        void updateMeshStreaming();
+
     private:
 
             std::string m_contentsName;
@@ -66,10 +82,23 @@ namespace SkinningPlugin
             Ra::Engine::ComponentMessenger::CallbackTypes<Ra::Core::Vector3Array>::ReadWrite m_verticesWriter;
             Ra::Engine::ComponentMessenger::CallbackTypes<Ra::Core::Vector3Array>::ReadWrite m_normalsWriter;
 
+            // Tell the mesh which vertices were written, in incremental mode.
+            Ra::Engine::ComponentMessenger::CallbackTypes<Ra::Core::Animation::VertexRangeList>::Setter m_verticesRangesWriter;
+            Ra::Engine::ComponentMessenger::CallbackTypes<Ra::Core::Animation::VertexRangeList>::Setter m_normalsRangesWriter;
+            Ra::Engine::ComponentMessenger::CallbackTypes<bool>::Setter m_streamingWriter;
+
             Ra::Core::AlignedStdVector< Ra::Core::DualQuaternion > m_DQ;
 
+            /// Bones which moved since the last skinning, in incremental mode.
+            std::vector<uint> m_changedHandles;
+
+            /// Normals written by the last incremental skinning.
+            Ra::Core::Animation::VertexRangeList m_normalRanges;
+
             SkinningType m_skinningType;
             bool m_isReady;
+            bool m_incrementalSkinning;
+            bool m_forceFullSkinning; /// The next incremental skinning must skin the whole mesh.
     };
 }
 
@@ -5,6 +5,8 @@
 #include <SkinningSystem.hpp>
 #include <GuiBase/SelectionManager/SelectionManager.hpp>
 
+#include <QVBoxLayout>
+
 namespace SkinningPlugin
 {
 
@@ -76,6 +78,14 @@ namespace SkinningPlugin
             this,
             &SkinningWidget::onSkinningChanged );
 
+        m_incrementalCheck = new QCheckBox( "Only skin moving bones", this );
+        m_incrementalCheck->setEnabled( false );
+        connect( m_incrementalCheck, &QCheckBox::toggled, this, &SkinningWidget::onIncrementalChanged );
+
+        QVBoxLayout* layout = new QVBoxLayout( this );
+        layout->addWidget( m_skinningSelect );
+        layout->addWidget( m_incrementalCheck );
+        layout->addStretch();
     }
 
     void SkinningWidget::setCurrent( const Ra::Engine::ItemEntry& entry, SkinningComponent* comp )
@@ -86,10 +96,13 @@ namespace SkinningPlugin
             CORE_ASSERT( entry.m_component == comp, "Component Inconsistency" );
             m_skinningSelect->setEnabled( true );
             m_skinningSelect->setCurrentIndex( int( comp->getSkinningType() ) );
+            m_incrementalCheck->setEnabled( true );
+            m_incrementalCheck->setChecked( comp->isIncrementalSkinning() );
         }
         else
         {
             m_skinningSelect->setEnabled( false );
+            m_incrementalCheck->setEnabled( false );
         }
     }
 
@@ -100,4 +113,10 @@ namespace SkinningPlugin
         m_current->setSkinningType( SkinningComponent::SkinningType( newType ) );
     }
 
+    void SkinningWidget::onIncrementalChanged( bool incremental )
+    {
+        CORE_ASSERT( m_current, "should be disabled" );
+        m_current->setIncrementalSkinning( incremental );
+    }
+
 }
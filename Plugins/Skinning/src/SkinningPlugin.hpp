@@ -13,6 +13,7 @@
 #include <QtPlugin>
 #include <QFrame>
 #include <QComboBox>
+#include <QCheckBox>
 #include <MainApplication/PluginBase/RadiumPluginInterface.hpp>
 
 namespace Ra
@@ -44,10 +45,12 @@ public slots:
 
 private slots:
     void onSkinningChanged( int  newType );
+    void onIncrementalChanged( bool incremental );
 
 private:
         SkinningComponent* m_current;
         QComboBox* m_skinningSelect;
+        QCheckBox* m_incrementalCheck;
 };
 
 // Du to an ambiguous name while compiling with Clang, must differentiate plugin claas from plugin namespace
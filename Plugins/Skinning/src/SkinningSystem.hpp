@@ -30,14 +30,19 @@ namespace SkinningPlugin
                 SkinnerTask* skinTask = new SkinnerTask(comp);
                 SkinnerEndTask* endTask = new SkinnerEndTask(comp);
 
-                Ra::Core::TaskQueue::TaskId skinTaskId = taskQueue->registerTask(skinTask);
-                Ra::Core::TaskQueue::TaskId endTaskId = taskQueue->registerTask(endTask);
-                taskQueue->addPendingDependency( "AnimatorTask", skinTaskId );
+                // Each skinning only waits for the animation of its own entity, so that
+                // the characters of a crowd are animated and skinned independently.
+                Ra::Core::TaskQueue::TaskId skinTaskId = taskQueue->registerTask(skinTask, compEntry.first);
+                Ra::Core::TaskQueue::TaskId endTaskId = taskQueue->registerTask(endTask, compEntry.first);
+                taskQueue->addPendingScopedDependency( "AnimatorTask", skinTaskId );
                 taskQueue->addDependency( skinTaskId, endTaskId);
             }
 
         }
 
+        /// Skinning tasks do not depend on the frame, they can be run again as is.
+        virtual bool hasPersistentTasks() const override { return true; }
+
         void handleAssetLoading( Ra::Engine::Entity* entity, const Ra::Asset::FileData* fileData) override
         {
 
@@ -4,6 +4,7 @@
 #include <Core/Mesh/DCEL/HalfEdge.hpp>
 #include <Core/Mesh/DCEL/FullEdge.hpp>
 #include <Core/Mesh/DCEL/Dcel.hpp>
+#include <Core/Mesh/DCEL/Operations/EdgeSplit.hpp>
 
 namespace Ra {
 namespace Core {
@@ -86,5 +87,98 @@ void fulledgeCollapse( Dcel& dcel, const Index fulledge_id ) {
 
 
 
+VertexIdx fulledgeSplit( HalfEdgeMesh& mesh, const EdgeIdx e ) {
+    return DcelOperations::splitEdge( mesh, e, 0.5 );
+}
+
+
+
+bool fulledgeCollapse( HalfEdgeMesh& mesh, const EdgeIdx e ) {
+    const HalfEdgeIdx h[2] = { mesh.getEdgeHalfEdge( e, 0 ), mesh.getEdgeHalfEdge( e, 1 ) };
+    const VertexIdx   v0   = mesh.getVertex( h[0] );
+    const VertexIdx   v1   = mesh.getVertex( h[1] );
+
+    // Check the triangles and their opposite vertices
+    uint opposite = 0;
+    for( uint i = 0; i < 2; ++i ) {
+        if( mesh.isBoundary( h[i] ) ) {
+            continue;
+        }
+        const HalfEdgeIdx n = mesh.getNext( h[i] );
+        const HalfEdgeIdx p = mesh.getPrev( h[i] );
+        if( mesh.getNext( n ) != p ) {
+            return false;
+        }
+        // The triangle would become a dangling edge
+        if( mesh.isBoundary( mesh.getTwin( n ) ) && mesh.isBoundary( mesh.getTwin( p ) ) ) {
+            return false;
+        }
+        ++opposite;
+    }
+    if( !mesh.isBoundaryEdge( e ) && mesh.isBoundaryVertex( v0 ) && mesh.isBoundaryVertex( v1 ) ) {
+        return false;
+    }
+
+    // Link condition
+    uint common = 0;
+    for( VertexIdx a : mesh.vertexVertices( v0 ) ) {
+        for( VertexIdx b : mesh.vertexVertices( v1 ) ) {
+            common += ( a == b ) ? 1 : 0;
+        }
+    }
+    if( common != opposite ) {
+        return false;
+    }
+
+    // Move the halfedges of v1 to v0
+    HalfEdgeIdx he = h[1];
+    do {
+        mesh.setVertex( he, v0 );
+        he = mesh.getNextAroundVertex( he );
+    } while( he != h[1] );
+
+    // Remove the halfedges of the edge, and the triangles which became 2-gons. out is an outgoing
+    // halfedge of v0 which is not removed.
+    HalfEdgeIdx out = InvalidIdx;
+    for( uint i = 0; i < 2; ++i ) {
+        const HalfEdgeIdx n = mesh.getNext( h[i] );
+        const HalfEdgeIdx p = mesh.getPrev( h[i] );
+        mesh.link( p, n );
+        if( mesh.isBoundary( h[i] ) ) {
+            out = ( i == 0 ) ? n : out;
+            continue;
+        }
+
+        // n is replaced by p in the face of its twin
+        const HalfEdgeIdx t = mesh.getTwin( n );
+        const FaceIdx     f = mesh.getFace( t );
+        mesh.link( mesh.getPrev( t ), p );
+        mesh.link( p, mesh.getNext( t ) );
+        mesh.setFace( p, f );
+        if( ( f != FaceIdx( InvalidIdx ) ) && ( mesh.getFaceHalfEdge( f ) == t ) ) {
+            mesh.setFaceHalfEdge( f, p );
+        }
+        const VertexIdx a = mesh.getVertex( p );
+        if( mesh.getVertexHalfEdge( a ) == t ) {
+            mesh.setVertexHalfEdge( a, p );
+        }
+        out = ( i == 0 ) ? mesh.getTwin( p ) : out;
+
+        mesh.deleteFace( mesh.getFace( h[i] ) );
+        mesh.deleteEdge( mesh.getEdge( n ) );
+    }
+
+    mesh.getPosition( v0 ) = 0.5 * ( mesh.getPosition( v0 ) + mesh.getPosition( v1 ) );
+    mesh.getNormal( v0 )   = ( mesh.getNormal( v0 ) + mesh.getNormal( v1 ) ).normalized();
+    mesh.deleteEdge( e );
+    mesh.deleteVertex( v1 );
+    mesh.setVertexHalfEdge( v0, out );
+    mesh.adjustVertexHalfEdge( v0 );
+
+    return true;
+}
+
+
+
 } // namespace Core
 } // namespace Ra
@@ -3,6 +3,7 @@
 
 #include <Core/Index/Index.hpp>
 #include <Core/Mesh/DCEL/Definition.hpp>
+#include <Core/Mesh/DCEL/HalfEdgeMesh.hpp>
 
 namespace Ra {
 namespace Core {
@@ -10,6 +11,15 @@ namespace Core {
 void fulledgeSplit( Dcel& dcel, const Index fulledge_id );
 void fulledgeCollapse( Dcel& dcel, const Index fulledge_id );
 
+// Split the edge at its middle, and the triangles on each side.
+RA_CORE_API VertexIdx fulledgeSplit( HalfEdgeMesh& mesh, const EdgeIdx e );
+
+// Merge the vertices of the edge at its middle, removing the triangles on each side. The first
+// vertex is kept, the second is deleted.
+// Return false, leaving the mesh unchanged, if the collapse would make the mesh non manifold:
+// the vertices must share no other neighbor than the opposite vertices of the triangles.
+RA_CORE_API bool fulledgeCollapse( HalfEdgeMesh& mesh, const EdgeIdx e );
+
 } // namespace Core
 } // namespace Ra
 
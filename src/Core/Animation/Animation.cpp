@@ -1,6 +1,6 @@
 #include <Core/Animation/Animation.hpp>
 #include <algorithm>
-#include <Core/Animation/Pose/PoseOperation.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <cmath>
 
 namespace Ra {
@@ -18,16 +18,33 @@ struct KeyPoseComparator
 void Animation::addKeyPose(const Pose& pose, Scalar timestamp)
 {
     m_keys.push_back(KeyPose(timestamp, pose));
+    m_times.push_back(timestamp);
+    addKeyTransforms(pose);
 }
 
 void Animation::addKeyPose(const KeyPose& keyPose)
 {
-    m_keys.push_back(keyPose);
+    addKeyPose(keyPose.second, keyPose.first);
+}
+
+void Animation::addKeyTransforms(const Pose& pose)
+{
+    m_rotations.emplace_back(pose.size());
+    m_translations.emplace_back(pose.size());
+    for (uint i = 0; i < pose.size(); ++i)
+    {
+        // rotation() is a polar decomposition, it is better done once.
+        m_rotations.back()[i] = Quaternion(pose[i].rotation());
+        m_translations.back()[i] = pose[i].translation();
+    }
 }
 
 void Animation::clear()
 {
     m_keys.clear();
+    m_times.clear();
+    m_rotations.clear();
+    m_translations.clear();
 }
 
 bool Animation::isEmpty() const
@@ -39,34 +56,139 @@ void Animation::normalize()
 {
     if (m_keys.size() == 0)
         return;
+
+    if (std::is_sorted(m_times.begin(), m_times.end()))
+        return;
     
     // sort the keys according to their timestamp
-    sort(m_keys.begin(), m_keys.end(), KeyPoseComparator());
-    
+    std::stable_sort(m_keys.begin(), m_keys.end(), KeyPoseComparator());
+
+    m_times.clear();
+    m_rotations.clear();
+    m_translations.clear();
+    for (const auto& key : m_keys)
+    {
+        m_times.push_back(key.first);
+        addKeyTransforms(key.second);
+    }
+}
+
+uint Animation::getNumKeys() const
+{
+    return m_keys.size();
+}
+
+const KeyPose& Animation::getKeyPose(uint i) const
+{
+    CORE_ASSERT(i < m_keys.size(), "Invalid key");
+    return m_keys[i];
+}
+
+Scalar Animation::getDuration() const
+{
+    return m_keys.empty() ? Scalar(0) : m_keys.back().first;
 }
 
 Pose Animation::getPose(Scalar timestamp) const
 {
-    Scalar duration = m_keys.back().first;
-    
+    Pose pose;
+    getPose(timestamp, pose);
+    return pose;
+}
+
+void Animation::getPose(Scalar timestamp, Pose& pose) const
+{
+    AnimationCursor cursor;
+    cursor.m_key = uint(-1);
+    getPose(timestamp, cursor, pose);
+}
+
+void Animation::getPose(Scalar timestamp, AnimationCursor& cursor, Pose& pose) const
+{
+    CORE_ASSERT(!m_keys.empty(), "Empty animation");
+
+    const Scalar time = getLocalTime(timestamp, getDuration());
+
+    if (m_keys.size() == 1 || time <= m_times.front())
+    {
+        pose = m_keys.front().second;
+        return;
+    }
+    if (time >= m_times.back())
+    {
+        pose = m_keys.back().second;
+        return;
+    }
+
+    cursor.m_key = findKey(m_times, time, cursor.m_key);
+    interpolateKeys(cursor.m_key, time, pose);
+}
+
+Scalar getLocalTime(Scalar timestamp, Scalar duration)
+{
+    if (duration <= 0)
+        return 0;
+
     // ping pong: d - abs(mod(x, 2 * d) - d)
-    Scalar modifiedTime = duration - std::abs(fmod(timestamp, 2 * duration) - duration);
- 
-    if (modifiedTime <= m_keys.front().first)
-        return m_keys.front().second;
-    
-    for ( uint i = 0; i < m_keys.size() - 1; i++ )
+    return duration - std::abs(std::fmod(timestamp, 2 * duration) - duration);
+}
+
+uint findKey(const std::vector<Scalar>& times, Scalar time, uint hint)
+{
+    const uint last = times.size() - 2;
+
+    // Playback moves to the next interval (or the previous one, playing backward).
+    if (hint <= last)
     {
-        if (modifiedTime >= m_keys[i].first && modifiedTime <= m_keys[i + 1].first)
+        if (times[hint] <= time && time <= times[hint + 1])
+            return hint;
+        if (hint < last && times[hint + 1] <= time && time <= times[hint + 2])
+            return hint + 1;
+        if (hint > 0 && times[hint - 1] <= time && time <= times[hint])
+            return hint - 1;
+    }
+
+    const uint next = std::upper_bound(times.begin(), times.end(), time) - times.begin();
+    return std::min(std::max(next, 1u) - 1, last);
+}
+
+void Animation::interpolateKeys(uint i, Scalar time, Pose& pose) const
+{
+    const Scalar span = m_times[i + 1] - m_times[i];
+    const Scalar t = span > 0 ? (time - m_times[i]) / span : Scalar(0);
+
+    const AlignedStdVector<Quaternion>& rotA = m_rotations[i];
+    const AlignedStdVector<Quaternion>& rotB = m_rotations[i + 1];
+    const Vector3Array& transA = m_translations[i];
+    const Vector3Array& transB = m_translations[i + 1];
+    CORE_ASSERT(rotA.size() == rotB.size(), "Poses are wrong");
+
+    const uint size = rotA.size();
+    pose.resize(size);
+    for (uint b = 0; b < size; ++b)
+    {
+        pose[b].linear() = rotA[b].slerp(t, rotB[b]).toRotationMatrix();
+        pose[b].translation() = (1 - t) * transA[b] + t * transB[b];
+    }
+}
+
+void samplePoses(const std::vector<AnimationSample>& samples)
+{
+    parallelFor(0, samples.size(), 4, [&samples](uint begin, uint end)
+    {
+        for (uint i = begin; i < end; ++i)
         {
-            const KeyPose& prev = m_keys[i];
-            const KeyPose& next = m_keys[i + 1];
-            Scalar t = (modifiedTime - prev.first) / (next.first - prev.first);
-            return Ra::Core::Animation::interpolatePoses(m_keys[i].second, m_keys[i + 1].second, t);
+            const AnimationSample& s = samples[i];
+            if (s.m_cursor != nullptr)
+            {
+                s.m_animation->getPose(s.m_timestamp, *s.m_cursor, *s.m_pose);
+            }
+            else
+            {
+                s.m_animation->getPose(s.m_timestamp, *s.m_pose);
+            }
         }
-    }
-    
-    return m_keys.back().second;
+    });
 }
 
 }
@@ -4,6 +4,7 @@
 #include <vector>
 #include <utility>
 #include <Core/Animation/Pose/Pose.hpp>
+#include <Core/Containers/VectorArray.hpp>
 
 namespace Ra {
 namespace Core {
@@ -11,6 +12,15 @@ namespace Animation {
 
 typedef std::pair<Scalar, Pose> KeyPose;
 
+// Playback position in an animation: the key interval of the last sample.
+// Sampling from a cursor is O(1) while the time moves by less than a key
+// interval from one sample to the next, which is the case of a playback.
+struct AnimationCursor
+{
+    AnimationCursor() : m_key( 0 ) {}
+    uint m_key;
+};
+
 class RA_CORE_API Animation 
 {
 public:
@@ -27,15 +37,68 @@ public:
     
     // Re-order the poses by chronological order.
     void normalize();
+
+    uint getNumKeys() const;
+
+    // Key pose i, in chronological order once normalized.
+    const KeyPose& getKeyPose(uint i) const;
+
+    // Timestamp of the last key pose, in seconds.
+    Scalar getDuration() const;
     
     // Get the pose corresponding to the given timestamp.
-    // timestamp must be given in seconds.
+    // timestamp must be given in seconds. The animation plays back and forth.
     Pose getPose(Scalar timestamp) const;
+
+    // Same as above, written in pose, which is only allocated if it does not have
+    // the right size. The key poses around timestamp are found by binary search.
+    void getPose(Scalar timestamp, Pose& pose) const;
+
+    // Same as above, looking for the key poses around the cursor first and moving
+    // the cursor to them.
+    void getPose(Scalar timestamp, AnimationCursor& cursor, Pose& pose) const;
     
+private:
+    // Extracts the rotations and translations of a key pose.
+    void addKeyTransforms(const Pose& pose);
+
+    // Writes in pose the interpolation of the keys i and i+1 at time.
+    void interpolateKeys(uint i, Scalar time, Pose& pose) const;
+
 private:
     std::vector<KeyPose> m_keys;
+
+    // Timestamps, rotations and translations of the key poses, extracted once when
+    // they are added. The transforms of a key are stored bone after bone, so that
+    // the interpolation streams through two keys.
+    std::vector<Scalar> m_times;
+    std::vector<AlignedStdVector<Quaternion>> m_rotations;
+    std::vector<Vector3Array> m_translations;
 };
 
+// Returns the time in [0, duration] corresponding to timestamp, the animation
+// playing back and forth.
+RA_CORE_API Scalar getLocalTime(Scalar timestamp, Scalar duration);
+
+// Returns the index i of the key interval [t_i, t_i+1] of the sorted times (two
+// at least) containing time, starting the search at the interval hint.
+RA_CORE_API uint findKey(const std::vector<Scalar>& times, Scalar time, uint hint);
+
+// An animation to sample with samplePoses().
+struct AnimationSample
+{
+    const Animation* m_animation;
+    Scalar m_timestamp;
+    // Cursor of the playback, may be null.
+    AnimationCursor* m_cursor;
+    // Output of the sampling.
+    Pose* m_pose;
+};
+
+// Samples many animations (e.g. the characters of a crowd) at once, distributed
+// on the threads of parallelFor().
+RA_CORE_API void samplePoses(const std::vector<AnimationSample>& samples);
+
 }
 }
 }
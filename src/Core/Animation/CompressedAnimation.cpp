@@ -0,0 +1,400 @@
+#include <Core/Animation/CompressedAnimation.hpp>
+#include <algorithm>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <cmath>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+namespace {
+
+// Quantization of the three smallest components of a unit quaternion, which are
+// in [-1/sqrt(2), 1/sqrt(2)], on 15 bits. The index of the largest component is
+// stored in the last bit of the first two values.
+const Scalar QUAT_RANGE = Scalar(1.0 / std::sqrt(2.0));
+const Scalar QUAT_LEVELS = Scalar(32767);
+
+void encodeRotation(const Quaternion& q, ushort* out)
+{
+    Vector4 c = q.coeffs();
+    uint largest = 0;
+    c.cwiseAbs().maxCoeff(&largest);
+    if (c[largest] < 0)
+        c = -c;
+
+    uint k = 0;
+    for (uint i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+        const Scalar v = (c[i] / QUAT_RANGE + 1) * Scalar(0.5);
+        out[k++] = ushort(std::min(std::max(std::round(v * QUAT_LEVELS), Scalar(0)), QUAT_LEVELS));
+    }
+    out[0] |= ushort((largest & 1) << 15);
+    out[1] |= ushort((largest >> 1) << 15);
+}
+
+Quaternion decodeRotation(const ushort* in)
+{
+    const uint largest = (in[0] >> 15) | ((in[1] >> 15) << 1);
+    const Vector3 v = (Vector3(in[0] & 0x7fff, in[1] & 0x7fff, in[2]) * (2 / QUAT_LEVELS)
+                       - Vector3::Ones()) * QUAT_RANGE;
+    const Scalar l = std::sqrt(std::max(Scalar(1) - v.squaredNorm(), Scalar(0)));
+
+    // Coefficients in Eigen order (x, y, z, w).
+    Quaternion q;
+    switch (largest)
+    {
+    case 0: q.coeffs() << l, v[0], v[1], v[2]; break;
+    case 1: q.coeffs() << v[0], l, v[1], v[2]; break;
+    case 2: q.coeffs() << v[0], v[1], l, v[2]; break;
+    default: q.coeffs() << v[0], v[1], v[2], l; break;
+    }
+    return q;
+}
+
+Vector3 decodeVector(const ushort* in, const Vector3& min, const Vector3& step)
+{
+    return min + step.cwiseProduct(Vector3(in[0], in[1], in[2]));
+}
+
+// Normalized lerp along the shortest path.
+Quaternion nlerp(const Quaternion& a, const Quaternion& b, Scalar t)
+{
+    const Scalar sign = a.dot(b) < 0 ? Scalar(-1) : Scalar(1);
+    Quaternion q;
+    q.coeffs() = ((1 - t) * a.coeffs() + (sign * t) * b.coeffs()).normalized();
+    return q;
+}
+
+// Angle between two rotations, accurate for small angles unlike the acos of their dot product.
+Scalar angleBetween(const Quaternion& a, const Quaternion& b)
+{
+    const Quaternion d = a.conjugate() * b;
+    return 2 * std::atan2(d.vec().norm(), std::abs(d.w()));
+}
+
+}
+
+CompressedAnimation::CompressedAnimation()
+{
+}
+
+void CompressedAnimation::compress(const Animation& anim, const CompressionSettings& settings)
+{
+    clear();
+    const uint numKeys = anim.getNumKeys();
+    if (numKeys == 0)
+        return;
+    CORE_ASSERT(numKeys <= 65536, "Too many key poses");
+
+    const uint numBones = anim.getKeyPose(0).second.size();
+    std::vector<AlignedStdVector<Quaternion>> rotations(numBones);
+    std::vector<Vector3Array> translations(numBones);
+    std::vector<Vector3Array> scales(numBones);
+    for (uint k = 0; k < numKeys; ++k)
+    {
+        const KeyPose& key = anim.getKeyPose(k);
+        CORE_ASSERT(key.second.size() == numBones, "Poses are wrong");
+        CORE_ASSERT(k == 0 || m_times.back() <= key.first, "Animation is not normalized");
+        m_times.push_back(key.first);
+
+        for (uint b = 0; b < numBones; ++b)
+        {
+            Matrix3 rotation;
+            Matrix3 scaling;
+            key.second[b].computeRotationScaling(&rotation, &scaling);
+            rotations[b].push_back(Quaternion(rotation));
+            translations[b].push_back(key.second[b].translation());
+            scales[b].push_back(scaling.diagonal());
+        }
+    }
+
+    for (uint b = 0; b < numBones; ++b)
+    {
+        addRotationTrack(rotations[b], settings.m_rotationError);
+        addVectorTrack(translations[b], settings.m_translationError);
+        addVectorTrack(scales[b], settings.m_scaleError);
+    }
+}
+
+void CompressedAnimation::addRotationTrack(const AlignedStdVector<Quaternion>& values, Scalar maxError)
+{
+    const uint n = values.size();
+    std::vector<ushort> quantized(3 * n);
+    AlignedStdVector<Quaternion> decoded(n);
+    for (uint i = 0; i < n; ++i)
+    {
+        encodeRotation(values[i], &quantized[3 * i]);
+        decoded[i] = decodeRotation(&quantized[3 * i]);
+    }
+
+    const std::vector<uint> keys = reduceKeys(n, maxError, [&](uint a, uint b, Scalar t, uint i)
+    {
+        return angleBetween(nlerp(decoded[a], decoded[b], t), values[i]);
+    });
+    addTrack(keys, quantized, Vector3::Zero(), Vector3::Zero());
+}
+
+void CompressedAnimation::addVectorTrack(const Vector3Array& values, Scalar maxError)
+{
+    const uint n = values.size();
+    Vector3 min = values[0];
+    Vector3 max = values[0];
+    for (const auto& v : values)
+    {
+        min = min.cwiseMin(v);
+        max = max.cwiseMax(v);
+    }
+    const Vector3 step = (max - min) / Scalar(65535);
+
+    std::vector<ushort> quantized(3 * n);
+    Vector3Array decoded(n);
+    for (uint i = 0; i < n; ++i)
+    {
+        for (uint c = 0; c < 3; ++c)
+        {
+            const Scalar v = step[c] > 0 ? std::round((values[i][c] - min[c]) / step[c]) : Scalar(0);
+            quantized[3 * i + c] = ushort(std::min(std::max(v, Scalar(0)), Scalar(65535)));
+        }
+        decoded[i] = decodeVector(&quantized[3 * i], min, step);
+    }
+
+    const std::vector<uint> keys = reduceKeys(n, maxError, [&](uint a, uint b, Scalar t, uint i)
+    {
+        return ((1 - t) * decoded[a] + t * decoded[b] - values[i]).norm();
+    });
+    addTrack(keys, quantized, min, step);
+}
+
+template <typename ErrorFunc>
+std::vector<uint> CompressedAnimation::reduceKeys(uint numValues, Scalar maxError, const ErrorFunc& error) const
+{
+    // Constant track.
+    bool constant = true;
+    for (uint i = 0; constant && i < numValues; ++i)
+        constant = error(0, 0, 0, i) <= maxError;
+    if (constant)
+        return std::vector<uint>(1, 0);
+
+    // True if the key poses between a and b are interpolated within the bound.
+    auto isValid = [&](uint a, uint b)
+    {
+        const Scalar span = m_times[b] - m_times[a];
+        for (uint i = a + 1; i < b; ++i)
+        {
+            const Scalar t = span > 0 ? (m_times[i] - m_times[a]) / span : Scalar(0);
+            if (error(a, b, t, i) > maxError)
+                return false;
+        }
+        return true;
+    };
+
+    // Greedy reduction: from each kept key, the next one is the furthest which can be
+    // reached, found by doubling the length of the segment then by bisection.
+    std::vector<uint> keys(1, 0);
+    uint a = 0;
+    while (a + 1 < numValues)
+    {
+        uint good = a + 1;
+        uint bad = numValues;
+        uint step = 1;
+        while (good + 1 < numValues)
+        {
+            const uint next = std::min(good + step, numValues - 1);
+            if (!isValid(a, next))
+            {
+                bad = next;
+                break;
+            }
+            good = next;
+            step *= 2;
+        }
+        while (bad < numValues && bad - good > 1)
+        {
+            const uint mid = (good + bad) / 2;
+            if (isValid(a, mid))
+                good = mid;
+            else
+                bad = mid;
+        }
+        keys.push_back(good);
+        a = good;
+    }
+    return keys;
+}
+
+void CompressedAnimation::addTrack(const std::vector<uint>& keys, const std::vector<ushort>& quantized,
+                                   const Vector3& min, const Vector3& step)
+{
+    Track track;
+    track.m_first = m_keys.size();
+    track.m_numKeys = keys.size();
+    track.m_min = min;
+    track.m_step = step;
+    m_tracks.push_back(track);
+
+    for (uint k : keys)
+    {
+        m_keys.push_back(ushort(k));
+        m_values.insert(m_values.end(), quantized.begin() + 3 * k, quantized.begin() + 3 * k + 3);
+    }
+}
+
+void CompressedAnimation::clear()
+{
+    m_times.clear();
+    m_tracks.clear();
+    m_keys.clear();
+    m_values.clear();
+}
+
+bool CompressedAnimation::isEmpty() const
+{
+    return m_times.empty();
+}
+
+uint CompressedAnimation::getNumBones() const
+{
+    return m_tracks.size() / NUM_TRACKS;
+}
+
+uint CompressedAnimation::getNumKeys() const
+{
+    return m_times.size();
+}
+
+Scalar CompressedAnimation::getDuration() const
+{
+    return m_times.empty() ? Scalar(0) : m_times.back();
+}
+
+uint CompressedAnimation::getNumTrackKeys() const
+{
+    return m_keys.size();
+}
+
+uint CompressedAnimation::getNumConstantTracks() const
+{
+    return std::count_if(m_tracks.begin(), m_tracks.end(), [](const Track& track)
+    {
+        return track.m_numKeys == 1;
+    });
+}
+
+size_t CompressedAnimation::getMemorySize() const
+{
+    return sizeof(*this) + m_times.size() * sizeof(Scalar) + m_tracks.size() * sizeof(Track)
+           + (m_keys.size() + m_values.size()) * sizeof(ushort);
+}
+
+void CompressedAnimation::getPose(Scalar timestamp, Pose& pose) const
+{
+    uint hint = uint(-1);
+    samplePose(timestamp, hint, nullptr, pose);
+}
+
+void CompressedAnimation::getPose(Scalar timestamp, CompressedAnimationCursor& cursor, Pose& pose) const
+{
+    if (cursor.m_trackKeys.size() != m_tracks.size())
+        cursor.m_trackKeys.assign(m_tracks.size(), uint(-1));
+    samplePose(timestamp, cursor.m_key, cursor.m_trackKeys.data(), pose);
+}
+
+void CompressedAnimation::samplePose(Scalar timestamp, uint& hint, uint* trackKeys, Pose& pose) const
+{
+    CORE_ASSERT(!m_times.empty(), "Empty animation");
+
+    const Scalar time = getLocalTime(timestamp, getDuration());
+    const uint i = m_times.size() > 1 ? findKey(m_times, time, hint) : 0;
+    hint = i;
+
+    const uint numBones = getNumBones();
+    pose.resize(numBones);
+    uint keys[NUM_TRACKS] = { uint(-1), uint(-1), uint(-1) };
+    for (uint b = 0; b < numBones; ++b)
+    {
+        const Track* tracks = &m_tracks[NUM_TRACKS * b];
+        uint* k = trackKeys != nullptr ? trackKeys + NUM_TRACKS * b : keys;
+        const Quaternion rotation = sampleRotation(tracks[ROTATION], i, time, k[ROTATION]);
+        const Vector3 scale = sampleVector(tracks[SCALE], i, time, k[SCALE]);
+        pose[b].linear() = rotation.toRotationMatrix() * scale.asDiagonal();
+        pose[b].translation() = sampleVector(tracks[TRANSLATION], i, time, k[TRANSLATION]);
+    }
+}
+
+void CompressedAnimation::findTrackKeys(const Track& track, uint i, Scalar time, uint& key, Scalar& t) const
+{
+    t = 0;
+    if (track.m_numKeys == 1)
+    {
+        key = 0;
+        return;
+    }
+
+    // The first key of a track is the first key pose and the last one is the last
+    // key pose, which is after the interval i.
+    const ushort* keys = &m_keys[track.m_first];
+    const uint last = track.m_numKeys - 2;
+    const bool found = key <= last && keys[key] <= i && i < keys[key + 1];
+    if (!found)
+    {
+        if (key < last && keys[key + 1] <= i && i < keys[key + 2])
+            key = key + 1;
+        else if (key > 0 && key <= last && keys[key - 1] <= i && i < keys[key])
+            key = key - 1;
+        else
+            key = std::upper_bound(keys, keys + track.m_numKeys, i) - keys - 1;
+    }
+
+    const Scalar start = m_times[keys[key]];
+    const Scalar span = m_times[keys[key + 1]] - start;
+    if (span > 0)
+        t = std::min(std::max((time - start) / span, Scalar(0)), Scalar(1));
+}
+
+Quaternion CompressedAnimation::sampleRotation(const Track& track, uint i, Scalar time, uint& key) const
+{
+    Scalar t;
+    findTrackKeys(track, i, time, key, t);
+    const ushort* values = &m_values[3 * (track.m_first + key)];
+    const Quaternion a = decodeRotation(values);
+    if (track.m_numKeys == 1)
+        return a;
+    return nlerp(a, decodeRotation(values + 3), t);
+}
+
+Vector3 CompressedAnimation::sampleVector(const Track& track, uint i, Scalar time, uint& key) const
+{
+    Scalar t;
+    findTrackKeys(track, i, time, key, t);
+    const ushort* values = &m_values[3 * (track.m_first + key)];
+    const Vector3 a = decodeVector(values, track.m_min, track.m_step);
+    if (track.m_numKeys == 1)
+        return a;
+    return (1 - t) * a + t * decodeVector(values + 3, track.m_min, track.m_step);
+}
+
+void samplePoses(const std::vector<CompressedAnimationSample>& samples)
+{
+    parallelFor(0, samples.size(), 4, [&samples](uint begin, uint end)
+    {
+        for (uint i = begin; i < end; ++i)
+        {
+            const CompressedAnimationSample& s = samples[i];
+            if (s.m_cursor != nullptr)
+            {
+                s.m_animation->getPose(s.m_timestamp, *s.m_cursor, *s.m_pose);
+            }
+            else
+            {
+                s.m_animation->getPose(s.m_timestamp, *s.m_pose);
+            }
+        }
+    });
+}
+
+}
+}
+}
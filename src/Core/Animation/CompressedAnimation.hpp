@@ -0,0 +1,156 @@
+#ifndef COMPRESSED_ANIMATION_HPP
+#define COMPRESSED_ANIMATION_HPP
+
+#include <vector>
+#include <Core/Animation/Animation.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+// Maximum errors allowed when compressing an animation, between the sampled
+// transforms of a bone and the source key poses.
+struct CompressionSettings
+{
+    CompressionSettings()
+        : m_rotationError(Scalar(1e-3)), m_translationError(Scalar(1e-3)), m_scaleError(Scalar(1e-3)) {}
+
+    // Angle between the rotations, in radians.
+    Scalar m_rotationError;
+    // Distance between the translations.
+    Scalar m_translationError;
+    // Largest difference of the scale factors along the axes.
+    Scalar m_scaleError;
+};
+
+// Playback position in a compressed animation: the key interval of the last
+// sample, and the key of each track before it, which are looked for first.
+struct CompressedAnimationCursor
+{
+    CompressedAnimationCursor() : m_key( 0 ) {}
+    uint m_key;
+    std::vector<uint> m_trackKeys;
+};
+
+// Compact, read-only storage of an animation, for large libraries of clips
+// (e.g. motion capture).
+// Each bone has a rotation, a translation and a scale track:
+// - a track whose values stay within the error bound is stored as a single key,
+// - the other tracks only keep the keys which can not be interpolated from their
+//   neighbours within the error bound,
+// - rotations are quantized on 48 bits (the three smallest components of the
+//   quaternion), translations and scales on 16 bits per component in the range
+//   of their track.
+// Rotations are interpolated by normalized lerp, which the key reduction takes
+// into account. Unlike Animation, the scale of the key poses is kept.
+// The quantization step of a translation or scale track is its range / 65535,
+// the error bound can not be met below half of it.
+class RA_CORE_API CompressedAnimation
+{
+public:
+    CompressedAnimation();
+
+    // Compresses the key poses of anim, which must be normalized.
+    // An animation has at most 65536 key poses.
+    void compress(const Animation& anim, const CompressionSettings& settings = CompressionSettings());
+
+    void clear();
+
+    bool isEmpty() const;
+
+    uint getNumBones() const;
+
+    uint getNumKeys() const;
+
+    // Timestamp of the last key pose, in seconds.
+    Scalar getDuration() const;
+
+    // Number of keys stored in all the tracks.
+    uint getNumTrackKeys() const;
+
+    // Number of tracks stored as a single key.
+    uint getNumConstantTracks() const;
+
+    // Size of the compressed data, in bytes.
+    size_t getMemorySize() const;
+
+    // Get the pose corresponding to the given timestamp, written in pose.
+    // timestamp must be given in seconds. The animation plays back and forth,
+    // like Animation.
+    void getPose(Scalar timestamp, Pose& pose) const;
+
+    // Same as above, looking for the keys around the cursor first and moving the
+    // cursor to them. The cursor is allocated by its first use.
+    void getPose(Scalar timestamp, CompressedAnimationCursor& cursor, Pose& pose) const;
+
+private:
+    enum TrackType { ROTATION = 0, TRANSLATION, SCALE, NUM_TRACKS };
+
+    struct Track
+    {
+        // Index of the first key of the track in m_keys (and of its values in m_values).
+        uint m_first;
+        uint m_numKeys;
+        // Dequantization of the translation and scale values: m_min + m_step * value.
+        Vector3 m_min;
+        Vector3 m_step;
+    };
+
+    // Quantizes the values of a track, reduces its keys and appends them.
+    // Both arrays hold one value per key pose.
+    void addRotationTrack(const AlignedStdVector<Quaternion>& values, Scalar maxError);
+    void addVectorTrack(const Vector3Array& values, Scalar maxError);
+
+    // Appends the keys of a track made of the given key poses, with their quantized values.
+    void addTrack(const std::vector<uint>& keys, const std::vector<ushort>& quantized,
+                  const Vector3& min, const Vector3& step);
+
+    // Returns the keys of the track to keep so that the interpolation of the
+    // decoded values is within the error bound of the source values.
+    // error(a, b, t, i) is the error at the key pose i of the interpolation of the
+    // decoded values of the key poses a and b at t.
+    template <typename ErrorFunc>
+    std::vector<uint> reduceKeys(uint numValues, Scalar maxError, const ErrorFunc& error) const;
+
+    // Writes in pose the pose at timestamp, starting the search of the keys at the
+    // interval hint and at the keys of trackKeys, if not null, which are updated.
+    void samplePose(Scalar timestamp, uint& hint, uint* trackKeys, Pose& pose) const;
+
+    // Returns the key of the track before the key interval i, starting the search
+    // at the key hint, and the parameter of the interpolation with the next key of
+    // the track at time.
+    void findTrackKeys(const Track& track, uint i, Scalar time, uint& key, Scalar& t) const;
+
+    Quaternion sampleRotation(const Track& track, uint i, Scalar time, uint& key) const;
+    Vector3 sampleVector(const Track& track, uint i, Scalar time, uint& key) const;
+
+private:
+    // Timestamps of the key poses.
+    std::vector<Scalar> m_times;
+    // Tracks of the bones, NUM_TRACKS per bone.
+    std::vector<Track> m_tracks;
+    // Key pose of each key of the tracks.
+    std::vector<ushort> m_keys;
+    // Quantized values of the keys, three per key.
+    std::vector<ushort> m_values;
+};
+
+// A compressed animation to sample with samplePoses().
+struct CompressedAnimationSample
+{
+    const CompressedAnimation* m_animation;
+    Scalar m_timestamp;
+    // Cursor of the playback, may be null.
+    CompressedAnimationCursor* m_cursor;
+    // Output of the sampling.
+    Pose* m_pose;
+};
+
+// Samples many compressed animations at once, distributed on the threads of parallelFor().
+RA_CORE_API void samplePoses(const std::vector<CompressedAnimationSample>& samples);
+
+}
+}
+}
+
+#endif // COMPRESSED_ANIMATION_HPP
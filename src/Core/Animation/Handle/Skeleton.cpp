@@ -1,4 +1,5 @@
 #include <Core/Animation/Handle/Skeleton.hpp>
+#include <Core/Animation/Pose/PoseOperation.hpp>
 #include <stack>
 
 namespace Ra {
@@ -21,7 +22,7 @@ int Skeleton::addBone( const int parent, const Transform& T, const SpaceType MOD
         if( parent == -1 ) {
             m_modelSpace.push_back( T );
         } else {
-            m_modelSpace.push_back( T * m_modelSpace[parent] );
+            m_modelSpace.push_back( m_modelSpace[parent] * T );
         }
     } break;
     case SpaceType::MODEL: {
@@ -68,25 +69,18 @@ void Skeleton::setPose( const Pose& pose, const SpaceType MODE ) {
     switch( MODE ) {
     case SpaceType::LOCAL: {
         m_pose = pose;
-        m_modelSpace.resize( m_pose.size() );
-        for( uint i = 0; i < m_graph.size(); ++i ) {
-            if( m_graph.isRoot( i ) ) {
-                m_modelSpace[i] = m_pose[i];
-            }
-            for( const auto& child : m_graph.m_child[i] ) {
-                m_modelSpace[child] = m_modelSpace[i] * m_pose[child];
-            }
-        }
+        // The bones are added after their parent, the hierarchy is updated in one pass.
+        localToModelPose( m_graph.m_parent, m_pose, m_modelSpace );
     } break;
     case SpaceType::MODEL: {
         m_modelSpace = pose;
         m_pose.resize( m_modelSpace.size() );
         for( uint i = 0; i < m_graph.size(); ++i ) {
-            if( m_graph.isRoot( i ) ) {
+            const int parent = m_graph.m_parent[i];
+            if( parent < 0 ) {
                 m_pose[i] = m_modelSpace[i];
-            }
-            for( const auto& child : m_graph.m_child[i] ) {
-                m_pose[child] = m_modelSpace[i].inverse() * m_modelSpace[child];
+            } else {
+                m_pose[i] = m_modelSpace[parent].inverse( Eigen::Affine ) * m_modelSpace[i];
             }
         }
     } break;
@@ -13,6 +13,8 @@ namespace Animation {
 * The Skeleton handle class.
 *
 * A skeleton handle is a set of transforms with an associated hierarchy, represented by a graph ( adjacency list ).
+* A bone is added after its parent, so the bones are sorted parent before child and the model
+* space pose is updated in one pass over the parents of the graph ( see localToModelPose ).
 */
 class RA_CORE_API Skeleton : public PointCloud {
 public:
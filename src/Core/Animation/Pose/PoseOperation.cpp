@@ -1,4 +1,5 @@
 #include <Core/Animation/Pose/PoseOperation.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Eigen/Geometry>
 
 namespace Ra {
@@ -25,6 +26,81 @@ Pose relativePose( const Pose& modelPose, const RestPose& restPose )  {
 
 
 
+Pose inversePose( const Pose& pose ) {
+    Pose T( pose.size() );
+    for( uint i = 0; i < T.size(); ++i ) {
+        T[i] = pose[i].inverse( Eigen::Affine );
+    }
+    return T;
+}
+
+
+
+void relativePoseFromInverse( const Pose& modelPose, const Pose& inverseRestPose, Pose& relPose ) {
+    CORE_ASSERT( compatible( modelPose, inverseRestPose ), " Poses with different size " );
+    relPose.resize( modelPose.size() );
+    for( uint i = 0; i < relPose.size(); ++i ) {
+        // The product of the 4x4 matrices is vectorized, unlike the affine product.
+        relPose[i].matrix().noalias() = modelPose[i].matrix() * inverseRestPose[i].matrix();
+    }
+}
+
+
+
+void localToModelPose( const Graph::ParentList& parents, const Pose& localPose, Pose& modelPose ) {
+    CORE_ASSERT( ( parents.size() == localPose.size() ), " Hierarchy and pose with different size " );
+    const uint n = localPose.size();
+    modelPose.resize( n );
+    for( uint i = 0; i < n; ++i ) {
+        const int parent = parents[i];
+        CORE_ASSERT( ( parent < int( i ) ), " Parent after its child " );
+        if( parent < 0 ) {
+            modelPose[i] = localPose[i];
+        } else {
+            modelPose[i].matrix().noalias() = modelPose[parent].matrix() * localPose[i].matrix();
+        }
+    }
+}
+
+
+
+void localToModelPose( const Graph::ParentList& parents, const Pose& localPose,
+                       const Pose& inverseRestPose, Pose& modelPose, Pose& relPose ) {
+    CORE_ASSERT( ( parents.size() == localPose.size() ), " Hierarchy and pose with different size " );
+    CORE_ASSERT( compatible( localPose, inverseRestPose ), " Poses with different size " );
+    const uint n = localPose.size();
+    modelPose.resize( n );
+    relPose.resize( n );
+    for( uint i = 0; i < n; ++i ) {
+        const int parent = parents[i];
+        CORE_ASSERT( ( parent < int( i ) ), " Parent after its child " );
+        if( parent < 0 ) {
+            modelPose[i] = localPose[i];
+        } else {
+            modelPose[i].matrix().noalias() = modelPose[parent].matrix() * localPose[i].matrix();
+        }
+        relPose[i].matrix().noalias() = modelPose[i].matrix() * inverseRestPose[i].matrix();
+    }
+}
+
+
+
+void localToModelPoses( const Graph::ParentList& parents, const Pose& inverseRestPose,
+                        const std::vector< HierarchyPoses >& poses ) {
+    parallelFor( 0, poses.size(), 4, [&]( uint begin, uint end ) {
+        for( uint i = begin; i < end; ++i ) {
+            const HierarchyPoses& p = poses[i];
+            if( p.m_relPose != nullptr ) {
+                localToModelPose( parents, *p.m_localPose, inverseRestPose, *p.m_modelPose, *p.m_relPose );
+            } else {
+                localToModelPose( parents, *p.m_localPose, *p.m_modelPose );
+            }
+        }
+    } );
+}
+
+
+
 Pose applyTransformation(const Pose& pose, const AlignedStdVector<Transform> &transform ) {
     Pose T( std::min( pose.size(), transform.size() ) );
     #pragma omp parallel for
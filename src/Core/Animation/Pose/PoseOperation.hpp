@@ -2,6 +2,9 @@
 #define POSE_OPERATION_H
 
 #include <Core/Animation/Pose/Pose.hpp>
+#include <Core/Utils/Graph/AdjacencyList.hpp>
+
+#include <vector>
 
 namespace Ra {
 namespace Core {
@@ -26,6 +29,63 @@ RA_CORE_API Pose relativePose( const Pose& modelPose, const RestPose& restPose )
 
 
 
+/*
+* Return the inverse of each transform of the pose. Used to precompute the inverse
+* of a rest pose, which does not change from one frame to the next.
+*/
+RA_CORE_API Pose inversePose( const Pose& pose );
+
+
+
+/*
+* Given a model pose and the inverse of a compatible rest pose, write the relative pose
+* in relPose. Same as relativePose, without inverting the rest pose.
+*/
+RA_CORE_API void relativePoseFromInverse( const Pose& modelPose, const Pose& inverseRestPose, Pose& relPose );
+
+
+
+/*
+* Compute the model pose of a hierarchy from its local pose, in one pass over the bones.
+* parents[i] is the parent of the i-th bone, or -1 for a root. The parents must come
+* before their children, which is the order of the bones of a Skeleton.
+*
+* The operation is equal to:
+*           modelPose[i] = modelPose[parents[i]] * localPose[i];
+*/
+RA_CORE_API void localToModelPose( const Graph::ParentList& parents, const Pose& localPose, Pose& modelPose );
+
+
+
+/*
+* Same as above, also computing the skinning pose in the same pass:
+*           relPose[i] = modelPose[i] * inverseRestPose[i];
+*/
+RA_CORE_API void localToModelPose( const Graph::ParentList& parents, const Pose& localPose,
+                                   const Pose& inverseRestPose, Pose& modelPose, Pose& relPose );
+
+
+
+/*
+* The poses of one instance of a hierarchy, for the batched update.
+* relPose may be null if the skinning pose is not needed.
+*/
+struct HierarchyPoses {
+    const Pose* m_localPose;
+    Pose*       m_modelPose;
+    Pose*       m_relPose;
+};
+
+/*
+* Update the model and skinning poses of many instances of the same hierarchy
+* (e.g. the characters of a crowd sharing a skeleton), distributed on the threads
+* of parallelFor().
+*/
+RA_CORE_API void localToModelPoses( const Graph::ParentList& parents, const Pose& inverseRestPose,
+                                    const std::vector< HierarchyPoses >& poses );
+
+
+
 /*
 * Return the pose resulting in applying the i-th transform to the i-th pose transform.
 *
@@ -1,9 +1,125 @@
 #include <Core/Animation/Skinning/DualQuaternionSkinning.hpp>
 
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+#include <cmath>
+
 namespace Ra {
 namespace Core {
 namespace Animation {
 
+namespace {
+    // Number of vertices blended together by the SoA kernel. This is also the parallelFor() grain size.
+    const uint DQS_BLOCK_SIZE = 256;
+
+    // Coefficients of a dual quaternion: (w, x, y, z) of q0, then (w, x, y, z) of qe.
+    struct DQCoeffs
+    {
+        Scalar m_c[8];
+    };
+
+    // Converts the pose transforms to dual quaternion coefficients.
+    void extractDQ( const Pose& pose, std::vector<DQCoeffs>& poseDQ )
+    {
+        poseDQ.resize( pose.size() );
+        for( uint j = 0; j < pose.size(); ++j ) {
+            const DualQuaternion dq( pose[j] );
+            const Quaternion& q0 = dq.getQ0();
+            const Quaternion& qe = dq.getQe();
+            const Scalar c[8] = { q0.w(), q0.x(), q0.y(), q0.z(), qe.w(), qe.x(), qe.y(), qe.z() };
+            std::copy( c, c + 8, poseDQ[j].m_c );
+        }
+    }
+
+    // Skins the vertices (and normals if inNormals is not empty) [begin, end[,
+    // with end - begin <= DQS_BLOCK_SIZE.
+    void skinDQBlock( const Vector3Array& inVertices, const Vector3Array& inNormals,
+                      const DQCoeffs* dqs, const PackedWeights& weight, uint begin, uint end,
+                      Vector3Array& outVertices, Vector3Array& outNormals )
+    {
+        CORE_ASSERT( end - begin <= DQS_BLOCK_SIZE, "Block is too large" );
+        const bool doNormals = !inNormals.empty();
+        const uint width = weight.m_width;
+        const uint* indices = weight.m_indices.data();
+        const Scalar* weights = weight.m_weights.data();
+
+        const uint count = end - begin;
+        // Blended dual quaternions of the block, one array per coefficient.
+        Scalar blend[8][DQS_BLOCK_SIZE];
+
+        // 1. Blend. Each dual quaternion is flipped to lie in the same hemisphere
+        // as the first influence of the vertex (Kavan et al. 2008, algorithm 2).
+        for( uint v = 0; v < count; ++v ) {
+            const uint* idx = indices + ( begin + v ) * width;
+            const Scalar* wgt = weights + ( begin + v ) * width;
+            const Scalar* f = dqs[idx[0]].m_c;
+            Scalar acc[8];
+            for( uint c = 0; c < 8; ++c ) {
+                acc[c] = wgt[0] * f[c];
+            }
+            for( uint k = 1; k < width; ++k ) {
+                const Scalar* q = dqs[idx[k]].m_c;
+                const Scalar dot = q[0] * f[0] + q[1] * f[1] + q[2] * f[2] + q[3] * f[3];
+                const Scalar w = wgt[k] * Math::signNZ( dot );
+                for( uint c = 0; c < 8; ++c ) {
+                    acc[c] += w * q[c];
+                }
+            }
+            for( uint c = 0; c < 8; ++c ) {
+                blend[c][v] = acc[c];
+            }
+        }
+
+        // 2. Normalize.
+        for( uint v = 0; v < count; ++v ) {
+            const Scalar invNorm = Scalar( 1 ) / std::sqrt( blend[0][v] * blend[0][v] + blend[1][v] * blend[1][v]
+                                                          + blend[2][v] * blend[2][v] + blend[3][v] * blend[3][v] );
+            for( uint c = 0; c < 8; ++c ) {
+                blend[c][v] *= invNorm;
+            }
+        }
+
+        // 3. Apply : p' = p + 2 * r x ( r x p + w * p ) + 2 * ( w * re - we * r + r x re ),
+        // with q0 = ( w, r ) and qe = ( we, re ). Normals only get the rotation.
+        for( uint v = 0; v < count; ++v ) {
+            const uint i = begin + v;
+            const Scalar w = blend[0][v];
+            const Scalar rx = blend[1][v];
+            const Scalar ry = blend[2][v];
+            const Scalar rz = blend[3][v];
+            const Scalar we = blend[4][v];
+            const Scalar ex = blend[5][v];
+            const Scalar ey = blend[6][v];
+            const Scalar ez = blend[7][v];
+
+            const Vector3& p = inVertices[i];
+            const Scalar tx = ry * p.z() - rz * p.y() + w * p.x();
+            const Scalar ty = rz * p.x() - rx * p.z() + w * p.y();
+            const Scalar tz = rx * p.y() - ry * p.x() + w * p.z();
+            outVertices[i] = Vector3( p.x() + 2 * ( ry * tz - rz * ty ) + 2 * ( w * ex - we * rx + ry * ez - rz * ey ),
+                                      p.y() + 2 * ( rz * tx - rx * tz ) + 2 * ( w * ey - we * ry + rz * ex - rx * ez ),
+                                      p.z() + 2 * ( rx * ty - ry * tx ) + 2 * ( w * ez - we * rz + rx * ey - ry * ex ) );
+        }
+        if( doNormals ) {
+            for( uint v = 0; v < count; ++v ) {
+                const uint i = begin + v;
+                const Scalar w = blend[0][v];
+                const Scalar rx = blend[1][v];
+                const Scalar ry = blend[2][v];
+                const Scalar rz = blend[3][v];
+                const Vector3& n = inNormals[i];
+                const Scalar tx = ry * n.z() - rz * n.y() + w * n.x();
+                const Scalar ty = rz * n.x() - rx * n.z() + w * n.y();
+                const Scalar tz = rx * n.y() - ry * n.x() + w * n.z();
+                outNormals[i] = Vector3( n.x() + 2 * ( ry * tz - rz * ty ),
+                                         n.y() + 2 * ( rz * tx - rx * tz ),
+                                         n.z() + 2 * ( rx * ty - ry * tx ) );
+            }
+        }
+    }
+}
+
 void computeDQ( const Pose& pose, const WeightMatrix& weight, DQList& DQ ) {
     CORE_ASSERT( ( pose.size() == weight.cols() ), "pose/weight size mismatch." );
     DQ.clear();
@@ -13,8 +129,7 @@ void computeDQ( const Pose& pose, const WeightMatrix& weight, DQList& DQ ) {
     std::vector<uint> firstNonZero( weight.rows(), std::numeric_limits<uint>::max());
 
     // Contains the converted dual quaternions from the pose
-    std::vector<DualQuaternion> poseDQ;
-    poseDQ.reserve( pose.size());
+    std::vector<DualQuaternion> poseDQ( pose.size() );
 
     // Loop through all transforms Tj
     for( int j = 0; j < weight.outerSize(); ++j ) {
@@ -24,45 +139,60 @@ void computeDQ( const Pose& pose, const WeightMatrix& weight, DQList& DQ ) {
         const int nonZero = weight.col( j ).nonZeros();
 
         WeightMatrix::InnerIterator it0( weight, j );
-#if defined CORE_USE_OMP
-        omp_set_dynamic(0);
-        #pragma omp parallel for schedule( static ) num_threads(4)
-#endif
-        // This for loop is here just because OpenMP wants classic for loops.
+        // Loop through all vertices vi who depend on Tj. Each vertex appears once in the
+        // column, so the blocks of the column can be accumulated in parallel without the
+        // critical section a parallel loop over the transforms would need on DQ[i].
         // Since we cannot iterate directly through the non-zero elements using the InnerIterator,
         // we initialize an InnerIterator to the first element and then we increase it nz times.
-        /*
-        * This crappy piece of code was done in order to avoid the critical section
-        *           DQ[i] += wq;
-        *
-        * that was occurring when parallelizing the main for loop.
-        *
-        * NOTE: this could be definitely improved by using std::thread
-        */
-        // Loop trhough all vertices vi who depend on Tj
-
-        for( int nz = 0; nz < nonZero; ++nz ) {
-
-            WeightMatrix::InnerIterator itn = it0 + nz;
-            const uint   i  = itn.row();
-            const Scalar w  = itn.value();
-
-            firstNonZero[i] = std::min( firstNonZero[i], uint(j) );
-            const Scalar sign =  Ra::Core::Math::signNZ(  poseDQ[j].getQ0().dot(poseDQ[firstNonZero[i]].getQ0()));
-
-            const auto  wq = poseDQ[j] * w * sign;
-            DQ[i] += wq;
-        }
+        parallelFor( 0, nonZero, DQS_BLOCK_SIZE, [&]( uint begin, uint end ) {
+            for( uint nz = begin; nz < end; ++nz ) {
+                WeightMatrix::InnerIterator itn = it0 + nz;
+                const uint   i  = itn.row();
+                const Scalar w  = itn.value();
+
+                firstNonZero[i] = std::min( firstNonZero[i], uint(j) );
+                const Scalar sign =  Ra::Core::Math::signNZ(  poseDQ[j].getQ0().dot(poseDQ[firstNonZero[i]].getQ0()));
+
+                const auto  wq = poseDQ[j] * w * sign;
+                DQ[i] += wq;
+            }
+        });
     }
 
     // Normalize all dual quats.
-#if defined CORE_USE_OMP
-    omp_set_dynamic(0);
-    #pragma omp parallel for schedule( static ) num_threads(4)
-#endif
-    for( int i = 0; i < int(DQ.size()) ; ++i) {
-        DQ[i].normalize();
+    parallelFor( 0, DQ.size(), 1024, [&DQ]( uint begin, uint end ) {
+        for( uint i = begin; i < end; ++i ) {
+            DQ[i].normalize();
+        }
+    });
+}
+
+void computeDQ( const Pose& pose, const PackedWeights& weight, const VertexRangeList& ranges, DQList& DQ ) {
+    CORE_ASSERT( ( DQ.size() == weight.m_numVertices ), "DQ/weight size mismatch." );
+
+    DQList poseDQ( pose.size() );
+    for( uint j = 0; j < pose.size(); ++j ) {
+        poseDQ[j] = DualQuaternion( pose[j] );
     }
+
+    const uint width = weight.m_width;
+    parallelForRanges( ranges, DQS_BLOCK_SIZE, [&]( uint begin, uint end ) {
+        for( uint i = begin; i < end; ++i ) {
+            const uint*   indices = &weight.m_indices[i * width];
+            const Scalar* weights = &weight.m_weights[i * width];
+
+            // As in computeDQ(), the signs are given by the first influence, which has the
+            // smallest handle index (padding slots have a zero weight).
+            const Quaternion& first = poseDQ[indices[0]].getQ0();
+            DualQuaternion dq( Quaternion( 0, 0, 0, 0 ), Quaternion( 0, 0, 0, 0 ) );
+            for( uint k = 0; k < width; ++k ) {
+                const DualQuaternion& q = poseDQ[indices[k]];
+                dq += q * ( weights[k] * Ra::Core::Math::signNZ( q.getQ0().dot( first ) ) );
+            }
+            dq.normalize();
+            DQ[i] = dq;
+        }
+    });
 }
 
 // alternate naive version, for reference purposes.
@@ -110,13 +240,51 @@ void dualQuaternionSkinning( const Vector3Array& input, const DQList& DQ, Vector
     const uint size = input.size();
     CORE_ASSERT( ( size == DQ.size() ), "input/DQ size mismatch." );
     output.resize( size );
-#if defined CORE_USE_OMP
-    omp_set_dynamic(0);
-    #pragma omp parallel for schedule( static ) num_threads(4)
-#endif
-    for( int i = 0; i < int(size); ++i ) {
-        output[i] = DQ[i].transform( input[i] );
+    parallelFor( 0, size, 1024, [&]( uint begin, uint end ) {
+        for( uint i = begin; i < end; ++i ) {
+            output[i] = DQ[i].transform( input[i] );
+        }
+    });
+}
+
+void dualQuaternionSkinning( const Vector3Array& inVertices, const Vector3Array& inNormals,
+                             const Pose& pose, const PackedWeights& weight,
+                             Vector3Array& outVertices, Vector3Array& outNormals ) {
+    const uint size = inVertices.size();
+    const bool doNormals = !inNormals.empty();
+    CORE_ASSERT( ( size == weight.m_numVertices ), "input/weight size mismatch." );
+    CORE_ASSERT( ( !doNormals || size == inNormals.size() ), "vertices/normals size mismatch." );
+    CORE_ASSERT( weight.m_width > 0, "Weights are not packed" );
+
+    std::vector<DQCoeffs> poseDQ;
+    extractDQ( pose, poseDQ );
+
+    outVertices.resize( size );
+    if( doNormals ) {
+        outNormals.resize( size );
     }
+
+    parallelFor( 0, size, DQS_BLOCK_SIZE, [&]( uint begin, uint end ) {
+        skinDQBlock( inVertices, inNormals, poseDQ.data(), weight, begin, end, outVertices, outNormals );
+    });
+}
+
+void dualQuaternionSkinning( const Vector3Array& inVertices, const Vector3Array& inNormals,
+                             const Pose& pose, const PackedWeights& weight, const VertexRangeList& ranges,
+                             Vector3Array& outVertices, Vector3Array& outNormals ) {
+    const uint size = inVertices.size();
+    CORE_ASSERT( ( size == weight.m_numVertices ), "input/weight size mismatch." );
+    CORE_ASSERT( ( inNormals.empty() || size == inNormals.size() ), "vertices/normals size mismatch." );
+    CORE_ASSERT( ( size == outVertices.size() ), "Output must hold the previous skinning result" );
+    CORE_ASSERT( ( inNormals.empty() || size == outNormals.size() ), "Output must hold the previous skinning result" );
+    CORE_ASSERT( weight.m_width > 0, "Weights are not packed" );
+
+    std::vector<DQCoeffs> poseDQ;
+    extractDQ( pose, poseDQ );
+
+    parallelForRanges( ranges, DQS_BLOCK_SIZE, [&]( uint begin, uint end ) {
+        skinDQBlock( inVertices, inNormals, poseDQ.data(), weight, begin, end, outVertices, outNormals );
+    });
 }
 
 } // namespace Animation
@@ -6,6 +6,8 @@
 #include <Core/Math/DualQuaternion.hpp>
 #include <Core/Animation/Pose/Pose.hpp>
 #include <Core/Animation/Handle/HandleWeight.hpp>
+#include <Core/Animation/Skinning/PackedWeights.hpp>
+#include <Core/Animation/Skinning/IncrementalSkinning.hpp>
 
 namespace Ra {
 namespace Core {
@@ -23,6 +25,12 @@ void RA_CORE_API computeDQ( const Pose& pose, const WeightMatrix& weight, DQList
 // Same version, without the parallelism for reference purposes (see github issue #118)
 void RA_CORE_API computeDQ_naive( const Pose& pose, const WeightMatrix& weight, DQList& DQ );
 
+/*
+* Same as computeDQ() with weights packed by packWeights(), but only the dual quaternions of the vertices
+* in ranges are computed. The others are left untouched, DQ must have one entry per vertex.
+*/
+void RA_CORE_API computeDQ( const Pose& pose, const PackedWeights& weight, const VertexRangeList& ranges, DQList& DQ );
+
 /*
 * DualQuaternionSkinning applies a set of dual quaternions to a given input set of vertices and returns the resulting transformed vertices.
 *
@@ -30,6 +38,26 @@ void RA_CORE_API computeDQ_naive( const Pose& pose, const WeightMatrix& weight,
 */
 void RA_CORE_API dualQuaternionSkinning( const Vector3Array& input, const DQList& DQ, Vector3Array& output );
 
+/*
+* Dual quaternion skinning of the vertices and normals in one pass, with weights packed by packWeights().
+* The dual quaternions are blended, normalized and applied on blocks of vertices stored as structure of
+* arrays, in parallel (see parallelFor()). Normals are rotated by the blended rotation.
+* If inNormals is empty, only the vertices are skinned.
+*
+* WARNING : in Debug the function will assert if inVertices, inNormals and weight size mismatch.
+*/
+void RA_CORE_API dualQuaternionSkinning( const Vector3Array& inVertices, const Vector3Array& inNormals,
+                                         const Pose& pose, const PackedWeights& weight,
+                                         Vector3Array& outVertices, Vector3Array& outNormals );
+
+/*
+* Same as above, but only the vertices in ranges are skinned. The other vertices and normals of the
+* outputs, which must have the size of the inputs, are left untouched.
+*/
+void RA_CORE_API dualQuaternionSkinning( const Vector3Array& inVertices, const Vector3Array& inNormals,
+                                         const Pose& pose, const PackedWeights& weight, const VertexRangeList& ranges,
+                                         Vector3Array& outVertices, Vector3Array& outNormals );
+
 } // namespace Animation
 } // namespace Core
 } // namespace Ra
@@ -0,0 +1,185 @@
+#include <Core/Animation/Skinning/IncrementalSkinning.hpp>
+
+#include <algorithm>
+
+#include <Core/Geometry/Triangle/TriangleOperation.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+namespace
+{
+    const uint NORMALS_GRAIN_SIZE = 2048;
+
+    /// Appends [begin, end[ to the sorted ranges, merging it with the last range if they are
+    /// separated by less than mergeGap vertices.
+    void appendRange( uint begin, uint end, uint mergeGap, VertexRangeList& ranges )
+    {
+        if ( !ranges.empty() && begin - ranges.back().second < mergeGap )
+        {
+            ranges.back().second = end;
+        }
+        else
+        {
+            ranges.push_back( std::make_pair( begin, end ) );
+        }
+    }
+}
+
+void getChangedHandles( const Pose& previous, const Pose& current, std::vector<uint>& changed )
+{
+    CORE_ASSERT( previous.size() == current.size(), "Poses with different size" );
+    changed.clear();
+    for ( uint j = 0; j < current.size(); ++j )
+    {
+        if ( !previous[j].isApprox( current[j] ) )
+        {
+            changed.push_back( j );
+        }
+    }
+}
+
+void getInfluencedRanges( const WeightMatrix& weights, const std::vector<uint>& handles,
+                          uint mergeGap, VertexRangeList& ranges )
+{
+    ranges.clear();
+    if ( handles.empty() )
+    {
+        return;
+    }
+
+    // Columns of the weight matrix are the vertices influenced by each handle.
+    std::vector<bool> influenced( weights.rows(), false );
+    for ( uint j : handles )
+    {
+        CORE_ASSERT( j < uint( weights.cols() ), "Invalid handle index" );
+        for ( WeightMatrix::InnerIterator it( weights, j ); it; ++it )
+        {
+            if ( it.value() != 0 )
+            {
+                influenced[it.row()] = true;
+            }
+        }
+    }
+
+    const uint numVertices = influenced.size();
+    uint i = 0;
+    while ( i < numVertices )
+    {
+        if ( !influenced[i] )
+        {
+            ++i;
+            continue;
+        }
+        const uint begin = i;
+        while ( i < numVertices && influenced[i] )
+        {
+            ++i;
+        }
+        appendRange( begin, i, mergeGap, ranges );
+    }
+}
+
+uint getRangesSize( const VertexRangeList& ranges )
+{
+    uint size = 0;
+    for ( const auto& r : ranges )
+    {
+        size += r.second - r.first;
+    }
+    return size;
+}
+
+void parallelForRanges( const VertexRangeList& ranges, uint grainSize,
+                        const std::function<void( uint, uint )>& func )
+{
+    grainSize = std::max( grainSize, 1u );
+
+    // Split the ranges in chunks so that small and large ranges are balanced among threads.
+    VertexRangeList chunks;
+    for ( const auto& r : ranges )
+    {
+        for ( uint begin = r.first; begin < r.second; begin += std::min( grainSize, r.second - begin ) )
+        {
+            chunks.push_back( std::make_pair( begin, begin + std::min( grainSize, r.second - begin ) ) );
+        }
+    }
+
+    parallelFor( 0, chunks.size(), 1, [&]( uint begin, uint end )
+    {
+        for ( uint c = begin; c < end; ++c )
+        {
+            func( chunks[c].first, chunks[c].second );
+        }
+    } );
+}
+
+void getNormalRanges( const Geometry::TVAdj& adj, const VectorArray<Triangle>& triangles,
+                      const VertexRangeList& ranges, uint mergeGap, VertexRangeList& normalRanges )
+{
+    normalRanges.clear();
+
+    // Sorting the vertices of the triangles around the ranges does not depend on the mesh size.
+    std::vector<uint> vertices;
+    vertices.reserve( 2 * getRangesSize( ranges ) );
+    for ( const auto& r : ranges )
+    {
+        for ( uint i = r.first; i < r.second; ++i )
+        {
+            for ( Geometry::TVAdj::InnerIterator it( adj, i ); it; ++it )
+            {
+                const Triangle& t = triangles[it.row()];
+                vertices.push_back( t( 0 ) );
+                vertices.push_back( t( 1 ) );
+                vertices.push_back( t( 2 ) );
+            }
+        }
+    }
+    std::sort( vertices.begin(), vertices.end() );
+    vertices.erase( std::unique( vertices.begin(), vertices.end() ), vertices.end() );
+
+    uint k = 0;
+    while ( k < vertices.size() )
+    {
+        const uint begin = vertices[k];
+        uint end = begin + 1;
+        while ( ++k < vertices.size() && vertices[k] == end )
+        {
+            ++end;
+        }
+        appendRange( begin, end, mergeGap, normalRanges );
+    }
+}
+
+void uniformNormal( const Vector3Array& vertices, const VectorArray<Triangle>& triangles,
+                    const Geometry::TVAdj& adj, const VertexRangeList& ranges, Vector3Array& normals )
+{
+    CORE_ASSERT( normals.size() == vertices.size() && uint( adj.cols() ) == vertices.size(), "Size mismatch" );
+    parallelForRanges( ranges, NORMALS_GRAIN_SIZE, [&]( uint begin, uint end )
+    {
+        for ( uint i = begin; i < end; ++i )
+        {
+            Vector3 normal = Vector3::Zero();
+            for ( Geometry::TVAdj::InnerIterator it( adj, i ); it; ++it )
+            {
+                const Triangle& t = triangles[it.row()];
+                const Vector3 triN = Geometry::triangleNormal( vertices[t( 0 )], vertices[t( 1 )], vertices[t( 2 )] );
+                if ( triN.allFinite() )
+                {
+                    normal += triN;
+                }
+            }
+            if ( !normal.isApprox( Vector3::Zero() ) )
+            {
+                normal.normalize();
+            }
+            normals[i] = normal;
+        }
+    } );
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
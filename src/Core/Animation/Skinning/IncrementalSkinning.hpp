@@ -0,0 +1,55 @@
+#ifndef RADIUMENGINE_INCREMENTAL_SKINNING_HPP_
+#define RADIUMENGINE_INCREMENTAL_SKINNING_HPP_
+
+#include <Core/RaCore.hpp>
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <Core/Animation/Pose/Pose.hpp>
+#include <Core/Animation/Handle/HandleWeight.hpp>
+#include <Core/Geometry/Adjacency/Adjacency.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/// Sorted, disjoint half-open ranges [first, second[ of vertex indices.
+typedef std::vector<std::pair<uint, uint>> VertexRangeList;
+
+/// Fills changed with the indices of the transforms which are not approximately
+/// equal in the two poses (using the same test as areEqual()).
+void RA_CORE_API getChangedHandles( const Pose& previous, const Pose& current, std::vector<uint>& changed );
+
+/// Computes the ranges of vertices having a non-zero weight for at least one of the handles.
+/// Ranges separated by less than mergeGap vertices are merged, which trades a few useless
+/// vertices against fewer ranges.
+void RA_CORE_API getInfluencedRanges( const WeightMatrix& weights, const std::vector<uint>& handles,
+                                      uint mergeGap, VertexRangeList& ranges );
+
+/// Returns the number of vertices in the ranges.
+uint RA_CORE_API getRangesSize( const VertexRangeList& ranges );
+
+/// Calls func( begin, end ) on sub-ranges of the ranges of at most grainSize vertices,
+/// in parallel (see parallelFor()).
+void RA_CORE_API parallelForRanges( const VertexRangeList& ranges, uint grainSize,
+                                    const std::function<void( uint, uint )>& func );
+
+/// Computes the ranges of the vertices whose normal changes when the vertices in ranges move,
+/// i.e. the vertices of the triangles around them. adj gives the triangles around each vertex
+/// (see Geometry::triangleUniformAdjacency()). Ranges are merged as in getInfluencedRanges().
+void RA_CORE_API getNormalRanges( const Geometry::TVAdj& adj, const VectorArray<Triangle>& triangles,
+                                  const VertexRangeList& ranges, uint mergeGap, VertexRangeList& normalRanges );
+
+/// Same as Geometry::uniformNormal(), but only the normals of the vertices in ranges are computed,
+/// from the triangles around them given by adj. The other normals are left untouched, normals must
+/// have the size of vertices.
+void RA_CORE_API uniformNormal( const Vector3Array& vertices, const VectorArray<Triangle>& triangles,
+                                const Geometry::TVAdj& adj, const VertexRangeList& ranges, Vector3Array& normals );
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_INCREMENTAL_SKINNING_HPP_
@@ -1,27 +1,100 @@
 #include <Core/Animation/Skinning/LinearBlendSkinning.hpp>
 
+#include <Core/Containers/AlignedStdVector.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
 namespace Ra {
 namespace Core {
 namespace Animation {
 
+namespace {
+    typedef Eigen::Matrix<Scalar, 3, 4> AffineMatrix;
+
+    // Number of vertices processed by a parallelFor() chunk.
+    const uint SKINNING_GRAIN_SIZE = 2048;
+
+    // Copies the affine part of the pose in a contiguous array.
+    void extractAffine( const Pose& pose, AlignedStdVector<AffineMatrix>& matrices )
+    {
+        matrices.resize( pose.size() );
+        for( uint j = 0; j < pose.size(); ++j ) {
+            matrices[j] = pose[j].affine();
+        }
+    }
+
+    // Skins the vertices [begin, end[ with packed weights.
+    void skinPackedBlock( const Vector3Array& inMesh, const AffineMatrix* mats, const PackedWeights& weight,
+                          uint begin, uint end, Vector3Array& outMesh )
+    {
+        const uint width = weight.m_width;
+        const uint* indices = weight.m_indices.data();
+        const Scalar* weights = weight.m_weights.data();
+        for( uint i = begin; i < end; ++i ) {
+            const uint* idx = indices + i * width;
+            const Scalar* w = weights + i * width;
+            // Padded influences have a zero weight, so the loop has a fixed length.
+            AffineMatrix m = w[0] * mats[idx[0]];
+            for( uint k = 1; k < width; ++k ) {
+                m += w[k] * mats[idx[k]];
+            }
+            outMesh[i] = m.leftCols<3>() * inMesh[i] + m.col( 3 );
+        }
+    }
+}
+
 void linearBlendSkinning( const Vector3Array&  inMesh,
                              const Pose&          pose,
                              const WeightMatrix&  weight,
                              Vector3Array&        outMesh ) {
+    CORE_ASSERT( inMesh.size() == uint( weight.rows() ), "Weights are incompatible with mesh" );
+
+    // Columns of the weight matrix share output vertices, so this loop stays serial.
+    // Use the PackedWeights version to skin the vertices in parallel.
     outMesh.clear();
     outMesh.resize( inMesh.size(), Vector3::Zero() );
-#pragma omp parallel for
     for( int k = 0; k < weight.outerSize(); ++k ) {
+        const Transform& t = pose[k];
         for( WeightMatrix::InnerIterator it( weight, k ); it; ++it ) {
             const uint   i = it.row();
-            const uint   j = it.col();
             const Scalar w = it.value();
-            outMesh[i] += w * ( pose[j] * inMesh[i] );
+            outMesh[i] += w * ( t * inMesh[i] );
         }
     }
 }
 
+void linearBlendSkinning( const Vector3Array&  inMesh,
+                             const Pose&          pose,
+                             const PackedWeights& weight,
+                             Vector3Array&        outMesh ) {
+    CORE_ASSERT( inMesh.size() == weight.m_numVertices, "Weights are incompatible with mesh" );
+    CORE_ASSERT( weight.m_width > 0, "Weights are not packed" );
+
+    AlignedStdVector<AffineMatrix> matrices;
+    extractAffine( pose, matrices );
+
+    outMesh.resize( inMesh.size() );
+    parallelFor( 0, inMesh.size(), SKINNING_GRAIN_SIZE, [&]( uint begin, uint end ) {
+        skinPackedBlock( inMesh, matrices.data(), weight, begin, end, outMesh );
+    } );
+}
+
+void linearBlendSkinning( const Vector3Array&    inMesh,
+                          const Pose&            pose,
+                          const PackedWeights&   weight,
+                          const VertexRangeList& ranges,
+                          Vector3Array&          outMesh ) {
+    CORE_ASSERT( inMesh.size() == weight.m_numVertices, "Weights are incompatible with mesh" );
+    CORE_ASSERT( outMesh.size() == inMesh.size(), "Output must hold the previous skinning result" );
+    CORE_ASSERT( weight.m_width > 0, "Weights are not packed" );
+
+    AlignedStdVector<AffineMatrix> matrices;
+    extractAffine( pose, matrices );
+
+    parallelForRanges( ranges, SKINNING_GRAIN_SIZE, [&]( uint begin, uint end ) {
+        skinPackedBlock( inMesh, matrices.data(), weight, begin, end, outMesh );
+    } );
+}
+
 } // namespace Animation
 } // namespace Core
 } // namespace Ra
-
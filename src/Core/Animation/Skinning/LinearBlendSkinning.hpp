@@ -5,19 +5,39 @@
 #include <Core/Math/LinearAlgebra.hpp>
 #include <Core/Animation/Pose/Pose.hpp>
 #include <Core/Animation/Handle/HandleWeight.hpp>
+#include <Core/Animation/Skinning/PackedWeights.hpp>
+#include <Core/Animation/Skinning/IncrementalSkinning.hpp>
 
 namespace Ra {
 namespace Core {
 namespace Animation {
 
+/// Skins the vertices of inMesh with the sparse weight matrix.
+/// This version runs on the calling thread.
 void RA_CORE_API linearBlendSkinning( const Vector3Array&  inMesh,
                              const Pose&          pose,
                              const WeightMatrix&  weight,
                              Vector3Array&        outMesh );
 
+/// Skins the vertices of inMesh with weights packed by packWeights().
+/// The transforms of the influences are blended before being applied once to the vertex.
+/// Vertices are skinned in parallel over blocks of vertices, see parallelFor().
+/// This is the fast path, to be preferred when the weights do not change between frames.
+void RA_CORE_API linearBlendSkinning( const Vector3Array&  inMesh,
+                             const Pose&          pose,
+                             const PackedWeights& weight,
+                             Vector3Array&        outMesh );
+
+/// Same as above, but only the vertices in ranges are skinned. The other
+/// vertices of outMesh, which must have the size of inMesh, are left untouched.
+void RA_CORE_API linearBlendSkinning( const Vector3Array&    inMesh,
+                                      const Pose&            pose,
+                                      const PackedWeights&   weight,
+                                      const VertexRangeList& ranges,
+                                      Vector3Array&          outMesh );
+
 } // namespace Animation
 } // namespace Core
 } // namespace Ra
 
 #endif // RADIUMENGINE_LINEAR_BLENDING_SKINNING_HPP
-
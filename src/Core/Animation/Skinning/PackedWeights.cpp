@@ -0,0 +1,96 @@
+#include <Core/Animation/Skinning/PackedWeights.hpp>
+
+#include <algorithm>
+#include <utility>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+void packWeights( const WeightMatrix& weights, uint maxInfluences, PackedWeights& packedOut )
+{
+    CORE_ASSERT( maxInfluences > 0, "At least one influence per vertex is needed" );
+
+    const uint numVertices = weights.rows();
+
+    // Count the influences of each vertex.
+    std::vector<uint> counts( numVertices, 0 );
+    for ( int k = 0; k < weights.outerSize(); ++k )
+    {
+        for ( WeightMatrix::InnerIterator it( weights, k ); it; ++it )
+        {
+            ++counts[it.row()];
+        }
+    }
+    uint width = 1;
+    for ( uint i = 0; i < numVertices; ++i )
+    {
+        width = std::max( width, counts[i] );
+    }
+    width = std::min( width, maxInfluences );
+
+    packedOut.m_width = width;
+    packedOut.m_numVertices = numVertices;
+    packedOut.m_indices.assign( numVertices * width, 0 );
+    packedOut.m_weights.assign( numVertices * width, 0 );
+
+    // Vertices with too many influences are gathered aside and truncated afterwards.
+    typedef std::pair<Scalar, uint> Influence;
+    std::vector<uint> overflowIndex( numVertices, uint( -1 ) );
+    std::vector<std::vector<Influence>> overflow;
+    for ( uint i = 0; i < numVertices; ++i )
+    {
+        if ( counts[i] > width )
+        {
+            overflowIndex[i] = overflow.size();
+            overflow.emplace_back();
+            overflow.back().reserve( counts[i] );
+        }
+        counts[i] = 0;
+    }
+
+    for ( int k = 0; k < weights.outerSize(); ++k )
+    {
+        for ( WeightMatrix::InnerIterator it( weights, k ); it; ++it )
+        {
+            const uint i = it.row();
+            if ( overflowIndex[i] == uint( -1 ) )
+            {
+                const uint slot = i * width + counts[i]++;
+                packedOut.m_indices[slot] = it.col();
+                packedOut.m_weights[slot] = it.value();
+            }
+            else
+            {
+                overflow[overflowIndex[i]].push_back( Influence( it.value(), it.col() ) );
+            }
+        }
+    }
+
+    for ( uint i = 0; i < numVertices; ++i )
+    {
+        if ( overflowIndex[i] == uint( -1 ) )
+        {
+            continue;
+        }
+        // Keep the largest weights and renormalize them.
+        std::vector<Influence>& influences = overflow[overflowIndex[i]];
+        std::partial_sort( influences.begin(), influences.begin() + width, influences.end(),
+                           []( const Influence& a, const Influence& b ) { return a.first > b.first; } );
+        Scalar sum = 0;
+        for ( uint k = 0; k < width; ++k )
+        {
+            sum += influences[k].first;
+        }
+        const Scalar scale = sum > 0 ? Scalar( 1 ) / sum : Scalar( 1 );
+        for ( uint k = 0; k < width; ++k )
+        {
+            packedOut.m_indices[i * width + k] = influences[k].second;
+            packedOut.m_weights[i * width + k] = influences[k].first * scale;
+        }
+    }
+}
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
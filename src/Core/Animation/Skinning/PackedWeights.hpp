@@ -0,0 +1,48 @@
+#ifndef RADIUMENGINE_PACKED_WEIGHTS_HPP_
+#define RADIUMENGINE_PACKED_WEIGHTS_HPP_
+
+#include <Core/RaCore.hpp>
+
+#include <vector>
+
+#include <Core/Animation/Handle/HandleWeight.hpp>
+
+namespace Ra {
+namespace Core {
+namespace Animation {
+
+/// Skinning weights stored with a fixed number of influences per vertex.
+/// Influences of vertex i are stored in [i * m_width, (i + 1) * m_width[ in both arrays.
+/// Unused slots are padded with a zero weight pointing to handle 0, so that
+/// skinning kernels can run over a fixed width without any branching.
+struct PackedWeights
+{
+    PackedWeights() : m_width( 0 ), m_numVertices( 0 ) {}
+
+    inline bool empty() const { return m_numVertices == 0; }
+
+    /// Handle index of each influence.
+    std::vector<uint> m_indices;
+
+    /// Weight of each influence.
+    std::vector<Scalar> m_weights;
+
+    /// Number of influences per vertex.
+    uint m_width;
+
+    /// Number of vertices.
+    uint m_numVertices;
+};
+
+/// Packs the sparse weight matrix (one row per vertex, one column per handle)
+/// into a fixed width layout. If a vertex has more than maxInfluences non-zero
+/// weights, only the largest ones are kept and they are renormalized to sum to 1.
+/// The width of the result is the smallest of maxInfluences and the maximum number
+/// of influences of any vertex.
+void RA_CORE_API packWeights( const WeightMatrix& weights, uint maxInfluences, PackedWeights& packedOut );
+
+} // namespace Animation
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_PACKED_WEIGHTS_HPP_
@@ -51,9 +51,9 @@ namespace Ra
                 // Store the weights as row major here because we are going to query the per-vertex weights.
                 Eigen::SparseMatrix<Scalar, Eigen::RowMajor> subdividedWeights = dataInOut.m_weights;
 
-                // Convert the mesh to DCEL for easy processing.
-                Dcel dcel;
-                convert(subdividedMesh, dcel);
+                // Convert the mesh to a half-edge mesh for easy processing.
+                HalfEdgeMesh hem;
+                convert(subdividedMesh, hem);
 
                 // The mesh will be subdivided by repeated edge-split, so that adjacent vertices
                 // weights are distant of at most `weightEpsilon`.
@@ -64,21 +64,22 @@ namespace Ra
                     maxWeightDistance = 0;
 
                     // Stores the edges to split
-                    std::vector<Index> edgesToSplit;
+                    std::vector<EdgeIdx> edgesToSplit;
 
-                    // Compute all weights distances for all edges.
-                    for (const auto& edge : dcel.m_fulledge)
+                    // Compute all weights distances for all edges, including the border ones.
+                    for (EdgeIdx edge = 0; edge < hem.getEdgeCapacity(); ++edge)
                     {
-                        Vertex_ptr v1 = edge->V(0);
-                        Vertex_ptr v2 = edge->V(1);
+                        const HalfEdgeIdx he = hem.getEdgeHalfEdge(edge, 0);
+                        const VertexIdx v1 = hem.getVertex(he);
+                        const VertexIdx v2 = hem.getEndVertex(he);
 
-                        Scalar weightDistance = (subdividedWeights.row(v1->idx)
-                                                 - subdividedWeights.row(v2->idx)).norm();
+                        Scalar weightDistance = (subdividedWeights.row(v1)
+                                                 - subdividedWeights.row(v2)).norm();
 
                         maxWeightDistance = std::max(maxWeightDistance, weightDistance);
                         if (weightDistance > weightEpsilon)
                         {
-                            edgesToSplit.push_back(edge->idx);
+                            edgesToSplit.push_back(edge);
                         }
                     }
 
@@ -97,18 +98,17 @@ namespace Ra
                         newWeights.topRows(startIndex) = subdividedWeights;
                         subdividedWeights = newWeights;
 
-                        int i = 0;
-
-                        // Split ALL the edges !
+                        // Split ALL the edges ! No vertex is deleted, so the new ones are appended.
                         for (const auto& edge : edgesToSplit)
                         {
-                            int V1Idx = dcel.m_fulledge[edge]->V(0)->idx;
-                            int V2Idx = dcel.m_fulledge[edge]->V(1)->idx;
+                            const HalfEdgeIdx he = hem.getEdgeHalfEdge(edge, 0);
+                            const VertexIdx V1Idx = hem.getVertex(he);
+                            const VertexIdx V2Idx = hem.getEndVertex(he);
 
-                            DcelOperations::splitEdge(dcel, edge, 0.5f);
-                            subdividedWeights.row(startIndex + i) =
+                            const VertexIdx VMIdx = DcelOperations::splitEdge(hem, edge, 0.5f);
+                            CORE_ASSERT(VMIdx < uint(subdividedWeights.rows()), "Vertex index out of the weights");
+                            subdividedWeights.row(VMIdx) =
                                     0.5f * (subdividedWeights.row(V1Idx) + subdividedWeights.row(V2Idx));
-                            ++i;
                         }
 
                     }
@@ -117,7 +117,7 @@ namespace Ra
                 } while (maxWeightDistance > weightEpsilon);
 
                 // get the subdivided mesh back into mesh form.
-                convert(dcel, subdividedMesh);
+                convert(hem, subdividedMesh);
 
                 // Second step : evaluate the integrals over all triangles for all vertices.
                 CORE_ASSERT(subdividedMesh.m_vertices.size() == subdividedWeights.rows(),
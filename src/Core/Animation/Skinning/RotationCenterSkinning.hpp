@@ -9,9 +9,8 @@
 #include <Core/Log/Log.hpp>
 #include <Core/Mesh/MeshUtils.hpp>
 #include <Core/Mesh/Wrapper/Convert.hpp>
-#include <Core/Mesh/DCEL/Dcel.hpp>
+#include <Core/Mesh/DCEL/HalfEdgeMesh.hpp>
 #include <Core/Mesh/DCEL/Operations/EdgeSplit.hpp>
-#include <Core/Mesh/DCEL/FullEdge.hpp>
 
 #include <Core/Animation/Handle/HandleWeight.hpp>
 #include <Core/Animation/Pose/Pose.hpp>
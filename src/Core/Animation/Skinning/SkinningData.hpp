@@ -6,6 +6,8 @@
 #include <Core/Animation/Pose/Pose.hpp>
 #include <Core/Animation/Handle/Skeleton.hpp>
 #include <Core/Animation/Handle/HandleWeight.hpp>
+#include <Core/Animation/Skinning/PackedWeights.hpp>
+#include <Core/Animation/Skinning/IncrementalSkinning.hpp>
 
 namespace Ra
 {
@@ -26,11 +28,21 @@ namespace Skinning
         /// Reference pose
         Ra::Core::Animation::Pose m_refPose;
 
+        /// Inverse of the reference pose, computed once for the relative poses.
+        Ra::Core::Animation::Pose m_inverseRefPose;
+
         /// Skinning weights.
         Ra::Core::Animation::WeightMatrix m_weights;
 
+        /// Optionnal fixed width copy of the weights for LBS skinning
+        Ra::Core::Animation::PackedWeights m_packedWeights;
+
         /// Optionnal centers of rotations for CoR skinning
         Ra::Core::Vector3Array m_CoR;
+
+        /// Optionnal triangles around each vertex, to only update the normals of the
+        /// vertices moved by incremental LBS skinning.
+        Ra::Core::Geometry::TVAdj m_triangleAdjacency;
     };
 
     /// Pose data of one frame
@@ -57,6 +69,10 @@ namespace Skinning
         /// Current vertex normals
         Ra::Core::Vector3Array m_currentNormal;
 
+        /// Vertices written by the last skinning, when skinning incrementally.
+        /// In this mode m_previousPos and m_currentPos only differ on these ranges.
+        Ra::Core::Animation::VertexRangeList m_dirtyRanges;
+
         /// Indicator whether skinning must be processed.
         /// It is set to true if the current pose is different from previous.
         bool m_doSkinning;
@@ -66,14 +66,22 @@ TVAdj triangleUniformAdjacency( const VectorArray< Vector3 >& p, const VectorArr
     const uint p_size = p.size();
     const uint t_size = T.size();
     TVAdj A( t_size, p_size );
+    // Built from triplets, since inserting with coeffRef() is quadratic on large meshes.
+    std::vector< Eigen::Triplet< Scalar > > triplets;
+    triplets.reserve( 3 * t_size );
     for( uint t = 0; t < t_size; ++t ) {
         const uint i = T[t]( 0 );
         const uint j = T[t]( 1 );
         const uint k = T[t]( 2 );
-        A.coeffRef( t, i ) = 1;
-        A.coeffRef( t, j ) = 1;
-        A.coeffRef( t, k ) = 1;
+        triplets.push_back( Eigen::Triplet< Scalar >( t, i, 1 ) );
+        if( j != i ) {
+            triplets.push_back( Eigen::Triplet< Scalar >( t, j, 1 ) );
+        }
+        if( k != i && k != j ) {
+            triplets.push_back( Eigen::Triplet< Scalar >( t, k, 1 ) );
+        }
     }
+    A.setFromTriplets( triplets.begin(), triplets.end() );
     return A;
 }
 
@@ -2,10 +2,12 @@
 #define RADIUMENGINE_LOG_HPP
 
 #include <Core/RaCore.hpp>
-#include <sstream>
+#include <ostream>
 #include <string>
 #include <stdio.h>
 
+#include <Core/Log/LogQueue.hpp>
+
 #include <Core/String/StringUtils.hpp>
 
 inline std::string NowTime();
@@ -18,13 +20,15 @@ class Log
 public:
     Log();
     virtual ~Log();
-    std::ostringstream& Get( TLogLevel level = logINFO );
+    std::ostream& Get( TLogLevel level = logINFO );
 public:
     static TLogLevel& ReportingLevel();
-    static std::string ToString( TLogLevel level );
+    static const char* ToString( TLogLevel level );
     static TLogLevel FromString( const std::string& level );
 protected:
-    std::ostringstream os;
+    /// Preallocated buffer the message is formatted in.
+    Ra::Core::LogLine* m_line;
+    TLogLevel m_level;
 private:
     Log( const Log& );
     Log& operator = ( const Log& );
@@ -32,23 +36,31 @@ private:
 
 template <typename T>
 Log<T>::Log()
+    : m_line( Ra::Core::LogLine::acquire() )
+    , m_level( logINFO )
 {
 }
 
 template <typename T>
-std::ostringstream& Log<T>::Get( TLogLevel level )
+std::ostream& Log<T>::Get( TLogLevel level )
 {
-    os << "- " << NowTime();
-    os << " " << ToString( level ) << ": ";
-    os << std::string( level > logDEBUG ? level - logDEBUG : 0, '\t' );
+    // The time is added by the writer thread of the log queue.
+    m_level = level;
+    std::ostream& os = m_line->stream();
+    os << ToString( level ) << ": ";
+    for ( int i = logDEBUG; i < level; ++i )
+    {
+        os << '\t';
+    }
     return os;
 }
 
 template <typename T>
 Log<T>::~Log()
 {
-    os << std::endl;
-    T::Output( os.str() );
+    m_line->finish();
+    T::Output( m_level, m_line->data(), m_line->size() );
+    Ra::Core::LogLine::release( m_line );
 }
 
 template <typename T>
@@ -58,8 +70,9 @@ TLogLevel& Log<T>::ReportingLevel()
     return reportingLevel;
 }
 
+/// Returns a static string, so that formatting a message does not allocate.
 template <typename T>
-std::string Log<T>::ToString( TLogLevel level )
+const char* Log<T>::ToString( TLogLevel level )
 {
     static const char* const buffer[] = { "ERROR", "WARNING", "INFO", "DEBUG", "DEBUG1", "DEBUG2", "DEBUG3", "DEBUG4" };
     return buffer[level];
@@ -108,7 +121,7 @@ class Output2FILE
 {
 public:
     static FILE*& Stream();
-    static void Output( const std::string& msg );
+    static void Output( TLogLevel level, const char* msg, uint length );
 };
 
 inline FILE*& Output2FILE::Stream()
@@ -117,15 +130,21 @@ inline FILE*& Output2FILE::Stream()
     return pStream;
 }
 
-inline void Output2FILE::Output( const std::string& msg )
+inline void Output2FILE::Output( TLogLevel level, const char* msg, uint length )
 {
     FILE* pStream = Stream();
     if ( !pStream )
     {
         return;
     }
-    fprintf( pStream, "%s", msg.c_str() );
-    fflush( pStream );
+    // Messages are written asynchronously, except errors which are
+    // waited for in case the application is about to crash.
+    Ra::Core::LogQueue& queue = Ra::Core::LogQueue::getInstance();
+    queue.push( pStream, msg, length );
+    if ( level == logERROR )
+    {
+        queue.flush();
+    }
 }
 
 class FILELog : public Log<Output2FILE> {};
@@ -0,0 +1,365 @@
+#include <Core/Log/LogQueue.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            /// Number of lines each thread keeps to format its messages
+            /// (more than one in case a message is logged while formatting another).
+            const uint NUM_THREAD_LINES = 4;
+
+            /// Size above which the writer sends its batch to the output.
+            const size_t MAX_BATCH_SIZE = 1 << 16;
+
+            /// Maximum time the writer thread sleeps when the queue is empty.
+            const std::chrono::milliseconds WRITER_SLEEP_TIME( 10 );
+
+            long long getSteadyTime()
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch() ).count();
+            }
+
+            uint roundUpToPowerOfTwo( uint n )
+            {
+                uint p = 2;
+                while ( p < n )
+                {
+                    p *= 2;
+                }
+                return p;
+            }
+        }
+
+        struct LogQueue::Slot
+        {
+            /// Slot is free for the producer reserving position m_sequence,
+            /// and holds a message for the writer when m_sequence is position + 1.
+            std::atomic<uint> m_sequence;
+            FILE* m_output;
+            long long m_time;
+            uint m_length;
+            char m_text[SLOT_SIZE];
+            /// Text of a message longer than m_text, or nullptr.
+            std::unique_ptr<char[]> m_longText;
+        };
+
+        LogQueue::LogQueue( uint numSlots )
+            : m_slots( new Slot[roundUpToPowerOfTwo( numSlots )] )
+            , m_mask( roundUpToPowerOfTwo( numSlots ) - 1 )
+            , m_enqueuePos( 0 )
+            , m_dequeuePos( 0 )
+            , m_numWritten( 0 )
+            , m_numDropped( 0 )
+            , m_numDroppedReported( 0 )
+            , m_startTime( getSteadyTime() )
+            , m_startWallTime( std::chrono::duration_cast<std::chrono::microseconds>(
+                                   std::chrono::system_clock::now().time_since_epoch() ).count() )
+            , m_lastSecond( -1 )
+            , m_writerSleeping( false )
+            , m_stop( false )
+        {
+            for ( uint i = 0; i <= m_mask; ++i )
+            {
+                m_slots[i].m_sequence.store( i, std::memory_order_relaxed );
+            }
+            m_timeString[0] = '\0';
+
+            m_writer = std::thread( &LogQueue::runWriter, this );
+        }
+
+        LogQueue::~LogQueue()
+        {
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                m_stop = true;
+            }
+            m_wakeUp.notify_one();
+            m_writer.join();
+        }
+
+        bool LogQueue::push( FILE* output, const char* text, uint length )
+        {
+            // Reserve a slot (bounded MPMC queue of D. Vyukov, with a single consumer).
+            uint pos = m_enqueuePos.load( std::memory_order_relaxed );
+            Slot* slot;
+            for ( ;; )
+            {
+                slot = &m_slots[pos & m_mask];
+                const uint seq = slot->m_sequence.load( std::memory_order_acquire );
+                const int diff = int( seq - pos );
+                if ( diff == 0 )
+                {
+                    if ( m_enqueuePos.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                    {
+                        break;
+                    }
+                }
+                else if ( diff < 0 )
+                {
+                    // The writer did not free this slot yet : the queue is full.
+                    m_numDropped.fetch_add( 1, std::memory_order_relaxed );
+                    return false;
+                }
+                else
+                {
+                    pos = m_enqueuePos.load( std::memory_order_relaxed );
+                }
+            }
+
+            slot->m_output = output;
+            slot->m_time = getSteadyTime();
+            slot->m_length = length;
+            if ( length <= SLOT_SIZE )
+            {
+                std::memcpy( slot->m_text, text, length );
+            }
+            else
+            {
+                slot->m_longText.reset( new char[length] );
+                std::memcpy( slot->m_longText.get(), text, length );
+            }
+            slot->m_sequence.store( pos + 1, std::memory_order_release );
+
+            // Wake the writer up if it is waiting for messages.
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            if ( m_writerSleeping.load( std::memory_order_relaxed ) )
+            {
+                m_wakeUp.notify_one();
+            }
+            return true;
+        }
+
+        void LogQueue::flush()
+        {
+            const uint target = m_enqueuePos.load( std::memory_order_acquire );
+
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_wakeUp.notify_one();
+            m_flushed.wait( lock, [this, target]()
+            {
+                return int( m_numWritten.load( std::memory_order_acquire ) - target ) >= 0;
+            } );
+        }
+
+        uint LogQueue::getNumDropped() const
+        {
+            return m_numDropped.load( std::memory_order_relaxed );
+        }
+
+        LogQueue& LogQueue::getInstance()
+        {
+            static LogQueue queue;
+            return queue;
+        }
+
+        void LogQueue::runWriter()
+        {
+            for ( ;; )
+            {
+                writeMessages();
+
+                std::unique_lock<std::mutex> lock( m_mutex );
+                m_flushed.notify_all();
+
+                if ( m_stop )
+                {
+                    // Write the messages pushed in the meantime before leaving.
+                    lock.unlock();
+                    writeMessages();
+                    m_flushed.notify_all();
+                    break;
+                }
+
+                m_writerSleeping.store( true, std::memory_order_seq_cst );
+                const Slot& next = m_slots[m_dequeuePos & m_mask];
+                if ( next.m_sequence.load( std::memory_order_seq_cst ) != m_dequeuePos + 1 )
+                {
+                    // A late wake up is caught by the timeout.
+                    m_wakeUp.wait_for( lock, WRITER_SLEEP_TIME );
+                }
+                m_writerSleeping.store( false, std::memory_order_relaxed );
+            }
+        }
+
+        uint LogQueue::writeMessages()
+        {
+            // Messages are gathered so that each batch is a single write.
+            FILE* output = nullptr;
+            auto writeBatch = [this, &output]()
+            {
+                if ( !m_batch.empty() )
+                {
+                    std::fwrite( m_batch.data(), 1, m_batch.size(), output );
+                    std::fflush( output );
+                    m_batch.clear();
+                }
+            };
+
+            uint numMessages = 0;
+            for ( ;; )
+            {
+                Slot& slot = m_slots[m_dequeuePos & m_mask];
+                if ( slot.m_sequence.load( std::memory_order_acquire ) != m_dequeuePos + 1 )
+                {
+                    break;
+                }
+
+                if ( slot.m_output != output || m_batch.size() > MAX_BATCH_SIZE )
+                {
+                    writeBatch();
+                    output = slot.m_output;
+                }
+
+                formatTime( slot.m_time );
+                m_batch.append( m_timeString );
+                if ( slot.m_longText )
+                {
+                    m_batch.append( slot.m_longText.get(), slot.m_length );
+                    slot.m_longText.reset();
+                }
+                else
+                {
+                    m_batch.append( slot.m_text, slot.m_length );
+                }
+
+                // Give the slot back to the producers.
+                slot.m_sequence.store( m_dequeuePos + m_mask + 1, std::memory_order_release );
+                ++m_dequeuePos;
+                ++numMessages;
+            }
+
+            const uint numDropped = m_numDropped.load( std::memory_order_relaxed );
+            if ( numDropped != m_numDroppedReported )
+            {
+                if ( output == nullptr )
+                {
+                    output = stderr;
+                }
+                char buffer[64];
+                std::snprintf( buffer, sizeof( buffer ), "WARNING: %u log messages dropped.\n",
+                               numDropped - m_numDroppedReported );
+                m_batch.append( m_timeString );
+                m_batch.append( buffer );
+                m_numDroppedReported = numDropped;
+            }
+
+            writeBatch();
+
+            m_numWritten.fetch_add( numMessages, std::memory_order_release );
+            return numMessages;
+        }
+
+        void LogQueue::formatTime( long long time )
+        {
+            const long long wallTime = m_startWallTime + ( time - m_startTime );
+            const long long second = wallTime / 1000000;
+            if ( second == m_lastSecond )
+            {
+                return;
+            }
+            m_lastSecond = second;
+
+            // Only the writer thread calls localtime().
+            const std::time_t t = std::time_t( second );
+            char buffer[20];
+            if ( std::strftime( buffer, sizeof( buffer ), "%X", std::localtime( &t ) ) == 0 )
+            {
+                buffer[0] = '\0';
+            }
+            std::snprintf( m_timeString, sizeof( m_timeString ), "- %s ", buffer );
+        }
+
+        LogLine::LogLine()
+            : m_stream( this )
+            , m_defaultFlags( m_stream.flags() )
+            , m_busy( false )
+            , m_owned( false )
+        {
+            reset();
+        }
+
+        LogLine::~LogLine()
+        {
+        }
+
+        void LogLine::reset()
+        {
+            // Keep one character for the line return.
+            setp( m_buffer, m_buffer + LogQueue::SLOT_SIZE - 1 );
+            if ( !m_longLine.empty() )
+            {
+                std::string().swap( m_longLine );
+            }
+
+            // Undo the manipulators of the previous message.
+            m_stream.clear();
+            m_stream.flags( m_defaultFlags );
+            m_stream.precision( 6 );
+            m_stream.width( 0 );
+            m_stream.fill( ' ' );
+        }
+
+        LogLine::int_type LogLine::overflow( int_type c )
+        {
+            // The buffer is full : move its content to the heap and reuse it for the rest
+            // of the message.
+            m_longLine.append( pbase(), pptr() - pbase() );
+            if ( !traits_type::eq_int_type( c, traits_type::eof() ) )
+            {
+                m_longLine.push_back( traits_type::to_char_type( c ) );
+            }
+            setp( m_buffer, m_buffer + LogQueue::SLOT_SIZE - 1 );
+            return traits_type::not_eof( c );
+        }
+
+        void LogLine::finish()
+        {
+            // There is always room for the line return.
+            *pptr() = '\n';
+            pbump( 1 );
+            if ( !m_longLine.empty() )
+            {
+                m_longLine.append( pbase(), pptr() - pbase() );
+            }
+        }
+
+        LogLine* LogLine::acquire()
+        {
+            static thread_local LogLine lines[NUM_THREAD_LINES];
+            for ( auto& line : lines )
+            {
+                if ( !line.m_busy )
+                {
+                    line.m_busy = true;
+                    return &line;
+                }
+            }
+
+            LogLine* line = new LogLine;
+            line->m_busy = true;
+            line->m_owned = true;
+            return line;
+        }
+
+        void LogLine::release( LogLine* line )
+        {
+            if ( line->m_owned )
+            {
+                delete line;
+            }
+            else
+            {
+                line->reset();
+                line->m_busy = false;
+            }
+        }
+    }
+}
@@ -0,0 +1,152 @@
+#ifndef RADIUMENGINE_LOG_QUEUE_HPP
+#define RADIUMENGINE_LOG_QUEUE_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Asynchronous backend of the LOG() macro.
+        /// Messages are copied in a fixed number of preallocated slots of a lock-free
+        /// ring buffer, with a monotonic timestamp. A background thread writes them,
+        /// adding the wall clock time, and flushes the outputs once per batch of messages.
+        /// Memory is bounded : when the ring buffer is full, new messages are dropped and
+        /// the number of dropped messages is reported in the log.
+        /// Messages longer than a slot, e.g. shader compilation errors, are copied on the heap.
+        class RA_CORE_API LogQueue
+        {
+        public:
+            /// Maximum length of a message copied in a slot, including the line return.
+            static const uint SLOT_SIZE = 512;
+
+            /// Creates a queue of numSlots messages (rounded up to a power of two)
+            /// and starts the writer thread.
+            explicit LogQueue( uint numSlots = 4096 );
+
+            /// Writes the remaining messages and stops the writer thread.
+            ~LogQueue();
+
+            /// Queue a message to be written to output. Never blocks.
+            /// Returns false if the message was dropped because the queue is full.
+            bool push( FILE* output, const char* text, uint length );
+
+            /// Blocks until all the messages pushed before the call are written and flushed.
+            void flush();
+
+            /// Number of messages dropped since the creation of the queue.
+            uint getNumDropped() const;
+
+            /// The queue used by the LOG() macro.
+            static LogQueue& getInstance();
+
+        private:
+            struct Slot;
+
+            LogQueue( const LogQueue& ) = delete;
+            LogQueue& operator=( const LogQueue& ) = delete;
+
+            /// Writer thread loop.
+            void runWriter();
+
+            /// Write all the available messages. Returns the number of messages written.
+            uint writeMessages();
+
+            /// Writes "- hh:mm:ss " for the given steady clock time in m_timeString.
+            void formatTime( long long time );
+
+        private:
+            std::unique_ptr<Slot[]> m_slots;
+            const uint m_mask;
+
+            /// Next slot to be reserved by a producer.
+            std::atomic<uint> m_enqueuePos;
+            /// Next slot to be read by the writer (only used by the writer thread).
+            uint m_dequeuePos;
+            /// Number of messages written, for flush().
+            std::atomic<uint> m_numWritten;
+
+            std::atomic<uint> m_numDropped;
+            uint m_numDroppedReported;
+
+            /// Wall clock time, in seconds, at the steady clock time m_startTime.
+            long long m_startTime;
+            long long m_startWallTime;
+            long long m_lastSecond;
+            char m_timeString[32];
+
+            /// Messages formatted by the writer, waiting to be written.
+            std::string m_batch;
+
+            std::thread m_writer;
+            std::mutex m_mutex;
+            std::condition_variable m_wakeUp;
+            std::condition_variable m_flushed;
+            std::atomic<bool> m_writerSleeping;
+            bool m_stop;
+        };
+
+        /// A preallocated buffer a log message is formatted in. The LOG() macro takes one
+        /// of the buffers owned by the calling thread, so that formatting a message does
+        /// not allocate memory nor take any lock, unless it is longer than the buffer.
+        class RA_CORE_API LogLine : public std::streambuf
+        {
+        public:
+            LogLine();
+            ~LogLine();
+
+            inline std::ostream& stream()
+            {
+                return m_stream;
+            }
+
+            /// Message, valid after finish().
+            inline const char* data() const
+            {
+                return m_longLine.empty() ? pbase() : m_longLine.data();
+            }
+
+            inline uint size() const
+            {
+                return m_longLine.empty() ? uint( pptr() - pbase() ) : uint( m_longLine.size() );
+            }
+
+            /// Ends the message with a line return.
+            void finish();
+
+            /// Returns a free line of the calling thread.
+            static LogLine* acquire();
+
+            /// Gives back a line returned by acquire().
+            static void release( LogLine* line );
+
+        protected:
+            int_type overflow( int_type c ) override;
+
+        private:
+            void reset();
+
+        private:
+            char m_buffer[LogQueue::SLOT_SIZE];
+            /// Message moved out of the buffer when it got full.
+            std::string m_longLine;
+            std::ostream m_stream;
+            std::ios_base::fmtflags m_defaultFlags;
+            bool m_busy;
+            /// Lines allocated when all the lines of the thread are in use.
+            bool m_owned;
+        };
+    }
+}
+
+#endif // RADIUMENGINE_LOG_QUEUE_HPP
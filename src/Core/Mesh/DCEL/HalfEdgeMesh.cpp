@@ -0,0 +1,268 @@
+#include <Core/Mesh/DCEL/HalfEdgeMesh.hpp>
+
+namespace Ra {
+namespace Core {
+
+
+
+/// CONSTRUCTOR
+HalfEdgeMesh::HalfEdgeMesh() :
+    m_position(),
+    m_normal(),
+    m_vertexHalfEdge(),
+    m_heVertex(),
+    m_heNext(),
+    m_hePrev(),
+    m_heFace(),
+    m_faceHalfEdge(),
+    m_freeVertices(),
+    m_freeEdges(),
+    m_freeFaces() { }
+
+
+
+/// DESTRUCTOR
+HalfEdgeMesh::~HalfEdgeMesh() { }
+
+
+
+/// CLEAR
+void HalfEdgeMesh::clear() {
+    m_position.clear();
+    m_normal.clear();
+    m_vertexHalfEdge.clear();
+    m_heVertex.clear();
+    m_heNext.clear();
+    m_hePrev.clear();
+    m_heFace.clear();
+    m_faceHalfEdge.clear();
+    m_freeVertices.clear();
+    m_freeEdges.clear();
+    m_freeFaces.clear();
+}
+
+
+
+void HalfEdgeMesh::reserve( uint nVertices, uint nEdges, uint nFaces ) {
+    m_position.reserve( nVertices );
+    m_normal.reserve( nVertices );
+    m_vertexHalfEdge.reserve( nVertices );
+    m_heVertex.reserve( 2 * nEdges );
+    m_heNext.reserve( 2 * nEdges );
+    m_hePrev.reserve( 2 * nEdges );
+    m_heFace.reserve( 2 * nEdges );
+    m_faceHalfEdge.reserve( nFaces );
+}
+
+
+
+/// CIRCULATION
+uint HalfEdgeMesh::valence( VertexIdx v ) const {
+    uint n = 0;
+    for( HalfEdgeIdx he : vertexHalfEdges( v ) ) {
+        CORE_UNUSED( he );
+        ++n;
+    }
+    return n;
+}
+
+
+
+/// CREATION
+VertexIdx HalfEdgeMesh::addVertex( const Vector3& p, const Vector3& n ) {
+    if( !m_freeVertices.empty() ) {
+        const VertexIdx v = m_freeVertices.back();
+        m_freeVertices.pop_back();
+        m_position[v]       = p;
+        m_normal[v]         = n;
+        m_vertexHalfEdge[v] = InvalidIdx;
+        return v;
+    }
+    m_position.push_back( p );
+    m_normal.push_back( n );
+    m_vertexHalfEdge.push_back( InvalidIdx );
+    return ( m_vertexHalfEdge.size() - 1 );
+}
+
+
+
+EdgeIdx HalfEdgeMesh::addEdge( VertexIdx v0, VertexIdx v1 ) {
+    EdgeIdx e;
+    if( !m_freeEdges.empty() ) {
+        e = m_freeEdges.back();
+        m_freeEdges.pop_back();
+    } else {
+        e = m_heVertex.size() / 2;
+        m_heVertex.resize( 2 * e + 2 );
+        m_heNext.resize( 2 * e + 2 );
+        m_hePrev.resize( 2 * e + 2 );
+        m_heFace.resize( 2 * e + 2 );
+    }
+    for( uint i = 0; i < 2; ++i ) {
+        const HalfEdgeIdx he = 2 * e + i;
+        m_heVertex[he] = ( i == 0 ) ? v0 : v1;
+        m_heNext[he]   = InvalidIdx;
+        m_hePrev[he]   = InvalidIdx;
+        m_heFace[he]   = InvalidIdx;
+    }
+    return e;
+}
+
+
+
+FaceIdx HalfEdgeMesh::addFace( HalfEdgeIdx he ) {
+    FaceIdx f;
+    if( !m_freeFaces.empty() ) {
+        f = m_freeFaces.back();
+        m_freeFaces.pop_back();
+        m_faceHalfEdge[f] = he;
+    } else {
+        f = m_faceHalfEdge.size();
+        m_faceHalfEdge.push_back( he );
+    }
+    for( HalfEdgeIdx h : faceHalfEdges( f ) ) {
+        m_heFace[h] = f;
+    }
+    return f;
+}
+
+
+
+/// DELETION
+void HalfEdgeMesh::deleteVertex( VertexIdx v ) {
+    CORE_ASSERT( !isDeletedVertex( v ), "Vertex already deleted" );
+    m_vertexHalfEdge[v] = DeletedIdx;
+    m_freeVertices.push_back( v );
+}
+
+
+
+void HalfEdgeMesh::deleteEdge( EdgeIdx e ) {
+    CORE_ASSERT( !isDeletedEdge( e ), "Edge already deleted" );
+    for( uint i = 0; i < 2; ++i ) {
+        const HalfEdgeIdx he = 2 * e + i;
+        m_heVertex[he] = DeletedIdx;
+        m_heNext[he]   = InvalidIdx;
+        m_hePrev[he]   = InvalidIdx;
+        m_heFace[he]   = InvalidIdx;
+    }
+    m_freeEdges.push_back( e );
+}
+
+
+
+void HalfEdgeMesh::deleteFace( FaceIdx f ) {
+    CORE_ASSERT( !isDeletedFace( f ), "Face already deleted" );
+    m_faceHalfEdge[f] = DeletedIdx;
+    m_freeFaces.push_back( f );
+}
+
+
+
+/// OPERATION
+EdgeIdx HalfEdgeMesh::splitFace( HalfEdgeIdx he0, HalfEdgeIdx he1 ) {
+    CORE_ASSERT( !isBoundary( he0 ) && ( getFace( he0 ) == getFace( he1 ) ), "The halfedges are not in the same face" );
+    CORE_ASSERT( ( getNext( he0 ) != he1 ) && ( getNext( he1 ) != he0 ), "The new edge would duplicate he0 or he1" );
+
+    const HalfEdgeIdx n0 = getNext( he0 );
+    const HalfEdgeIdx n1 = getNext( he1 );
+    const EdgeIdx     e  = addEdge( getEndVertex( he0 ), getEndVertex( he1 ) );
+    const HalfEdgeIdx d0 = 2 * e;
+    const HalfEdgeIdx d1 = 2 * e + 1;
+
+    link( he0, d0 );
+    link( d0, n1 );
+    link( he1, d1 );
+    link( d1, n0 );
+
+    const FaceIdx f = getFace( he0 );
+    m_heFace[d0]    = f;
+    setFaceHalfEdge( f, he0 );
+    addFace( he1 );
+
+    return e;
+}
+
+
+
+void HalfEdgeMesh::adjustVertexHalfEdge( VertexIdx v ) {
+    for( HalfEdgeIdx he : vertexHalfEdges( v ) ) {
+        if( isBoundary( he ) ) {
+            m_vertexHalfEdge[v] = he;
+            return;
+        }
+    }
+}
+
+
+
+bool HalfEdgeMesh::checkConsistency() const {
+    const uint nHalfEdges = m_heVertex.size();
+    auto isValidHalfEdge = [&]( HalfEdgeIdx he ) {
+        return ( ( he < nHalfEdges ) && !isDeletedEdge( getEdge( he ) ) );
+    };
+
+    // Halfedges
+    for( HalfEdgeIdx he = 0; he < nHalfEdges; ++he ) {
+        if( isDeletedEdge( getEdge( he ) ) ) {
+            continue;
+        }
+        const VertexIdx v = getVertex( he );
+        const FaceIdx   f = getFace( he );
+        if( ( v >= getVertexCapacity() ) || isDeletedVertex( v ) ) {
+            return false;
+        }
+        if( !isValidHalfEdge( getNext( he ) ) || !isValidHalfEdge( getPrev( he ) ) ) {
+            return false;
+        }
+        if( ( getPrev( getNext( he ) ) != he ) || ( getNext( getPrev( he ) ) != he ) ) {
+            return false;
+        }
+        if( ( getVertex( getNext( he ) ) != getEndVertex( he ) ) || ( getFace( getNext( he ) ) != f ) ) {
+            return false;
+        }
+        if( ( f != FaceIdx( InvalidIdx ) ) && ( ( f >= getFaceCapacity() ) || isDeletedFace( f ) ) ) {
+            return false;
+        }
+    }
+
+    // Vertices: the circulation must come back to the first halfedge, which is on the border if any is.
+    for( VertexIdx v = 0; v < getVertexCapacity(); ++v ) {
+        const HalfEdgeIdx start = getVertexHalfEdge( v );
+        if( isDeletedVertex( v ) || ( start == HalfEdgeIdx( InvalidIdx ) ) ) {
+            continue;
+        }
+        if( !isValidHalfEdge( start ) || ( getVertex( start ) != v ) ) {
+            return false;
+        }
+        bool boundary = false;
+        uint n = 0;
+        HalfEdgeIdx he = start;
+        do {
+            boundary = boundary || isBoundary( he );
+            he = getNextAroundVertex( he );
+            ++n;
+        } while( ( he != start ) && ( n <= nHalfEdges ) );
+        if( ( he != start ) || ( boundary && !isBoundary( start ) ) ) {
+            return false;
+        }
+    }
+
+    // Faces
+    for( FaceIdx f = 0; f < getFaceCapacity(); ++f ) {
+        if( isDeletedFace( f ) ) {
+            continue;
+        }
+        const HalfEdgeIdx he = getFaceHalfEdge( f );
+        if( !isValidHalfEdge( he ) || ( getFace( he ) != f ) ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,194 @@
+#ifndef RADIUMENGINE_HALFEDGE_MESH_HPP
+#define RADIUMENGINE_HALFEDGE_MESH_HPP
+
+#include <vector>
+
+#include <Core/RaCore.hpp>
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Mesh/MeshTypes.hpp>
+
+namespace Ra {
+namespace Core {
+
+/**
+* Class HalfEdgeMesh
+* Index based version of the DCEL, for the algorithms modifying the topology of large meshes.
+*
+* The elements are 32 bits indices in arrays, one array per attribute ( structure of arrays ):
+* - a vertex has a position, a normal and one of its outgoing halfedges,
+* - a halfedge has the vertex it starts from, the next and previous halfedges of its face and
+*   its face ( InvalidIdx on the border of the mesh ),
+* - the two halfedges of the edge e are 2 * e and 2 * e + 1, so the twin of a halfedge and its
+*   edge are computed, not stored,
+* - a face has one of its halfedges.
+* The halfedges on the border of the mesh are linked in loops like the ones of the faces, and
+* the halfedge of a border vertex is on the border, so the circulation around any vertex works.
+*
+* Deleted elements are kept in free lists and reused by the next insertions, so the indices of
+* the other elements do not change. An algorithm can then store its own data of the elements
+* in arrays of getVertexCapacity(), getEdgeCapacity() or getFaceCapacity() entries.
+*
+* The circulators iterate on the neighborhood of a vertex or a face without allocation:
+*       for( VertexIdx n : mesh.vertexVertices( v ) ) { ... }
+*/
+class RA_CORE_API HalfEdgeMesh {
+public:
+    /// CONSTRUCTOR
+    HalfEdgeMesh();                                 // Build an empty mesh
+    HalfEdgeMesh( const HalfEdgeMesh& ) = default;  // Copy constructor
+    HalfEdgeMesh& operator=( const HalfEdgeMesh& ) = default;
+
+    /// DESTRUCTOR
+    ~HalfEdgeMesh();
+
+    /// CLEAR
+    void clear();                                               // Clear the data, making the mesh empty
+    void reserve( uint nVertices, uint nEdges, uint nFaces );   // Reserve the memory of the elements
+
+    /// SIZE
+    inline uint getNumVertices() const;     // Return the number of vertices, not counting the deleted ones
+    inline uint getNumEdges() const;        // Return the number of edges, not counting the deleted ones
+    inline uint getNumFaces() const;        // Return the number of faces, not counting the deleted ones
+    inline uint getVertexCapacity() const;  // Return the upper bound of the vertex indices
+    inline uint getEdgeCapacity() const;    // Return the upper bound of the edge indices
+    inline uint getFaceCapacity() const;    // Return the upper bound of the face indices
+
+    /// QUERY
+    inline bool isDeletedVertex( VertexIdx v ) const;
+    inline bool isDeletedEdge( EdgeIdx e ) const;
+    inline bool isDeletedFace( FaceIdx f ) const;
+    inline bool isBoundary( HalfEdgeIdx he ) const;     // Return true if the halfedge has no face
+    inline bool isBoundaryEdge( EdgeIdx e ) const;      // Return true if one of the halfedges of the edge has no face
+    inline bool isBoundaryVertex( VertexIdx v ) const;  // Return true if the vertex is on the border of the mesh
+
+    /// HALFEDGE
+    inline HalfEdgeIdx getHalfEdge( HalfEdgeIdx he ) const;         // Return he ( identity, for the circulators )
+    inline VertexIdx   getVertex( HalfEdgeIdx he ) const;           // Return the vertex the halfedge starts from
+    inline VertexIdx   getEndVertex( HalfEdgeIdx he ) const;        // Return the vertex the halfedge points to
+    inline HalfEdgeIdx getNext( HalfEdgeIdx he ) const;             // Return the next halfedge of the face
+    inline HalfEdgeIdx getPrev( HalfEdgeIdx he ) const;             // Return the previous halfedge of the face
+    inline HalfEdgeIdx getTwin( HalfEdgeIdx he ) const;             // Return the opposite halfedge
+    inline HalfEdgeIdx getNextAroundVertex( HalfEdgeIdx he ) const; // Return the next outgoing halfedge of the vertex of he
+    inline FaceIdx     getFace( HalfEdgeIdx he ) const;             // Return the face of the halfedge, or InvalidIdx
+    inline EdgeIdx     getEdge( HalfEdgeIdx he ) const;             // Return the edge of the halfedge
+
+    inline void setVertex( HalfEdgeIdx he, VertexIdx v );
+    inline void setFace( HalfEdgeIdx he, FaceIdx f );
+    inline void link( HalfEdgeIdx he, HalfEdgeIdx next );           // Set next as the next halfedge of he
+
+    /// EDGE
+    inline HalfEdgeIdx getEdgeHalfEdge( EdgeIdx e, uint i ) const;  // Return the i-th halfedge of the edge ( i = 0 or 1 )
+
+    /// VERTEX
+    inline const Vector3& getPosition( VertexIdx v ) const;
+    inline Vector3&       getPosition( VertexIdx v );
+    inline const Vector3& getNormal( VertexIdx v ) const;
+    inline Vector3&       getNormal( VertexIdx v );
+    inline HalfEdgeIdx    getVertexHalfEdge( VertexIdx v ) const;   // Return an outgoing halfedge, InvalidIdx if isolated
+    inline void           setVertexHalfEdge( VertexIdx v, HalfEdgeIdx he );
+
+    /// FACE
+    inline HalfEdgeIdx getFaceHalfEdge( FaceIdx f ) const;
+    inline void        setFaceHalfEdge( FaceIdx f, HalfEdgeIdx he );
+
+    /// CIRCULATOR
+    // Range of the halfedges met by repeatedly applying STEP from a starting halfedge, until the
+    // circulation comes back to it. The values are obtained from the halfedges with GET.
+    template < typename T,
+               T ( HalfEdgeMesh::*GET )( HalfEdgeIdx ) const,
+               HalfEdgeIdx ( HalfEdgeMesh::*STEP )( HalfEdgeIdx ) const >
+    class Circulator {
+    public:
+        class Iterator {
+        public:
+            inline Iterator( const HalfEdgeMesh* mesh, HalfEdgeIdx he );
+            inline T         operator*() const;
+            inline Iterator& operator++();
+            inline bool      operator!=( const Iterator& it ) const;
+            inline HalfEdgeIdx halfEdge() const; // Return the current halfedge
+
+        private:
+            const HalfEdgeMesh* m_mesh;
+            HalfEdgeIdx         m_he;
+            HalfEdgeIdx         m_start;
+        };
+
+        inline Circulator( const HalfEdgeMesh* mesh, HalfEdgeIdx start );
+        inline Iterator begin() const;
+        inline Iterator end() const;
+
+    private:
+        const HalfEdgeMesh* m_mesh;
+        HalfEdgeIdx         m_start;
+    };
+
+    typedef Circulator< HalfEdgeIdx, &HalfEdgeMesh::getHalfEdge, &HalfEdgeMesh::getNextAroundVertex > VHECirculator; // Outgoing halfedges of a vertex
+    typedef Circulator< VertexIdx,   &HalfEdgeMesh::getEndVertex, &HalfEdgeMesh::getNextAroundVertex > VVCirculator;  // Neighbors of a vertex
+    typedef Circulator< FaceIdx,     &HalfEdgeMesh::getFace,      &HalfEdgeMesh::getNextAroundVertex > VFCirculator;  // Faces around a vertex ( InvalidIdx on the border )
+    typedef Circulator< HalfEdgeIdx, &HalfEdgeMesh::getHalfEdge, &HalfEdgeMesh::getNext >             FHECirculator; // Halfedges of a face
+    typedef Circulator< VertexIdx,   &HalfEdgeMesh::getVertex,   &HalfEdgeMesh::getNext >             FVCirculator;  // Vertices of a face
+
+    /// CIRCULATION
+    inline VHECirculator vertexHalfEdges( VertexIdx v ) const;
+    inline VVCirculator  vertexVertices( VertexIdx v ) const;
+    inline VFCirculator  vertexFaces( VertexIdx v ) const;
+    inline FHECirculator faceHalfEdges( FaceIdx f ) const;
+    inline FVCirculator  faceVertices( FaceIdx f ) const;
+    uint valence( VertexIdx v ) const;    // Return the number of edges of the vertex
+
+    /// CREATION
+    // The new elements are not linked to the others: the halfedges of a new edge have no next,
+    // previous halfedge or face, and a new vertex or face has no halfedge.
+    VertexIdx addVertex( const Vector3& p, const Vector3& n );
+    EdgeIdx   addEdge( VertexIdx v0, VertexIdx v1 );    // The first halfedge goes from v0 to v1
+    FaceIdx   addFace( HalfEdgeIdx he );                // he and the halfedges of its loop get the new face
+
+    /// DELETION
+    // The element is put in the free list, the links of the other elements are not changed.
+    void deleteVertex( VertexIdx v );
+    void deleteEdge( EdgeIdx e );
+    void deleteFace( FaceIdx f );
+
+    /// OPERATION
+    // Split the face of he0 and he1 by an edge joining the end vertices of he0 and he1. The face
+    // keeps the halfedges from he0 to the new edge, a new face gets the ones from he1.
+    // Return the new edge, its first halfedge being after he0.
+    EdgeIdx splitFace( HalfEdgeIdx he0, HalfEdgeIdx he1 );
+
+    // Set the halfedge of the vertex to the one on the border, if any.
+    void adjustVertexHalfEdge( VertexIdx v );
+
+    // Return true if the links of the elements are consistent.
+    bool checkConsistency() const;
+
+private:
+    // Marks the deleted elements in m_vertexHalfEdge, m_faceHalfEdge and in the first vertex of an edge.
+    enum : uint { DeletedIdx = uint( -2 ) };
+
+    /// VARIABLE
+    // Vertex data
+    VectorArray< Vector3 >     m_position;       // Position of each vertex
+    VectorArray< Vector3 >     m_normal;         // Normal of each vertex
+    std::vector< HalfEdgeIdx > m_vertexHalfEdge; // Outgoing halfedge of each vertex
+
+    // Halfedge data, two per edge
+    std::vector< VertexIdx >   m_heVertex;       // Vertex the halfedge starts from
+    std::vector< HalfEdgeIdx > m_heNext;         // Next halfedge of the face
+    std::vector< HalfEdgeIdx > m_hePrev;         // Previous halfedge of the face
+    std::vector< FaceIdx >     m_heFace;         // Face of the halfedge
+
+    // Face data
+    std::vector< HalfEdgeIdx > m_faceHalfEdge;   // One halfedge of each face
+
+    // Deleted elements, reused by the next insertions
+    std::vector< VertexIdx > m_freeVertices;
+    std::vector< EdgeIdx >   m_freeEdges;
+    std::vector< FaceIdx >   m_freeFaces;
+};
+
+} // namespace Core
+} // namespace Ra
+
+#include <Core/Mesh/DCEL/HalfEdgeMesh.inl>
+
+#endif // RADIUMENGINE_HALFEDGE_MESH_HPP
@@ -0,0 +1,248 @@
+#include <Core/Mesh/DCEL/HalfEdgeMesh.hpp>
+
+namespace Ra {
+namespace Core {
+
+/// CIRCULATOR
+template < typename T, T ( HalfEdgeMesh::*GET )( HalfEdgeIdx ) const, HalfEdgeIdx ( HalfEdgeMesh::*STEP )( HalfEdgeIdx ) const >
+inline HalfEdgeMesh::Circulator< T, GET, STEP >::Iterator::Iterator( const HalfEdgeMesh* mesh, HalfEdgeIdx he ) :
+    m_mesh( mesh ),
+    m_he( he ),
+    m_start( he ) { }
+
+template < typename T, T ( HalfEdgeMesh::*GET )( HalfEdgeIdx ) const, HalfEdgeIdx ( HalfEdgeMesh::*STEP )( HalfEdgeIdx ) const >
+inline T HalfEdgeMesh::Circulator< T, GET, STEP >::Iterator::operator*() const {
+    return ( m_mesh->*GET )( m_he );
+}
+
+template < typename T, T ( HalfEdgeMesh::*GET )( HalfEdgeIdx ) const, HalfEdgeIdx ( HalfEdgeMesh::*STEP )( HalfEdgeIdx ) const >
+inline typename HalfEdgeMesh::Circulator< T, GET, STEP >::Iterator& HalfEdgeMesh::Circulator< T, GET, STEP >::Iterator::operator++() {
+    m_he = ( m_mesh->*STEP )( m_he );
+    if( m_he == m_start ) {
+        m_he = InvalidIdx;
+    }
+    return *this;
+}
+
+template < typename T, T ( HalfEdgeMesh::*GET )( HalfEdgeIdx ) const, HalfEdgeIdx ( HalfEdgeMesh::*STEP )( HalfEdgeIdx ) const >
+inline bool HalfEdgeMesh::Circulator< T, GET, STEP >::Iterator::operator!=( const Iterator& it ) const {
+    return ( m_he != it.m_he );
+}
+
+template < typename T, T ( HalfEdgeMesh::*GET )( HalfEdgeIdx ) const, HalfEdgeIdx ( HalfEdgeMesh::*STEP )( HalfEdgeIdx ) const >
+inline HalfEdgeIdx HalfEdgeMesh::Circulator< T, GET, STEP >::Iterator::halfEdge() const {
+    return m_he;
+}
+
+template < typename T, T ( HalfEdgeMesh::*GET )( HalfEdgeIdx ) const, HalfEdgeIdx ( HalfEdgeMesh::*STEP )( HalfEdgeIdx ) const >
+inline HalfEdgeMesh::Circulator< T, GET, STEP >::Circulator( const HalfEdgeMesh* mesh, HalfEdgeIdx start ) :
+    m_mesh( mesh ),
+    m_start( start ) { }
+
+template < typename T, T ( HalfEdgeMesh::*GET )( HalfEdgeIdx ) const, HalfEdgeIdx ( HalfEdgeMesh::*STEP )( HalfEdgeIdx ) const >
+inline typename HalfEdgeMesh::Circulator< T, GET, STEP >::Iterator HalfEdgeMesh::Circulator< T, GET, STEP >::begin() const {
+    return Iterator( m_mesh, m_start );
+}
+
+template < typename T, T ( HalfEdgeMesh::*GET )( HalfEdgeIdx ) const, HalfEdgeIdx ( HalfEdgeMesh::*STEP )( HalfEdgeIdx ) const >
+inline typename HalfEdgeMesh::Circulator< T, GET, STEP >::Iterator HalfEdgeMesh::Circulator< T, GET, STEP >::end() const {
+    return Iterator( m_mesh, InvalidIdx );
+}
+
+
+
+/// SIZE
+inline uint HalfEdgeMesh::getNumVertices() const {
+    return ( m_vertexHalfEdge.size() - m_freeVertices.size() );
+}
+
+inline uint HalfEdgeMesh::getNumEdges() const {
+    return ( m_heVertex.size() / 2 - m_freeEdges.size() );
+}
+
+inline uint HalfEdgeMesh::getNumFaces() const {
+    return ( m_faceHalfEdge.size() - m_freeFaces.size() );
+}
+
+inline uint HalfEdgeMesh::getVertexCapacity() const {
+    return m_vertexHalfEdge.size();
+}
+
+inline uint HalfEdgeMesh::getEdgeCapacity() const {
+    return ( m_heVertex.size() / 2 );
+}
+
+inline uint HalfEdgeMesh::getFaceCapacity() const {
+    return m_faceHalfEdge.size();
+}
+
+
+
+/// QUERY
+inline bool HalfEdgeMesh::isDeletedVertex( VertexIdx v ) const {
+    CORE_ASSERT( v < m_vertexHalfEdge.size(), "Index v out of bounds" );
+    return ( m_vertexHalfEdge[v] == HalfEdgeIdx( DeletedIdx ) );
+}
+
+inline bool HalfEdgeMesh::isDeletedEdge( EdgeIdx e ) const {
+    CORE_ASSERT( 2 * e < m_heVertex.size(), "Index e out of bounds" );
+    return ( m_heVertex[2 * e] == VertexIdx( DeletedIdx ) );
+}
+
+inline bool HalfEdgeMesh::isDeletedFace( FaceIdx f ) const {
+    CORE_ASSERT( f < m_faceHalfEdge.size(), "Index f out of bounds" );
+    return ( m_faceHalfEdge[f] == HalfEdgeIdx( DeletedIdx ) );
+}
+
+inline bool HalfEdgeMesh::isBoundary( HalfEdgeIdx he ) const {
+    return ( getFace( he ) == FaceIdx( InvalidIdx ) );
+}
+
+inline bool HalfEdgeMesh::isBoundaryEdge( EdgeIdx e ) const {
+    return ( isBoundary( 2 * e ) || isBoundary( 2 * e + 1 ) );
+}
+
+inline bool HalfEdgeMesh::isBoundaryVertex( VertexIdx v ) const {
+    // The halfedge of a border vertex is on the border.
+    const HalfEdgeIdx he = getVertexHalfEdge( v );
+    return ( he != HalfEdgeIdx( InvalidIdx ) && isBoundary( he ) );
+}
+
+
+
+/// HALFEDGE
+inline HalfEdgeIdx HalfEdgeMesh::getHalfEdge( HalfEdgeIdx he ) const {
+    return he;
+}
+
+inline VertexIdx HalfEdgeMesh::getVertex( HalfEdgeIdx he ) const {
+    CORE_ASSERT( he < m_heVertex.size(), "Index he out of bounds" );
+    return m_heVertex[he];
+}
+
+inline VertexIdx HalfEdgeMesh::getEndVertex( HalfEdgeIdx he ) const {
+    return getVertex( getTwin( he ) );
+}
+
+inline HalfEdgeIdx HalfEdgeMesh::getNext( HalfEdgeIdx he ) const {
+    CORE_ASSERT( he < m_heNext.size(), "Index he out of bounds" );
+    return m_heNext[he];
+}
+
+inline HalfEdgeIdx HalfEdgeMesh::getPrev( HalfEdgeIdx he ) const {
+    CORE_ASSERT( he < m_hePrev.size(), "Index he out of bounds" );
+    return m_hePrev[he];
+}
+
+inline HalfEdgeIdx HalfEdgeMesh::getTwin( HalfEdgeIdx he ) const {
+    return ( he ^ 1 );
+}
+
+inline HalfEdgeIdx HalfEdgeMesh::getNextAroundVertex( HalfEdgeIdx he ) const {
+    return getTwin( getPrev( he ) );
+}
+
+inline FaceIdx HalfEdgeMesh::getFace( HalfEdgeIdx he ) const {
+    CORE_ASSERT( he < m_heFace.size(), "Index he out of bounds" );
+    return m_heFace[he];
+}
+
+inline EdgeIdx HalfEdgeMesh::getEdge( HalfEdgeIdx he ) const {
+    return ( he >> 1 );
+}
+
+inline void HalfEdgeMesh::setVertex( HalfEdgeIdx he, VertexIdx v ) {
+    CORE_ASSERT( he < m_heVertex.size(), "Index he out of bounds" );
+    m_heVertex[he] = v;
+}
+
+inline void HalfEdgeMesh::setFace( HalfEdgeIdx he, FaceIdx f ) {
+    CORE_ASSERT( he < m_heFace.size(), "Index he out of bounds" );
+    m_heFace[he] = f;
+}
+
+inline void HalfEdgeMesh::link( HalfEdgeIdx he, HalfEdgeIdx next ) {
+    CORE_ASSERT( ( he < m_heNext.size() ) && ( next < m_hePrev.size() ), "Index out of bounds" );
+    m_heNext[he]   = next;
+    m_hePrev[next] = he;
+}
+
+
+
+/// EDGE
+inline HalfEdgeIdx HalfEdgeMesh::getEdgeHalfEdge( EdgeIdx e, uint i ) const {
+    CORE_ASSERT( i < 2, "Index i out of bounds" );
+    return ( 2 * e + i );
+}
+
+
+
+/// VERTEX
+inline const Vector3& HalfEdgeMesh::getPosition( VertexIdx v ) const {
+    CORE_ASSERT( v < m_position.size(), "Index v out of bounds" );
+    return m_position[v];
+}
+
+inline Vector3& HalfEdgeMesh::getPosition( VertexIdx v ) {
+    CORE_ASSERT( v < m_position.size(), "Index v out of bounds" );
+    return m_position[v];
+}
+
+inline const Vector3& HalfEdgeMesh::getNormal( VertexIdx v ) const {
+    CORE_ASSERT( v < m_normal.size(), "Index v out of bounds" );
+    return m_normal[v];
+}
+
+inline Vector3& HalfEdgeMesh::getNormal( VertexIdx v ) {
+    CORE_ASSERT( v < m_normal.size(), "Index v out of bounds" );
+    return m_normal[v];
+}
+
+inline HalfEdgeIdx HalfEdgeMesh::getVertexHalfEdge( VertexIdx v ) const {
+    CORE_ASSERT( v < m_vertexHalfEdge.size(), "Index v out of bounds" );
+    return m_vertexHalfEdge[v];
+}
+
+inline void HalfEdgeMesh::setVertexHalfEdge( VertexIdx v, HalfEdgeIdx he ) {
+    CORE_ASSERT( v < m_vertexHalfEdge.size(), "Index v out of bounds" );
+    m_vertexHalfEdge[v] = he;
+}
+
+
+
+/// FACE
+inline HalfEdgeIdx HalfEdgeMesh::getFaceHalfEdge( FaceIdx f ) const {
+    CORE_ASSERT( f < m_faceHalfEdge.size(), "Index f out of bounds" );
+    return m_faceHalfEdge[f];
+}
+
+inline void HalfEdgeMesh::setFaceHalfEdge( FaceIdx f, HalfEdgeIdx he ) {
+    CORE_ASSERT( f < m_faceHalfEdge.size(), "Index f out of bounds" );
+    m_faceHalfEdge[f] = he;
+}
+
+
+
+/// CIRCULATION
+inline HalfEdgeMesh::VHECirculator HalfEdgeMesh::vertexHalfEdges( VertexIdx v ) const {
+    return VHECirculator( this, getVertexHalfEdge( v ) );
+}
+
+inline HalfEdgeMesh::VVCirculator HalfEdgeMesh::vertexVertices( VertexIdx v ) const {
+    return VVCirculator( this, getVertexHalfEdge( v ) );
+}
+
+inline HalfEdgeMesh::VFCirculator HalfEdgeMesh::vertexFaces( VertexIdx v ) const {
+    return VFCirculator( this, getVertexHalfEdge( v ) );
+}
+
+inline HalfEdgeMesh::FHECirculator HalfEdgeMesh::faceHalfEdges( FaceIdx f ) const {
+    return FHECirculator( this, getFaceHalfEdge( f ) );
+}
+
+inline HalfEdgeMesh::FVCirculator HalfEdgeMesh::faceVertices( FaceIdx f ) const {
+    return FVCirculator( this, getFaceHalfEdge( f ) );
+}
+
+} // namespace Core
+} // namespace Ra
@@ -179,6 +179,61 @@ void splitEdge( Dcel& dcel, Index edgeIndex, Scalar fraction )
     f2->HE() = he2;
     f3->HE() = he3;
 }
+
+VertexIdx splitEdge( HalfEdgeMesh& mesh, EdgeIdx edgeIndex, Scalar fraction )
+{
+    // Same schema as above, he2 and he3 being the halfedges of the new edge. The edges MA and MB
+    // are created by splitting the faces, when they exist.
+
+    CORE_ASSERT( fraction > 0 && fraction < 1, "Invalid fraction" );
+    CORE_ASSERT( !mesh.isDeletedEdge( edgeIndex ), "Deleted edge" );
+
+    const HalfEdgeIdx he0 = mesh.getEdgeHalfEdge( edgeIndex, 0 );
+    const HalfEdgeIdx he1 = mesh.getEdgeHalfEdge( edgeIndex, 1 );
+    const VertexIdx   v1  = mesh.getVertex( he0 );
+    const VertexIdx   v2  = mesh.getVertex( he1 );
+
+    // Halfedges leaving V2 in F0 and arriving in V2 in F1
+    const HalfEdgeIdx V2A = mesh.getNext( he0 );
+    const HalfEdgeIdx BV2 = mesh.getPrev( he1 );
+
+    // New vertex M
+    const VertexIdx vm = mesh.addVertex(
+        fraction * mesh.getPosition( v1 ) + ( 1. - fraction ) * mesh.getPosition( v2 ),
+        ( fraction * mesh.getNormal( v1 ) + ( 1. - fraction ) * mesh.getNormal( v2 ) ).normalized() );
+
+    // New edge M->V2, inserted after he0 and before he1
+    const EdgeIdx     fe1 = mesh.addEdge( vm, v2 );
+    const HalfEdgeIdx he2 = mesh.getEdgeHalfEdge( fe1, 0 );
+    const HalfEdgeIdx he3 = mesh.getEdgeHalfEdge( fe1, 1 );
+
+    mesh.setVertex( he1, vm );
+    mesh.link( he0, he2 );
+    mesh.link( he2, V2A );
+    mesh.setFace( he2, mesh.getFace( he0 ) );
+    mesh.link( BV2, he3 );
+    mesh.link( he3, he1 );
+    mesh.setFace( he3, mesh.getFace( he1 ) );
+
+    // he3 is on the border when he1 is
+    if( mesh.getVertexHalfEdge( v2 ) == he1 )
+    {
+        mesh.setVertexHalfEdge( v2, he3 );
+    }
+    mesh.setVertexHalfEdge( vm, mesh.isBoundary( he1 ) ? he1 : he2 );
+
+    // Edges MA and MB
+    if( !mesh.isBoundary( he0 ) )
+    {
+        mesh.splitFace( he0, V2A );
+    }
+    if( !mesh.isBoundary( he1 ) )
+    {
+        mesh.splitFace( he3, mesh.getNext( he1 ) );
+    }
+
+    return vm;
+}
 }
 }
 }
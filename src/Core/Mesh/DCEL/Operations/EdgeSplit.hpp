@@ -1,9 +1,14 @@
 #include <Core/RaCore.hpp>
 #include <Core/Mesh/DCEL/Dcel.hpp>
+#include <Core/Mesh/DCEL/HalfEdgeMesh.hpp>
 namespace Ra {
 namespace Core {
 namespace DcelOperations {
     RA_CORE_API void splitEdge( Dcel& dcel, Index edgeIndex, Scalar fraction );
+
+    // Same operation on a HalfEdgeMesh, where the edge can be on the border. The new vertex is
+    // returned, the first halfedge of the edge keeps going from its vertex to it.
+    RA_CORE_API VertexIdx splitEdge( HalfEdgeMesh& mesh, EdgeIdx edgeIndex, Scalar fraction );
 }
 }
 }
\ No newline at end of file
@@ -16,6 +16,8 @@ namespace Ra
         typedef uint TriangleIdx;
         typedef uint VertexIdx;
         typedef uint HalfEdgeIdx;
+        typedef uint EdgeIdx;
+        typedef uint FaceIdx;
 
         enum { InvalidIdx = uint( -1 ) };
     }
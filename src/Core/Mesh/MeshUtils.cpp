@@ -7,6 +7,7 @@
 #include <Core/Math/Math.hpp>
 #include <Core/Math/RayCast.hpp>
 #include <Core/String/StringUtils.hpp>
+#include <Core/TreeStructures/TriangleMeshBVH.hpp>
 
 namespace Ra
 {
@@ -96,10 +97,33 @@ namespace Ra
                 mesh.m_vertices = uniqueVertices;
             }
 
+            namespace
+            {
+                // Returns the vertex of the triangle closest to the point.
+                int getNearestVertex(const TriangleMesh &mesh, uint triangle, const Vector3 &point)
+                {
+                    Scalar minDist = std::numeric_limits<Scalar>::max();
+                    int nearest = -1;
+                    std::array<Vector3,3> v;
+                    getTriangleVertices(mesh, triangle, v);
+                    for (uint i = 0; i < 3; ++i)
+                    {
+                        Scalar dSq = (v[i] - point).squaredNorm();
+                        if (dSq < minDist)
+                        {
+                            minDist = dSq;
+                            nearest = mesh.m_triangles[triangle][i];
+                        }
+                    }
+                    return nearest;
+                }
+            }
+
             RayCastResult castRay(const TriangleMesh &mesh, const Ray &ray)
             {
                 RayCastResult result;
                 result.m_hitTriangle = -1;
+                result.m_nearestVertex = -1;
                 Scalar minT = std::numeric_limits<Scalar>::max();
 
                 std::vector<Scalar> tValues;
@@ -117,20 +141,30 @@ namespace Ra
 
                 if (result.m_hitTriangle >= 0)
                 {
-                    Scalar minDist = std::numeric_limits<Scalar>::max();
-                    std::array<Vector3,3> v;
-                    getTriangleVertices(mesh, result.m_hitTriangle, v);
-                    for (uint i = 0; i < 3; ++i)
-                    {
-                        Scalar dSq = (v[i] - ray.pointAt(minT)).squaredNorm();
-                        if (dSq < minDist)
-                        {
-                            result.m_nearestVertex = mesh.m_triangles[result.m_hitTriangle][i];
-                        }
-                    }
+                    result.m_nearestVertex = getNearestVertex(mesh, result.m_hitTriangle, ray.pointAt(minT));
+                }
 
+                return result;
+            }
+
+            RayCastResult castRay(const TriangleMesh &mesh, const TriangleMeshBVH &bvh, const Ray &ray)
+            {
+                if (bvh.isEmpty())
+                {
+                    return castRay(mesh, ray);
                 }
+                CORE_ASSERT(bvh.getNumTriangles() == mesh.m_triangles.size(), "BVH was not built on this mesh");
 
+                RayCastResult result;
+                result.m_hitTriangle = -1;
+                result.m_nearestVertex = -1;
+                Scalar t;
+                uint triangle;
+                if (bvh.closestHit(mesh, ray, t, triangle))
+                {
+                    result.m_hitTriangle = int(triangle);
+                    result.m_nearestVertex = getNearestVertex(mesh, triangle, ray.pointAt(t));
+                }
                 return result;
             }
 
@@ -165,6 +199,35 @@ namespace Ra
                 return 0.0;
             }
 
+            void transform( TriangleMesh& mesh, const Transform& T )
+            {
+                transformPoints( mesh.m_vertices, T, mesh.m_vertices );
+                transformNormals( mesh.m_normals, T, mesh.m_normals );
+            }
+
+            void transformPoints( const Vector3Array& in, const Transform& T, Vector3Array& out )
+            {
+                out.resize( in.size() );
+                if ( in.empty() )
+                {
+                    return;
+                }
+                // The product is evaluated in a temporary, so in and out can alias.
+                out.getMap() = ( T.linear() * in.getMap() ).colwise() + T.translation();
+            }
+
+            void transformNormals( const Vector3Array& in, const Transform& T, Vector3Array& out )
+            {
+                out.resize( in.size() );
+                if ( in.empty() )
+                {
+                    return;
+                }
+                const Matrix3 N = T.linear().inverse().transpose();
+                out.getMap() = N * in.getMap();
+                out.getMap().colwise().normalize();
+            }
+
         } // namespace MeshUtils
     } // namespace Core
 } // namespace Ra
@@ -12,6 +12,7 @@ namespace Ra
 {
     namespace Core
     {
+        class TriangleMeshBVH;
 
         /// Functions to operate on a TriangleMesh
         namespace MeshUtils
@@ -44,11 +45,28 @@ namespace Ra
             struct RayCastResult { int m_hitTriangle; int m_nearestVertex; };
 
             /// Return the index of the triangle hit by the ray or -1 if there's no hit.
+            /// This tests all the triangles, use the version with a TriangleMeshBVH for repeated queries.
             RA_CORE_API RayCastResult castRay( const TriangleMesh& mesh, const Ray& ray);
 
+            /// Same as above, using a hierarchy built on the mesh to only test the triangles close to the ray.
+            /// If the hierarchy is empty, all the triangles are tested.
+            RA_CORE_API RayCastResult castRay( const TriangleMesh& mesh, const TriangleMeshBVH& bvh, const Ray& ray);
+
             /// Return the mean edge length of the given triangle mesh
             RA_CORE_API Scalar getMeanEdgeLength( const TriangleMesh& mesh );
 
+            /// Applies a transform to the vertices and normals of the mesh.
+            /// Normals are transformed by the inverse transpose of the linear part and normalized.
+            RA_CORE_API void transform( TriangleMesh& mesh, const Transform& T );
+
+            /// Writes in out the points of in transformed by T, in a single pass over the arrays.
+            /// out may be the same array as in.
+            RA_CORE_API void transformPoints( const Vector3Array& in, const Transform& T, Vector3Array& out );
+
+            /// Writes in out the normals of in transformed by the inverse transpose of the
+            /// linear part of T and normalized. out may be the same array as in.
+            RA_CORE_API void transformNormals( const Vector3Array& in, const Transform& T, Vector3Array& out );
+
             //
             // Checks
             //
@@ -0,0 +1,112 @@
+#include <Core/Mesh/VertexPacking.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace VertexPacking
+        {
+            namespace
+            {
+                /// Number of vertices converted at once. The components of a block are
+                /// converted in a flat loop, then gathered in the output.
+                const uint BLOCK_SIZE = 256;
+
+                inline char* element( void* out, uint i, uint stride )
+                {
+                    return static_cast<char*>( out ) + size_t( i ) * stride;
+                }
+            }
+
+            void packFloat3( const Vector3* in, uint count, void* out, uint stride )
+            {
+                float values[3 * BLOCK_SIZE];
+                for ( uint begin = 0; begin < count; begin += BLOCK_SIZE )
+                {
+                    const uint blockSize = std::min( BLOCK_SIZE, count - begin );
+                    const Scalar* src = in[begin].data();
+                    for ( uint k = 0; k < 3 * blockSize; ++k )
+                    {
+                        values[k] = float( src[k] );
+                    }
+                    for ( uint i = 0; i < blockSize; ++i )
+                    {
+                        std::memcpy( element( out, begin + i, stride ), values + 3 * i, 3 * sizeof( float ) );
+                    }
+                }
+            }
+
+            void packSnorm1010102( const Vector3* in, uint count, void* out, uint stride )
+            {
+                int q[3 * BLOCK_SIZE];
+                for ( uint begin = 0; begin < count; begin += BLOCK_SIZE )
+                {
+                    const uint blockSize = std::min( BLOCK_SIZE, count - begin );
+                    const Scalar* src = in[begin].data();
+                    for ( uint k = 0; k < 3 * blockSize; ++k )
+                    {
+                        q[k] = toSnorm10( src[k] );
+                    }
+                    for ( uint i = 0; i < blockSize; ++i )
+                    {
+                        const uint p = ( uint( q[3 * i] ) & 1023u )
+                                       | ( ( uint( q[3 * i + 1] ) & 1023u ) << 10 )
+                                       | ( ( uint( q[3 * i + 2] ) & 1023u ) << 20 );
+                        std::memcpy( element( out, begin + i, stride ), &p, sizeof( p ) );
+                    }
+                }
+            }
+
+            void packHalf2( const Vector3* in, uint count, void* out, uint stride )
+            {
+                ushort h[3 * BLOCK_SIZE];
+                for ( uint begin = 0; begin < count; begin += BLOCK_SIZE )
+                {
+                    const uint blockSize = std::min( BLOCK_SIZE, count - begin );
+                    const Scalar* src = in[begin].data();
+                    for ( uint k = 0; k < 3 * blockSize; ++k )
+                    {
+                        h[k] = packHalf( float( src[k] ) );
+                    }
+                    for ( uint i = 0; i < blockSize; ++i )
+                    {
+                        std::memcpy( element( out, begin + i, stride ), h + 3 * i, 2 * sizeof( ushort ) );
+                    }
+                }
+            }
+
+            void packUnorm8888( const Vector4* in, uint count, void* out, uint stride )
+            {
+                uchar c[4 * BLOCK_SIZE];
+                for ( uint begin = 0; begin < count; begin += BLOCK_SIZE )
+                {
+                    const uint blockSize = std::min( BLOCK_SIZE, count - begin );
+                    const Scalar* src = in[begin].data();
+                    for ( uint k = 0; k < 4 * blockSize; ++k )
+                    {
+                        c[k] = uchar( toUnorm8( src[k] ) );
+                    }
+                    for ( uint i = 0; i < blockSize; ++i )
+                    {
+                        std::memcpy( element( out, begin + i, stride ), c + 4 * i, 4 );
+                    }
+                }
+            }
+
+            void packIndices16( const VectorArray<Triangle>& in, ushort* out )
+            {
+                if ( in.empty() )
+                {
+                    return;
+                }
+                const uint* src = in[0].data();
+                const uint numIndices = 3 * uint( in.size() );
+                for ( uint k = 0; k < numIndices; ++k )
+                {
+                    CORE_ASSERT( src[k] < 65536, "Index does not fit in 16 bits" );
+                    out[k] = ushort( src[k] );
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,72 @@
+#ifndef RADIUMENGINE_VERTEX_PACKING_HPP
+#define RADIUMENGINE_VERTEX_PACKING_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <Core/Containers/VectorArray.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Mesh/MeshTypes.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Conversions of vertex attributes to compact formats the GPU decodes
+        /// natively, for vertex buffers.
+        /// The array versions convert count values and write value i at out + i * stride,
+        /// so that they can fill an interleaved buffer. Their loops are vectorized by the
+        /// compiler. An interleaved buffer is best filled by blocks of a few thousand
+        /// vertices, calling all the conversions on each block while it is in cache.
+        namespace VertexPacking
+        {
+            //
+            // Single values
+            //
+
+            /// Packs a vector of [-1,1]^3 and w in [-2,1] as GL_INT_2_10_10_10_REV
+            /// (signed normalized). Components are clamped.
+            inline uint packSnorm1010102( const Vector3& v, int w = 0 );
+
+            /// Inverse of packSnorm1010102(), ignoring w.
+            inline Vector3 unpackSnorm1010102( uint p );
+
+            /// Converts a float to an IEEE half float (GL_HALF_FLOAT), rounding to nearest.
+            /// Values too small for a normalized half are flushed to zero, values too
+            /// large (and NaN) become infinity.
+            inline ushort packHalf( float f );
+
+            /// Inverse of packHalf().
+            inline float unpackHalf( ushort h );
+
+            /// Packs a color of [0,1]^4 as 4 unsigned normalized bytes (GL_UNSIGNED_BYTE).
+            inline uint packUnorm8888( const Vector4& c );
+
+            /// Inverse of packUnorm8888().
+            inline Vector4 unpackUnorm8888( uint p );
+
+            //
+            // Arrays
+            //
+
+            /// Writes the vectors as 3 floats.
+            RA_CORE_API void packFloat3( const Vector3* in, uint count, void* out, uint stride );
+
+            /// Writes the unit vectors (normals, tangents) with packSnorm1010102().
+            RA_CORE_API void packSnorm1010102( const Vector3* in, uint count, void* out, uint stride );
+
+            /// Writes the two first coordinates of the vectors (texture coordinates) as half floats.
+            RA_CORE_API void packHalf2( const Vector3* in, uint count, void* out, uint stride );
+
+            /// Writes the colors with packUnorm8888().
+            RA_CORE_API void packUnorm8888( const Vector4* in, uint count, void* out, uint stride );
+
+            /// Writes the indices of the triangles as 16 bits integers. All the
+            /// indices must be lower than 65536.
+            RA_CORE_API void packIndices16( const VectorArray<Triangle>& in, ushort* out );
+        }
+    }
+}
+
+#include <Core/Mesh/VertexPacking.inl>
+
+#endif // RADIUMENGINE_VERTEX_PACKING_HPP
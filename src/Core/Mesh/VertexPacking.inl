@@ -0,0 +1,100 @@
+#include <Core/Mesh/VertexPacking.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace VertexPacking
+        {
+            inline int toSnorm10( Scalar x )
+            {
+                // Rounds without branch : the truncated value is always positive.
+                const Scalar c = std::min( std::max( x, Scalar( -1 ) ), Scalar( 1 ) );
+                return int( c * Scalar( 511 ) + Scalar( 512.5 ) ) - 512;
+            }
+
+            inline uint toUnorm8( Scalar x )
+            {
+                const Scalar c = std::min( std::max( x, Scalar( 0 ) ), Scalar( 1 ) );
+                return uint( c * Scalar( 255 ) + Scalar( 0.5 ) );
+            }
+
+            inline uint packSnorm1010102( const Vector3& v, int w )
+            {
+                return ( uint( toSnorm10( v.x() ) ) & 1023u )
+                       | ( ( uint( toSnorm10( v.y() ) ) & 1023u ) << 10 )
+                       | ( ( uint( toSnorm10( v.z() ) ) & 1023u ) << 20 )
+                       | ( ( uint( w ) & 3u ) << 30 );
+            }
+
+            inline Vector3 unpackSnorm1010102( uint p )
+            {
+                Vector3 v;
+                for ( uint k = 0; k < 3; ++k )
+                {
+                    // Sign extension of the 10 bits of the component.
+                    const int q = int( p << ( 22 - 10 * k ) ) >> 22;
+                    v[k] = std::max( Scalar( q ) / Scalar( 511 ), Scalar( -1 ) );
+                }
+                return v;
+            }
+
+            inline ushort packHalf( float f )
+            {
+                uint x;
+                std::memcpy( &x, &f, sizeof( x ) );
+
+                const uint sign = ( x >> 16 ) & 0x8000u;
+                // Exponent rebiased from 127 to 15.
+                const int e = int( ( x >> 23 ) & 0xffu ) - 112;
+                const uint m = x & 0x7fffffu;
+
+                // Rounding may carry in the exponent, which is what we want.
+                uint h = ( uint( e ) << 10 ) + ( ( m + 0x1000u ) >> 13 );
+                h = ( e <= 0 ) ? 0u : h;
+                h = ( e >= 31 || h > 0x7c00u ) ? 0x7c00u : h;
+                return ushort( sign | h );
+            }
+
+            inline float unpackHalf( ushort h )
+            {
+                const uint sign = uint( h & 0x8000u ) << 16;
+                const uint e = ( h >> 10 ) & 0x1fu;
+                const uint m = h & 0x3ffu;
+
+                if ( e == 0 )
+                {
+                    const float d = float( m ) / float( 1 << 24 );
+                    return sign ? -d : d;
+                }
+
+                const uint x = ( e == 31 ) ? ( sign | 0x7f800000u | ( m << 13 ) )
+                                           : ( sign | ( ( e + 112 ) << 23 ) | ( m << 13 ) );
+                float f;
+                std::memcpy( &f, &x, sizeof( f ) );
+                return f;
+            }
+
+            inline uint packUnorm8888( const Vector4& c )
+            {
+                return toUnorm8( c.x() )
+                       | ( toUnorm8( c.y() ) << 8 )
+                       | ( toUnorm8( c.z() ) << 16 )
+                       | ( toUnorm8( c.w() ) << 24 );
+            }
+
+            inline Vector4 unpackUnorm8888( uint p )
+            {
+                Vector4 c;
+                for ( uint k = 0; k < 4; ++k )
+                {
+                    c[k] = Scalar( ( p >> ( 8 * k ) ) & 0xffu ) / Scalar( 255 );
+                }
+                return c;
+            }
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include <Core/Mesh/Wrapper/Convert.hpp>
 
+#include <algorithm>
 #include <map>
 
 #include <Core/Mesh/TriangleMesh.hpp>
@@ -9,6 +10,7 @@
 #include <Core/Mesh/DCEL/FullEdge.hpp>
 #include <Core/Mesh/DCEL/Face.hpp>
 #include <Core/Mesh/DCEL/Dcel.hpp>
+#include <Core/Mesh/DCEL/HalfEdgeMesh.hpp>
 #include <Core/Containers/MakeShared.hpp>
 
 
@@ -129,6 +131,112 @@ void convert( const Dcel& dcel, TriangleMesh& mesh ) {
 
 
 
+void convert( const TriangleMesh& mesh, HalfEdgeMesh& hem ) {
+    const uint v_size = mesh.m_vertices.size();
+    const uint c_size = 3 * mesh.m_triangles.size();
+    hem.clear();
+    hem.reserve( v_size, c_size / 2 + 1, mesh.m_triangles.size() );
+    for( uint i = 0; i < v_size; ++i ) {
+        hem.addVertex( mesh.m_vertices[i], mesh.m_normals[i] );
+    }
+
+    /// TWIN SEARCH
+    // Sorting the corners by the vertices of their edge puts the twins next to each other,
+    // without the allocations of a map.
+    struct Corner {
+        uint m_v[2];
+        uint m_id;
+        bool operator< ( const Corner& c ) const {
+            return ( ( m_v[0] < c.m_v[0] ) || ( ( m_v[0] == c.m_v[0] ) && ( ( m_v[1] < c.m_v[1] ) ||
+                                                ( ( m_v[1] == c.m_v[1] ) && ( m_id < c.m_id ) ) ) ) );
+        }
+    };
+    auto cornerVertex = [&mesh]( uint c ) { return mesh.m_triangles[c / 3][c % 3]; };
+    auto cornerNext   = []( uint c ) { return ( 3 * ( c / 3 ) + ( c + 1 ) % 3 ); };
+    std::vector< Corner > corner( c_size );
+    for( uint c = 0; c < c_size; ++c ) {
+        const uint a = cornerVertex( c );
+        const uint b = cornerVertex( cornerNext( c ) );
+        corner[c].m_v[0] = std::min( a, b );
+        corner[c].m_v[1] = std::max( a, b );
+        corner[c].m_id   = c;
+    }
+    std::sort( corner.begin(), corner.end() );
+
+    // Halfedge of each corner, going from its vertex to the next one
+    std::vector< HalfEdgeIdx > he( c_size );
+    for( uint i = 0; i < c_size; ) {
+        uint j = i + 1;
+        while( ( j < c_size ) && ( corner[j].m_v[0] == corner[i].m_v[0] ) && ( corner[j].m_v[1] == corner[i].m_v[1] ) ) {
+            ++j;
+        }
+        const uint c0 = corner[i].m_id;
+        if( ( j == i + 2 ) && ( cornerVertex( c0 ) != cornerVertex( corner[i + 1].m_id ) ) ) {
+            const EdgeIdx e = hem.addEdge( cornerVertex( c0 ), cornerVertex( cornerNext( c0 ) ) );
+            he[c0]                 = hem.getEdgeHalfEdge( e, 0 );
+            he[corner[i + 1].m_id] = hem.getEdgeHalfEdge( e, 1 );
+        } else {
+            // Border, or non manifold edge split in border edges
+            for( uint k = i; k < j; ++k ) {
+                const uint c = corner[k].m_id;
+                he[c] = hem.getEdgeHalfEdge( hem.addEdge( cornerVertex( c ), cornerVertex( cornerNext( c ) ) ), 0 );
+            }
+        }
+        i = j;
+    }
+
+    /// FACES
+    for( uint c = 0; c < c_size; ++c ) {
+        hem.link( he[c], he[cornerNext( c )] );
+        hem.setVertexHalfEdge( cornerVertex( c ), he[c] );
+    }
+    for( uint c = 0; c < c_size; c += 3 ) {
+        hem.addFace( he[c] );
+    }
+
+    /// BORDER
+    // The border halfedges become the halfedge of their vertex, and are linked in loops: the next
+    // one is found by turning around the end vertex, from the twin through the faces of the fan.
+    const HalfEdgeIdx he_size = 2 * hem.getEdgeCapacity();
+    for( HalfEdgeIdx h = 0; h < he_size; ++h ) {
+        if( hem.isBoundary( h ) ) {
+            hem.setVertexHalfEdge( hem.getVertex( h ), h );
+            HalfEdgeIdx next = hem.getTwin( h );
+            while( !hem.isBoundary( next ) ) {
+                next = hem.getNextAroundVertex( next );
+            }
+            hem.link( h, next );
+        }
+    }
+}
+
+
+
+void convert( const HalfEdgeMesh& hem, TriangleMesh& mesh ) {
+    mesh.clear();
+    std::vector< uint > v_table( hem.getVertexCapacity(), uint( InvalidIdx ) );
+    for( VertexIdx v = 0; v < hem.getVertexCapacity(); ++v ) {
+        if( !hem.isDeletedVertex( v ) ) {
+            v_table[v] = mesh.m_vertices.size();
+            mesh.m_vertices.push_back( hem.getPosition( v ) );
+            mesh.m_normals.push_back( hem.getNormal( v ) );
+        }
+    }
+    mesh.m_triangles.reserve( hem.getNumFaces() );
+    for( FaceIdx f = 0; f < hem.getFaceCapacity(); ++f ) {
+        if( hem.isDeletedFace( f ) ) {
+            continue;
+        }
+        const HalfEdgeIdx h0 = hem.getFaceHalfEdge( f );
+        const uint        v0 = v_table[hem.getVertex( h0 )];
+        for( HalfEdgeIdx h = hem.getNext( h0 ); hem.getNext( h ) != h0; h = hem.getNext( h ) ) {
+            mesh.m_triangles.push_back( Triangle( v0, v_table[hem.getVertex( h )], v_table[hem.getEndVertex( h )] ) );
+        }
+    }
+}
+
+
+
 
 } // namespace Core
 } // namespace Ra
@@ -10,6 +10,7 @@ namespace Core {
 class Index;
 struct TriangleMesh;
 class Dcel;
+class HalfEdgeMesh;
 
 struct Twin {
     Twin();
@@ -24,6 +25,12 @@ struct Twin {
 RA_CORE_API void convert( const TriangleMesh& mesh, Dcel& dcel );
 RA_CORE_API void convert( const Dcel& dcel, TriangleMesh& mesh );
 
+// The indices of the vertices are kept. The edges shared by two triangles of opposite orientation
+// are paired, the others get a border halfedge.
+RA_CORE_API void convert( const TriangleMesh& mesh, HalfEdgeMesh& hem );
+// The deleted vertices are skipped and the faces with more than three sides are split in fans.
+RA_CORE_API void convert( const HalfEdgeMesh& hem, TriangleMesh& mesh );
+
 
 
 
@@ -188,6 +188,49 @@ namespace Ra
 
                 return items;
             }
+
+            std::string toJsonString( const std::string& str )
+            {
+                std::string res = "\"";
+                for ( const char c : str )
+                {
+                    if ( c == '"' || c == '\\' )
+                    {
+                        res += '\\';
+                        res += c;
+                    }
+                    else if ( static_cast<unsigned char>( c ) < 0x20 )
+                    {
+                        appendPrintf( res, "\\u%04x", static_cast<unsigned char>( c ) );
+                    }
+                    else
+                    {
+                        res += c;
+                    }
+                }
+                res += '"';
+                return res;
+            }
+
+            std::string toCsvField( const std::string& str )
+            {
+                if ( str.find_first_of( ",\"\r\n" ) == std::string::npos )
+                {
+                    return str;
+                }
+
+                std::string res = "\"";
+                for ( const char c : str )
+                {
+                    if ( c == '"' )
+                    {
+                        res += '"';
+                    }
+                    res += c;
+                }
+                res += '"';
+                return res;
+            }
         }
     }
 }
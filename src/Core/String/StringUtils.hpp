@@ -53,6 +53,18 @@ namespace Ra
             /// { "Hello", " World", " and Universe !" }.
             /// @return a vector containing n substrings given a split token.
             RA_CORE_API std::vector<std::string> splitString( const std::string& str, char token );
+
+            //
+            // Text formats.
+            //
+
+            /// @return str as a JSON string, between double quotes and with the quotes,
+            /// backslashes and control characters escaped.
+            RA_CORE_API std::string toJsonString( const std::string& str );
+
+            /// @return str as a CSV field, between double quotes (with the inner quotes
+            /// doubled) if it contains a separator, a quote or a line break.
+            RA_CORE_API std::string toCsvField( const std::string& str );
         }
     }
 }
@@ -0,0 +1,45 @@
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+#include <Core/Tasks/TaskQueue.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            std::atomic<TaskQueue*> g_parallelForQueue( nullptr );
+        }
+
+        void setParallelForTaskQueue( TaskQueue* queue )
+        {
+            g_parallelForQueue = queue;
+        }
+
+        TaskQueue* getParallelForTaskQueue()
+        {
+            return g_parallelForQueue;
+        }
+
+        void parallelFor( uint begin, uint end, uint grainSize,
+                          const std::function<void( uint, uint )>& func )
+        {
+            TaskQueue* queue = g_parallelForQueue;
+            if ( queue != nullptr )
+            {
+                queue->parallelFor( begin, end, grainSize, func );
+            }
+            else
+            {
+                grainSize = std::max( grainSize, 1u );
+                for ( uint chunk = begin; chunk < end; chunk += std::min( grainSize, end - chunk ) )
+                {
+                    func( chunk, chunk + std::min( grainSize, end - chunk ) );
+                }
+            }
+        }
+    }
+}
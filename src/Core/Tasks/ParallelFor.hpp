@@ -0,0 +1,38 @@
+#ifndef RADIUMENGINE_PARALLEL_FOR_HPP_
+#define RADIUMENGINE_PARALLEL_FOR_HPP_
+
+#include <Core/RaCore.hpp>
+#include <functional>
+
+namespace Ra
+{
+    namespace Core
+    {
+        class TaskQueue;
+    }
+}
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Sets the task queue whose threads are used by parallelFor().
+        /// If no task queue is set, the loops run on the calling thread.
+        RA_CORE_API void setParallelForTaskQueue( TaskQueue* queue );
+
+        /// Returns the task queue used by parallelFor(), or nullptr.
+        RA_CORE_API TaskQueue* getParallelForTaskQueue();
+
+        /// Calls func( chunkBegin, chunkEnd ) on sub-ranges of [begin, end) of at most grainSize
+        /// elements, in parallel on the threads of the task queue set with setParallelForTaskQueue().
+        /// Loops started outside the tasks, e.g. by a file loader, do not delay the tasks (see
+        /// TaskQueue::parallelFor()).
+        /// Returns when the whole range has been processed.
+        /// This is meant to replace "#pragma omp parallel for" so that data-parallel loops share
+        /// the threads of the task queue instead of competing with them.
+        RA_CORE_API void parallelFor( uint begin, uint end, uint grainSize,
+                                      const std::function<void( uint, uint )>& func );
+    }
+}
+
+#endif // RADIUMENGINE_PARALLEL_FOR_HPP_
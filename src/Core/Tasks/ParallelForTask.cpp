@@ -0,0 +1,31 @@
+#include <Core/Tasks/ParallelForTask.hpp>
+
+#include <Core/Tasks/TaskQueue.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        ParallelForTask::ParallelForTask( const std::string& name, TaskQueue* queue, uint begin, uint end,
+                                          uint grainSize, const std::function<void( uint, uint )>& func )
+            : m_func( func )
+            , m_name( name )
+            , m_queue( queue )
+            , m_begin( begin )
+            , m_end( end )
+            , m_grainSize( grainSize )
+        {
+            CORE_ASSERT( m_queue != nullptr, "A parallel loop task needs the task queue running it" );
+        }
+
+        std::string ParallelForTask::getName() const
+        {
+            return m_name;
+        }
+
+        void ParallelForTask::process()
+        {
+            m_queue->parallelFor( m_begin, m_end, m_grainSize, m_func );
+        }
+    }
+}
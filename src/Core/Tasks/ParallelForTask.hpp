@@ -0,0 +1,42 @@
+#ifndef RADIUMENGINE_PARALLEL_FOR_TASK_HPP_
+#define RADIUMENGINE_PARALLEL_FOR_TASK_HPP_
+
+#include <Core/RaCore.hpp>
+#include <Core/Tasks/Task.hpp>
+
+#include <functional>
+#include <string>
+
+namespace Ra
+{
+    namespace Core
+    {
+        class TaskQueue;
+
+        /// A task running a data-parallel loop with TaskQueue::parallelFor().
+        /// It can be registered in a task queue like any other task, so that other tasks
+        /// can depend on the whole loop being finished.
+        class RA_CORE_API ParallelForTask : public Task
+        {
+        public:
+            /// The loop runs on the threads of queue, which must be the task queue the task
+            /// is registered in.
+            ParallelForTask( const std::string& name, TaskQueue* queue, uint begin, uint end, uint grainSize,
+                             const std::function<void( uint, uint )>& func );
+
+            virtual std::string getName() const override;
+
+            virtual void process() override;
+
+        private:
+            std::function<void( uint, uint )> m_func;
+            std::string m_name;
+            TaskQueue* m_queue;
+            uint m_begin;
+            uint m_end;
+            uint m_grainSize;
+        };
+    }
+}
+
+#endif // RADIUMENGINE_PARALLEL_FOR_TASK_HPP_
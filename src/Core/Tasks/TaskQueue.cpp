@@ -1,30 +1,68 @@
 #include <Core/Tasks/TaskQueue.hpp>
 #include <Core/Tasks/Task.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Time/Profiler.hpp>
 
 #include <stack>
 #include <iostream>
 #include <algorithm>
+#include <iterator>
 
 namespace Ra
 {
     namespace Core
     {
+        namespace
+        {
+            /// Task queue whose task, or a parallel loop started by one, the thread is running.
+            thread_local const TaskQueue* g_runningTaskQueue = nullptr;
+        }
 
-        TaskQueue::TaskQueue( uint numThreads )
-            : m_processingTasks( 0 ), m_shuttingDown( false )
+        TaskQueue::TaskQueue( uint numThreads, SchedulingMode mode )
+            : m_graphChanged( true )
+            , m_queuedTasks( 0 )
+            , m_sleepingThreads( 0 )
+            , m_unfinishedTasks( 0 )
+            , m_processingTasks( 0 )
+            , m_mode( mode )
+            , m_shuttingDown( false )
         {
             CORE_ASSERT( numThreads > 0, " You need at least one thread" );
             m_workerThreads.reserve( numThreads );
-            for ( uint i = 0 ; i < numThreads; ++i )
+            if ( m_mode == SchedulingMode::WORK_STEALING )
+            {
+                // One more deque for the thread which runs tasks in waitForTasks().
+                m_workerQueues.reserve( numThreads + 1 );
+                for ( uint i = 0 ; i < numThreads + 1; ++i )
+                {
+                    m_workerQueues.emplace_back( new WorkerQueue );
+                }
+                for ( uint i = 0 ; i < numThreads; ++i )
+                {
+                    m_workerThreads.emplace_back( std::thread( &TaskQueue::runThreadWorkStealing, this, i ) );
+                }
+            }
+            else
             {
-                m_workerThreads.emplace_back( std::thread( &TaskQueue::runThread, this, i ) );
+                for ( uint i = 0 ; i < numThreads; ++i )
+                {
+                    m_workerThreads.emplace_back( std::thread( &TaskQueue::runThread, this, i ) );
+                }
             }
         }
 
         TaskQueue::~TaskQueue()
         {
+            // Parallel loops must not use this task queue anymore.
+            if ( getParallelForTaskQueue() == this )
+            {
+                setParallelForTaskQueue( nullptr );
+            }
             flushTaskQueue();
-            m_shuttingDown = true;
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                m_shuttingDown = true;
+            }
             m_threadNotifier.notify_all();
             for ( auto& t :  m_workerThreads )
             {
@@ -33,17 +71,30 @@ namespace Ra
         }
 
         TaskQueue::TaskId TaskQueue::registerTask( Task* task )
+        {
+            return registerTask( task, nullptr );
+        }
+
+        TaskQueue::TaskId TaskQueue::registerTask( Task* task, const void* scope )
         {
             m_tasks.emplace_back( std::unique_ptr<Task> ( task ) );
             m_dependencies.push_back( std::vector<TaskId>() );
-            m_remainingDependencies.push_back( 0 );
+            m_numPredecessors.push_back( 0 );
+            m_taskNames[task->getName()].push_back( TaskId( m_tasks.size() - 1 ) );
+            m_taskScopes.push_back( scope );
+            if ( scope != nullptr )
+            {
+                m_scopedTaskNames[std::make_pair( task->getName(), scope )].push_back( TaskId( m_tasks.size() - 1 ) );
+            }
+            m_graphChanged = true;
             TimerData tdata;
             tdata.taskName = task->getName();
             m_timerData.push_back( tdata );
 
             CORE_ASSERT( m_tasks.size() == m_dependencies.size(), "Inconsistent task list" );
-            CORE_ASSERT( m_tasks.size() == m_remainingDependencies.size(), "Inconsistent task list" );
+            CORE_ASSERT( m_tasks.size() == m_numPredecessors.size(), "Inconsistent task list" );
             CORE_ASSERT( m_tasks.size() == m_timerData.size(), "Inconsistent task list" );
+            CORE_ASSERT( m_tasks.size() == m_taskScopes.size(), "Inconsistent task list" );
             return TaskId( m_tasks.size() - 1 );
         }
 
@@ -56,35 +107,36 @@ namespace Ra
             CORE_ASSERT( std::find( m_dependencies[predecessor].begin(), m_dependencies[predecessor].end(), successor ) == m_dependencies[predecessor].end(), "Cannot add a dependency twice" );
 
             m_dependencies[predecessor].push_back( successor );
-            ++m_remainingDependencies[successor];
+            ++m_numPredecessors[successor];
+            m_graphChanged = true;
         }
 
         bool TaskQueue::addDependency(const std::string &predecessors, TaskQueue::TaskId successor)
         {
-            bool added = false;
-            for (uint i = 0; i < m_tasks.size(); ++i)
+            auto it = m_taskNames.find( predecessors );
+            if ( it == m_taskNames.end() )
             {
-                if (m_tasks[i]->getName() == predecessors )
-                {
-                    added = true;
-                    addDependency( i, successor);
-                }
+                return false;
             }
-            return added;
+            for ( TaskId i : it->second )
+            {
+                addDependency( i, successor );
+            }
+            return true;
         }
 
         bool TaskQueue::addDependency(TaskQueue::TaskId predecessor, const std::string &successors)
         {
-            bool added = false;
-            for (uint i = 0; i < m_tasks.size(); ++i)
+            auto it = m_taskNames.find( successors );
+            if ( it == m_taskNames.end() )
             {
-                if (m_tasks[i]->getName() == successors )
-                {
-                    added = true;
-                    addDependency( predecessor, i );
-                }
+                return false;
             }
-            return added;
+            for ( TaskId i : it->second )
+            {
+                addDependency( predecessor, i );
+            }
+            return true;
         }
 
         void TaskQueue::addPendingDependency(const std::string &predecessors, TaskQueue::TaskId successor)
@@ -97,20 +149,65 @@ namespace Ra
             m_pendingDepsPre.push_back(std::make_pair(predecessor, successors));
         }
 
+        void TaskQueue::addPendingScopedDependency( const std::string& predecessors, TaskId successor )
+        {
+            CORE_ASSERT( successor < m_tasks.size(), "Invalid successor task" );
+            CORE_ASSERT( m_taskScopes[successor] != nullptr, "Scoped dependency on a task without scope" );
+            m_pendingScopedDeps.push_back( std::make_pair( predecessors, successor ) );
+        }
+
         void TaskQueue::resolveDependencies()
         {
            for ( const auto& pre : m_pendingDepsPre )
            {
-               ON_DEBUG(bool result =) addDependency( pre.first, pre.second );
-               CORE_ASSERT( result, "Pending dependency unresolved");
+               auto it = m_taskNames.find( pre.second );
+               CORE_ASSERT( it != m_taskNames.end(), "Pending dependency unresolved");
+               if ( it != m_taskNames.end() )
+               {
+                   for ( TaskId successor : it->second )
+                   {
+                       addDependencyOnce( pre.first, successor );
+                   }
+               }
            }
            for ( const auto& pre : m_pendingDepsSucc )
            {
-               ON_DEBUG(bool result =) addDependency( pre.first, pre.second );
-               CORE_ASSERT( result, "Pending dependency unresolved");
+               auto it = m_taskNames.find( pre.first );
+               CORE_ASSERT( it != m_taskNames.end(), "Pending dependency unresolved");
+               if ( it != m_taskNames.end() )
+               {
+                   for ( TaskId predecessor : it->second )
+                   {
+                       addDependencyOnce( predecessor, pre.second );
+                   }
+               }
+           }
+           for ( const auto& dep : m_pendingScopedDeps )
+           {
+               auto it = m_scopedTaskNames.find( std::make_pair( dep.first, m_taskScopes[dep.second] ) );
+               if ( it != m_scopedTaskNames.end() )
+               {
+                   for ( TaskId predecessor : it->second )
+                   {
+                       addDependencyOnce( predecessor, dep.second );
+                   }
+               }
            }
+           m_resolvedDepsPre.insert( m_resolvedDepsPre.end(), m_pendingDepsPre.begin(), m_pendingDepsPre.end() );
+           m_resolvedDepsSucc.insert( m_resolvedDepsSucc.end(), m_pendingDepsSucc.begin(), m_pendingDepsSucc.end() );
+           m_resolvedScopedDeps.insert( m_resolvedScopedDeps.end(), m_pendingScopedDeps.begin(), m_pendingScopedDeps.end() );
            m_pendingDepsPre.clear();
            m_pendingDepsSucc.clear();
+           m_pendingScopedDeps.clear();
+        }
+
+        void TaskQueue::addDependencyOnce( TaskQueue::TaskId predecessor, TaskQueue::TaskId successor )
+        {
+            const auto& successors = m_dependencies[predecessor];
+            if ( std::find( successors.begin(), successors.end(), successor ) == successors.end() )
+            {
+                addDependency( predecessor, successor );
+            }
         }
 
         void TaskQueue::queueTask( TaskQueue::TaskId task )
@@ -119,40 +216,94 @@ namespace Ra
             m_taskQueue.push_front( task );
         }
 
-        void TaskQueue::detectCycles()
+        void TaskQueue::queueTaskLocal( TaskQueue::TaskId task, uint threadId )
         {
-#if defined (CORE_DEBUG)
-            // Do a depth-first search of the nodes.
-            std::vector<bool> visited( m_tasks.size(), false );
-            std::stack<TaskId> pending;
+            CORE_ASSERT( m_remainingDependencies[task] == 0, " Task has unsatisfied dependencies" );
+            WorkerQueue& queue = *m_workerQueues[threadId];
+            {
+                std::unique_lock<std::mutex> lock( queue.m_mutex );
+                queue.m_tasks.push_back( task );
+                ++m_queuedTasks;
+            }
 
-            for (TaskId id = 0; id < m_tasks.size(); ++id)
+            // Only wake up a thread if one is actually asleep. A thread going to sleep increments
+            // m_sleepingThreads before checking m_queuedTasks, so one of the two sides sees the
+            // other and the wake-up cannot be lost.
+            if ( m_sleepingThreads > 0 )
             {
-                if ( m_dependencies[id].size() == 0 )
                 {
-                    pending.push(id);
+                    std::unique_lock<std::mutex> lock( m_taskQueueMutex );
                 }
+                m_threadNotifier.notify_one();
             }
+        }
 
-            // If you hit this assert, there are tasks in the list but
-            // all tasks have dependencies so no task can start.
-            CORE_ASSERT( m_tasks.empty() || !pending.empty(), "No free tasks.");
+        TaskQueue::TaskId TaskQueue::fetchTask( uint threadId )
+        {
+            // Pop from the back of our own deque (most recently queued, likely hot in cache).
+            {
+                WorkerQueue& queue = *m_workerQueues[threadId];
+                std::unique_lock<std::mutex> lock( queue.m_mutex );
+                if ( !queue.m_tasks.empty() )
+                {
+                    const TaskId task = queue.m_tasks.back();
+                    queue.m_tasks.pop_back();
+                    --m_queuedTasks;
+                    return task;
+                }
+            }
+
+            // Steal from the front of the other deques.
+            const uint numQueues = uint( m_workerQueues.size() );
+            for ( uint i = 1; i < numQueues; ++i )
+            {
+                WorkerQueue& victim = *m_workerQueues[( threadId + i ) % numQueues];
+                std::unique_lock<std::mutex> lock( victim.m_mutex, std::try_to_lock );
+                if ( lock.owns_lock() && !victim.m_tasks.empty() )
+                {
+                    const TaskId task = victim.m_tasks.front();
+                    victim.m_tasks.pop_front();
+                    --m_queuedTasks;
+                    return task;
+                }
+            }
+            return InvalidTaskId;
+        }
 
-            while (! pending.empty())
+        void TaskQueue::sortTasks()
+        {
+            // Kahn's algorithm : repeatedly remove the tasks with no predecessor left.
+            std::vector<uint> remaining( m_numPredecessors );
+            m_sortedTasks.clear();
+            m_sortedTasks.reserve( m_tasks.size() );
+            m_rootTasks.clear();
+            for ( TaskId id = 0; id < m_tasks.size(); ++id )
             {
-                TaskId id = pending.top();
-                pending.pop();
+                if ( m_numPredecessors[id] == 0 )
+                {
+                    m_sortedTasks.push_back( id );
+                    m_rootTasks.push_back( id );
+                }
+            }
 
-                // The task has already been visited. It means there is a cycle in the task graph.
-                CORE_ASSERT( !(visited[id]), "Cycle detected in tasks !");
+            // If you hit this assert, there are tasks in the list but
+            // all tasks have dependencies so no task can start.
+            CORE_ASSERT( m_tasks.empty() || !m_rootTasks.empty(), "No free tasks.");
 
-                visited[id] = true;
-                for ( const auto& dep : m_dependencies[id])
+            for ( uint i = 0; i < m_sortedTasks.size(); ++i )
+            {
+                for ( const auto& dep : m_dependencies[m_sortedTasks[i]] )
                 {
-                    pending.push( dep );
+                    if ( --remaining[dep] == 0 )
+                    {
+                        m_sortedTasks.push_back( dep );
+                    }
                 }
             }
-#endif
+
+            // Some tasks were never freed : they are part of a cycle.
+            CORE_ASSERT( m_sortedTasks.size() == m_tasks.size(), "Cycle detected in tasks !");
+            m_graphChanged = false;
         }
 
         void TaskQueue::startTasks()
@@ -160,13 +311,39 @@ namespace Ra
             // Add pending dependencies.
             resolveDependencies();
 
-            // Do a debug check
-            detectCycles();
+            // Sort the graph again only if it changed since the last run.
+            if ( m_graphChanged )
+            {
+                sortTasks();
+            }
 
-            // Enqueue all tasks with no dependencies.
+            // Reset the dependency counters.
+            if ( m_remainingDependencies.size() != m_tasks.size() )
+            {
+                m_remainingDependencies = std::vector<std::atomic<uint>>( m_tasks.size() );
+            }
             for ( uint t = 0; t < m_tasks.size(); ++t )
             {
-                if ( m_remainingDependencies[t] == 0 )
+                m_remainingDependencies[t] = m_numPredecessors[t];
+            }
+
+            m_unfinishedTasks = uint( m_tasks.size() );
+            if ( m_mode == SchedulingMode::WORK_STEALING )
+            {
+                // Spread the tasks with no dependencies over the worker threads.
+                uint threadId = 0;
+                for ( TaskId t : m_rootTasks )
+                {
+                    queueTaskLocal( t, threadId );
+                    threadId = ( threadId + 1 ) % m_workerThreads.size();
+                }
+                return;
+            }
+
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                // Enqueue all tasks with no dependencies.
+                for ( TaskId t : m_rootTasks )
                 {
                     queueTask( t );
                 }
@@ -176,22 +353,88 @@ namespace Ra
             m_threadNotifier.notify_all();
         }
 
-        void TaskQueue::waitForTasks()
+        void TaskQueue::waitForTasks( bool runTasks )
         {
-            bool isFinished = false;
-            while ( !isFinished )
+            std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+            if ( m_mode == SchedulingMode::WORK_STEALING )
             {
-                // TODO : use a notifier for task queue empty.
-                m_taskQueueMutex.lock();
-                isFinished = ( m_taskQueue.empty() && m_processingTasks == 0 );
-                m_taskQueueMutex.unlock();
-                if ( !isFinished )
+                // The calling thread uses the extra deque after the workers' ones.
+                const uint callerId = uint( m_workerThreads.size() );
+                while ( m_unfinishedTasks > 0 )
                 {
-                    std::this_thread::yield();
+                    if ( runTasks )
+                    {
+                        lock.unlock();
+                        const TaskId task = fetchTask( callerId );
+                        bool worked = true;
+                        if ( task != InvalidTaskId )
+                        {
+                            processTaskWorkStealing( task, callerId );
+                        }
+                        else
+                        {
+                            worked = helpParallelFor( true );
+                        }
+                        lock.lock();
+                        if ( worked )
+                        {
+                            continue;
+                        }
+
+                        // Wait with the workers so that new tasks wake us up too.
+                        ++m_sleepingThreads;
+                        while ( m_unfinishedTasks > 0 && m_queuedTasks == 0 && findParallelJob( true ) == nullptr )
+                        {
+                            m_threadNotifier.wait( lock );
+                        }
+                        --m_sleepingThreads;
+                    }
+                    else
+                    {
+                        m_doneNotifier.wait( lock );
+                    }
+                }
+                return;
+            }
+
+            while ( !( m_taskQueue.empty() && m_processingTasks == 0 ) )
+            {
+                if ( runTasks && !m_taskQueue.empty() )
+                {
+                    const TaskId task = m_taskQueue.back();
+                    m_taskQueue.pop_back();
+                    ++m_processingTasks;
+                    lock.unlock();
+                    processTask( task );
+                    lock.lock();
+                }
+                else if ( runTasks && findParallelJob( true ) != nullptr )
+                {
+                    lock.unlock();
+                    helpParallelFor( true );
+                    lock.lock();
+                }
+                else if ( runTasks )
+                {
+                    m_threadNotifier.wait( lock );
+                }
+                else
+                {
+                    m_doneNotifier.wait( lock );
                 }
             }
         }
 
+        void TaskQueue::notifyTasksDone()
+        {
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+            }
+            m_doneNotifier.notify_all();
+            // A thread running tasks in waitForTasks() waits on the thread notifier.
+            m_threadNotifier.notify_all();
+        }
+
         const std::vector<TaskQueue::TimerData>& TaskQueue::getTimerData()
         {
             return m_timerData;
@@ -201,14 +444,98 @@ namespace Ra
         {
             CORE_ASSERT( m_processingTasks == 0, "You have tasks still in process" );
             CORE_ASSERT( m_taskQueue.empty(), " You have unprocessed tasks " );
+            CORE_ASSERT( m_unfinishedTasks == 0, " You have unprocessed tasks " );
+            CORE_ASSERT( m_queuedTasks == 0, " You have unprocessed tasks " );
             m_tasks.clear();
             m_dependencies.clear();
             m_timerData.clear();
+            m_numPredecessors.clear();
             m_remainingDependencies.clear();
+            m_taskNames.clear();
+            m_taskScopes.clear();
+            m_scopedTaskNames.clear();
+            m_sortedTasks.clear();
+            m_rootTasks.clear();
+            m_pendingDepsPre.clear();
+            m_pendingDepsSucc.clear();
+            m_pendingScopedDeps.clear();
+            m_resolvedDepsPre.clear();
+            m_resolvedDepsSucc.clear();
+            m_resolvedScopedDeps.clear();
+            m_graphChanged = true;
+        }
+
+        void TaskQueue::removeTasksFrom( TaskId first )
+        {
+            CORE_ASSERT( m_processingTasks == 0, "You have tasks still in process" );
+            CORE_ASSERT( m_unfinishedTasks == 0, " You have unprocessed tasks " );
+            CORE_ASSERT( first <= m_tasks.size(), "Invalid task" );
+
+            auto isRemoved = [first]( TaskId task ) { return task >= first; };
+            auto removeIds = [&isRemoved]( std::vector<TaskId>& ids )
+            {
+                ids.erase( std::remove_if( ids.begin(), ids.end(), isRemoved ), ids.end() );
+            };
+
+            m_tasks.resize( first );
+            m_dependencies.resize( first );
+            m_numPredecessors.resize( first );
+            m_taskScopes.resize( first );
+            m_timerData.resize( first );
+
+            // The kept tasks may have waited for removed ones : count their predecessors again.
+            std::fill( m_numPredecessors.begin(), m_numPredecessors.end(), 0 );
+            for ( auto& successors : m_dependencies )
+            {
+                removeIds( successors );
+                for ( TaskId successor : successors )
+                {
+                    ++m_numPredecessors[successor];
+                }
+            }
+
+            for ( auto it = m_taskNames.begin(); it != m_taskNames.end(); )
+            {
+                removeIds( it->second );
+                it = it->second.empty() ? m_taskNames.erase( it ) : std::next( it );
+            }
+            for ( auto it = m_scopedTaskNames.begin(); it != m_scopedTaskNames.end(); )
+            {
+                removeIds( it->second );
+                it = it->second.empty() ? m_scopedTaskNames.erase( it ) : std::next( it );
+            }
+
+            // The named dependencies of the kept tasks are resolved again, with the tasks
+            // registered next. The dependencies between kept tasks are not added twice.
+            auto keepPre  = [first]( const std::pair<TaskId, std::string>& dep ) { return dep.first < first; };
+            auto keepSucc = [first]( const std::pair<std::string, TaskId>& dep ) { return dep.second < first; };
+            m_pendingDepsPre.erase( std::stable_partition( m_pendingDepsPre.begin(), m_pendingDepsPre.end(), keepPre ), m_pendingDepsPre.end() );
+            m_pendingDepsSucc.erase( std::stable_partition( m_pendingDepsSucc.begin(), m_pendingDepsSucc.end(), keepSucc ), m_pendingDepsSucc.end() );
+            m_pendingScopedDeps.erase( std::stable_partition( m_pendingScopedDeps.begin(), m_pendingScopedDeps.end(), keepSucc ), m_pendingScopedDeps.end() );
+            std::copy_if( m_resolvedDepsPre.begin(), m_resolvedDepsPre.end(), std::back_inserter( m_pendingDepsPre ), keepPre );
+            std::copy_if( m_resolvedDepsSucc.begin(), m_resolvedDepsSucc.end(), std::back_inserter( m_pendingDepsSucc ), keepSucc );
+            std::copy_if( m_resolvedScopedDeps.begin(), m_resolvedScopedDeps.end(), std::back_inserter( m_pendingScopedDeps ), keepSucc );
+            m_resolvedDepsPre.clear();
+            m_resolvedDepsSucc.clear();
+            m_resolvedScopedDeps.clear();
+
+            m_sortedTasks.clear();
+            m_rootTasks.clear();
+            m_graphChanged = true;
+        }
+
+        void TaskQueue::recordTask( TaskQueue::TaskId task ) const
+        {
+            Profiler& profiler = Profiler::getInstance();
+            if ( profiler.isEnabled() )
+            {
+                profiler.record( m_tasks[task]->getName(), m_timerData[task].start, m_timerData[task].end );
+            }
         }
 
         void TaskQueue::runThread( uint id )
         {
+            Profiler::getInstance().setThreadName( "Task worker " + std::to_string( id ) );
             while ( true )
             {
                 TaskId task = InvalidTaskId;
@@ -217,12 +544,12 @@ namespace Ra
                 {
                     std::unique_lock<std::mutex> lock( m_taskQueueMutex );
 
-                    // Wait for a new task
-                    // TODO : use the second form of wait()
-                    while ( !m_shuttingDown && m_taskQueue.empty() )
+                    // Wait for a new task or a parallel loop to help with.
+                    m_threadNotifier.wait( lock, [this]()
                     {
-                        m_threadNotifier.wait( lock );
-                    }
+                        return m_shuttingDown || !m_taskQueue.empty() || findParallelJob( false ) != nullptr;
+                    } );
+
                     // If the task queue is shutting down we quit, releasing
                     // the lock.
                     if ( m_shuttingDown )
@@ -230,43 +557,232 @@ namespace Ra
                         return;
                     }
 
-                    // If we are here it means we got a task
-                    task = m_taskQueue.back();
-                    m_taskQueue.pop_back();
-                    ++m_processingTasks;
-                    CORE_ASSERT( task != InvalidTaskId && task < m_tasks.size(), "Invalid task" );
+                    // If we are here it means we got a task or a job.
+                    if ( !m_taskQueue.empty() )
+                    {
+                        task = m_taskQueue.back();
+                        m_taskQueue.pop_back();
+                        ++m_processingTasks;
+                    }
                 }
                 // Release mutex.
 
-                // Run task
-                m_timerData[task].start = Timer::Clock::now();
-                m_tasks[task]->process();
-                m_timerData[task].end = Timer::Clock::now();
+                if ( task != InvalidTaskId )
+                {
+                    processTask( task );
+                }
+                else
+                {
+                    helpParallelFor( false );
+                }
+            } // End of while(true)
+        }
 
-                // Critical section : mark task as finished and en-queue dependencies.
-                uint newTasks = 0;
+        void TaskQueue::processTask( TaskQueue::TaskId task )
+        {
+            CORE_ASSERT( task != InvalidTaskId && task < m_tasks.size(), "Invalid task" );
+
+            // Run task
+            g_runningTaskQueue = this;
+            m_timerData[task].start = Timer::Clock::now();
+            m_tasks[task]->process();
+            m_timerData[task].end = Timer::Clock::now();
+            g_runningTaskQueue = nullptr;
+            recordTask( task );
+
+            // Critical section : mark task as finished and en-queue dependencies.
+            uint newTasks = 0;
+            bool finished = false;
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                for ( auto t : m_dependencies[task] )
                 {
-                    std::unique_lock<std::mutex> lock( m_taskQueueMutex );
-                    for ( auto t : m_dependencies[task] )
+                    CORE_ASSERT( m_remainingDependencies[t] > 0, "Inconsistency in dependencies" );
+                    const uint nDepends = --m_remainingDependencies[t];
+                    if ( nDepends == 0 )
                     {
-                        uint& nDepends = m_remainingDependencies[t];
-                        CORE_ASSERT( nDepends > 0, "Inconsistency in dependencies" );
-                        --nDepends;
-                        if ( nDepends == 0 )
-                        {
-                            queueTask( t );
-                            ++newTasks;
-                        }
-                        // TODO :Easy optimization : grab one of the new task and process it immediately.
+                        queueTask( t );
+                        ++newTasks;
                     }
-                    --m_processingTasks;
+                    // TODO :Easy optimization : grab one of the new task and process it immediately.
+                }
+                --m_processingTasks;
+                --m_unfinishedTasks;
+                finished = ( m_taskQueue.empty() && m_processingTasks == 0 );
+            }
+            // If we added new tasks, we wake up one thread to execute it.
+            if ( newTasks > 0 )
+            {
+                m_threadNotifier.notify_one();
+            }
+            if ( finished )
+            {
+                notifyTasksDone();
+            }
+        }
+
+        void TaskQueue::processTaskWorkStealing( TaskQueue::TaskId task, uint threadId )
+        {
+            CORE_ASSERT( task != InvalidTaskId && task < m_tasks.size(), "Invalid task" );
+
+            g_runningTaskQueue = this;
+            m_timerData[task].start = Timer::Clock::now();
+            m_tasks[task]->process();
+            m_timerData[task].end = Timer::Clock::now();
+            g_runningTaskQueue = nullptr;
+            recordTask( task );
+
+            // The last predecessor to finish is the one which queues the successor,
+            // so no lock is needed on the counters.
+            for ( auto t : m_dependencies[task] )
+            {
+                CORE_ASSERT( m_remainingDependencies[t] > 0, "Inconsistency in dependencies" );
+                if ( --m_remainingDependencies[t] == 0 )
+                {
+                    queueTaskLocal( t, threadId );
+                }
+            }
+            if ( --m_unfinishedTasks == 0 )
+            {
+                notifyTasksDone();
+            }
+        }
+
+        void TaskQueue::runThreadWorkStealing( uint id )
+        {
+            Profiler::getInstance().setThreadName( "Task worker " + std::to_string( id ) );
+            while ( true )
+            {
+                const TaskId task = fetchTask( id );
+                if ( task != InvalidTaskId )
+                {
+                    processTaskWorkStealing( task, id );
+                    continue;
+                }
+                if ( helpParallelFor( false ) )
+                {
+                    continue;
+                }
+
+                // Nothing to do or to steal : go to sleep until a task is queued.
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                ++m_sleepingThreads;
+                while ( !m_shuttingDown && m_queuedTasks == 0 && findParallelJob( false ) == nullptr )
+                {
+                    m_threadNotifier.wait( lock );
                 }
-                // If we added new tasks, we wake up one thread to execute it.
-                if ( newTasks > 0 )
+                --m_sleepingThreads;
+
+                // If the task queue is shutting down we quit, releasing
+                // the lock.
+                if ( m_shuttingDown )
                 {
-                    m_threadNotifier.notify_one();
+                    return;
                 }
             } // End of while(true)
         }
+
+        void TaskQueue::parallelFor( uint begin, uint end, uint grainSize,
+                                     const std::function<void( uint, uint )>& func )
+        {
+            if ( end <= begin )
+            {
+                return;
+            }
+            grainSize = std::max( grainSize, 1u );
+            if ( end - begin <= grainSize )
+            {
+                func( begin, end );
+                return;
+            }
+
+            ParallelForJob job( begin, end, grainSize, func, g_runningTaskQueue == this );
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                m_parallelJobs.push_back( &job );
+            }
+            m_threadNotifier.notify_all();
+
+            while ( runParallelForChunk( job ) )
+            {
+            }
+
+            // No thread can start helping once the job is out of the list. Then sleep until
+            // the last chunks running on the other threads are done, which is at most one
+            // chunk per thread.
+            std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+            auto it = std::find( m_parallelJobs.begin(), m_parallelJobs.end(), &job );
+            if ( it != m_parallelJobs.end() )
+            {
+                m_parallelJobs.erase( it );
+            }
+            job.m_released.wait( lock, [&job]() { return job.m_users == 0; } );
+        }
+
+        bool TaskQueue::runParallelForChunk( ParallelForJob& job )
+        {
+            const uint start = job.m_next.fetch_add( job.m_grainSize );
+            if ( start >= job.m_end )
+            {
+                return false;
+            }
+            job.m_func( start, std::min( start + job.m_grainSize, job.m_end ) );
+            return true;
+        }
+
+        TaskQueue::ParallelForJob* TaskQueue::findParallelJob( bool tasksOnly ) const
+        {
+            // A job started outside of the tasks can take long chunks, it is left alone while
+            // tasks are running.
+            const bool helpAll = !tasksOnly && m_unfinishedTasks == 0;
+            for ( auto it = m_parallelJobs.rbegin(); it != m_parallelJobs.rend(); ++it )
+            {
+                if ( helpAll || ( *it )->m_fromTask )
+                {
+                    return *it;
+                }
+            }
+            return nullptr;
+        }
+
+        bool TaskQueue::helpParallelFor( bool tasksOnly )
+        {
+            ParallelForJob* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+                job = findParallelJob( tasksOnly );
+                if ( job == nullptr )
+                {
+                    return false;
+                }
+                ++job->m_users;
+            }
+
+            // Loops nested in the chunks belong to the tasks if the job does.
+            const TaskQueue* runningTaskQueue = g_runningTaskQueue;
+            g_runningTaskQueue = job->m_fromTask ? this : nullptr;
+            while ( ( job->m_fromTask || m_unfinishedTasks == 0 ) && runParallelForChunk( *job ) )
+            {
+            }
+            g_runningTaskQueue = runningTaskQueue;
+
+            // If the job has no chunk left, take it out of the list so that idle threads go to sleep.
+            // The caller may destroy the job as soon as the lock is released after the last user
+            // signaled it, so it is not touched after that.
+            std::unique_lock<std::mutex> lock( m_taskQueueMutex );
+            if ( job->m_next >= job->m_end )
+            {
+                auto it = std::find( m_parallelJobs.begin(), m_parallelJobs.end(), job );
+                if ( it != m_parallelJobs.end() )
+                {
+                    m_parallelJobs.erase( it );
+                }
+            }
+            if ( --job->m_users == 0 )
+            {
+                job->m_released.notify_all();
+            }
+            return true;
+        }
     }
 }
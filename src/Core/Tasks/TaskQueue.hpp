@@ -3,6 +3,8 @@
 
 
 #include <Core/RaCore.hpp>
+#include <atomic>
+#include <map>
 #include <memory>
 #include <vector>
 #include <deque>
@@ -10,6 +12,7 @@
 #include <mutex>
 #include <string>
 #include <condition_variable>
+#include <functional>
 
 #include <Core/Time/Timer.hpp>
 
@@ -31,6 +34,16 @@ namespace Ra
         /// Task are allowed to have dependencies. A task will be executed only when all its dependencies
         /// are satisfied, i.e. all dependant tasks are finished.
         /// Note that most functions are not thread safe and must not be called when the task queue is running.
+        /// Tasks are kept until flushTaskQueue() is called, so the same task graph can be run
+        /// several times by calling startTasks() again : the graph is only sorted again when
+        /// tasks or dependencies are added.
+        /// Two scheduling policies are available : a single queue shared by all the threads, or a
+        /// work-stealing scheduler where each thread owns a deque of ready tasks and steals from the
+        /// others when it runs out of work.
+        /// The threads of the task queue can also be used for data-parallel loops with parallelFor(),
+        /// either from a running task or from any other thread. Only the loops of the tasks are
+        /// helped with while tasks are running, so that a loop started by another thread, e.g. a
+        /// file loader, does not delay them.
         class RA_CORE_API TaskQueue
         {
         public:
@@ -38,6 +51,13 @@ namespace Ra
             typedef uint TaskId;
             enum { InvalidTaskId = TaskId( -1 ) };
 
+            /// Policy used to dispatch the ready tasks to the threads.
+            enum class SchedulingMode
+            {
+                SHARED_QUEUE, ///< One global queue protected by a mutex.
+                WORK_STEALING ///< One deque per thread, idle threads steal from the others.
+            };
+
             /// Record of a task's start and end time.
             struct TimerData
             {
@@ -49,7 +69,7 @@ namespace Ra
         public:
 
             /// Constructor. Initializes the thread pools with numThreads threads.
-            TaskQueue( uint numThreads );
+            explicit TaskQueue( uint numThreads, SchedulingMode mode = SchedulingMode::SHARED_QUEUE );
 
             /// Destructor. Waits for all the threads and saefly deletes them.
             ~TaskQueue();
@@ -63,6 +83,10 @@ namespace Ra
             /// The task queue assumes ownership of the task.
             TaskId registerTask( Task* task );
 
+            /// Registers a task working on the given scope, e.g. the entity of its component.
+            /// Scoped dependencies only link tasks of the same scope.
+            TaskId registerTask( Task* task, const void* scope );
+
             /// Add dependency between two tasks. The successor task will be executed only when all
             /// its predecessor completed.
             void addDependency( TaskId predecessor, TaskId successor );
@@ -77,16 +101,25 @@ namespace Ra
             void addPendingDependency( const std::string& predecessors, TaskId successor);
             void addPendingDependency( TaskId predecessor, const std::string& successors);
 
+            /// Add a dependency between the tasks with a given name and the same scope as the
+            /// successor, resolved when the tasks start like the pending dependencies.
+            /// Tasks of other scopes do not wait for each other, and the dependency may resolve
+            /// to no task at all (e.g. an entity without this kind of task).
+            void addPendingScopedDependency( const std::string& predecessors, TaskId successor );
+
             //
             // Task queue operations
             //
 
             /// Launches the execution of all the threads in the task queue.
             /// No more tasks should be added at this point.
+            /// Can be called again once waitForTasks() returned to run the same tasks again.
             void startTasks();
 
             /// Blocks until all tasks and dependencies are finished.
-            void waitForTasks();
+            /// The calling thread sleeps until the last task signals completion. If runTasks
+            /// is true, it also executes ready tasks while waiting, acting as an extra worker.
+            void waitForTasks( bool runTasks = false );
 
             /// Access the data from the last frame execution after processTaskQueue();
             const std::vector<TimerData>& getTimerData();
@@ -94,22 +127,117 @@ namespace Ra
             /// Erases all tasks. Will assert if tasks are unprocessed.
             void flushTaskQueue();
 
+            /// Erases the tasks registered from the given one on, keeping the previous tasks and the
+            /// dependencies between them, so that the end of the graph can be generated again.
+            /// The pending dependencies of the kept tasks are resolved again with the new tasks
+            /// when the tasks start. Will assert if tasks are unprocessed.
+            void removeTasksFrom( TaskId first );
+
+            /// Calls func( chunkBegin, chunkEnd ) on consecutive sub-ranges of [begin, end) of at
+            /// most grainSize elements, using the idle threads of the task queue. The calling thread
+            /// runs chunks too and returns when the whole range has been processed. Can be called
+            /// from inside a task.
+            /// When called from outside the tasks, the worker threads only help while no tasks are
+            /// running and waitForTasks() never runs its chunks.
+            void parallelFor( uint begin, uint end, uint grainSize,
+                              const std::function<void( uint, uint )>& func );
+
+            /// Returns the number of registered tasks. The next task will get this id.
+            uint getNumTasks() const { return uint( m_tasks.size() ); }
+
+            /// Returns the number of worker threads.
+            uint getNumThreads() const { return uint( m_workerThreads.size() ); }
+
+            /// Returns the scheduling policy of this task queue.
+            SchedulingMode getSchedulingMode() const { return m_mode; }
+
+        private:
+            /// Ready tasks owned by one thread in work-stealing mode.
+            /// The owner pushes and pops at the back, thieves take from the front.
+            struct WorkerQueue
+            {
+                std::deque<TaskId> m_tasks;
+                std::mutex m_mutex;
+            };
+
+            /// A parallelFor() loop being processed. Threads take chunks by incrementing m_next.
+            /// The job lives on the stack of the thread calling parallelFor(), which waits on
+            /// m_released until no other thread uses it.
+            struct ParallelForJob
+            {
+                ParallelForJob( uint begin, uint end, uint grainSize,
+                                const std::function<void( uint, uint )>& func, bool fromTask )
+                    : m_func( func ), m_end( end ), m_grainSize( grainSize ), m_fromTask( fromTask )
+                    , m_next( begin ), m_users( 0 ) {}
+
+                const std::function<void( uint, uint )>& m_func;
+                const uint m_end;
+                const uint m_grainSize;
+                /// True if the loop was started by a task of this queue, or by a loop of such a task.
+                const bool m_fromTask;
+                /// Start of the next chunk to process.
+                std::atomic<uint> m_next;
+                /// Number of threads helping with this job, protected by m_taskQueueMutex.
+                uint m_users;
+                /// Signaled when the last helping thread stops using the job.
+                std::condition_variable m_released;
+            };
+
         private:
 
             /// Function called by a new thread.
             void runThread( uint id );
 
+            /// Processes one chunk of the job. Returns false if there was no chunk left.
+            bool runParallelForChunk( ParallelForJob& job );
+
+            /// Helps on a pending parallelFor() job until it has no chunk left, or until tasks
+            /// start for a job which is not from a task. If tasksOnly is true, only the jobs
+            /// started by tasks are considered. Returns false if there was no job to help with.
+            bool helpParallelFor( bool tasksOnly );
+
+            /// Returns the most recent job that can be helped with, or nullptr.
+            /// Must be called with m_taskQueueMutex locked.
+            ParallelForJob* findParallelJob( bool tasksOnly ) const;
+
+            /// Runs a task, then en-queues its successors which have no dependencies left.
+            void processTask( TaskId task );
+
+            /// Records the execution of a task in the profiler, if it is enabled.
+            void recordTask( TaskId task ) const;
+
+            /// Wakes up the threads waiting for all the tasks to finish.
+            void notifyTasksDone();
+
+            /// Function called by a new thread in work-stealing mode.
+            void runThreadWorkStealing( uint id );
+
             /// Puts the task on the queue to be executed. A task can only be queued if it has
             /// no dependencies.
             void queueTask( TaskId task );
 
-            /// Detect if there are any cycles in the task graph, and asserts if it is the case.
-            /// (this function is compiled to nothing in release).
-            void detectCycles();
+            /// Puts the task on the deque of the given thread (work-stealing mode only).
+            void queueTaskLocal( TaskId task, uint threadId );
+
+            /// Pops a task from the thread's own deque, or steals one from another thread.
+            /// Returns InvalidTaskId if no ready task was found.
+            TaskId fetchTask( uint threadId );
+
+            /// Runs a task and decrements the dependency counters of its successors.
+            /// Newly ready tasks are pushed on the deque of the given thread.
+            void processTaskWorkStealing( TaskId task, uint threadId );
+
+            /// Sorts the task graph topologically and caches the tasks with no dependencies.
+            /// Asserts if there are any cycles in the task graph.
+            void sortTasks();
 
             /// Resolves the pending named dependencies. Will assert if dependencies don't resolve.
             void resolveDependencies();
 
+            /// Adds a dependency unless the tasks are already linked, e.g. by a pending dependency
+            /// which is resolved again after removeTasksFrom().
+            void addDependencyOnce( TaskId predecessor, TaskId successor );
+
         private:
 
             /// Threads working on tasks.
@@ -118,29 +246,71 @@ namespace Ra
             std::vector<std::unique_ptr<Task>> m_tasks;
             /// For each task, stores which tasks depend on it.
             std::vector<std::vector <TaskId>> m_dependencies;
+            /// For each task, the number of tasks it depends on.
+            std::vector<uint> m_numPredecessors;
+            /// Tasks ids for each task name, used to resolve named dependencies.
+            std::map<std::string, std::vector<TaskId>> m_taskNames;
+            /// Scope of each task, null if it was registered without one.
+            std::vector<const void*> m_taskScopes;
+            /// Tasks ids for each task name and scope, used to resolve scoped dependencies.
+            std::map<std::pair<std::string, const void*>, std::vector<TaskId>> m_scopedTaskNames;
+            /// Tasks in topological order.
+            std::vector<TaskId> m_sortedTasks;
+            /// Tasks with no dependencies, started first.
+            std::vector<TaskId> m_rootTasks;
+            /// True if tasks or dependencies were added since the last sort.
+            bool m_graphChanged;
 
             /// List of pending dependencies
             std::vector<std::pair<TaskId,std::string>> m_pendingDepsPre;
             std::vector<std::pair<std::string,TaskId>> m_pendingDepsSucc;
+            std::vector<std::pair<std::string,TaskId>> m_pendingScopedDeps;
+
+            /// Pending dependencies already resolved, kept for removeTasksFrom().
+            std::vector<std::pair<TaskId,std::string>> m_resolvedDepsPre;
+            std::vector<std::pair<std::string,TaskId>> m_resolvedDepsSucc;
+            std::vector<std::pair<std::string,TaskId>> m_resolvedScopedDeps;
 
             /// Stores the timings of each frame after execution.
             std::vector<TimerData> m_timerData;
 
+            /// Number of tasks each task is still waiting on, reset when the tasks start.
+            std::vector<std::atomic<uint>> m_remainingDependencies;
+
+            //
+            // work-stealing variables.
+            //
+
+            /// Per-thread deques of ready tasks. The last one belongs to the thread
+            /// calling waitForTasks().
+            std::vector<std::unique_ptr<WorkerQueue>> m_workerQueues;
+            /// Number of tasks sitting in the worker deques.
+            std::atomic<uint> m_queuedTasks;
+            /// Number of threads waiting on the notifier.
+            std::atomic<uint> m_sleepingThreads;
+
+            /// Number of tasks not finished yet, in both modes.
+            std::atomic<uint> m_unfinishedTasks;
+
             //
             // mutex protected variables.
             //
 
-            /// Number of tasks each task is waiting on.
-            std::vector<uint> m_remainingDependencies;
             /// Queue holding the pending tasks.
             std::deque<TaskId> m_taskQueue;
+            /// parallelFor() jobs which still have chunks to process.
+            std::vector<ParallelForJob*> m_parallelJobs;
             /// Number of tasks currently being processed.
             uint m_processingTasks;
 
+            /// Scheduling policy.
+            const SchedulingMode m_mode;
             /// Flag to signal threads to quit.
-            bool m_shuttingDown;
+            std::atomic<bool> m_shuttingDown;
             /// Variable on which threads wait for new tasks.
             std::condition_variable m_threadNotifier;
+            /// Variable on which waitForTasks() waits for the last task to finish.
+            std::condition_variable m_doneNotifier;
             /// Global mutex over thread-sensitive variables.
             std::mutex m_taskQueueMutex;
 
@@ -0,0 +1,201 @@
+#include <Core/Time/FrameStats.hpp>
+
+#include <Core/CoreMacros.hpp>
+#include <Core/String/StringUtils.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            const double NO_DURATION = std::numeric_limits<double>::quiet_NaN();
+
+            void writeCsvSummaryRow( std::ostream& out, const std::string& series, const FrameStats::Summary& s )
+            {
+                out << StringUtils::toCsvField( series ) << ',' << s.count << ',' << s.min << ',' << s.mean << ','
+                    << s.p50 << ',' << s.p90 << ',' << s.p95 << ',' << s.p99 << ',' << s.max << '\n';
+            }
+        }
+
+        void FrameStats::beginFrame( uint frame )
+        {
+            m_frames.push_back( frame );
+            m_durations.emplace_back();
+        }
+
+        void FrameStats::add( const std::string& series, double milliseconds )
+        {
+            CORE_ASSERT( !m_frames.empty(), "No frame was started" );
+
+            auto it = m_seriesIndex.find( series );
+            if ( it == m_seriesIndex.end() )
+            {
+                it = m_seriesIndex.insert( std::make_pair( series, uint( m_series.size() ) ) ).first;
+                m_series.push_back( series );
+            }
+
+            std::vector<double>& durations = m_durations.back();
+            if ( durations.size() <= it->second )
+            {
+                durations.resize( it->second + 1, NO_DURATION );
+            }
+
+            double& d = durations[it->second];
+            d = std::isnan( d ) ? milliseconds : d + milliseconds;
+        }
+
+        FrameStats::Summary FrameStats::getSummary( const std::string& series ) const
+        {
+            Summary s = { 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+            auto it = m_seriesIndex.find( series );
+            if ( it == m_seriesIndex.end() )
+            {
+                return s;
+            }
+
+            std::vector<double> values;
+            values.reserve( m_durations.size() );
+            for ( const auto& durations : m_durations )
+            {
+                if ( it->second < durations.size() && !std::isnan( durations[it->second] ) )
+                {
+                    values.push_back( durations[it->second] );
+                }
+            }
+            if ( values.empty() )
+            {
+                return s;
+            }
+
+            double sum = 0.0;
+            for ( double v : values )
+            {
+                sum += v;
+            }
+
+            s.count = values.size();
+            s.mean = sum / values.size();
+            s.p50 = percentile( values, 50.0 );
+            s.p90 = percentile( values, 90.0 );
+            s.p95 = percentile( values, 95.0 );
+            s.p99 = percentile( values, 99.0 );
+            s.min = values.front();
+            s.max = values.back();
+            return s;
+        }
+
+        void FrameStats::clear()
+        {
+            m_frames.clear();
+            m_series.clear();
+            m_seriesIndex.clear();
+            m_durations.clear();
+        }
+
+        void FrameStats::writeJson( std::ostream& out ) const
+        {
+            out << "{\n\"unit\":\"ms\",\n\"numFrames\":" << m_frames.size() << ",\n\"summary\":{";
+            for ( uint i = 0; i < m_series.size(); ++i )
+            {
+                const Summary s = getSummary( m_series[i] );
+                out << ( i == 0 ? "\n" : ",\n" ) << StringUtils::toJsonString( m_series[i] )
+                    << ":{\"count\":" << s.count << ",\"min\":" << s.min << ",\"mean\":" << s.mean
+                    << ",\"p50\":" << s.p50 << ",\"p90\":" << s.p90 << ",\"p95\":" << s.p95
+                    << ",\"p99\":" << s.p99 << ",\"max\":" << s.max << "}";
+            }
+
+            out << "\n},\n\"frames\":[";
+            for ( uint f = 0; f < m_frames.size(); ++f )
+            {
+                out << ( f == 0 ? "\n" : ",\n" ) << "{\"frame\":" << m_frames[f];
+                const std::vector<double>& durations = m_durations[f];
+                for ( uint i = 0; i < durations.size(); ++i )
+                {
+                    if ( !std::isnan( durations[i] ) )
+                    {
+                        out << "," << StringUtils::toJsonString( m_series[i] ) << ":" << durations[i];
+                    }
+                }
+                out << "}";
+            }
+            out << "\n]\n}\n";
+        }
+
+        void FrameStats::writeCsv( std::ostream& out ) const
+        {
+            out << "frame";
+            for ( const auto& series : m_series )
+            {
+                out << ',' << StringUtils::toCsvField( series );
+            }
+            out << '\n';
+
+            for ( uint f = 0; f < m_frames.size(); ++f )
+            {
+                out << m_frames[f];
+                const std::vector<double>& durations = m_durations[f];
+                for ( uint i = 0; i < m_series.size(); ++i )
+                {
+                    out << ',';
+                    if ( i < durations.size() && !std::isnan( durations[i] ) )
+                    {
+                        out << durations[i];
+                    }
+                }
+                out << '\n';
+            }
+        }
+
+        void FrameStats::writeCsvSummary( std::ostream& out ) const
+        {
+            out << "series,count,min,mean,p50,p90,p95,p99,max\n";
+            for ( const auto& series : m_series )
+            {
+                writeCsvSummaryRow( out, series, getSummary( series ) );
+            }
+        }
+
+        bool FrameStats::write( const std::string& filename ) const
+        {
+            std::ofstream file( filename );
+            if ( !file )
+            {
+                return false;
+            }
+
+            if ( StringUtils::getFileExt( filename ) != "csv" )
+            {
+                writeJson( file );
+                return bool( file );
+            }
+
+            writeCsv( file );
+            const std::string summaryName = filename.substr( 0, filename.size() - 4 ) + ".summary.csv";
+            std::ofstream summary( summaryName );
+            if ( !summary )
+            {
+                return false;
+            }
+            writeCsvSummary( summary );
+            return file && summary;
+        }
+
+        double FrameStats::percentile( std::vector<double>& values, double p )
+        {
+            CORE_ASSERT( !values.empty(), "No values" );
+            std::sort( values.begin(), values.end() );
+
+            const double rank = std::min( std::max( p, 0.0 ), 100.0 ) / 100.0 * ( values.size() - 1 );
+            const uint below = uint( rank );
+            const uint above = std::min( below + 1, uint( values.size() - 1 ) );
+            const double t = rank - below;
+            return ( 1.0 - t ) * values[below] + t * values[above];
+        }
+    }
+}
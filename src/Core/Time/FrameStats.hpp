@@ -0,0 +1,88 @@
+#ifndef RADIUMENGINE_FRAME_STATS_HPP
+#define RADIUMENGINE_FRAME_STATS_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Time/Timer.hpp>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Per frame durations of named series (frame, tasks, systems, render passes...),
+        /// with their statistics, to be written in machine-readable formats.
+        /// Durations are in milliseconds.
+        class RA_CORE_API FrameStats
+        {
+        public:
+            /// Statistics of a series over the frames where it has a value.
+            struct Summary
+            {
+                uint count;
+                double min;
+                double max;
+                double mean;
+                double p50;
+                double p90;
+                double p95;
+                double p99;
+            };
+
+            /// Starts the durations of a new frame.
+            void beginFrame( uint frame );
+
+            /// Adds a duration to a series in the current frame. The durations added
+            /// several times to a series in a frame are summed (e.g. several tasks of a system).
+            void add( const std::string& series, double milliseconds );
+            inline void add( const std::string& series, const Timer::TimePoint& start, const Timer::TimePoint& end );
+
+            inline uint getNumFrames() const;
+
+            /// Names of the series, in the order of their first duration.
+            inline const std::vector<std::string>& getSeries() const;
+
+            /// Statistics of a series. The count is 0 if the series does not exist.
+            Summary getSummary( const std::string& series ) const;
+
+            void clear();
+
+            /// Writes the statistics of the series and the durations of each frame in
+            /// a JSON object.
+            void writeJson( std::ostream& out ) const;
+
+            /// Writes one row per frame and one column per series, empty when the series
+            /// has no duration in the frame.
+            void writeCsv( std::ostream& out ) const;
+
+            /// Writes one row per series with its statistics.
+            void writeCsvSummary( std::ostream& out ) const;
+
+            /// Writes the durations in the given file, as CSV if its extension is csv
+            /// (the statistics are then written next to it, in <name>.summary.csv) and
+            /// as JSON otherwise. Returns false if a file could not be written.
+            bool write( const std::string& filename ) const;
+
+            /// Returns the p-th percentile (p in [0,100]) of the values, interpolated
+            /// between the closest ranks. The values are sorted in place.
+            static double percentile( std::vector<double>& values, double p );
+
+        private:
+            /// Numbers of the frames.
+            std::vector<uint> m_frames;
+            std::vector<std::string> m_series;
+            std::map<std::string, uint> m_seriesIndex;
+            /// Durations of each frame, indexed by series. A row is shorter than the
+            /// number of series if the last series have no duration, and NaN marks
+            /// missing durations.
+            std::vector<std::vector<double>> m_durations;
+        };
+    }
+}
+
+#include <Core/Time/FrameStats.inl>
+
+#endif // RADIUMENGINE_FRAME_STATS_HPP
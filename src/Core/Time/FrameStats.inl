@@ -0,0 +1,23 @@
+#include <Core/Time/FrameStats.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        inline void FrameStats::add( const std::string& series, const Timer::TimePoint& start,
+                                     const Timer::TimePoint& end )
+        {
+            add( series, std::chrono::duration<double, std::milli>( end - start ).count() );
+        }
+
+        inline uint FrameStats::getNumFrames() const
+        {
+            return m_frames.size();
+        }
+
+        inline const std::vector<std::string>& FrameStats::getSeries() const
+        {
+            return m_series;
+        }
+    }
+}
@@ -0,0 +1,263 @@
+#include <Core/Time/Profiler.hpp>
+
+#include <Core/String/StringUtils.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            uint roundUpToPowerOfTwo( uint n )
+            {
+                uint p = 2;
+                while ( p < n )
+                {
+                    p *= 2;
+                }
+                return p;
+            }
+
+            long long toMicroSeconds( const Timer::TimePoint& t )
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>( t.time_since_epoch() ).count();
+            }
+
+            std::atomic<uint> g_nextProfilerId( 1 );
+
+            /// Flags of the buffers used by the calling thread, cleared when it exits.
+            /// They are shared with the buffers, which may be destroyed first.
+            struct ThreadExitFlags
+            {
+                ~ThreadExitFlags()
+                {
+                    for ( const auto& flag : m_running )
+                    {
+                        flag->store( false, std::memory_order_release );
+                    }
+                }
+
+                std::vector<std::shared_ptr<std::atomic<bool>>> m_running;
+            };
+        }
+
+        struct Profiler::ThreadBuffer
+        {
+            /// Ring buffer of events, allocated by the thread when it records its first zone.
+            std::unique_ptr<Event[]> m_events;
+            /// Number of events ever written in the buffer.
+            std::atomic<unsigned long long> m_head;
+            std::thread::id m_owner;
+            /// False once the owner thread exited.
+            std::shared_ptr<std::atomic<bool>> m_running;
+            std::string m_name;
+            uint m_index;
+        };
+
+        Profiler::Profiler( uint eventsPerThread )
+            : m_id( g_nextProfilerId.fetch_add( 1 ) )
+            , m_capacity( eventsPerThread )
+            , m_slots( roundUpToPowerOfTwo( eventsPerThread + 1 ) )
+            , m_enabled( false )
+        {
+        }
+
+        Profiler::~Profiler()
+        {
+        }
+
+        Profiler& Profiler::getInstance()
+        {
+            static Profiler profiler;
+            return profiler;
+        }
+
+        void Profiler::setEnabled( bool enabled )
+        {
+            m_enabled.store( enabled, std::memory_order_relaxed );
+        }
+
+        Profiler::ThreadBuffer* Profiler::getThreadBuffer()
+        {
+            // Each thread remembers the buffer of the last profiler it used.
+            static thread_local uint cachedProfiler = 0;
+            static thread_local ThreadBuffer* cachedBuffer = nullptr;
+            if ( cachedProfiler == m_id )
+            {
+                return cachedBuffer;
+            }
+
+            std::lock_guard<std::mutex> lock( m_mutex );
+            const std::thread::id self = std::this_thread::get_id();
+            auto it = std::find_if( m_buffers.begin(), m_buffers.end(), [self]( const std::unique_ptr<ThreadBuffer>& b )
+            {
+                return b->m_owner == self && b->m_running->load( std::memory_order_acquire );
+            } );
+
+            ThreadBuffer* buffer;
+            if ( it != m_buffers.end() )
+            {
+                buffer = it->get();
+            }
+            else
+            {
+                // Take over the buffer of a thread which exited, or create one. The events of
+                // the previous thread stay in the buffer until they are overwritten.
+                it = std::find_if( m_buffers.begin(), m_buffers.end(), []( const std::unique_ptr<ThreadBuffer>& b )
+                {
+                    return !b->m_running->load( std::memory_order_acquire );
+                } );
+                if ( it != m_buffers.end() )
+                {
+                    buffer = it->get();
+                }
+                else
+                {
+                    buffer = new ThreadBuffer;
+                    buffer->m_head.store( 0 );
+                    buffer->m_index = m_buffers.size();
+                    m_buffers.emplace_back( buffer );
+                }
+                buffer->m_owner = self;
+                buffer->m_running = std::make_shared<std::atomic<bool>>( true );
+                buffer->m_name = "Thread " + std::to_string( buffer->m_index );
+
+                static thread_local ThreadExitFlags exitFlags;
+                exitFlags.m_running.push_back( buffer->m_running );
+            }
+
+            cachedProfiler = m_id;
+            cachedBuffer = buffer;
+            return buffer;
+        }
+
+        void Profiler::record( const char* name, const Timer::TimePoint& start, const Timer::TimePoint& end )
+        {
+            ThreadBuffer* buffer = getThreadBuffer();
+            if ( !buffer->m_events )
+            {
+                // The readers only access the events while holding the lock.
+                std::lock_guard<std::mutex> lock( m_mutex );
+                buffer->m_events.reset( new Event[m_slots] );
+            }
+
+            // Only this thread writes in the buffer.
+            const unsigned long long pos = buffer->m_head.load( std::memory_order_relaxed );
+            Event& event = buffer->m_events[pos & ( m_slots - 1 )];
+            event.m_start = toMicroSeconds( start );
+            event.m_end = toMicroSeconds( end );
+            event.m_thread = buffer->m_index;
+            std::strncpy( event.m_name, name, NAME_SIZE - 1 );
+            event.m_name[NAME_SIZE - 1] = '\0';
+            buffer->m_head.store( pos + 1, std::memory_order_release );
+        }
+
+        void Profiler::setThreadName( const std::string& name )
+        {
+            ThreadBuffer* buffer = getThreadBuffer();
+            std::lock_guard<std::mutex> lock( m_mutex );
+            buffer->m_name = name;
+        }
+
+        void Profiler::getEvents( const Timer::TimePoint& begin, const Timer::TimePoint& end,
+                                  std::vector<Event>& events ) const
+        {
+            const long long windowStart = toMicroSeconds( begin );
+            const long long windowEnd = toMicroSeconds( end );
+            const size_t firstEvent = events.size();
+
+            std::lock_guard<std::mutex> lock( m_mutex );
+            std::vector<Event> copy;
+            for ( const auto& buffer : m_buffers )
+            {
+                if ( !buffer->m_events )
+                {
+                    continue;
+                }
+
+                const unsigned long long head = buffer->m_head.load( std::memory_order_acquire );
+                const unsigned long long first = head > m_capacity ? head - m_capacity : 0;
+                copy.clear();
+                for ( unsigned long long i = first; i < head; ++i )
+                {
+                    copy.push_back( buffer->m_events[i & ( m_slots - 1 )] );
+                }
+
+                // The thread may have overwritten the oldest events while they were copied,
+                // and may be writing the event at newHead.
+                std::atomic_thread_fence( std::memory_order_acquire );
+                const unsigned long long newHead = buffer->m_head.load( std::memory_order_relaxed );
+                const unsigned long long valid = newHead + 1 > m_slots ? newHead + 1 - m_slots : 0;
+
+                for ( unsigned long long i = std::max( first, valid ); i < head; ++i )
+                {
+                    const Event& event = copy[i - first];
+                    if ( event.m_end >= windowStart && event.m_start <= windowEnd )
+                    {
+                        events.push_back( event );
+                    }
+                }
+            }
+
+            std::sort( events.begin() + firstEvent, events.end(), []( const Event& a, const Event& b )
+            {
+                return a.m_start < b.m_start;
+            } );
+        }
+
+        void Profiler::writeChromeTrace( std::ostream& out, const Timer::TimePoint& begin,
+                                         const Timer::TimePoint& end ) const
+        {
+            std::vector<Event> events;
+            getEvents( begin, end, events );
+            const long long origin = toMicroSeconds( begin );
+
+            out << "{\"traceEvents\":[\n";
+
+            // Thread names, for the threads which have events.
+            bool first = true;
+            {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                for ( const auto& buffer : m_buffers )
+                {
+                    if ( !buffer->m_events )
+                    {
+                        continue;
+                    }
+                    out << ( first ? "" : ",\n" )
+                        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->m_index
+                        << ",\"args\":{\"name\":" << StringUtils::toJsonString( buffer->m_name ) << "}}";
+                    first = false;
+                }
+            }
+
+            // Complete events, with their start and duration.
+            for ( const Event& event : events )
+            {
+                out << ( first ? "" : ",\n" ) << "{\"name\":" << StringUtils::toJsonString( event.m_name )
+                    << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.m_thread
+                    << ",\"ts\":" << event.m_start - origin
+                    << ",\"dur\":" << event.m_end - event.m_start << "}";
+                first = false;
+            }
+
+            out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        }
+
+        bool Profiler::writeChromeTrace( const std::string& filename, const Timer::TimePoint& begin,
+                                         const Timer::TimePoint& end ) const
+        {
+            std::ofstream file( filename );
+            if ( !file )
+            {
+                return false;
+            }
+            writeChromeTrace( file, begin, end );
+            return bool( file );
+        }
+    }
+}
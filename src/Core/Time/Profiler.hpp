@@ -0,0 +1,124 @@
+#ifndef RADIUMENGINE_PROFILER_HPP
+#define RADIUMENGINE_PROFILER_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Time/Timer.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// Records timed zones (tasks, rendering steps, file loading...) of all the
+        /// threads, to be exported as a timeline.
+        /// Each thread writes its zones in its own ring buffer, without lock nor
+        /// allocation once the buffer exists, so the buffers only keep the most recent
+        /// zones. Nothing is recorded while the profiler is disabled.
+        /// The buffer of a thread which exited is given to the next new thread, so that
+        /// short-lived threads (e.g. file loaders) do not add a buffer each.
+        class RA_CORE_API Profiler
+        {
+        public:
+            /// Maximum length of a zone name, longer names are truncated.
+            static const uint NAME_SIZE = 48;
+
+            /// A recorded zone.
+            struct Event
+            {
+                /// Start and end time in microseconds since the epoch of Timer::Clock.
+                long long m_start;
+                long long m_end;
+                /// Index of the thread which recorded the zone.
+                uint m_thread;
+                char m_name[NAME_SIZE];
+            };
+
+            /// Creates a profiler keeping the last eventsPerThread zones of each thread.
+            /// The profiler is disabled.
+            explicit Profiler( uint eventsPerThread = 10000 );
+            ~Profiler();
+
+            /// The profiler used by the engine and RA_PROFILE_ZONE().
+            static Profiler& getInstance();
+
+            void setEnabled( bool enabled );
+            inline bool isEnabled() const;
+
+            /// Records a zone of the calling thread.
+            void record( const char* name, const Timer::TimePoint& start, const Timer::TimePoint& end );
+            inline void record( const std::string& name, const Timer::TimePoint& start, const Timer::TimePoint& end );
+
+            /// Sets the name of the calling thread in the timelines.
+            void setThreadName( const std::string& name );
+
+            /// Appends to events the recorded zones which overlap [begin, end],
+            /// sorted by start time.
+            void getEvents( const Timer::TimePoint& begin, const Timer::TimePoint& end,
+                            std::vector<Event>& events ) const;
+
+            /// Writes the zones which overlap [begin, end] in the Chrome trace event
+            /// format (chrome://tracing or Perfetto), with one track per thread.
+            /// Times are relative to begin.
+            void writeChromeTrace( std::ostream& out, const Timer::TimePoint& begin,
+                                   const Timer::TimePoint& end ) const;
+
+            /// Same as above, in a file. Returns false if the file could not be written.
+            bool writeChromeTrace( const std::string& filename, const Timer::TimePoint& begin,
+                                   const Timer::TimePoint& end ) const;
+
+        private:
+            struct ThreadBuffer;
+
+            Profiler( const Profiler& ) = delete;
+            Profiler& operator=( const Profiler& ) = delete;
+
+            /// Returns the buffer of the calling thread, creating it if needed.
+            ThreadBuffer* getThreadBuffer();
+
+        private:
+            /// Buffers of all the threads which used the profiler. A new thread reuses
+            /// the buffer of a thread which exited, keeping its index and its events.
+            std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+            /// Unique id of the profiler, for the buffer cache of the threads.
+            const uint m_id;
+            /// Number of zones kept per thread.
+            const uint m_capacity;
+            /// Size of the ring buffers, a power of two with a slot more than m_capacity
+            /// so that a zone being written is never one of the kept ones.
+            const uint m_slots;
+            std::atomic<bool> m_enabled;
+            mutable std::mutex m_mutex;
+        };
+
+        /// Records the zone from its construction to its destruction in the profiler.
+        class ProfileZone
+        {
+        public:
+            explicit inline ProfileZone( const char* name );
+            inline ~ProfileZone();
+
+        private:
+            ProfileZone( const ProfileZone& ) = delete;
+            ProfileZone& operator=( const ProfileZone& ) = delete;
+
+        private:
+            Timer::TimePoint m_start;
+            const char* m_name;
+            bool m_enabled;
+        };
+    }
+}
+
+/// Records the rest of the current scope as a zone with the given name.
+#define RA_PROFILE_ZONE( NAME ) ::Ra::Core::ProfileZone CONCATENATE( raProfileZone, __LINE__ )( NAME )
+
+#include <Core/Time/Profiler.inl>
+
+#endif // RADIUMENGINE_PROFILER_HPP
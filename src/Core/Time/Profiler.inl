@@ -0,0 +1,36 @@
+#include <Core/Time/Profiler.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        inline bool Profiler::isEnabled() const
+        {
+            return m_enabled.load( std::memory_order_relaxed );
+        }
+
+        inline void Profiler::record( const std::string& name, const Timer::TimePoint& start,
+                                      const Timer::TimePoint& end )
+        {
+            record( name.c_str(), start, end );
+        }
+
+        inline ProfileZone::ProfileZone( const char* name )
+            : m_name( name )
+            , m_enabled( Profiler::getInstance().isEnabled() )
+        {
+            if ( m_enabled )
+            {
+                m_start = Timer::Clock::now();
+            }
+        }
+
+        inline ProfileZone::~ProfileZone()
+        {
+            if ( m_enabled )
+            {
+                Profiler::getInstance().record( m_name, m_start, Timer::Clock::now() );
+            }
+        }
+    }
+}
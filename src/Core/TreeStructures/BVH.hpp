@@ -1,10 +1,9 @@
- 
 #ifndef RADIUMENGINE_BVH_HPP
 #define RADIUMENGINE_BVH_HPP
 
 #include <Core/RaCore.hpp>
 
-#include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
 #include <Core/Math/Frustum.hpp>
 
 #include <vector>
@@ -16,47 +15,38 @@ namespace Ra
 {
     namespace Core
     {
-        /// This class stores a 3-dimensional hierarchy of meshes of arbitrary type.
-        /// Built on a binary tree
+        /// This class stores a 3-dimensional hierarchy of objects of arbitrary type.
+        /// Built on a binary tree which is maintained incrementally : leaves can be
+        /// inserted, moved and removed at any time without rebuilding the whole tree.
+        /// Leaves are stored with a slightly enlarged box, so that small motions of an
+        /// object only update its leaf and do not touch the tree structure.
         template <typename T>
         class BVH
         {
-            class Node {
-            public:
-                inline Node( const std::shared_ptr<T>& t );
+            struct Node
+            {
+                inline Node();
 
-                inline Node( const std::shared_ptr<Node>& l, const std::shared_ptr<Node>& r );
-
-                inline std::shared_ptr<Node> getLeftChild() const;
-                inline std::shared_ptr<Node> getRightChild() const;
-
-                inline Aabb getAabb() const
+                inline bool isLeaf() const
                 {
-                    return m_aabb;
+                    return m_children[0] == INVALID_NODE;
                 }
 
-                inline std::shared_ptr<T> getData()
-                {
-                    return m_data;
-                }
-
-                inline bool isFinal() const
-                {
-                    return m_children.empty();
-                }
-
-            protected:
-                Aabb m_aabb ;
-                std::vector<std::shared_ptr<Node>> m_children ;
+                /// Box used for the tree (enlarged for leaves).
+                Aabb m_aabb;
+                /// Exact box of the object, only used by leaves.
+                Aabb m_tightAabb;
 
                 std::shared_ptr<T> m_data;
+
+                /// Parent node, or next free node when the node is not used.
+                uint m_parent;
+                uint m_children[2];
             };
 
         public:
-            // public types and constants.
-            typedef std::shared_ptr<Node> NodePtr;
-
-            typedef Node * Nodep;
+            /// Handle of a leaf, returned by insertLeaf().
+            static const uint INVALID_NODE = uint( -1 );
 
         public:
             RA_CORE_ALIGNED_NEW
@@ -66,28 +56,63 @@ namespace Ra
             inline BVH( const BVH& other ) = default;
             inline BVH& operator= ( const BVH& other ) = default;
 
-            inline void insertLeaf(const std::shared_ptr<T>& t);
+            /// Insert an object using its own getAabb() box.
+            inline uint insertLeaf( const std::shared_ptr<T>& t );
+
+            /// Insert an object with the given box. Returns the handle of the new leaf.
+            inline uint insertLeaf( const std::shared_ptr<T>& t, const Aabb& aabb );
 
-            //TODO removeLeaf()
+            /// Remove a leaf from the tree. The handle becomes invalid.
+            inline void removeLeaf( uint leaf );
+
+            /// Set the box of a leaf. The tree is only modified if the new box escapes
+            /// the enlarged box of the leaf. Returns true if the leaf has been moved.
+            inline bool updateLeaf( uint leaf, const Aabb& aabb );
 
             inline void clear();
 
-            inline void update();
+            inline bool isEmpty() const
+            {
+                return m_root == INVALID_NODE;
+            }
+
+            inline uint getNumLeaves() const
+            {
+                return m_numLeaves;
+            }
+
+            /// Returns the box enclosing all the objects.
+            inline Aabb getAabb() const;
+
+            /// Append to objects all the objects whose box intersects the frustum.
+            inline void getInFrustum( std::vector<std::shared_ptr<T>>& objects, const Frustum& frustum ) const;
+
+        private:
+            inline uint allocateNode();
+            inline void freeNode( uint node );
+
+            inline void insertInTree( uint leaf );
+            inline void removeFromTree( uint leaf );
 
-            inline void buildBottomUpSlow();
+            /// Recompute the boxes of all the ancestors of node.
+            inline void refitFrom( uint node );
 
-            //TODO void buildBottomUpFast();
+            inline void getSubtree( uint node, std::vector<std::shared_ptr<T>>& objects ) const;
 
-            //TODO void buildTopDown();
+            /// Surface area of a box, used as the insertion cost.
+            static inline Scalar area( const Aabb& aabb );
 
-            void getInFrustumSlow(std::vector<std::shared_ptr<T>> & objects, const Frustum & frustum) const;
+            /// Box stored in the tree for an object box.
+            static inline Aabb enlarged( const Aabb& aabb );
 
-        protected:
-            std::vector<NodePtr> m_leaves;
-            NodePtr m_root;
-            Aabb m_root_aabb;
+            /// Returns 0 if the box is outside the frustum, 2 if it is fully inside and 1 otherwise.
+            static inline int classify( const Aabb& aabb, const Frustum& frustum );
 
-            bool m_upToDate;
+        private:
+            std::vector<Node> m_nodes;
+            uint m_root;
+            uint m_freeList;
+            uint m_numLeaves;
         };
     }
 }
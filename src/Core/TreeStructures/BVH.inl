@@ -1,12 +1,6 @@
 #include <Core/TreeStructures/BVH.hpp>
-#include <Core/Mesh/MeshUtils.hpp>
 
-#include <iostream>
-
-#include <Core/Math/ColorPresets.hpp>
-#include <Engine/Renderer/RenderObject/Primitives/DrawPrimitives.hpp>
-#include <Engine/Renderer/RenderObject/RenderObject.hpp>
-#include <Engine/Renderer/Renderers/DebugRender.hpp>
+#include <algorithm>
 
 namespace Ra
 {
@@ -14,166 +8,333 @@ namespace Ra
     {
 
         template <typename T>
-        inline BVH<T>::Node::Node(const std::shared_ptr<T>& t)
-            :m_aabb(t->getAabb()), m_data(t)
+        inline BVH<T>::Node::Node()
+            : m_aabb(), m_tightAabb(), m_data( nullptr ), m_parent( INVALID_NODE )
+        {
+            m_children[0] = INVALID_NODE;
+            m_children[1] = INVALID_NODE;
+        }
+
+        template <typename T>
+        inline BVH<T>::BVH()
+            : m_root( INVALID_NODE ), m_freeList( INVALID_NODE ), m_numLeaves( 0 )
         {}
 
         template <typename T>
-        inline BVH<T>::Node::Node( const std::shared_ptr<Node>& l, const std::shared_ptr<Node>& r )
-            :m_aabb(l->m_aabb.merged(r->m_aabb))
+        inline uint BVH<T>::insertLeaf( const std::shared_ptr<T>& t )
         {
-            m_children.push_back(l);
-            m_children.push_back(r);
+            return insertLeaf( t, t->getAabb() );
         }
 
         template <typename T>
-        inline typename BVH<T>::NodePtr BVH<T>::Node::getLeftChild() const
+        inline uint BVH<T>::insertLeaf( const std::shared_ptr<T>& t, const Aabb& aabb )
         {
-            if (!isFinal())
-                return m_children[0];
-            else
-                return nullptr;
+            const uint leaf = allocateNode();
+            Node& node = m_nodes[leaf];
+            node.m_aabb = enlarged( aabb );
+            node.m_tightAabb = aabb;
+            node.m_data = t;
+
+            insertInTree( leaf );
+            ++m_numLeaves;
+
+            return leaf;
         }
 
         template <typename T>
-        inline typename BVH<T>::NodePtr BVH<T>::Node::getRightChild() const
+        inline void BVH<T>::removeLeaf( uint leaf )
         {
-            if (!isFinal())
-                return m_children[1];
-            else
-                return nullptr;
-        }
+            CORE_ASSERT( leaf < m_nodes.size() && m_nodes[leaf].isLeaf() && m_nodes[leaf].m_data,
+                         "Invalid BVH leaf" );
 
+            removeFromTree( leaf );
+            freeNode( leaf );
+            --m_numLeaves;
+        }
 
         template <typename T>
-        inline BVH<T>::BVH()
-            :m_root(nullptr), m_root_aabb(), m_upToDate(true)
-        {}
+        inline bool BVH<T>::updateLeaf( uint leaf, const Aabb& aabb )
+        {
+            CORE_ASSERT( leaf < m_nodes.size() && m_nodes[leaf].isLeaf() && m_nodes[leaf].m_data,
+                         "Invalid BVH leaf" );
+
+            Node& node = m_nodes[leaf];
+            node.m_tightAabb = aabb;
+
+            if ( !aabb.isEmpty() && node.m_aabb.contains( aabb ) )
+            {
+                return false;
+            }
+
+            removeFromTree( leaf );
+            m_nodes[leaf].m_aabb = enlarged( aabb );
+            insertInTree( leaf );
+
+            return true;
+        }
 
         template <typename T>
-        inline void BVH<T>::insertLeaf(const std::shared_ptr<T>& t)
+        inline void BVH<T>::clear()
         {
-            m_leaves.push_back(std::shared_ptr<Node>(new Node(t)));
-            m_root_aabb.extend(t->getAabb());
+            m_nodes.clear();
+            m_root = INVALID_NODE;
+            m_freeList = INVALID_NODE;
+            m_numLeaves = 0;
+        }
 
-            m_upToDate = false ;
+        template <typename T>
+        inline Aabb BVH<T>::getAabb() const
+        {
+            return isEmpty() ? Aabb() : m_nodes[m_root].m_aabb;
         }
 
         template <typename T>
-        inline void BVH<T>::clear()
+        inline void BVH<T>::getInFrustum( std::vector<std::shared_ptr<T>>& objects, const Frustum& frustum ) const
         {
-            //TODO Clear tree
+            if ( isEmpty() )
+            {
+                return;
+            }
 
-            m_leaves.clear();
-            m_root = nullptr;
-            m_root_aabb = Aabb();
+            std::vector<uint> toCheck;
+            toCheck.push_back( m_root );
+
+            while ( !toCheck.empty() )
+            {
+                const uint current = toCheck.back();
+                toCheck.pop_back();
+
+                const Node& node = m_nodes[current];
+                const Aabb& aabb = node.isLeaf() ? node.m_tightAabb : node.m_aabb;
+                const int inside = classify( aabb, frustum );
+
+                if ( inside == 0 )
+                {
+                    continue;
+                }
 
-            //m_upToDate = true ;
+                if ( node.isLeaf() )
+                {
+                    objects.push_back( node.m_data );
+                }
+                else if ( inside == 2 )
+                {
+                    // No need to test the planes again for the whole subtree.
+                    getSubtree( current, objects );
+                }
+                else
+                {
+                    toCheck.push_back( node.m_children[0] );
+                    toCheck.push_back( node.m_children[1] );
+                }
+            }
         }
 
         template <typename T>
-        inline void BVH<T>::update()
+        inline uint BVH<T>::allocateNode()
         {
-            if (!m_upToDate)
-                buildBottomUpSlow();
+            if ( m_freeList == INVALID_NODE )
+            {
+                m_nodes.push_back( Node() );
+                return m_nodes.size() - 1;
+            }
+
+            const uint node = m_freeList;
+            m_freeList = m_nodes[node].m_parent;
+            m_nodes[node] = Node();
+            return node;
         }
 
         template <typename T>
-        inline void BVH<T>::buildBottomUpSlow()
+        inline void BVH<T>::freeNode( uint node )
         {
-            /*if (m_root != nullptr)
-                clear();*/
+            m_nodes[node].m_data.reset();
+            m_nodes[node].m_parent = m_freeList;
+            m_freeList = node;
+        }
 
-            // We start from known leaves, bottom up
-            std::vector<NodePtr> toMerge(m_leaves);
+        template <typename T>
+        inline void BVH<T>::insertInTree( uint leaf )
+        {
+            if ( m_root == INVALID_NODE )
+            {
+                m_root = leaf;
+                m_nodes[leaf].m_parent = INVALID_NODE;
+                return;
+            }
+
+            // Walk down the tree towards the sibling which increases the
+            // surface area of the hierarchy the least.
+            const Aabb leafAabb = m_nodes[leaf].m_aabb;
+            uint sibling = m_root;
+            while ( !m_nodes[sibling].isLeaf() )
+            {
+                const Node& node = m_nodes[sibling];
+                const Scalar nodeArea = area( node.m_aabb );
+                const Scalar mergedArea = area( node.m_aabb.merged( leafAabb ) );
 
-            // As long as there are several leaves to merge
-            while (toMerge.size() > 2) {
-                Scalar low = m_root_aabb.isEmpty() ? 0 : m_root_aabb.volume();
-                typename std::vector<NodePtr>::iterator l_min, r_min;
-                Aabb merge;
+                // Cost of making a new parent for this node and the leaf.
+                const Scalar cost = 2 * mergedArea;
+                // Cost of pushing the leaf further down.
+                const Scalar inheritedCost = 2 * ( mergedArea - nodeArea );
 
-                for (typename std::vector<NodePtr>::iterator it = toMerge.begin(); it != toMerge.end(); ++it)
+                Scalar childCost[2];
+                for ( uint i = 0; i < 2; ++i )
                 {
-                    for (typename std::vector<NodePtr>::iterator it2 = (it+1); it2 != toMerge.end(); ++it2)
-                    {
-                        // Find the merger with smallest volume
-                        merge = it->get()->getAabb().merged(it2->get()->getAabb());
-                        if (merge.volume() < low)
-                        {
-                            low = merge.volume();
-                            l_min = it;
-                            r_min = it2;
-                        }
-                    }
+                    const Node& child = m_nodes[node.m_children[i]];
+                    const Scalar childMerged = area( child.m_aabb.merged( leafAabb ) );
+                    childCost[i] = inheritedCost + ( child.isLeaf() ? childMerged : childMerged - area( child.m_aabb ) );
                 }
 
-                NodePtr l_node(*l_min), r_node(*r_min);
+                if ( cost < childCost[0] && cost < childCost[1] )
+                {
+                    break;
+                }
 
-                // Remove nodes going to be merged
-                toMerge.erase(r_min);
-                toMerge.erase(l_min);
-                // Add the merger
-                toMerge.push_back(std::shared_ptr<Node>(new Node(l_node, r_node)));
+                sibling = node.m_children[childCost[0] < childCost[1] ? 0 : 1];
             }
 
-            // Final node (the root) is the merger of last two nodes
-            m_root = std::shared_ptr<Node>(new Node(toMerge[0], toMerge[1]));
+            // Create a new parent for the sibling and the leaf.
+            const uint oldParent = m_nodes[sibling].m_parent;
+            const uint newParent = allocateNode();
+            Node& parent = m_nodes[newParent];
+            parent.m_parent = oldParent;
+            parent.m_aabb = m_nodes[sibling].m_aabb.merged( leafAabb );
+            parent.m_children[0] = sibling;
+            parent.m_children[1] = leaf;
+            m_nodes[sibling].m_parent = newParent;
+            m_nodes[leaf].m_parent = newParent;
 
-            m_upToDate = true ;
+            if ( oldParent == INVALID_NODE )
+            {
+                m_root = newParent;
+            }
+            else
+            {
+                Node& grandParent = m_nodes[oldParent];
+                grandParent.m_children[grandParent.m_children[0] == sibling ? 0 : 1] = newParent;
+                refitFrom( oldParent );
+            }
         }
 
+        template <typename T>
+        inline void BVH<T>::removeFromTree( uint leaf )
+        {
+            if ( leaf == m_root )
+            {
+                m_root = INVALID_NODE;
+                return;
+            }
+
+            const uint parent = m_nodes[leaf].m_parent;
+            const uint grandParent = m_nodes[parent].m_parent;
+            const uint sibling = m_nodes[parent].m_children[m_nodes[parent].m_children[0] == leaf ? 1 : 0];
 
-        // Dummy function to transform Vector3 to Vector4
-        inline Vector4 fromV3(Vector3 v, int x) {
-            return Vector4(v(0), v(1), v(2), x) ;
+            // The sibling takes the place of the parent.
+            m_nodes[sibling].m_parent = grandParent;
+            if ( grandParent == INVALID_NODE )
+            {
+                m_root = sibling;
+            }
+            else
+            {
+                Node& node = m_nodes[grandParent];
+                node.m_children[node.m_children[0] == parent ? 0 : 1] = sibling;
+                refitFrom( grandParent );
+            }
+
+            freeNode( parent );
         }
 
         template <typename T>
-        inline void BVH<T>::getInFrustumSlow(std::vector<std::shared_ptr<T>> & objects, const Frustum & frustum) const
+        inline void BVH<T>::refitFrom( uint node )
         {
+            while ( node != INVALID_NODE )
+            {
+                Node& current = m_nodes[node];
+                current.m_aabb = m_nodes[current.m_children[0]].m_aabb.merged( m_nodes[current.m_children[1]].m_aabb );
+                node = current.m_parent;
+            }
+        }
 
-            if (m_root)
+        template <typename T>
+        inline void BVH<T>::getSubtree( uint node, std::vector<std::shared_ptr<T>>& objects ) const
+        {
+            std::vector<uint> toVisit;
+            toVisit.push_back( node );
+
+            while ( !toVisit.empty() )
             {
-                std::vector<NodePtr> toCheck;
-                toCheck.push_back(m_root);
+                const Node& current = m_nodes[toVisit.back()];
+                toVisit.pop_back();
 
-                while (!toCheck.empty())
+                if ( current.isLeaf() )
+                {
+                    objects.push_back( current.m_data );
+                }
+                else
+                {
+                    toVisit.push_back( current.m_children[0] );
+                    toVisit.push_back( current.m_children[1] );
+                }
+            }
+        }
+
+        template <typename T>
+        inline Scalar BVH<T>::area( const Aabb& aabb )
+        {
+            if ( aabb.isEmpty() )
+            {
+                return 0;
+            }
+            const Vector3 d = aabb.sizes();
+            return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+        }
+
+        template <typename T>
+        inline Aabb BVH<T>::enlarged( const Aabb& aabb )
+        {
+            if ( aabb.isEmpty() )
+            {
+                return aabb;
+            }
+            // Enlarge by 10% of the size on each axis.
+            const Vector3 margin = Scalar( 0.1 ) * aabb.sizes();
+            return Aabb( aabb.min() - margin, aabb.max() + margin );
+        }
+
+        template <typename T>
+        inline int BVH<T>::classify( const Aabb& aabb, const Frustum& frustum )
+        {
+            if ( aabb.isEmpty() )
+            {
+                return 0;
+            }
+
+            int result = 2;
+            for ( uint i = 0; i < 6; ++i )
+            {
+                const Vector4& plane = frustum.m_planes[i];
+
+                // Corners of the box the furthest along and against the plane normal.
+                Vector3 positive;
+                Vector3 negative;
+                for ( uint k = 0; k < 3; ++k )
+                {
+                    positive[k] = plane[k] >= 0 ? aabb.max()[k] : aabb.min()[k];
+                    negative[k] = plane[k] >= 0 ? aabb.min()[k] : aabb.max()[k];
+                }
+
+                if ( plane.head<3>().dot( positive ) + plane[3] < 0 )
+                {
+                    return 0;
+                }
+                if ( plane.head<3>().dot( negative ) + plane[3] < 0 )
                 {
-                    NodePtr current = toCheck.back() ;
-                    toCheck.pop_back();
-
-                    if (current->isFinal())
-                        objects.push_back(current->getData());
-                    else
-                    {
-                        // If BBOX cuts the frustum, add child in toCheck list
-                        bool isIn = true;
-                        for (uint i=0; i<6 && isIn; ++i)
-                        {
-                            Vector4 plane = frustum.getPlane(i);
-                            Aabb aabb = current->getAabb();
-
-                            // If the BBOX is fully outside (at least) one plane, it is not in
-                            if ((plane.dot(fromV3(aabb.corner(Aabb::BottomLeftFloor), 1))    < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::BottomRightFloor), 1))   < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::TopLeftFloor), 1))       < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::TopRightFloor), 1))      < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::BottomLeftCeil), 1))     < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::BottomRightCeil), 1))    < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::TopLeftCeil), 1))        < 0.f) &&
-                                (plane.dot(fromV3(aabb.corner(Aabb::TopRightCeil), 1))       < 0.f) )
-                                    isIn = false ;
-                        }
-
-                        if (isIn)
-                        {
-                            toCheck.push_back(current->getLeftChild());
-                            toCheck.push_back(current->getRightChild());
-                        }
-                    }
+                    result = 1;
                 }
             }
+            return result;
         }
     }
 }
@@ -0,0 +1,413 @@
+#include <Core/TreeStructures/TriangleMeshBVH.hpp>
+
+#include <algorithm>
+#include <array>
+#include <numeric>
+
+namespace Ra
+{
+    namespace Core
+    {
+        namespace
+        {
+            // Number of bins used to evaluate the split candidates of the surface area heuristic.
+            const uint SAH_NUM_BINS = 16;
+
+            // Cost of traversing a node, relative to the cost of intersecting a triangle.
+            const Scalar SAH_TRAVERSAL_COST = 1.f;
+
+            // Depth limit of the tree, which bounds the size of the traversal stack.
+            const uint MAX_DEPTH = 64;
+
+            inline Scalar halfArea( const Aabb& box )
+            {
+                if ( box.isEmpty() )
+                {
+                    return 0;
+                }
+                const Vector3 d = box.diagonal();
+                return d.x() * d.y() + d.y() * d.z() + d.z() * d.x();
+            }
+
+            // Moller-Trumbore ray triangle intersection, without backface culling.
+            inline bool rayTriangle( const Ray& ray, const Vector3& a, const Vector3& b, const Vector3& c, Scalar& tOut )
+            {
+                const Vector3 ab = b - a;
+                const Vector3 ac = c - a;
+                const Vector3 pvec = ray.direction().cross( ac );
+                const Scalar det = ab.dot( pvec );
+                if ( det == 0 )
+                {
+                    return false;
+                }
+                const Scalar invDet = Scalar( 1 ) / det;
+                const Vector3 tvec = ray.origin() - a;
+                const Scalar u = tvec.dot( pvec ) * invDet;
+                if ( u < 0 || u > 1 )
+                {
+                    return false;
+                }
+                const Vector3 qvec = tvec.cross( ab );
+                const Scalar v = ray.direction().dot( qvec ) * invDet;
+                if ( v < 0 || u + v > 1 )
+                {
+                    return false;
+                }
+                tOut = ac.dot( qvec ) * invDet;
+                return tOut >= 0;
+            }
+
+            // Slab test of the ray against the box of a node, within [0, maxT].
+            // Returns the entry distance in tEnter.
+            inline bool rayBox( const TriangleMeshBVH::Node& node, const Vector3& origin, const Vector3& invDir,
+                                Scalar maxT, Scalar& tEnter )
+            {
+                const Vector3 t0 = ( node.m_min - origin ).cwiseProduct( invDir );
+                const Vector3 t1 = ( node.m_max - origin ).cwiseProduct( invDir );
+                const Scalar tmin = std::max( t0.cwiseMin( t1 ).maxCoeff(), Scalar( 0 ) );
+                const Scalar tmax = std::min( t0.cwiseMax( t1 ).minCoeff(), maxT );
+                tEnter = tmin;
+                return tmin <= tmax;
+            }
+
+            inline void getVertices( const TriangleMesh& mesh, uint t, Vector3& a, Vector3& b, Vector3& c )
+            {
+                const Triangle& tri = mesh.m_triangles[t];
+                a = mesh.m_vertices[tri[0]];
+                b = mesh.m_vertices[tri[1]];
+                c = mesh.m_vertices[tri[2]];
+            }
+
+            inline void setBounds( TriangleMeshBVH::Node& node, const Aabb& box )
+            {
+                node.m_min = box.min();
+                node.m_max = box.max();
+            }
+        }
+
+        TriangleMeshBVH::TriangleMeshBVH()
+        {
+        }
+
+        void TriangleMeshBVH::clear()
+        {
+            m_nodes.clear();
+            m_triangles.clear();
+        }
+
+        void TriangleMeshBVH::build( const TriangleMesh& mesh, uint maxLeafSize )
+        {
+            CORE_ASSERT( maxLeafSize > 0, "Leaves must hold at least one triangle" );
+            clear();
+
+            const uint numTriangles = mesh.m_triangles.size();
+            if ( numTriangles == 0 )
+            {
+                return;
+            }
+
+            // Bounds and centroids of the triangles.
+            std::vector<Aabb> boxes( numTriangles );
+            std::vector<Vector3> centroids( numTriangles );
+            for ( uint t = 0; t < numTriangles; ++t )
+            {
+                Vector3 a;
+                Vector3 b;
+                Vector3 c;
+                getVertices( mesh, t, a, b, c );
+                boxes[t] = Aabb( a );
+                boxes[t].extend( b );
+                boxes[t].extend( c );
+                centroids[t] = boxes[t].center();
+            }
+
+            m_triangles.resize( numTriangles );
+            std::iota( m_triangles.begin(), m_triangles.end(), 0 );
+            m_nodes.reserve( 2 * numTriangles );
+            m_nodes.emplace_back();
+
+            struct BuildItem
+            {
+                uint m_node;
+                uint m_begin;
+                uint m_end;
+                uint m_depth;
+            };
+            std::vector<BuildItem> stack;
+            stack.push_back( { 0, 0, numTriangles, 0 } );
+
+            struct Bin
+            {
+                Aabb m_box;
+                uint m_count;
+            };
+
+            while ( !stack.empty() )
+            {
+                const BuildItem item = stack.back();
+                stack.pop_back();
+
+                Aabb bounds;
+                Aabb centroidBounds;
+                for ( uint i = item.m_begin; i < item.m_end; ++i )
+                {
+                    bounds.extend( boxes[m_triangles[i]] );
+                    centroidBounds.extend( centroids[m_triangles[i]] );
+                }
+                setBounds( m_nodes[item.m_node], bounds );
+
+                const uint count = item.m_end - item.m_begin;
+                m_nodes[item.m_node].m_index = item.m_begin;
+                m_nodes[item.m_node].m_count = count;
+                if ( count <= maxLeafSize || item.m_depth + 1 >= MAX_DEPTH )
+                {
+                    continue;
+                }
+
+                // Find the best split among the bin boundaries of the three axes.
+                Scalar bestCost = std::numeric_limits<Scalar>::max();
+                uint bestAxis = 0;
+                uint bestSplit = 0;
+                const Vector3 extent = centroidBounds.diagonal();
+                for ( uint axis = 0; axis < 3; ++axis )
+                {
+                    if ( extent[axis] <= 0 )
+                    {
+                        continue;
+                    }
+                    const Scalar scale = Scalar( SAH_NUM_BINS ) / extent[axis];
+                    std::array<Bin, SAH_NUM_BINS> bins;
+                    for ( auto& bin : bins )
+                    {
+                        bin.m_box.setEmpty();
+                        bin.m_count = 0;
+                    }
+                    for ( uint i = item.m_begin; i < item.m_end; ++i )
+                    {
+                        const uint t = m_triangles[i];
+                        const uint b = std::min( uint( ( centroids[t][axis] - centroidBounds.min()[axis] ) * scale ),
+                                                 SAH_NUM_BINS - 1 );
+                        bins[b].m_box.extend( boxes[t] );
+                        ++bins[b].m_count;
+                    }
+
+                    // Sweep from the right to get the cost of the right side of each split.
+                    std::array<Scalar, SAH_NUM_BINS> rightCost;
+                    Aabb rightBox;
+                    uint rightCount = 0;
+                    for ( uint b = SAH_NUM_BINS - 1; b > 0; --b )
+                    {
+                        rightBox.extend( bins[b].m_box );
+                        rightCount += bins[b].m_count;
+                        rightCost[b] = rightCount > 0 ? halfArea( rightBox ) * rightCount : 0;
+                    }
+
+                    Aabb leftBox;
+                    uint leftCount = 0;
+                    for ( uint b = 1; b < SAH_NUM_BINS; ++b )
+                    {
+                        leftBox.extend( bins[b - 1].m_box );
+                        leftCount += bins[b - 1].m_count;
+                        if ( leftCount == 0 || leftCount == count )
+                        {
+                            continue;
+                        }
+                        const Scalar cost = halfArea( leftBox ) * leftCount + rightCost[b];
+                        if ( cost < bestCost )
+                        {
+                            bestCost = cost;
+                            bestAxis = axis;
+                            bestSplit = b;
+                        }
+                    }
+                }
+
+                // All centroids at the same place : the triangles cannot be separated.
+                if ( bestSplit == 0 )
+                {
+                    continue;
+                }
+
+                // Stop if intersecting all the triangles is cheaper than splitting.
+                const Scalar parentArea = halfArea( bounds );
+                const Scalar splitCost = SAH_TRAVERSAL_COST + ( parentArea > 0 ? bestCost / parentArea : 0 );
+                if ( splitCost >= Scalar( count ) && count <= 4 * maxLeafSize )
+                {
+                    continue;
+                }
+
+                const Scalar scale = Scalar( SAH_NUM_BINS ) / extent[bestAxis];
+                const Scalar minCentroid = centroidBounds.min()[bestAxis];
+                auto middle = std::partition( m_triangles.begin() + item.m_begin, m_triangles.begin() + item.m_end,
+                                              [&]( uint t )
+                                              {
+                                                  const uint b = std::min( uint( ( centroids[t][bestAxis] - minCentroid ) * scale ),
+                                                                           SAH_NUM_BINS - 1 );
+                                                  return b < bestSplit;
+                                              } );
+                const uint mid = uint( middle - m_triangles.begin() );
+                CORE_ASSERT( mid > item.m_begin && mid < item.m_end, "Empty side in BVH split" );
+
+                const uint left = m_nodes.size();
+                m_nodes.emplace_back();
+                m_nodes.emplace_back();
+                m_nodes[item.m_node].m_index = left;
+                m_nodes[item.m_node].m_count = 0;
+
+                stack.push_back( { left + 1, mid, item.m_end, item.m_depth + 1 } );
+                stack.push_back( { left, item.m_begin, mid, item.m_depth + 1 } );
+            }
+        }
+
+        void TriangleMeshBVH::refit( const TriangleMesh& mesh )
+        {
+            CORE_ASSERT( mesh.m_triangles.size() == m_triangles.size(), "Mesh topology changed, rebuild the BVH" );
+
+            // Children are always stored after their parent.
+            for ( uint n = m_nodes.size(); n-- > 0; )
+            {
+                Node& node = m_nodes[n];
+                Aabb box;
+                if ( node.isLeaf() )
+                {
+                    for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i )
+                    {
+                        Vector3 a;
+                        Vector3 b;
+                        Vector3 c;
+                        getVertices( mesh, m_triangles[i], a, b, c );
+                        box.extend( a );
+                        box.extend( b );
+                        box.extend( c );
+                    }
+                }
+                else
+                {
+                    const Node& left = m_nodes[node.m_index];
+                    const Node& right = m_nodes[node.m_index + 1];
+                    box.extend( Aabb( left.m_min, left.m_max ) );
+                    box.extend( Aabb( right.m_min, right.m_max ) );
+                }
+                setBounds( node, box );
+            }
+        }
+
+        bool TriangleMeshBVH::closestHit( const TriangleMesh& mesh, const Ray& ray, Scalar& tOut, uint& triangleOut ) const
+        {
+            if ( m_nodes.empty() )
+            {
+                return false;
+            }
+
+            const Vector3 origin = ray.origin();
+            const Vector3 invDir = ray.direction().cwiseInverse();
+            Scalar bestT = std::numeric_limits<Scalar>::max();
+            bool hit = false;
+
+            std::array<uint, MAX_DEPTH + 1> stack;
+            uint stackSize = 0;
+            stack[stackSize++] = 0;
+            while ( stackSize > 0 )
+            {
+                const Node& node = m_nodes[stack[--stackSize]];
+                Scalar tEnter;
+                if ( !rayBox( node, origin, invDir, bestT, tEnter ) )
+                {
+                    continue;
+                }
+
+                if ( node.isLeaf() )
+                {
+                    for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i )
+                    {
+                        Vector3 a;
+                        Vector3 b;
+                        Vector3 c;
+                        getVertices( mesh, m_triangles[i], a, b, c );
+                        Scalar t;
+                        if ( rayTriangle( ray, a, b, c, t ) && t < bestT )
+                        {
+                            bestT = t;
+                            triangleOut = m_triangles[i];
+                            hit = true;
+                        }
+                    }
+                }
+                else
+                {
+                    // Visit the nearest child first.
+                    Scalar tLeft;
+                    Scalar tRight;
+                    const bool hitLeft = rayBox( m_nodes[node.m_index], origin, invDir, bestT, tLeft );
+                    const bool hitRight = rayBox( m_nodes[node.m_index + 1], origin, invDir, bestT, tRight );
+                    if ( hitLeft && hitRight )
+                    {
+                        const bool leftFirst = tLeft <= tRight;
+                        stack[stackSize++] = leftFirst ? node.m_index + 1 : node.m_index;
+                        stack[stackSize++] = leftFirst ? node.m_index : node.m_index + 1;
+                    }
+                    else if ( hitLeft )
+                    {
+                        stack[stackSize++] = node.m_index;
+                    }
+                    else if ( hitRight )
+                    {
+                        stack[stackSize++] = node.m_index + 1;
+                    }
+                }
+            }
+
+            if ( hit )
+            {
+                tOut = bestT;
+            }
+            return hit;
+        }
+
+        bool TriangleMeshBVH::anyHit( const TriangleMesh& mesh, const Ray& ray, Scalar maxT ) const
+        {
+            if ( m_nodes.empty() )
+            {
+                return false;
+            }
+
+            const Vector3 origin = ray.origin();
+            const Vector3 invDir = ray.direction().cwiseInverse();
+
+            std::array<uint, MAX_DEPTH + 1> stack;
+            uint stackSize = 0;
+            stack[stackSize++] = 0;
+            while ( stackSize > 0 )
+            {
+                const Node& node = m_nodes[stack[--stackSize]];
+                Scalar tEnter;
+                if ( !rayBox( node, origin, invDir, maxT, tEnter ) )
+                {
+                    continue;
+                }
+
+                if ( node.isLeaf() )
+                {
+                    for ( uint i = node.m_index; i < node.m_index + node.m_count; ++i )
+                    {
+                        Vector3 a;
+                        Vector3 b;
+                        Vector3 c;
+                        getVertices( mesh, m_triangles[i], a, b, c );
+                        Scalar t;
+                        if ( rayTriangle( ray, a, b, c, t ) && t <= maxT )
+                        {
+                            return true;
+                        }
+                    }
+                }
+                else
+                {
+                    stack[stackSize++] = node.m_index + 1;
+                    stack[stackSize++] = node.m_index;
+                }
+            }
+            return false;
+        }
+    }
+}
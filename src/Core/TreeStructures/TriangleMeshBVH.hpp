@@ -0,0 +1,78 @@
+#ifndef RADIUMENGINE_TRIANGLE_MESH_BVH_HPP
+#define RADIUMENGINE_TRIANGLE_MESH_BVH_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <limits>
+#include <vector>
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Core/Math/Ray.hpp>
+#include <Core/Mesh/TriangleMesh.hpp>
+
+namespace Ra
+{
+    namespace Core
+    {
+        /// A bounding volume hierarchy over the triangles of a TriangleMesh, to accelerate ray queries.
+        /// The tree is built top-down with the surface area heuristic and stored as a flat array of nodes,
+        /// where the two children of a node are stored next to each other.
+        /// The hierarchy only stores triangle indices : queries take the mesh it was built on, which
+        /// must not have changed since the last call to build() (or refit() if only the vertices moved).
+        class RA_CORE_API TriangleMeshBVH
+        {
+        public:
+            /// A node of the hierarchy (32 bytes in single precision).
+            struct Node
+            {
+                Vector3 m_min;
+                /// For leaves, first triangle in the triangle index array. Otherwise, index of the left child
+                /// (the right child is m_index + 1).
+                uint m_index;
+                Vector3 m_max;
+                /// Number of triangles of a leaf, 0 for inner nodes.
+                uint m_count;
+
+                inline bool isLeaf() const { return m_count > 0; }
+            };
+
+        public:
+            TriangleMeshBVH();
+
+            /// Builds the hierarchy over all the triangles of the mesh.
+            /// Leaves hold at most maxLeafSize triangles.
+            void build( const TriangleMesh& mesh, uint maxLeafSize = 4 );
+
+            /// Recomputes the bounding boxes after the vertices of the mesh moved, keeping the tree structure.
+            /// This is much faster than build() but the tree quality degrades with large deformations.
+            void refit( const TriangleMesh& mesh );
+
+            /// Removes all nodes.
+            void clear();
+
+            /// Returns true if the hierarchy has not been built or the mesh has no triangles.
+            inline bool isEmpty() const { return m_nodes.empty(); }
+
+            /// Returns the number of triangles the hierarchy was built on.
+            inline uint getNumTriangles() const { return m_triangles.size(); }
+
+            inline const std::vector<Node>& getNodes() const { return m_nodes; }
+
+            /// Finds the closest triangle hit by the ray, with a parameter t >= 0.
+            /// Returns false if the ray misses the mesh. Otherwise tOut holds the ray parameter of the hit
+            /// and triangleOut the index of the triangle in the mesh.
+            bool closestHit( const TriangleMesh& mesh, const Ray& ray, Scalar& tOut, uint& triangleOut ) const;
+
+            /// Returns true as soon as a triangle is hit with a ray parameter in [0, maxT].
+            /// This is the query to use for visibility / shadow tests.
+            bool anyHit( const TriangleMesh& mesh, const Ray& ray,
+                         Scalar maxT = std::numeric_limits<Scalar>::max() ) const;
+
+        private:
+            std::vector<Node> m_nodes;     /// Nodes, the root is the first one.
+            std::vector<uint> m_triangles; /// Triangle indices, sorted so that each leaf has a contiguous range.
+        };
+    }
+}
+
+#endif //RADIUMENGINE_TRIANGLE_MESH_BVH_HPP
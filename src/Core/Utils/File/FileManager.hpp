@@ -49,6 +49,12 @@ protected:
     virtual bool importData( std::ifstream& file, DATA& data ) = 0;         // Load data from a given file. Return false if an error occurs, true otherwise.
     virtual bool exportData( std::ofstream& file, const DATA& data ) = 0;   // Store given data into a given file. Return false if an error occurs, true otherwise.
 
+    /// MAPPED INTERFACE
+    inline virtual bool supportsMappedImport() const;                       // Return true if the data can be loaded from a file mapped in memory.
+    inline virtual bool importMappedData( const char* begin,
+                                          const char* end,
+                                          DATA&       data );               // Load data from the content of a mapped file. Only called if supportsMappedImport() is true.
+
 private:
     /// LOG
     inline void resetLog();                                                 // Reset the log string.
@@ -1,5 +1,7 @@
 #include <Core/Utils/File/FileManager.hpp>
 
+#include <Core/Utils/File/MappedFile.hpp>
+
 namespace Ra {
 namespace Core {
 
@@ -31,6 +33,23 @@ inline bool FileManager< DATA, Binary >::load( const std::string& filename,
     addLogEntry( "Expected Format : " + fileExtension() );
     addLogEntry( "File Type       : " + std::string( Binary ? "Binary" : "Text" ) );
     addLogEntry( "Loading start..." );
+    if( supportsMappedImport() ) {
+        MappedFile mapped;
+        if( mapped.open( filename ) ) {
+            addLogEntry( "File mapped successfully." );
+            addLogEntry( "Starting to import the data." );
+            const bool status = importMappedData( mapped.data(), mapped.data() + mapped.size(), data );
+            addLogEntry( "Import " + ( ( status ) ? std::string( "DONE." ) : std::string( "FAILED." ) ) );
+            mapped.close();
+            addLogEntry( "File unmapped." );
+            addLogEntry( "Loading " + filename + " ended." );
+            if( SAVE_LOG_FILE ) {
+                saveLog( filename + "_load" );
+            }
+            return status;
+        }
+        addLogEntry( "File could not be mapped, reading it as a stream." );
+    }
     std::ifstream file( filename, std::ios_base::in | ( Binary ? std::ios_base::binary : std::ios_base::in ) );
     if( !file.is_open() ) {
         addLogEntry( "Error occured while opening the file. HINT: FILENAME MAY BE WRONG." );
@@ -80,6 +99,23 @@ inline bool FileManager< DATA, Binary >::save( const std::string& filename,
 
 
 
+/// ===============================================================================
+/// MAPPED INTERFACE
+/// ===============================================================================
+template < typename DATA, bool Binary >
+inline bool FileManager< DATA, Binary >::supportsMappedImport() const {
+    return false;
+}
+
+
+
+template < typename DATA, bool Binary >
+inline bool FileManager< DATA, Binary >::importMappedData( const char* begin, const char* end, DATA& data ) {
+    return false;
+}
+
+
+
 /// ===============================================================================
 /// LOG
 /// ===============================================================================
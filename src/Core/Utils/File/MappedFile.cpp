@@ -0,0 +1,124 @@
+#include <Core/Utils/File/MappedFile.hpp>
+
+#ifdef OS_WINDOWS
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace Ra {
+namespace Core {
+
+/// ===============================================================================
+/// CONSTRUCTOR
+/// ===============================================================================
+#ifdef OS_WINDOWS
+MappedFile::MappedFile() : m_data( nullptr ), m_size( 0 ), m_file( INVALID_HANDLE_VALUE ), m_mapping( nullptr ) { }
+#else
+MappedFile::MappedFile() : m_data( nullptr ), m_size( 0 ), m_file( -1 ) { }
+#endif
+
+
+
+/// ===============================================================================
+/// DESTRUCTOR
+/// ===============================================================================
+MappedFile::~MappedFile() {
+    close();
+}
+
+
+
+/// ===============================================================================
+/// INTERFACE
+/// ===============================================================================
+#ifdef OS_WINDOWS
+bool MappedFile::open( const std::string& filename ) {
+    close();
+    m_file = CreateFileA( filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+    if( m_file == INVALID_HANDLE_VALUE ) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if( !GetFileSizeEx( m_file, &size ) || size.QuadPart == 0 ) {
+        close();
+        return false;
+    }
+    m_mapping = CreateFileMappingA( m_file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if( m_mapping == nullptr ) {
+        close();
+        return false;
+    }
+    m_data = static_cast< const char* >( MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+    if( m_data == nullptr ) {
+        close();
+        return false;
+    }
+    m_size = std::size_t( size.QuadPart );
+    return true;
+}
+
+
+
+void MappedFile::close() {
+    if( m_data != nullptr ) {
+        UnmapViewOfFile( m_data );
+        m_data = nullptr;
+    }
+    if( m_mapping != nullptr ) {
+        CloseHandle( m_mapping );
+        m_mapping = nullptr;
+    }
+    if( m_file != INVALID_HANDLE_VALUE ) {
+        CloseHandle( m_file );
+        m_file = INVALID_HANDLE_VALUE;
+    }
+    m_size = 0;
+}
+#else
+bool MappedFile::open( const std::string& filename ) {
+    close();
+    m_file = ::open( filename.c_str(), O_RDONLY );
+    if( m_file < 0 ) {
+        return false;
+    }
+    struct stat info;
+    if( fstat( m_file, &info ) != 0 || info.st_size == 0 ) {
+        close();
+        return false;
+    }
+    void* data = mmap( nullptr, std::size_t( info.st_size ), PROT_READ, MAP_PRIVATE, m_file, 0 );
+    if( data == MAP_FAILED ) {
+        close();
+        return false;
+    }
+    // The whole file is about to be read, by several threads.
+    madvise( data, std::size_t( info.st_size ), MADV_WILLNEED );
+    m_data = static_cast< const char* >( data );
+    m_size = std::size_t( info.st_size );
+    return true;
+}
+
+
+
+void MappedFile::close() {
+    if( m_data != nullptr ) {
+        munmap( const_cast< char* >( m_data ), m_size );
+        m_data = nullptr;
+    }
+    if( m_file >= 0 ) {
+        ::close( m_file );
+        m_file = -1;
+    }
+    m_size = 0;
+}
+#endif
+
+
+
+} // namespace Core
+} // namespace Ra
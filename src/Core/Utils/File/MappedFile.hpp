@@ -0,0 +1,49 @@
+#ifndef RADIUMENGINE_MAPPED_FILE_HPP
+#define RADIUMENGINE_MAPPED_FILE_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <string>
+
+namespace Ra {
+namespace Core {
+
+/*
+* The class MappedFile maps the content of a file in memory, read-only, so that it can be
+* parsed directly without being copied in a stream buffer.
+*/
+class RA_CORE_API MappedFile {
+public:
+    /// CONSTRUCTOR
+    MappedFile();                                                   // Default constructor.
+
+    /// DESTRUCTOR
+    ~MappedFile();                                                  // Destructor. Unmaps the file.
+
+    /// INTERFACE
+    bool open( const std::string& filename );                       // Return true if the file is correctly mapped. Empty files cannot be mapped.
+    void close();                                                   // Unmap the file.
+
+    inline bool isOpen() const { return m_data != nullptr; }
+    inline const char* data() const { return m_data; }
+    inline std::size_t size() const { return m_size; }
+
+private:
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    /// VARIABLE
+    const char* m_data;
+    std::size_t m_size;
+#ifdef OS_WINDOWS
+    void* m_file;
+    void* m_mapping;
+#else
+    int m_file;
+#endif
+};
+
+} // namespace Core
+} // namespace Ra
+
+#endif // RADIUMENGINE_MAPPED_FILE_HPP
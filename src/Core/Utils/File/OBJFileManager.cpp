@@ -1,12 +1,144 @@
 #include <Core/Utils/File/OBJFileManager.hpp>
 
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Utils/File/TextParsing.hpp>
+#include <Core/Utils/File/TextWriting.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
 namespace Ra {
 namespace Core {
 
+using namespace TextParsing;
+
+namespace {
+
+enum ObjLineType {
+    ObjLine_Other,
+    ObjLine_Vertex,
+    ObjLine_Normal,
+    ObjLine_TexCoord,
+    ObjLine_Face,
+};
+
+/// Number of elements of each kind in a chunk, or offset of the chunk in the mesh.
+struct ObjChunkCount {
+    uint m_vertices  = 0;
+    uint m_normals   = 0;
+    uint m_texCoords = 0;
+    uint m_triangles = 0;
+};
+
+/// Index of an attribute absent from a corner, and of an invalid reference.
+const int ObjIndex_None    = -1;
+const int ObjIndex_Invalid = -2;
+
+/// One corner of a face, as 0-based indices.
+struct ObjCorner {
+    int m_vertex;
+    int m_texCoord;
+    int m_normal;
+};
+
+/// Read the keyword starting the line at p, and move p after it.
+inline ObjLineType readLineType( const char*& p, const char* end ) {
+    skipSpaces( p, end );
+    if( end - p < 2 ) {
+        return ObjLine_Other;
+    }
+    if( isSpace( p[1] ) ) {
+        if( p[0] == 'v' ) {
+            p += 1;
+            return ObjLine_Vertex;
+        }
+        if( p[0] == 'f' ) {
+            p += 1;
+            return ObjLine_Face;
+        }
+    } else if( p[0] == 'v' && end - p > 2 && isSpace( p[2] ) ) {
+        if( p[1] == 'n' ) {
+            p += 2;
+            return ObjLine_Normal;
+        }
+        if( p[1] == 't' ) {
+            p += 2;
+            return ObjLine_TexCoord;
+        }
+    }
+    return ObjLine_Other;
+}
+
+/// Convert a 1-based index, or a negative index relative to the current count, to a 0-based index.
+inline int resolveIndex( int index, uint count ) {
+    const int i = ( index > 0 ) ? index - 1 : ( index < 0 ) ? int( count ) + index : ObjIndex_Invalid;
+    return ( i < 0 ) ? ObjIndex_Invalid : i;
+}
+
+/// Return true if index is absent, or a valid index in an array of the given size.
+inline bool isValidIndex( int index, uint size, bool optional ) {
+    return ( optional && index == ObjIndex_None ) || ( index >= 0 && uint( index ) < size );
+}
+
+/// Read the corners of a face line. Return false if the line is malformed.
+inline bool readFace( const char*& p, const char* end, const ObjChunkCount& count, std::vector< ObjCorner >& corners ) {
+    corners.clear();
+    for( ;; ) {
+        skipSpaces( p, end );
+        if( isEndOfLine( p, end ) ) {
+            return true;
+        }
+        ObjCorner corner = { ObjIndex_None, ObjIndex_None, ObjIndex_None };
+        int index;
+        if( !parseInt( p, end, index ) ) {
+            return false;
+        }
+        corner.m_vertex = resolveIndex( index, count.m_vertices );
+        if( p < end && *p == '/' ) {
+            ++p;
+            if( p < end && *p != '/' ) {
+                if( !parseInt( p, end, index ) ) {
+                    return false;
+                }
+                corner.m_texCoord = resolveIndex( index, count.m_texCoords );
+            }
+            if( p < end && *p == '/' ) {
+                ++p;
+                if( !parseInt( p, end, index ) ) {
+                    return false;
+                }
+                corner.m_normal = resolveIndex( index, count.m_normals );
+            }
+        }
+        if( p < end && !isSpace( *p ) && *p != '\n' ) {
+            return false;
+        }
+        corners.push_back( corner );
+    }
+}
+
+/// Count the corners of a face line.
+inline uint countCorners( const char*& p, const char* end ) {
+    uint corners = 0;
+    for( ;; ) {
+        skipSpaces( p, end );
+        if( isEndOfLine( p, end ) ) {
+            return corners;
+        }
+        ++corners;
+        while( p < end && !isSpace( *p ) && *p != '\n' ) {
+            ++p;
+        }
+    }
+}
+
+} // namespace
+
 /// ===============================================================================
 /// CONSTRUCTOR
 /// ===============================================================================
-OBJFileManager::OBJFileManager() : FileManager< TriangleMesh >() { }
+OBJFileManager::OBJFileManager() : FileManager< TriangleMesh >(), m_parallelExport( true ) { }
 
 
 
@@ -18,88 +150,230 @@ OBJFileManager::~OBJFileManager() { }
 
 
 /// ===============================================================================
-/// INTERFACE
+/// MAPPED INTERFACE
 /// ===============================================================================
-std::string OBJFileManager::fileExtension() const {
-    return "obj";
+bool OBJFileManager::supportsMappedImport() const {
+    return true;
 }
 
 
 
-bool OBJFileManager::importData( std::ifstream& file, TriangleMesh& data ) {
+bool OBJFileManager::importMappedData( const char* begin, const char* end, TriangleMesh& data ) {
     data = TriangleMesh();
-    std::string line;
-    while( std::getline( file, line ) ) {
-        std::istringstream iss( line );
-        std::string token;
-        iss >> token;
-
-        if( token == "#" ) {
-            continue;
-        }
-        if( token == "v" ) {
-            Vector3 v;
-            iss >> v[0] >> v[1] >> v[2];
-            data.m_vertices.push_back( v );
-        }
-        if( token == "vn" ) {
-            Vector3 n;
-            iss >> n[0] >> n[1] >> n[2];
-            data.m_normals.push_back( n );
-        }
-        if( token == "vt" ) {
-            continue;
-        }
-        if( token == "vp" ) {
-            continue;
-        }
-        if( token == "f" ) {
-            Triangle f;
-            iss >> f[0] >> f[1] >> f[2];
-            f[0] -= 1;
-            f[1] -= 1;
-            f[2] -= 1;
-            data.m_triangles.push_back( f );
+    m_texCoords.clear();
+
+    const std::vector< Range > chunks = splitLines( begin, end );
+    const uint numChunks = chunks.size();
+
+    // First pass : count the elements of each chunk.
+    std::vector< ObjChunkCount > offsets( numChunks + 1 );
+    parallelFor( 0, numChunks, 1, [&]( uint firstChunk, uint lastChunk ) {
+        for( uint c = firstChunk; c < lastChunk; ++c ) {
+            ObjChunkCount& count = offsets[c + 1];
+            for( const char* p = chunks[c].first; p < chunks[c].second; skipLine( p, chunks[c].second ) ) {
+                switch( readLineType( p, chunks[c].second ) ) {
+                    case ObjLine_Vertex:   ++count.m_vertices;  break;
+                    case ObjLine_Normal:   ++count.m_normals;   break;
+                    case ObjLine_TexCoord: ++count.m_texCoords; break;
+                    case ObjLine_Face: {
+                        const uint corners = countCorners( p, chunks[c].second );
+                        count.m_triangles += ( corners > 2 ) ? corners - 2 : 0;
+                    } break;
+                    default: break;
+                }
+            }
         }
+    } );
+    for( uint c = 0; c < numChunks; ++c ) {
+        offsets[c + 1].m_vertices  += offsets[c].m_vertices;
+        offsets[c + 1].m_normals   += offsets[c].m_normals;
+        offsets[c + 1].m_texCoords += offsets[c].m_texCoords;
+        offsets[c + 1].m_triangles += offsets[c].m_triangles;
     }
-    if( data.m_vertices.size() == 0 ) {
+    const ObjChunkCount& total = offsets[numChunks];
+
+    if( total.m_vertices == 0 ) {
         addLogErrorEntry( "MESH IS EMPTY." );
         return false;
     }
+
+    VectorArray< Vector3 > normals( total.m_normals );
+    VectorArray< Vector3 > texCoords( total.m_texCoords );
+    data.m_vertices.resize( total.m_vertices );
+    data.m_triangles.resize( total.m_triangles );
+
+    // Attributes indices of the triangle corners, only stored if the file has attributes.
+    std::vector< int > cornerNormals( total.m_normals > 0 ? 3 * total.m_triangles : 0, ObjIndex_None );
+    std::vector< int > cornerTexCoords( total.m_texCoords > 0 ? 3 * total.m_triangles : 0, ObjIndex_None );
+
+    // Second pass : parse each chunk at its offset in the mesh.
+    std::atomic< bool > malformed( false );
+    std::atomic< bool > invalidIndex( false );
+    parallelFor( 0, numChunks, 1, [&]( uint firstChunk, uint lastChunk ) {
+        for( uint c = firstChunk; c < lastChunk; ++c ) {
+            const char* chunkEnd = chunks[c].second;
+            ObjChunkCount count = offsets[c];
+            std::vector< ObjCorner > corners;
+            bool ok = true;
+            bool valid = true;
+            for( const char* p = chunks[c].first; p < chunkEnd && ok; skipLine( p, chunkEnd ) ) {
+                switch( readLineType( p, chunkEnd ) ) {
+                    case ObjLine_Vertex: {
+                        Vector3& v = data.m_vertices[count.m_vertices++];
+                        ok = parseScalar( p, chunkEnd, v[0] ) && parseScalar( p, chunkEnd, v[1] ) && parseScalar( p, chunkEnd, v[2] );
+                    } break;
+
+                    case ObjLine_Normal: {
+                        Vector3& n = normals[count.m_normals++];
+                        ok = parseScalar( p, chunkEnd, n[0] ) && parseScalar( p, chunkEnd, n[1] ) && parseScalar( p, chunkEnd, n[2] );
+                    } break;
+
+                    case ObjLine_TexCoord: {
+                        Vector3& t = texCoords[count.m_texCoords++];
+                        // "vt u [v [w]]"
+                        ok = parseScalar( p, chunkEnd, t[0] );
+                        if( !parseScalar( p, chunkEnd, t[1] ) ) {
+                            t[1] = 0;
+                        }
+                        if( !parseScalar( p, chunkEnd, t[2] ) ) {
+                            t[2] = 0;
+                        }
+                    } break;
+
+                    case ObjLine_Face: {
+                        ok = readFace( p, chunkEnd, count, corners );
+                        for( const auto& corner : corners ) {
+                            valid = valid && isValidIndex( corner.m_vertex, total.m_vertices, false ) &&
+                                    isValidIndex( corner.m_texCoord, total.m_texCoords, true ) &&
+                                    isValidIndex( corner.m_normal, total.m_normals, true );
+                        }
+                        // Triangulate the polygon as a fan around its first corner.
+                        for( uint i = 2; ok && i < corners.size(); ++i ) {
+                            const uint t = count.m_triangles++;
+                            const ObjCorner* triangle[3] = { &corners[0], &corners[i - 1], &corners[i] };
+                            for( uint k = 0; k < 3; ++k ) {
+                                data.m_triangles[t][k] = triangle[k]->m_vertex;
+                                if( !cornerNormals.empty() ) {
+                                    cornerNormals[3 * t + k] = triangle[k]->m_normal;
+                                }
+                                if( !cornerTexCoords.empty() ) {
+                                    cornerTexCoords[3 * t + k] = triangle[k]->m_texCoord;
+                                }
+                            }
+                        }
+                    } break;
+
+                    default: break;
+                }
+            }
+            if( !ok ) {
+                malformed = true;
+            }
+            if( !valid ) {
+                invalidIndex = true;
+            }
+        }
+    } );
+
+    if( malformed ) {
+        addLogErrorEntry( "MALFORMED LINE." );
+        return false;
+    }
+    if( invalidIndex ) {
+        addLogErrorEntry( "INVALID FACE INDEX." );
+        return false;
+    }
+
+    // Attributes referenced by the faces are moved to the vertices.
+    auto assignToVertices = [&data]( const VectorArray< Vector3 >& values,
+                                     const std::vector< int >& corners,
+                                     VectorArray< Vector3 >& result ) {
+        if( values.empty() ) {
+            return;
+        }
+        const bool referenced = std::any_of( corners.begin(), corners.end(), []( int i ) { return i >= 0; } );
+        if( !referenced ) {
+            // Attributes given in the order of the vertices.
+            if( values.size() == data.m_vertices.size() ) {
+                result = values;
+            }
+            return;
+        }
+        result.resize( data.m_vertices.size(), Vector3::Zero() );
+        std::vector< bool > assigned( data.m_vertices.size(), false );
+        for( uint i = 0; i < corners.size(); ++i ) {
+            const uint v = data.m_triangles[i / 3][i % 3];
+            if( corners[i] >= 0 && !assigned[v] ) {
+                result[v] = values[corners[i]];
+                assigned[v] = true;
+            }
+        }
+    };
+    assignToVertices( normals, cornerNormals, data.m_normals );
+    assignToVertices( texCoords, cornerTexCoords, m_texCoords );
+
     return true;
 }
 
 
 
+/// ===============================================================================
+/// INTERFACE
+/// ===============================================================================
+std::string OBJFileManager::fileExtension() const {
+    return "obj";
+}
+
+
+
+bool OBJFileManager::importData( std::ifstream& file, TriangleMesh& data ) {
+    // Only used when the file cannot be mapped.
+    const std::string content( ( std::istreambuf_iterator< char >( file ) ), std::istreambuf_iterator< char >() );
+    return importMappedData( content.data(), content.data() + content.size(), data );
+}
+
+
+
 bool OBJFileManager::exportData( std::ofstream& file, const TriangleMesh& data ) {
-    std::string content = "";
+    using namespace TextWriting;
     if( data.m_vertices.size() == 0 ) {
         addLogErrorEntry( "MESH IS EMPTY." );
         return false;
     }
+    const uint vectorSize = 3 + 3 * ( MAX_NUMBER_SIZE + 1 );
+    const uint triangleSize = 2 + 3 * ( MAX_NUMBER_SIZE + 1 );
     // Vertices
-    for( uint i = 0; i < data.m_vertices.size(); ++i ) {
-        const Vector3 v = data.m_vertices.at( i );
-        content += "v " + std::to_string( v[0] ) + " " +
-                          std::to_string( v[1] ) + " " +
-                          std::to_string( v[2] ) + "\n";
-    }
+    bool status = writeElements( file, data.m_vertices.size(), vectorSize, [&data]( char* out, uint i ) {
+        *out++ = 'v';
+        *out++ = ' ';
+        out = writeVector( out, data.m_vertices[i] );
+        *out++ = '\n';
+        return out;
+    }, m_parallelExport );
     // Normals
-    for( uint i = 0; i < data.m_normals.size(); ++i ) {
-        const Vector3 n = data.m_normals.at( i );
-        content += "vn " + std::to_string( n[0] ) + " " +
-                           std::to_string( n[1] ) + " " +
-                           std::to_string( n[2] ) + "\n";
-    }
+    status = status && writeElements( file, data.m_normals.size(), vectorSize, [&data]( char* out, uint i ) {
+        *out++ = 'v';
+        *out++ = 'n';
+        *out++ = ' ';
+        out = writeVector( out, data.m_normals[i] );
+        *out++ = '\n';
+        return out;
+    }, m_parallelExport );
     // Triangle
-    for( uint i = 0; i < data.m_triangles.size(); ++i ) {
-        const Triangle f = data.m_triangles.at( i );
-        content += "f " + std::to_string( f[0] + 1 ) + " " +
-                          std::to_string( f[1] + 1 ) + " " +
-                          std::to_string( f[2] + 1 ) + "\n";
+    status = status && writeElements( file, data.m_triangles.size(), triangleSize, [&data]( char* out, uint i ) {
+        const Triangle& f = data.m_triangles[i];
+        *out++ = 'f';
+        for( uint k = 0; k < 3; ++k ) {
+            *out++ = ' ';
+            out = writeUint( out, f[k] + 1 );
+        }
+        *out++ = '\n';
+        return out;
+    }, m_parallelExport );
+    if( !status ) {
+        addLogErrorEntry( "WRITING FAILED." );
     }
-    file << content;
-    return true;
+    return status;
 }
 
 
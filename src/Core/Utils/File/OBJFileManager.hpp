@@ -7,6 +7,12 @@
 namespace Ra {
 namespace Core {
 
+/*
+* The class OBJFileManager handles the loading and storing of TriangleMesh in the Wavefront OBJ format.
+* Files are mapped in memory and parsed by several threads. Polygonal faces are triangulated as fans.
+* Normals and texture coordinates referenced by the faces ("f v/vt/vn") are assigned to the vertices,
+* the first reference of a vertex winning.
+*/
 class OBJFileManager : public FileManager< TriangleMesh > {
 public:
     /// CONSTRUCTOR
@@ -15,11 +21,26 @@ public:
     /// DESTRUCTOR
     virtual ~OBJFileManager();
 
-protected:    
+    /// EXPORT
+    inline void setParallelExport( const bool parallel ) { m_parallelExport = parallel; }  // Format the exported text on several threads (default).
+
+    /// TEXTURE COORDINATES
+    inline const VectorArray< Vector3 >& texCoords() const { return m_texCoords; }   // Texture coordinates of the vertices of the last loaded mesh, empty if there are none.
+
+protected:
     /// INTERFACE
     virtual std::string fileExtension() const override;
     virtual bool importData( std::ifstream& file, TriangleMesh& data ) override;
     virtual bool exportData( std::ofstream& file, const TriangleMesh& data ) override;
+
+    /// MAPPED INTERFACE
+    virtual bool supportsMappedImport() const override;
+    virtual bool importMappedData( const char* begin, const char* end, TriangleMesh& data ) override;
+
+private:
+    /// VARIABLE
+    VectorArray< Vector3 > m_texCoords;
+    bool                   m_parallelExport;
 };
 
 } // namespace Core
@@ -1,12 +1,50 @@
 #include <Core/Utils/File/OFFFileManager.hpp>
 
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Utils/File/TextParsing.hpp>
+#include <Core/Utils/File/TextWriting.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <iterator>
+
 namespace Ra {
 namespace Core {
 
+using namespace TextParsing;
+
+namespace {
+
+/// Move p to the next character which is not a space, an empty line or a comment.
+inline void skipEmptyLines( const char*& p, const char* end ) {
+    skipSpaces( p, end );
+    while( p < end && isEndOfLine( p, end ) ) {
+        skipLine( p, end );
+        skipSpaces( p, end );
+    }
+}
+
+/// Count the face lines of a range and their triangles, up to maxLines lines.
+/// Return the end of the last counted line.
+inline const char* countFaces( const char* p, const char* end, uint maxLines, uint& lines, uint& triangles ) {
+    lines = 0;
+    triangles = 0;
+    for( skipEmptyLines( p, end ); p < end && lines < maxLines; skipEmptyLines( p, end ) ) {
+        int side = 0;
+        parseInt( p, end, side );
+        triangles += ( side > 2 ) ? side - 2 : 0;
+        ++lines;
+        skipLine( p, end );
+    }
+    return p;
+}
+
+} // namespace
+
 /// ===============================================================================
 /// CONSTRUCTOR
 /// ===============================================================================
-OFFFileManager::OFFFileManager() : FileManager< TriangleMesh >() { }
+OFFFileManager::OFFFileManager() : FileManager< TriangleMesh >(), m_parallelExport( true ) { }
 
 
 
@@ -27,59 +65,171 @@ std::string OFFFileManager::header() const {
 
 
 /// ===============================================================================
-/// INTERFACE
+/// MAPPED INTERFACE
 /// ===============================================================================
-std::string OFFFileManager::fileExtension() const {
-    return "off";
+bool OFFFileManager::supportsMappedImport() const {
+    return true;
 }
 
 
 
-bool OFFFileManager::importData( std::ifstream& file, TriangleMesh& data ) {
-    std::string h;
-    file >> h;
-    if( h != header() ) {
+bool OFFFileManager::importMappedData( const char* begin, const char* end, TriangleMesh& data ) {
+    data = TriangleMesh();
+
+    // Header
+    const char* p = begin;
+    skipEmptyLines( p, end );
+    const std::string h = header();
+    if( std::size_t( end - p ) < h.size() || std::strncmp( p, h.c_str(), h.size() ) != 0 ) {
         addLogErrorEntry( "HEADER IS NOT CORRECT." );
         return false;
     }
-    uint v_size;
-    uint f_size;
-    uint e_size;
-    file >> v_size >> f_size >> e_size;
-    data = TriangleMesh();
-    data.m_vertices.resize( v_size );
-    data.m_triangles.resize( f_size );
-
-    // Vertices
-    for( uint i = 0; i < v_size; ++i ) {
-        Vector3 v;
-        file >> v[0] >> v[1] >> v[2];
-        data.m_vertices[i] = v;
+    p += h.size();
+    int size[3];
+    for( uint i = 0; i < 3; ++i ) {
+        skipEmptyLines( p, end );
+        if( !parseInt( p, end, size[i] ) || size[i] < 0 ) {
+            addLogErrorEntry( "HEADER IS NOT CORRECT." );
+            return false;
+        }
     }
+    skipLine( p, end );
+    const uint v_size = size[0];
+    const uint f_size = size[1];
 
-    // Edge
-    for( uint i = 0; i < e_size; ++i ) {
-        break;
+    // Vertices : the vertex lines are scanned to cut them in chunks, then parsed in parallel.
+    std::vector< Range > vertexChunks;
+    std::vector< uint >  vertexOffsets( 1, 0 );
+    const char* chunkStart = p;
+    uint v = 0;
+    for( skipEmptyLines( p, end ); p < end && v < v_size; skipEmptyLines( p, end ) ) {
+        if( std::size_t( p - chunkStart ) >= CHUNK_SIZE ) {
+            vertexChunks.push_back( Range( chunkStart, p ) );
+            vertexOffsets.push_back( v );
+            chunkStart = p;
+        }
+        ++v;
+        const void* lf = std::memchr( p, '\n', end - p );
+        p = ( lf != nullptr ) ? static_cast< const char* >( lf ) + 1 : end;
+    }
+    if( v < v_size ) {
+        addLogErrorEntry( "UNEXPECTED END OF FILE." );
+        return false;
     }
+    vertexChunks.push_back( Range( chunkStart, p ) );
 
-    // Triangle
-    for( uint i = 0; i < f_size; ++i ) {
-        uint side;
-        Triangle f;
-        file >> side;
-        if( side == 3 ) {
-            file >> f[0] >> f[1] >> f[2];
-            data.m_triangles.push_back( f );
+    data.m_vertices.resize( v_size );
+    std::atomic< bool > malformed( false );
+    parallelFor( 0, vertexChunks.size(), 1, [&]( uint firstChunk, uint lastChunk ) {
+        for( uint c = firstChunk; c < lastChunk; ++c ) {
+            const char* chunkEnd = vertexChunks[c].second;
+            uint i = vertexOffsets[c];
+            bool ok = true;
+            for( const char* q = vertexChunks[c].first; ok && i < v_size; skipLine( q, chunkEnd ) ) {
+                skipEmptyLines( q, chunkEnd );
+                if( q == chunkEnd ) {
+                    break;
+                }
+                Vector3& vertex = data.m_vertices[i++];
+                ok = parseScalar( q, chunkEnd, vertex[0] ) && parseScalar( q, chunkEnd, vertex[1] ) && parseScalar( q, chunkEnd, vertex[2] );
+            }
+            if( !ok ) {
+                malformed = true;
+            }
+        }
+    } );
+
+    // Faces : count the triangles of each chunk, then parse them at their offset.
+    std::vector< Range > faceChunks = splitLines( p, end );
+    std::vector< uint > lineOffsets( faceChunks.size() + 1, 0 );
+    std::vector< uint > triangleOffsets( faceChunks.size() + 1, 0 );
+    parallelFor( 0, faceChunks.size(), 1, [&]( uint firstChunk, uint lastChunk ) {
+        for( uint c = firstChunk; c < lastChunk; ++c ) {
+            countFaces( faceChunks[c].first, faceChunks[c].second, uint( -1 ), lineOffsets[c + 1], triangleOffsets[c + 1] );
+        }
+    } );
+    for( uint c = 0; c < faceChunks.size(); ++c ) {
+        if( lineOffsets[c] + lineOffsets[c + 1] > f_size ) {
+            // Ignore the lines following the faces.
+            faceChunks[c].second = countFaces( faceChunks[c].first, faceChunks[c].second, f_size - lineOffsets[c],
+                                               lineOffsets[c + 1], triangleOffsets[c + 1] );
+            faceChunks.resize( c + 1 );
         }
+        lineOffsets[c + 1]     += lineOffsets[c];
+        triangleOffsets[c + 1] += triangleOffsets[c];
+    }
+    if( lineOffsets[faceChunks.size()] < f_size ) {
+        addLogErrorEntry( "UNEXPECTED END OF FILE." );
+        return false;
     }
 
+    data.m_triangles.resize( triangleOffsets[faceChunks.size()] );
+    std::atomic< bool > invalidIndex( false );
+    parallelFor( 0, faceChunks.size(), 1, [&]( uint firstChunk, uint lastChunk ) {
+        for( uint c = firstChunk; c < lastChunk; ++c ) {
+            const char* chunkEnd = faceChunks[c].second;
+            uint t = triangleOffsets[c];
+            std::vector< int > corners;
+            bool ok = true;
+            bool valid = true;
+            for( const char* q = faceChunks[c].first; ok && q < chunkEnd; skipLine( q, chunkEnd ) ) {
+                skipEmptyLines( q, chunkEnd );
+                if( q == chunkEnd ) {
+                    break;
+                }
+                int side = 0;
+                ok = parseInt( q, chunkEnd, side ) && side >= 0;
+                corners.resize( ok ? side : 0 );
+                for( auto& corner : corners ) {
+                    ok = ok && parseInt( q, chunkEnd, corner );
+                    valid = valid && corner >= 0 && uint( corner ) < v_size;
+                }
+                // Triangulate the polygon as a fan around its first corner.
+                for( uint i = 2; ok && i < corners.size(); ++i ) {
+                    data.m_triangles[t++] = Triangle( corners[0], corners[i - 1], corners[i] );
+                }
+            }
+            if( !ok ) {
+                malformed = true;
+            }
+            if( !valid ) {
+                invalidIndex = true;
+            }
+        }
+    } );
+
+    if( malformed ) {
+        addLogErrorEntry( "MALFORMED LINE." );
+        return false;
+    }
+    if( invalidIndex ) {
+        addLogErrorEntry( "INVALID FACE INDEX." );
+        return false;
+    }
     return true;
 }
 
 
 
+/// ===============================================================================
+/// INTERFACE
+/// ===============================================================================
+std::string OFFFileManager::fileExtension() const {
+    return "off";
+}
+
+
+
+bool OFFFileManager::importData( std::ifstream& file, TriangleMesh& data ) {
+    // Only used when the file cannot be mapped.
+    const std::string content( ( std::istreambuf_iterator< char >( file ) ), std::istreambuf_iterator< char >() );
+    return importMappedData( content.data(), content.data() + content.size(), data );
+}
+
+
+
 bool OFFFileManager::exportData( std::ofstream& file, const TriangleMesh& data ) {
-    std::string content = "";
+    using namespace TextWriting;
     const uint v_size = data.m_vertices.size();
     const uint f_size = data.m_triangles.size();
     const uint e_size = 0;
@@ -90,30 +240,31 @@ bool OFFFileManager::exportData( std::ofstream& file, const TriangleMesh& data )
     }
 
     // Header
-    content += header()                 + "\n" +
-               std::to_string( v_size ) + " "  +
-               std::to_string( f_size ) + " "  +
-               std::to_string( e_size ) + "\n";
+    file << header() << "\n" << v_size << " " << f_size << " " << e_size << "\n";
 
     // Vertices
-    for( uint i = 0; i < v_size; ++i ) {
-        const Vector3 v = data.m_vertices.at( i );
-        content += std::to_string( v[0] ) + " " +
-                   std::to_string( v[1] ) + " " +
-                   std::to_string( v[2] ) + "\n";
-    }
+    bool status = writeElements( file, v_size, 1 + 3 * ( MAX_NUMBER_SIZE + 1 ), [&data]( char* out, uint i ) {
+        out = writeVector( out, data.m_vertices[i] );
+        *out++ = '\n';
+        return out;
+    }, m_parallelExport );
 
     // Triangle
-    for( uint i = 0; i < f_size; ++i ) {
-        const Triangle f = data.m_triangles.at( i );
-        content += "3 " + std::to_string( f[0] ) + " " +
-                          std::to_string( f[1] ) + " " +
-                          std::to_string( f[2] ) + "\n";
-    }
-
-    file << content;
+    status = status && writeElements( file, f_size, 2 + 3 * ( MAX_NUMBER_SIZE + 1 ), [&data]( char* out, uint i ) {
+        const Triangle& f = data.m_triangles[i];
+        *out++ = '3';
+        for( uint k = 0; k < 3; ++k ) {
+            *out++ = ' ';
+            out = writeUint( out, f[k] );
+        }
+        *out++ = '\n';
+        return out;
+    }, m_parallelExport );
 
-    return true;
+    if( !status ) {
+        addLogErrorEntry( "WRITING FAILED." );
+    }
+    return status;
 }
 
 
@@ -9,6 +9,7 @@ namespace Core {
 
 /*
 * The class OFFFileManager handles the loading and storing of TriangleMesh in the standard OFF format.
+* Files are mapped in memory and parsed by several threads. Polygonal faces are triangulated as fans.
 */
 class OFFFileManager : public FileManager< TriangleMesh > {
 public:
@@ -18,6 +19,9 @@ public:
     /// DESTRUCTOR
     virtual ~OFFFileManager();
 
+    /// EXPORT
+    inline void setParallelExport( const bool parallel ) { m_parallelExport = parallel; }  // Format the exported text on several threads (default).
+
 protected:
     /// HEADER
     std::string header() const;
@@ -26,6 +30,14 @@ protected:
     virtual std::string fileExtension() const override;
     virtual bool importData( std::ifstream& file, TriangleMesh& data ) override;
     virtual bool exportData( std::ofstream& file, const TriangleMesh& data ) override;
+
+    /// MAPPED INTERFACE
+    virtual bool supportsMappedImport() const override;
+    virtual bool importMappedData( const char* begin, const char* end, TriangleMesh& data ) override;
+
+private:
+    /// VARIABLE
+    bool m_parallelExport;
 };
 
 } // namespace Core
@@ -0,0 +1,30 @@
+#include <Core/Utils/File/TextParsing.hpp>
+
+#include <cstring>
+
+namespace Ra {
+namespace Core {
+namespace TextParsing {
+
+/// ===============================================================================
+/// CHUNKS
+/// ===============================================================================
+std::vector< Range > splitLines( const char* begin, const char* end, std::size_t chunkSize ) {
+    std::vector< Range > chunks;
+    const char* start = begin;
+    while( start < end ) {
+        const char* stop = end;
+        if( std::size_t( end - start ) > chunkSize ) {
+            // Cut after the first line feed following the chunk size.
+            const void* lf = std::memchr( start + chunkSize, '\n', end - start - chunkSize );
+            stop = ( lf != nullptr ) ? static_cast< const char* >( lf ) + 1 : end;
+        }
+        chunks.push_back( Range( start, stop ) );
+        start = stop;
+    }
+    return chunks;
+}
+
+} // namespace TextParsing
+} // namespace Core
+} // namespace Ra
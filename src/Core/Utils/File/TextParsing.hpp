@@ -0,0 +1,46 @@
+#ifndef RADIUMENGINE_TEXT_PARSING_HPP
+#define RADIUMENGINE_TEXT_PARSING_HPP
+
+#include <Core/RaCore.hpp>
+
+#include <utility>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+
+/*
+* Helpers to parse text files held in memory (see MappedFile).
+* Numbers are parsed without going through streams nor the C locale, and the text can be
+* split in chunks of whole lines to be parsed in parallel with parallelFor().
+* All the functions take the current position by reference and never read past end.
+*/
+namespace TextParsing {
+
+typedef std::pair< const char*, const char* > Range;
+
+/// Size of the chunks a text is split in for parallel parsing.
+const std::size_t CHUNK_SIZE = 1 << 18;
+
+/// LINES
+inline bool isSpace( char c );                                              // Space, tab or carriage return (not line feed).
+inline void skipSpaces( const char*& p, const char* end );                  // Move p to the next non-space character of the line.
+inline void skipLine( const char*& p, const char* end );                    // Move p after the next line feed.
+inline bool isEndOfLine( const char* p, const char* end );                  // Return true at the end of a line, or at a comment.
+
+/// NUMBERS
+inline bool parseScalar( const char*& p, const char* end, Scalar& value );  // Parse a decimal number after optional spaces. Return false if there is none.
+inline bool parseInt( const char*& p, const char* end, int& value );        // Parse a signed integer after optional spaces. Return false if there is none.
+
+/// CHUNKS
+RA_CORE_API std::vector< Range > splitLines( const char* begin,
+                                             const char* end,
+                                             std::size_t chunkSize = CHUNK_SIZE );  // Split the text in chunks of about chunkSize bytes ending on line boundaries.
+
+} // namespace TextParsing
+} // namespace Core
+} // namespace Ra
+
+#include <Core/Utils/File/TextParsing.inl>
+
+#endif // RADIUMENGINE_TEXT_PARSING_HPP
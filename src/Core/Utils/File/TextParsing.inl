@@ -0,0 +1,149 @@
+#include <Core/Utils/File/TextParsing.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Ra {
+namespace Core {
+namespace TextParsing {
+
+/// ===============================================================================
+/// LINES
+/// ===============================================================================
+inline bool isSpace( char c ) {
+    return ( c == ' ' || c == '\t' || c == '\r' );
+}
+
+
+
+inline void skipSpaces( const char*& p, const char* end ) {
+    while( p < end && isSpace( *p ) ) {
+        ++p;
+    }
+}
+
+
+
+inline void skipLine( const char*& p, const char* end ) {
+    while( p < end && *p != '\n' ) {
+        ++p;
+    }
+    if( p < end ) {
+        ++p;
+    }
+}
+
+
+
+inline bool isEndOfLine( const char* p, const char* end ) {
+    return ( p == end || *p == '\n' || *p == '#' );
+}
+
+
+
+/// ===============================================================================
+/// NUMBERS
+/// ===============================================================================
+inline bool parseScalar( const char*& p, const char* end, Scalar& value ) {
+    // Exact powers of ten representable as a double.
+    static const double powers[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                     1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                     1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    skipSpaces( p, end );
+    const char* c = p;
+
+    bool negative = false;
+    if( c < end && ( *c == '-' || *c == '+' ) ) {
+        negative = ( *c == '-' );
+        ++c;
+    }
+
+    // Digits beyond the 19th do not fit in the mantissa and only scale it.
+    unsigned long long mantissa = 0;
+    int exponent = 0;
+    int numDigits = 0;
+    bool hasDigits = false;
+    for( ; c < end && *c >= '0' && *c <= '9'; ++c ) {
+        hasDigits = true;
+        if( numDigits < 19 ) {
+            mantissa = mantissa * 10 + ( *c - '0' );
+            numDigits += ( mantissa != 0 );
+        } else {
+            ++exponent;
+        }
+    }
+    if( c < end && *c == '.' ) {
+        for( ++c; c < end && *c >= '0' && *c <= '9'; ++c ) {
+            hasDigits = true;
+            if( numDigits < 19 ) {
+                mantissa = mantissa * 10 + ( *c - '0' );
+                numDigits += ( mantissa != 0 );
+                --exponent;
+            }
+        }
+    }
+    if( !hasDigits ) {
+        return false;
+    }
+
+    if( c < end && ( *c == 'e' || *c == 'E' ) ) {
+        const char* e = c + 1;
+        bool negativeExponent = false;
+        if( e < end && ( *e == '-' || *e == '+' ) ) {
+            negativeExponent = ( *e == '-' );
+            ++e;
+        }
+        if( e < end && *e >= '0' && *e <= '9' ) {
+            int n = 0;
+            for( ; e < end && *e >= '0' && *e <= '9'; ++e ) {
+                n = std::min( n * 10 + ( *e - '0' ), 10000 );
+            }
+            exponent += negativeExponent ? -n : n;
+            c = e;
+        }
+    }
+
+    double result = double( mantissa );
+    if( exponent != 0 && mantissa != 0 ) {
+        if( exponent > 0 && exponent <= 22 ) {
+            result *= powers[exponent];
+        } else if( exponent < 0 && exponent >= -22 ) {
+            result /= powers[-exponent];
+        } else {
+            result *= std::pow( 10.0, double( exponent ) );
+        }
+    }
+
+    value = Scalar( negative ? -result : result );
+    p = c;
+    return true;
+}
+
+
+
+inline bool parseInt( const char*& p, const char* end, int& value ) {
+    skipSpaces( p, end );
+    const char* c = p;
+
+    bool negative = false;
+    if( c < end && ( *c == '-' || *c == '+' ) ) {
+        negative = ( *c == '-' );
+        ++c;
+    }
+    if( c == end || *c < '0' || *c > '9' ) {
+        return false;
+    }
+    long long result = 0;
+    for( ; c < end && *c >= '0' && *c <= '9'; ++c ) {
+        result = std::min( result * 10 + ( *c - '0' ), 0x7fffffffLL );
+    }
+
+    value = int( negative ? -result : result );
+    p = c;
+    return true;
+}
+
+} // namespace TextParsing
+} // namespace Core
+} // namespace Ra
@@ -0,0 +1,48 @@
+#ifndef RADIUMENGINE_TEXT_WRITING_HPP
+#define RADIUMENGINE_TEXT_WRITING_HPP
+
+#include <Core/RaCore.hpp>
+#include <Core/Math/LinearAlgebra.hpp>
+
+#include <ostream>
+
+namespace Ra {
+namespace Core {
+
+/*
+* Helpers to write large text files.
+* Numbers are formatted directly in a character buffer, without going through streams nor the
+* C locale, and the text is written by blocks of a bounded size, which can be formatted by
+* the threads of parallelFor().
+*/
+namespace TextWriting {
+
+/// Maximum number of characters written by writeScalar() and writeUint().
+const uint MAX_NUMBER_SIZE = 24;
+
+/// Number of elements formatted in a block before it is written.
+const uint BLOCK_SIZE = 1 << 14;
+
+/// NUMBERS
+inline char* writeUint( char* out, unsigned long long value );             // Write an integer at out, return the end of the written text.
+inline char* writeScalar( char* out, Scalar value );                        // Write a number with 6 decimals at most (like "%f" without trailing zeros).
+inline char* writeVector( char* out, const Vector3& v );                    // Write the 3 coordinates separated by spaces, at most 3 * ( MAX_NUMBER_SIZE + 1 ) characters.
+
+/// BLOCKS
+/// Write the lines of numElements elements to file. writeElement( out, i ) writes the text of
+/// element i at out, at most maxElementSize characters, and returns the end of the written text.
+/// Blocks of elements are formatted in parallel with parallelFor() if parallel is true.
+template < typename FUNC >
+inline bool writeElements( std::ostream& file,
+                           uint numElements,
+                           uint maxElementSize,
+                           const FUNC& writeElement,
+                           bool parallel = true );
+
+} // namespace TextWriting
+} // namespace Core
+} // namespace Ra
+
+#include <Core/Utils/File/TextWriting.inl>
+
+#endif // RADIUMENGINE_TEXT_WRITING_HPP
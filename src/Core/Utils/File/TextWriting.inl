@@ -0,0 +1,116 @@
+#include <Core/Utils/File/TextWriting.hpp>
+
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace Ra {
+namespace Core {
+namespace TextWriting {
+
+/// ===============================================================================
+/// NUMBERS
+/// ===============================================================================
+inline char* writeUint( char* out, unsigned long long value ) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = char( '0' + value % 10 );
+        value /= 10;
+    } while( value != 0 );
+    while( n > 0 ) {
+        *out++ = digits[--n];
+    }
+    return out;
+}
+
+
+
+inline char* writeScalar( char* out, Scalar value ) {
+    const double v = value;
+    // Huge values and non finite numbers are left to printf.
+    if( !( std::abs( v ) < 1e12 ) ) {
+        return out + std::snprintf( out, MAX_NUMBER_SIZE, "%g", v );
+    }
+
+    const unsigned long long x = ( unsigned long long )( std::abs( v ) * 1e6 + 0.5 );
+    if( x == 0 ) {
+        *out++ = '0';
+        return out;
+    }
+    if( v < 0 ) {
+        *out++ = '-';
+    }
+    out = writeUint( out, x / 1000000 );
+
+    uint decimals = uint( x % 1000000 );
+    if( decimals != 0 ) {
+        int n = 6;
+        while( decimals % 10 == 0 ) {
+            decimals /= 10;
+            --n;
+        }
+        *out++ = '.';
+        for( int i = n - 1; i >= 0; --i ) {
+            out[i] = char( '0' + decimals % 10 );
+            decimals /= 10;
+        }
+        out += n;
+    }
+    return out;
+}
+
+
+
+inline char* writeVector( char* out, const Vector3& v ) {
+    out = writeScalar( out, v[0] );
+    *out++ = ' ';
+    out = writeScalar( out, v[1] );
+    *out++ = ' ';
+    return writeScalar( out, v[2] );
+}
+
+
+
+/// ===============================================================================
+/// BLOCKS
+/// ===============================================================================
+template < typename FUNC >
+inline bool writeElements( std::ostream& file,
+                           uint numElements,
+                           uint maxElementSize,
+                           const FUNC& writeElement,
+                           bool parallel ) {
+    const uint numBlocks = ( numElements + BLOCK_SIZE - 1 ) / BLOCK_SIZE;
+    const uint numBuffers = parallel ? std::max( 1u, std::min( numBlocks, std::thread::hardware_concurrency() ) ) : 1;
+
+    // Each buffer holds a block. Buffers are formatted together, then written in order.
+    std::vector< std::vector< char > > buffers( numBuffers, std::vector< char >( std::size_t( BLOCK_SIZE ) * maxElementSize ) );
+    std::vector< std::size_t > sizes( numBuffers );
+    for( uint first = 0; first < numBlocks && file; first += numBuffers ) {
+        const uint count = std::min( numBuffers, numBlocks - first );
+        parallelFor( 0, count, 1, [&]( uint blockBegin, uint blockEnd ) {
+            for( uint b = blockBegin; b < blockEnd; ++b ) {
+                const uint begin = ( first + b ) * BLOCK_SIZE;
+                const uint end = std::min( begin + BLOCK_SIZE, numElements );
+                char* out = buffers[b].data();
+                for( uint i = begin; i < end; ++i ) {
+                    out = writeElement( out, i );
+                }
+                sizes[b] = out - buffers[b].data();
+            }
+        } );
+        for( uint b = 0; b < count; ++b ) {
+            file.write( buffers[b].data(), sizes[b] );
+        }
+    }
+    return bool( file );
+}
+
+} // namespace TextWriting
+} // namespace Core
+} // namespace Ra
@@ -22,6 +22,7 @@ class AnimationData {
 public:
     /// FRIEND
     friend class AssimpAnimationDataLoader;
+    friend class CacheDataLoader;
 
     /// CONSTRUCTOR
     AnimationData( const std::string& name = "" );
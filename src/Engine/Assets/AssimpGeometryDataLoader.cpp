@@ -4,6 +4,7 @@
 #include <assimp/mesh.h>
 
 #include <Core/Log/Log.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
 #include <Engine/Assets/GeometryData.hpp>
 #include <Engine/Assets/AssimpWrapper.hpp>
 
@@ -88,9 +89,8 @@ namespace Ra {
             return mesh_size;
         }
 
-        void AssimpGeometryDataLoader::loadMeshData( const aiMesh& mesh, GeometryData& data, std::set<std::string>& usedNames )
+        void AssimpGeometryDataLoader::loadMeshData( const aiMesh& mesh, GeometryData& data ) const
         {
-            fetchName( mesh, data, usedNames );
             fetchType( mesh, data );
             fetchVertices( mesh, data );
             if ( data.isLineMesh() )
@@ -204,7 +204,7 @@ namespace Ra {
             }
         }
 
-        void AssimpGeometryDataLoader::fetchVertices( const aiMesh& mesh, GeometryData& data ) {
+        void AssimpGeometryDataLoader::fetchVertices( const aiMesh& mesh, GeometryData& data ) const {
             const uint size = mesh.mNumVertices;
 #if 0
             std::vector< Core::Vector3 > vertex( size );
@@ -237,26 +237,28 @@ namespace Ra {
         void AssimpGeometryDataLoader::fetchEdges( const aiMesh& mesh, GeometryData& data ) const {
             const uint size = mesh.mNumFaces;
             std::vector< Core::Vector2ui > edge( size );
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) {
-                edge[i] = assimpToCore( mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices ).cast<uint>();
-                edge[i][0] = data.m_duplicateTable.at( edge[i][0] );
-                edge[i][1] = data.m_duplicateTable.at( edge[i][1] );
-            }
+            Core::parallelFor( 0, size, GRAIN_SIZE, [&]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i ) {
+                    edge[i] = assimpToCore( mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices ).cast<uint>();
+                    edge[i][0] = data.m_duplicateTable.at( edge[i][0] );
+                    edge[i][1] = data.m_duplicateTable.at( edge[i][1] );
+                }
+            } );
             data.setEdges( edge );
         }
 
         void AssimpGeometryDataLoader::fetchFaces( const aiMesh& mesh, GeometryData& data ) const {
             const uint size = mesh.mNumFaces;
             std::vector< Core::VectorNui > face( size );
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) {
-                face[i] = assimpToCore( mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices ).cast<uint>();
-                const uint face_vertices = mesh.mFaces[i].mNumIndices;
-                for( uint j = 0; j < face_vertices; ++j ) {
-                    face[i][j] = data.m_duplicateTable.at( face[i][j] );
+            Core::parallelFor( 0, size, GRAIN_SIZE, [&]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i ) {
+                    face[i] = assimpToCore( mesh.mFaces[i].mIndices, mesh.mFaces[i].mNumIndices ).cast<uint>();
+                    const uint face_vertices = mesh.mFaces[i].mNumIndices;
+                    for( uint j = 0; j < face_vertices; ++j ) {
+                        face[i][j] = data.m_duplicateTable.at( face[i][j] );
+                    }
                 }
-            }
+            } );
             data.setFaces( face );
         }
 
@@ -267,17 +269,17 @@ namespace Ra {
         void AssimpGeometryDataLoader::fetchNormals( const aiMesh& mesh, GeometryData& data ) const {
             const uint size = mesh.mNumVertices;
             std::vector<Core::Vector3> normal(data.getVerticesSize(), Core::Vector3::Zero());
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) 
+            // Duplicates accumulate in the same normal, so this loop stays serial.
+            for( uint i = 0; i < size; ++i )
             {
                 normal.at( data.m_duplicateTable.at( i ) ) += assimpToCore( mesh.mNormals[i] );
             }
 
-#pragma omp parallel for
-            for( int i = 0; i < int(normal.size()); ++i ) 
-            {
-                normal[i].normalize();
-            }
+            Core::parallelFor( 0, normal.size(), GRAIN_SIZE, [&]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i ) {
+                    normal[i].normalize();
+                }
+            } );
             data.setNormals( normal );
         }
 
@@ -285,11 +287,11 @@ namespace Ra {
 #if defined(LOAD_TEXTURES)
             const uint size = mesh.mNumVertices;
             std::vector<Core::Vector3> tangent(data.getVerticesSize(), Core::Vector3::Zero());
-#pragma omp parallel for
-            for( uint i = 0; i < size; ++i ) 
-            {
-                tangent[i] = assimpToCore( mesh.mTangents[i]);
-            }
+            Core::parallelFor( 0, size, GRAIN_SIZE, [&]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i ) {
+                    tangent[i] = assimpToCore( mesh.mTangents[i] );
+                }
+            } );
             data.setTangents( tangent );
 #endif
         }
@@ -298,11 +300,11 @@ namespace Ra {
 #if defined(LOAD_TEXTURES)
             const uint size = mesh.mNumVertices;
             std::vector<Core::Vector3> bitangent(data.getVerticesSize());
-#pragma omp parallel for
-            for( uint i = 0; i < size; ++i ) 
-            {
-                bitangent[i] = assimpToCore(mesh.mBitangents[i]);
-            }
+            Core::parallelFor( 0, size, GRAIN_SIZE, [&]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i ) {
+                    bitangent[i] = assimpToCore( mesh.mBitangents[i] );
+                }
+            } );
             data.setBitangents( bitangent );
 #endif
         }
@@ -312,13 +314,13 @@ namespace Ra {
             const uint size = mesh.mNumVertices;
             std::vector<Core::Vector3> texcoord;
             texcoord.resize(data.getVerticesSize());
-#pragma omp parallel for
-            for ( uint i = 0; i < size; ++i )
-            {
-                // FIXME(Charly): Is it safe to only consider texcoords[0] ?
-                // FIXME(Charly): This is probably crappy if you do not allow duplicates.
-                texcoord.at(data.m_duplicateTable.at(i)) = assimpToCore( mesh.mTextureCoords[0][i] );
-            }
+            Core::parallelFor( 0, size, GRAIN_SIZE, [&]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i ) {
+                    // FIXME(Charly): Is it safe to only consider texcoords[0] ?
+                    // FIXME(Charly): This is probably crappy if you do not allow duplicates.
+                    texcoord.at(data.m_duplicateTable.at(i)) = assimpToCore( mesh.mTextureCoords[0][i] );
+                }
+            } );
             data.setTextureCoordinates( texcoord );
 #endif
         }
@@ -428,6 +430,9 @@ namespace Ra {
             const uint size = scene->mNumMeshes;
             std::map< uint, uint > indexTable;
             std::set<std::string> usedNames;
+            std::vector< const aiMesh* > meshes;
+
+            // Names depend on the previous meshes, so they are given first, in order.
             for( uint i = 0; i < size; ++i ) {
                 aiMesh* mesh = scene->mMeshes[i];
                 if( mesh->HasPositions() ) {
@@ -435,24 +440,35 @@ namespace Ra {
 #ifdef LOAD_TEXTURES
                     geometry->setLoadDuplicates(true);
 #endif
-                    loadMeshData( *mesh, *geometry, usedNames );
-                    if( scene->HasMaterials() ) {
-                        const uint matID = mesh->mMaterialIndex;
-                        if( matID < scene->mNumMaterials ) {
-                            aiMaterial* material = scene->mMaterials[matID];
-                            loadMaterial( *material, *geometry );
-                        }
-                    }
+                    fetchName( *mesh, *geometry, usedNames );
                     data.push_back( std::unique_ptr< GeometryData >( geometry ) );
+                    meshes.push_back( mesh );
                     indexTable[i] = data.size() - 1;
+                }
+            }
 
-                    if ( m_verbose )
-                    {
-                        geometry->displayInfo();
+            // Each mesh is converted by its own task. Big meshes also split their loops,
+            // so that a scene made of a single mesh still uses all the threads.
+            Core::parallelFor( 0, meshes.size(), 1, [&]( uint begin, uint end ) {
+                for( uint i = begin; i < end; ++i ) {
+                    const aiMesh& mesh = *meshes[i];
+                    GeometryData& geometry = *data[i];
+                    loadMeshData( mesh, geometry );
+                    if( scene->HasMaterials() ) {
+                        const uint matID = mesh.mMaterialIndex;
+                        if( matID < scene->mNumMaterials ) {
+                            loadMaterial( *scene->mMaterials[matID], geometry );
+                        }
                     }
+                }
+            } );
 
+            if( m_verbose ) {
+                for( const auto& geometry : data ) {
+                    geometry->displayInfo();
                 }
             }
+
             loadMeshFrame( scene->mRootNode, Core::Transform::Identity(), indexTable, data );
         }
 
@@ -46,7 +46,8 @@ protected:
     /// LOADING
     void loadGeometryData( const aiScene* scene, std::vector< std::unique_ptr< GeometryData > >& data );
 
-    void loadMeshData(const aiMesh& mesh, GeometryData& data , std::set<std::string>& usedNames);
+    /// Converts the mesh data, except its name. Can be called from several threads at once.
+    void loadMeshData( const aiMesh& mesh, GeometryData& data ) const;
 
     void loadMeshFrame( const aiNode*                                   node,
                         const Core::Transform&                          parentFrame,
@@ -60,7 +61,7 @@ protected:
     void fetchType( const aiMesh& mesh, GeometryData& data ) const;
 
     /// VERTEX
-    void fetchVertices( const aiMesh& mesh, GeometryData& data );
+    void fetchVertices( const aiMesh& mesh, GeometryData& data ) const;
 
     /// EDGE
     void fetchEdges( const aiMesh& mesh, GeometryData& data ) const;
@@ -93,6 +94,9 @@ protected:
     void loadMaterial( const aiMaterial& material, GeometryData& data ) const;
 
 private:
+    /// Number of elements processed by each task in the loops over the vertices and faces.
+    static const uint GRAIN_SIZE = 4096;
+
     std::string m_filepath;
 };
 
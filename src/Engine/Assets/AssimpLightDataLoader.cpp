@@ -0,0 +1,108 @@
+#include <Engine/Assets/AssimpLightDataLoader.hpp>
+
+#include <assimp/scene.h>
+
+#include <Core/Log/Log.hpp>
+#include <Engine/Assets/AssimpWrapper.hpp>
+#include <Engine/Assets/LightData.hpp>
+
+namespace Ra {
+namespace Asset {
+
+/// CONSTRUCTOR
+AssimpLightDataLoader::AssimpLightDataLoader( const bool VERBOSE_MODE ) : DataLoader< LightData >( VERBOSE_MODE ) { }
+
+/// DESTRUCTOR
+AssimpLightDataLoader::~AssimpLightDataLoader() { }
+
+/// LOAD
+void AssimpLightDataLoader::loadData( const aiScene* scene, std::vector< std::unique_ptr< LightData > >& data ) {
+    data.clear();
+
+    if( scene == nullptr ) {
+        LOG( logDEBUG ) << "AssimpLightDataLoader : scene is nullptr.";
+        return;
+    }
+
+    if( !sceneHasLight( scene ) ) {
+        LOG( logDEBUG ) << "AssimpLightDataLoader : scene has no light.";
+        return;
+    }
+
+    if( m_verbose ) {
+        LOG( logDEBUG ) << "File contains light.";
+        LOG( logDEBUG ) << "Light Loading begin...";
+    }
+
+    loadLightData( scene, data );
+
+    if( m_verbose ) {
+        LOG( logDEBUG ) << "Light Loading end.\n";
+    }
+}
+
+
+
+/// QUERY
+bool AssimpLightDataLoader::sceneHasLight( const aiScene* scene ) const {
+    return scene->HasLights();
+}
+
+
+
+/// LOAD
+void AssimpLightDataLoader::loadLightData( const aiScene* scene, std::vector< std::unique_ptr< LightData > >& data ) const {
+    for( uint i = 0; i < scene->mNumLights; ++i ) {
+        const aiLight& light = *scene->mLights[i];
+
+        LightData::LightType type;
+        switch( light.mType ) {
+            case aiLightSource_DIRECTIONAL : type = LightData::DIRECTIONAL; break;
+            case aiLightSource_POINT       : type = LightData::POINT;       break;
+            case aiLightSource_SPOT        : type = LightData::SPOT;        break;
+            default : {
+                if( m_verbose ) {
+                    LOG( logDEBUG ) << "Light " << assimpToCore( light.mName ) << " has undefined type.";
+                }
+                continue;
+            }
+        }
+
+        LightData* result = new LightData( assimpToCore( light.mName ), type );
+
+        // Position and direction are stored in the frame of the scene.
+        const Core::Matrix4 frame = fetchFrame( scene, light );
+
+        Core::Vector4 pos( light.mPosition.x, light.mPosition.y, light.mPosition.z, 1.0 );
+        pos = frame * pos;
+        pos /= pos.w();
+
+        Core::Vector4 dir( light.mDirection.x, light.mDirection.y, light.mDirection.z, 0.0 );
+        dir = frame.transpose().inverse() * dir;
+
+        result->m_color                = Core::Color( light.mColorDiffuse.r, light.mColorDiffuse.g, light.mColorDiffuse.b, 1.0 );
+        result->m_position             = pos.head< 3 >();
+        result->m_direction            = dir.head< 3 >();
+        result->m_constantAttenuation  = light.mAttenuationConstant;
+        result->m_linearAttenuation    = light.mAttenuationLinear;
+        result->m_quadraticAttenuation = light.mAttenuationQuadratic;
+        result->m_innerAngle           = light.mAngleInnerCone;
+        result->m_outerAngle           = light.mAngleOuterCone;
+
+        data.push_back( std::unique_ptr< LightData >( result ) );
+    }
+}
+
+
+
+/// FRAME
+Core::Matrix4 AssimpLightDataLoader::fetchFrame( const aiScene* scene, const aiLight& light ) const {
+    const aiNode* node = scene->mRootNode->FindNode( light.mName );
+    if( node == nullptr ) {
+        return Core::Matrix4::Identity();
+    }
+    return assimpToCore( scene->mRootNode->mTransformation ).matrix() * assimpToCore( node->mTransformation ).matrix();
+}
+
+} // namespace Asset
+} // namespace Ra
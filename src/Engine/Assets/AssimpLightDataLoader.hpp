@@ -0,0 +1,39 @@
+#ifndef RADIUMENGINE_ASSIMP_LIGHT_DATA_LOADER_HPP
+#define RADIUMENGINE_ASSIMP_LIGHT_DATA_LOADER_HPP
+
+#include <Core/Math/LinearAlgebra.hpp>
+#include <Engine/Assets/DataLoader.hpp>
+
+struct aiScene;
+struct aiLight;
+
+namespace Ra {
+namespace Asset {
+
+class LightData;
+class AssimpLightDataLoader : public DataLoader< LightData > {
+public:
+    /// CONSTRUCTOR
+    AssimpLightDataLoader( const bool VERBOSE_MODE = false );
+
+    /// DESTRUCTOR
+    ~AssimpLightDataLoader();
+
+    /// LOAD
+    void loadData( const aiScene* scene, std::vector< std::unique_ptr< LightData > >& data ) override;
+
+protected:
+    /// QUERY
+    bool sceneHasLight( const aiScene* scene ) const;
+
+    /// LOAD
+    void loadLightData( const aiScene* scene, std::vector< std::unique_ptr< LightData > >& data ) const;
+
+    /// FRAME
+    Core::Matrix4 fetchFrame( const aiScene* scene, const aiLight& light ) const;
+};
+
+} // namespace Asset
+} // namespace Ra
+
+#endif // RADIUMENGINE_ASSIMP_LIGHT_DATA_LOADER_HPP
@@ -0,0 +1,630 @@
+#include <Engine/Assets/CacheDataLoader.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <set>
+
+#include <Core/Log/Log.hpp>
+#include <Core/String/StringUtils.hpp>
+#include <Core/Utils/File/MappedFile.hpp>
+
+#include <Engine/Assets/GeometryData.hpp>
+#include <Engine/Assets/HandleData.hpp>
+#include <Engine/Assets/AnimationData.hpp>
+#include <Engine/Assets/LightData.hpp>
+
+namespace Ra {
+namespace Asset {
+
+namespace {
+
+const char     CACHE_MAGIC[8]  = { 'R', 'A', 'D', 'I', 'U', 'M', 'C', '\0' };
+const uint64_t CACHE_ALIGNMENT = 16;
+
+struct CacheHeader {
+    char     m_magic[8];
+    uint32_t m_version;
+    uint32_t m_flags;
+    uint64_t m_sourceHash;
+    uint64_t m_sourceSize;
+    uint32_t m_scalarSize;
+    uint32_t m_geometrySize;
+    uint32_t m_handleSize;
+    uint32_t m_animationSize;
+    uint32_t m_lightSize;
+};
+
+/// Texture paths are stored relative to the directory of the source file, which may move.
+inline std::string toCachePath( const std::string& path, const std::string& directory ) {
+    const std::string prefix = directory + "/";
+    return ( path.compare( 0, prefix.size(), prefix ) == 0 ) ? path.substr( prefix.size() ) : path;
+}
+
+inline std::string fromCachePath( const std::string& path, const std::string& directory ) {
+    return path.empty() ? path : directory + "/" + path;
+}
+
+} // namespace
+
+
+
+/// Writes the cache file, keeping track of the offset to align the arrays.
+class CacheDataLoader::Writer {
+public:
+    Writer( std::ofstream& file ) : m_file( file ), m_offset( 0 ) { }
+
+    inline void writeBytes( const void* data, const uint64_t size ) {
+        m_file.write( static_cast< const char* >( data ), size );
+        m_offset += size;
+    }
+
+    template < typename T >
+    inline void write( const T& value ) {
+        writeBytes( &value, sizeof( T ) );
+    }
+
+    inline void writeString( const std::string& s ) {
+        write( uint64_t( s.size() ) );
+        writeBytes( s.data(), s.size() );
+    }
+
+    inline void writeTransform( const Core::Transform& t ) {
+        const Core::Matrix4 m = t.matrix();
+        writeBytes( m.data(), sizeof( Core::Matrix4 ) );
+    }
+
+    /// Size, then raw elements starting on an aligned offset.
+    template < typename T >
+    inline void writeArray( const T* data, const uint64_t size ) {
+        static const char padding[CACHE_ALIGNMENT] = {};
+        write( size );
+        writeBytes( padding, ( CACHE_ALIGNMENT - m_offset % CACHE_ALIGNMENT ) % CACHE_ALIGNMENT );
+        writeBytes( data, size * sizeof( T ) );
+    }
+
+    template < typename ARRAY >
+    inline void writeArray( const ARRAY& array ) {
+        writeArray( array.data(), array.size() );
+    }
+
+    /// Arrays of arrays : the sizes, then all the elements.
+    template < typename ARRAY, typename T >
+    inline void writeNestedArray( const ARRAY& array ) {
+        std::vector< uint32_t > sizes;
+        std::vector< T > elements;
+        sizes.reserve( array.size() );
+        for( const auto& item : array ) {
+            sizes.push_back( item.size() );
+            elements.insert( elements.end(), item.data(), item.data() + item.size() );
+        }
+        writeArray( sizes );
+        writeArray( elements );
+    }
+
+private:
+    std::ofstream& m_file;
+    uint64_t       m_offset;
+};
+
+/// Reads the mapped cache file, checking that nothing is read past its end.
+class CacheDataLoader::Reader {
+public:
+    Reader( const char* begin, const char* end ) : m_begin( begin ), m_current( begin ), m_end( end ), m_valid( true ) { }
+
+    inline bool isValid() const {
+        return m_valid;
+    }
+
+    inline const char* reserve( const uint64_t size ) {
+        if( !m_valid || size > uint64_t( m_end - m_current ) ) {
+            m_valid = false;
+            return nullptr;
+        }
+        const char* data = m_current;
+        m_current += size;
+        return data;
+    }
+
+    inline void readBytes( void* data, const uint64_t size ) {
+        const char* source = reserve( size );
+        if( source != nullptr ) {
+            std::memcpy( data, source, size );
+        }
+    }
+
+    template < typename T >
+    inline T read() {
+        T value = T();
+        readBytes( &value, sizeof( T ) );
+        return value;
+    }
+
+    inline std::string readString() {
+        const uint64_t size = read< uint64_t >();
+        const char* data = reserve( size );
+        return ( data != nullptr ) ? std::string( data, size ) : std::string();
+    }
+
+    inline Core::Transform readTransform() {
+        Core::Matrix4 m = Core::Matrix4::Identity();
+        readBytes( m.data(), sizeof( Core::Matrix4 ) );
+        Core::Transform t;
+        t.matrix() = m;
+        return t;
+    }
+
+    template < typename ARRAY >
+    inline void readArray( ARRAY& array ) {
+        typedef typename ARRAY::value_type T;
+        const uint64_t size = read< uint64_t >();
+        reserve( ( CACHE_ALIGNMENT - ( m_current - m_begin ) % CACHE_ALIGNMENT ) % CACHE_ALIGNMENT );
+        if( !m_valid || size > uint64_t( m_end - m_current ) / sizeof( T ) ) {
+            m_valid = false;
+            return;
+        }
+        // The whole array is copied at once from the mapped file.
+        array.resize( size );
+        readBytes( array.data(), size * sizeof( T ) );
+    }
+
+    template < typename ARRAY, typename T >
+    inline void readNestedArray( ARRAY& array ) {
+        std::vector< uint32_t > sizes;
+        std::vector< T > elements;
+        readArray( sizes );
+        readArray( elements );
+        uint64_t total = 0;
+        for( const uint32_t s : sizes ) {
+            total += s;
+        }
+        if( !m_valid || total != elements.size() ) {
+            m_valid = false;
+            return;
+        }
+        array.resize( sizes.size() );
+        const T* element = elements.data();
+        for( uint i = 0; i < sizes.size(); ++i ) {
+            array[i].resize( sizes[i] );
+            std::copy( element, element + sizes[i], array[i].data() );
+            element += sizes[i];
+        }
+    }
+
+private:
+    const char* m_begin;
+    const char* m_current;
+    const char* m_end;
+    bool        m_valid;
+};
+
+/// CONSTRUCTOR
+CacheDataLoader::CacheDataLoader( const std::string& filename,
+                                  const uint         importFlags,
+                                  const bool         VERBOSE_MODE ) :
+    m_filename( filename ),
+    m_directory( Core::StringUtils::getDirName( filename ) ),
+    m_flags( importFlags ),
+    m_sourceHash( 0 ),
+    m_sourceSize( 0 ),
+    m_hasKey( false ),
+    m_verbose( VERBOSE_MODE ) { }
+
+
+
+/// DESTRUCTOR
+CacheDataLoader::~CacheDataLoader() { }
+
+
+
+/// FILENAME
+std::string CacheDataLoader::getCacheFileName( const std::string& filename ) {
+    return filename + ".radium";
+}
+
+
+
+/// LOADING
+bool CacheDataLoader::loadData( std::vector< std::unique_ptr< GeometryData > >&  geometryData,
+                                std::vector< std::unique_ptr< HandleData > >&    handleData,
+                                std::vector< std::unique_ptr< AnimationData > >& animationData,
+                                std::vector< std::unique_ptr< LightData > >&     lightData ) {
+    Core::MappedFile file;
+    if( !file.open( getCacheFileName( m_filename ) ) || !computeSourceKey() ) {
+        return false;
+    }
+
+    Reader reader( file.data(), file.data() + file.size() );
+    const CacheHeader header = reader.read< CacheHeader >();
+    if( !reader.isValid() ||
+        std::memcmp( header.m_magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) ) != 0 ||
+        header.m_version    != VERSION      ||
+        header.m_flags      != m_flags      ||
+        header.m_sourceHash != m_sourceHash ||
+        header.m_sourceSize != m_sourceSize ||
+        header.m_scalarSize != sizeof( Scalar ) ) {
+        if( m_verbose ) {
+            LOG( logINFO ) << "Cache of \"" << m_filename << "\" is out of date.";
+        }
+        return false;
+    }
+
+    std::vector< std::unique_ptr< GeometryData > >  geometry;
+    std::vector< std::unique_ptr< HandleData > >    handle;
+    std::vector< std::unique_ptr< AnimationData > > animation;
+    std::vector< std::unique_ptr< LightData > >     light;
+    bool status = true;
+    for( uint i = 0; status && i < header.m_geometrySize; ++i ) {
+        geometry.emplace_back( new GeometryData() );
+        status = readGeometry( reader, *geometry.back(), m_directory );
+    }
+    for( uint i = 0; status && i < header.m_handleSize; ++i ) {
+        handle.emplace_back( new HandleData() );
+        status = readHandle( reader, *handle.back() );
+    }
+    for( uint i = 0; status && i < header.m_animationSize; ++i ) {
+        animation.emplace_back( new AnimationData() );
+        status = readAnimation( reader, *animation.back() );
+    }
+    for( uint i = 0; status && i < header.m_lightSize; ++i ) {
+        light.emplace_back( new LightData() );
+        status = readLight( reader, *light.back() );
+    }
+
+    if( !status ) {
+        LOG( logWARNING ) << "Cache of \"" << m_filename << "\" is corrupted.";
+        return false;
+    }
+
+    geometryData  = std::move( geometry );
+    handleData    = std::move( handle );
+    animationData = std::move( animation );
+    lightData     = std::move( light );
+    return true;
+}
+
+
+
+/// SAVING
+bool CacheDataLoader::saveData( const std::vector< std::unique_ptr< GeometryData > >&  geometryData,
+                                const std::vector< std::unique_ptr< HandleData > >&    handleData,
+                                const std::vector< std::unique_ptr< AnimationData > >& animationData,
+                                const std::vector< std::unique_ptr< LightData > >&     lightData ) {
+    if( !computeSourceKey() ) {
+        return false;
+    }
+
+    // The cache is written aside, so that an interrupted write never leaves a corrupted cache.
+    const std::string cacheName = getCacheFileName( m_filename );
+    const std::string tmpName   = cacheName + ".tmp";
+    {
+        std::ofstream file( tmpName, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary );
+        if( !file.is_open() ) {
+            LOG( logWARNING ) << "Cannot write cache \"" << cacheName << "\".";
+            return false;
+        }
+
+        CacheHeader header;
+        std::memset( &header, 0, sizeof( header ) );
+        std::memcpy( header.m_magic, CACHE_MAGIC, sizeof( CACHE_MAGIC ) );
+        header.m_version       = VERSION;
+        header.m_flags         = m_flags;
+        header.m_sourceHash    = m_sourceHash;
+        header.m_sourceSize    = m_sourceSize;
+        header.m_scalarSize    = sizeof( Scalar );
+        header.m_geometrySize  = geometryData.size();
+        header.m_handleSize    = handleData.size();
+        header.m_animationSize = animationData.size();
+        header.m_lightSize     = lightData.size();
+
+        Writer writer( file );
+        writer.write( header );
+        for( const auto& data : geometryData ) {
+            writeGeometry( writer, *data, m_directory );
+        }
+        for( const auto& data : handleData ) {
+            writeHandle( writer, *data );
+        }
+        for( const auto& data : animationData ) {
+            writeAnimation( writer, *data );
+        }
+        for( const auto& data : lightData ) {
+            writeLight( writer, *data );
+        }
+
+        file.close();
+        if( !file ) {
+            LOG( logWARNING ) << "Cannot write cache \"" << cacheName << "\".";
+            std::remove( tmpName.c_str() );
+            return false;
+        }
+    }
+
+    std::remove( cacheName.c_str() );
+    if( std::rename( tmpName.c_str(), cacheName.c_str() ) != 0 ) {
+        std::remove( tmpName.c_str() );
+        return false;
+    }
+    if( m_verbose ) {
+        LOG( logINFO ) << "Cache \"" << cacheName << "\" written.";
+    }
+    return true;
+}
+
+
+
+/// KEY
+bool CacheDataLoader::computeSourceKey() {
+    if( m_hasKey ) {
+        return true;
+    }
+    Core::MappedFile file;
+    if( !file.open( m_filename ) ) {
+        return false;
+    }
+
+    // Hash of the content, processed by 64 bits words.
+    const uint64_t size = file.size();
+    uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+    const char* data = file.data();
+    uint64_t i = 0;
+    for( ; i + 8 <= size; i += 8 ) {
+        uint64_t word;
+        std::memcpy( &word, data + i, 8 );
+        hash = ( ( ( hash << 5 ) | ( hash >> 59 ) ) ^ word ) * 0x9e3779b97f4a7c15ULL;
+    }
+    for( ; i < size; ++i ) {
+        hash = ( hash ^ uint8_t( data[i] ) ) * 0x100000001b3ULL;
+    }
+
+    m_sourceHash = hash;
+    m_sourceSize = size;
+    m_hasKey     = true;
+    return true;
+}
+
+
+
+/// GEOMETRY
+void CacheDataLoader::writeGeometry( Writer& writer, const GeometryData& data, const std::string& directory ) {
+    writer.writeString( data.getName() );
+    writer.writeTransform( data.m_frame );
+    writer.write( uint32_t( data.m_type ) );
+
+    writer.writeArray( data.m_vertex );
+    writer.writeArray( data.m_edge );
+    writer.writeNestedArray< GeometryData::VectorNuArray, uint >( data.m_faces );
+    writer.writeNestedArray< GeometryData::VectorNuArray, uint >( data.m_polyhedron );
+    writer.writeArray( data.m_normal );
+    writer.writeArray( *data.m_tangent );
+    writer.writeArray( *data.m_bitangent );
+    writer.writeArray( *data.m_texCoord );
+    writer.writeArray( *data.m_color );
+    writer.writeNestedArray< GeometryData::WeightArray, GeometryData::Weight >( data.m_weights );
+
+    const MaterialData& material = data.m_material;
+    writer.write( uint8_t( data.m_hasMaterial ) );
+    writer.write( material.m_diffuse );
+    writer.write( material.m_specular );
+    writer.write( material.m_shininess );
+    writer.write( material.m_opacity );
+    writer.writeString( toCachePath( material.m_texDiffuse, directory ) );
+    writer.writeString( toCachePath( material.m_texSpecular, directory ) );
+    writer.writeString( toCachePath( material.m_texShininess, directory ) );
+    writer.writeString( toCachePath( material.m_texNormal, directory ) );
+    writer.writeString( toCachePath( material.m_texOpacity, directory ) );
+    const uint8_t flags[9] = { material.m_hasDiffuse, material.m_hasSpecular, material.m_hasShininess,
+                               material.m_hasOpacity, material.m_hasTexDiffuse, material.m_hasTexSpecular,
+                               material.m_hasTexShininess, material.m_hasTexNormal, material.m_hasTexOpacity };
+    writer.writeBytes( flags, sizeof( flags ) );
+
+    const std::vector< std::pair< uint, uint > > duplicates( data.m_duplicateTable.begin(), data.m_duplicateTable.end() );
+    writer.writeArray( duplicates );
+    writer.write( uint8_t( data.m_loadDuplicates ) );
+}
+
+
+
+bool CacheDataLoader::readGeometry( Reader& reader, GeometryData& data, const std::string& directory ) {
+    data.setName( reader.readString() );
+    data.m_frame = reader.readTransform();
+    data.m_type  = GeometryData::GeometryType( reader.read< uint32_t >() );
+
+    reader.readArray( data.m_vertex );
+    reader.readArray( data.m_edge );
+    reader.readNestedArray< GeometryData::VectorNuArray, uint >( data.m_faces );
+    reader.readNestedArray< GeometryData::VectorNuArray, uint >( data.m_polyhedron );
+    reader.readArray( data.m_normal );
+    reader.readArray( *data.m_tangent );
+    reader.readArray( *data.m_bitangent );
+    reader.readArray( *data.m_texCoord );
+    reader.readArray( *data.m_color );
+    reader.readNestedArray< GeometryData::WeightArray, GeometryData::Weight >( data.m_weights );
+
+    MaterialData& material = data.m_material;
+    data.m_hasMaterial     = reader.read< uint8_t >() != 0;
+    material.m_diffuse     = reader.read< Core::Color >();
+    material.m_specular    = reader.read< Core::Color >();
+    material.m_shininess   = reader.read< Scalar >();
+    material.m_opacity     = reader.read< Scalar >();
+    material.m_texDiffuse   = fromCachePath( reader.readString(), directory );
+    material.m_texSpecular  = fromCachePath( reader.readString(), directory );
+    material.m_texShininess = fromCachePath( reader.readString(), directory );
+    material.m_texNormal    = fromCachePath( reader.readString(), directory );
+    material.m_texOpacity   = fromCachePath( reader.readString(), directory );
+    uint8_t flags[9];
+    reader.readBytes( flags, sizeof( flags ) );
+    material.m_hasDiffuse      = flags[0] != 0;
+    material.m_hasSpecular     = flags[1] != 0;
+    material.m_hasShininess    = flags[2] != 0;
+    material.m_hasOpacity      = flags[3] != 0;
+    material.m_hasTexDiffuse   = flags[4] != 0;
+    material.m_hasTexSpecular  = flags[5] != 0;
+    material.m_hasTexShininess = flags[6] != 0;
+    material.m_hasTexNormal    = flags[7] != 0;
+    material.m_hasTexOpacity   = flags[8] != 0;
+
+    std::vector< std::pair< uint, uint > > duplicates;
+    reader.readArray( duplicates );
+    data.m_duplicateTable = std::map< uint, uint >( duplicates.begin(), duplicates.end() );
+    data.m_loadDuplicates = reader.read< uint8_t >() != 0;
+
+    return reader.isValid();
+}
+
+
+
+/// HANDLE
+void CacheDataLoader::writeHandle( Writer& writer, const HandleData& data ) {
+    writer.writeString( data.getName() );
+    writer.writeTransform( data.m_frame );
+    writer.write( uint32_t( data.m_type ) );
+    writer.write( uint8_t( data.m_endNode ) );
+    writer.write( uint32_t( data.m_vertexSize ) );
+
+    writer.write( uint64_t( data.m_nameTable.size() ) );
+    for( const auto& item : data.m_nameTable ) {
+        writer.writeString( item.first );
+        writer.write( uint32_t( item.second ) );
+    }
+
+    writer.write( uint64_t( data.m_component.size() ) );
+    for( const auto& component : data.m_component ) {
+        writer.writeTransform( component.m_frame );
+        writer.writeString( component.m_name );
+        writer.writeArray( component.m_weight );
+    }
+
+    writer.writeArray( data.m_edge );
+    writer.writeNestedArray< Core::AlignedStdVector< Core::VectorNi >, int >( data.m_face );
+}
+
+
+
+bool CacheDataLoader::readHandle( Reader& reader, HandleData& data ) {
+    data.setName( reader.readString() );
+    data.m_frame      = reader.readTransform();
+    data.m_type       = HandleData::HandleType( reader.read< uint32_t >() );
+    data.m_endNode    = reader.read< uint8_t >() != 0;
+    data.m_vertexSize = reader.read< uint32_t >();
+
+    const uint64_t tableSize = reader.read< uint64_t >();
+    for( uint64_t i = 0; reader.isValid() && i < tableSize; ++i ) {
+        const std::string name = reader.readString();
+        data.m_nameTable[name] = reader.read< uint32_t >();
+    }
+
+    const uint64_t componentSize = reader.read< uint64_t >();
+    for( uint64_t i = 0; reader.isValid() && i < componentSize; ++i ) {
+        HandleComponentData component;
+        component.m_frame = reader.readTransform();
+        component.m_name  = reader.readString();
+        reader.readArray( component.m_weight );
+        data.m_component.push_back( component );
+    }
+
+    reader.readArray( data.m_edge );
+    reader.readNestedArray< Core::AlignedStdVector< Core::VectorNi >, int >( data.m_face );
+
+    return reader.isValid();
+}
+
+
+
+/// ANIMATION
+void CacheDataLoader::writeAnimation( Writer& writer, const AnimationData& data ) {
+    writer.writeString( data.m_name );
+    writer.write( data.m_time.getStart() );
+    writer.write( data.m_time.getEnd() );
+    writer.write( data.m_dt );
+
+    writer.write( uint64_t( data.m_keyFrame.size() ) );
+    for( const auto& handle : data.m_keyFrame ) {
+        writer.writeString( handle.m_name );
+        writer.write( handle.m_anim.getAnimationTime().getStart() );
+        writer.write( handle.m_anim.getAnimationTime().getEnd() );
+
+        const std::set< Time > schedule = handle.m_anim.timeSchedule();
+        const std::vector< Time > times( schedule.begin(), schedule.end() );
+        Core::AlignedStdVector< Core::Matrix4 > frames( times.size() );
+        for( uint i = 0; i < times.size(); ++i ) {
+            frames[i] = handle.m_anim.at( times[i] ).matrix();
+        }
+        writer.writeArray( times );
+        writer.writeArray( frames );
+    }
+}
+
+
+
+bool CacheDataLoader::readAnimation( Reader& reader, AnimationData& data ) {
+    data.setName( reader.readString() );
+    const Time start = reader.read< Time >();
+    const Time end   = reader.read< Time >();
+    data.setTime( AnimationTime( start, end ) );
+    data.setTimeStep( reader.read< Time >() );
+
+    const uint64_t handleSize = reader.read< uint64_t >();
+    for( uint64_t i = 0; reader.isValid() && i < handleSize; ++i ) {
+        HandleAnimation handle( reader.readString() );
+        const Time animStart = reader.read< Time >();
+        const Time animEnd   = reader.read< Time >();
+        handle.m_anim = KeyTransform( AnimationTime( animStart, animEnd ) );
+
+        std::vector< Time > times;
+        Core::AlignedStdVector< Core::Matrix4 > frames;
+        reader.readArray( times );
+        reader.readArray( frames );
+        if( times.size() != frames.size() ) {
+            return false;
+        }
+        for( uint k = 0; k < times.size(); ++k ) {
+            Core::Transform frame;
+            frame.matrix() = frames[k];
+            handle.m_anim.insertKeyFrame( times[k], frame );
+        }
+        data.m_keyFrame.push_back( handle );
+    }
+
+    return reader.isValid();
+}
+
+
+
+/// LIGHT
+void CacheDataLoader::writeLight( Writer& writer, const LightData& data ) {
+    writer.writeString( data.getName() );
+    writer.write( uint32_t( data.m_type ) );
+    writer.write( data.m_color );
+    writer.write( data.m_position );
+    writer.write( data.m_direction );
+    writer.write( data.m_constantAttenuation );
+    writer.write( data.m_linearAttenuation );
+    writer.write( data.m_quadraticAttenuation );
+    writer.write( data.m_innerAngle );
+    writer.write( data.m_outerAngle );
+}
+
+
+
+bool CacheDataLoader::readLight( Reader& reader, LightData& data ) {
+    data.setName( reader.readString() );
+    data.m_type                 = LightData::LightType( reader.read< uint32_t >() );
+    data.m_color                = reader.read< Core::Color >();
+    data.m_position             = reader.read< Core::Vector3 >();
+    data.m_direction            = reader.read< Core::Vector3 >();
+    data.m_constantAttenuation  = reader.read< Scalar >();
+    data.m_linearAttenuation    = reader.read< Scalar >();
+    data.m_quadraticAttenuation = reader.read< Scalar >();
+    data.m_innerAngle           = reader.read< Scalar >();
+    data.m_outerAngle           = reader.read< Scalar >();
+
+    return reader.isValid();
+}
+
+
+
+} // namespace Asset
+} // namespace Ra
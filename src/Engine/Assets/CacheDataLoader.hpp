@@ -0,0 +1,93 @@
+#ifndef RADIUMENGINE_CACHE_DATA_LOADER_HPP
+#define RADIUMENGINE_CACHE_DATA_LOADER_HPP
+
+#include <Engine/RaEngine.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Ra {
+namespace Asset {
+
+class GeometryData;
+class HandleData;
+class AnimationData;
+class LightData;
+
+/*
+* The class CacheDataLoader stores the processed data of an asset file in a binary cache file,
+* next to the source file, so that the import work is only done once.
+* The cache is keyed by a hash of the source file content and by the import flags : it is
+* ignored when the source file, the flags or the cache format change.
+* The cache is only used when it is enabled (see FileData::setUseCache()).
+* Arrays are stored as raw blocks, aligned on 16 bytes, and are copied at once from the
+* mapped cache file to the data.
+*/
+class RA_ENGINE_API CacheDataLoader {
+public:
+    /// Version of the cache format. To be incremented when the data or its processing changes.
+    static const uint32_t VERSION = 2;
+
+    /// CONSTRUCTOR
+    CacheDataLoader( const std::string& filename,
+                     const uint         importFlags,
+                     const bool         VERBOSE_MODE = false );
+
+    /// DESTRUCTOR
+    ~CacheDataLoader();
+
+    /// FILENAME
+    static std::string getCacheFileName( const std::string& filename );
+
+    /// LOADING
+    bool loadData( std::vector< std::unique_ptr< GeometryData > >&  geometryData,
+                   std::vector< std::unique_ptr< HandleData > >&    handleData,
+                   std::vector< std::unique_ptr< AnimationData > >& animationData,
+                   std::vector< std::unique_ptr< LightData > >&     lightData );       // Return false if there is no valid cache for the file.
+
+    /// SAVING
+    bool saveData( const std::vector< std::unique_ptr< GeometryData > >&  geometryData,
+                   const std::vector< std::unique_ptr< HandleData > >&    handleData,
+                   const std::vector< std::unique_ptr< AnimationData > >& animationData,
+                   const std::vector< std::unique_ptr< LightData > >&     lightData );       // Return false if the cache cannot be written.
+
+protected:
+    class Writer;
+    class Reader;
+
+    /// KEY
+    bool computeSourceKey();                                                // Hash the source file. Return false if it cannot be read.
+
+    /// GEOMETRY
+    static void writeGeometry( Writer& writer, const GeometryData& data, const std::string& directory );
+    static bool readGeometry( Reader& reader, GeometryData& data, const std::string& directory );
+
+    /// HANDLE
+    static void writeHandle( Writer& writer, const HandleData& data );
+    static bool readHandle( Reader& reader, HandleData& data );
+
+    /// ANIMATION
+    static void writeAnimation( Writer& writer, const AnimationData& data );
+    static bool readAnimation( Reader& reader, AnimationData& data );
+
+    /// LIGHT
+    static void writeLight( Writer& writer, const LightData& data );
+    static bool readLight( Reader& reader, LightData& data );
+
+protected:
+    /// VARIABLE
+    std::string m_filename;
+    std::string m_directory;
+    uint32_t    m_flags;
+    uint64_t    m_sourceHash;
+    uint64_t    m_sourceSize;
+    bool        m_hasKey;
+    bool        m_verbose;
+};
+
+} // namespace Asset
+} // namespace Ra
+
+#endif // RADIUMENGINE_CACHE_DATA_LOADER_HPP
@@ -10,6 +10,8 @@
 #include <Engine/Assets/AssimpGeometryDataLoader.hpp>
 #include <Engine/Assets/AssimpHandleDataLoader.hpp>
 #include <Engine/Assets/AssimpAnimationDataLoader.hpp>
+#include <Engine/Assets/AssimpLightDataLoader.hpp>
+#include <Engine/Assets/CacheDataLoader.hpp>
 
 namespace Ra {
 namespace Asset {
@@ -18,14 +20,18 @@ namespace Asset {
 
 /// CONSTRUCTOR
 FileData::FileData( const std::string& filename,
-                    const bool         VERBOSE_MODE ) :
+                    const bool         VERBOSE_MODE,
+                    const bool         USE_CACHE ) :
     m_filename( filename ),
     m_loadingTime( 0.0 ),
     m_geometryData(),
     m_handleData(),
     m_animationData(),
+    m_lightData(),
     m_processed( false ),
-    m_verbose( VERBOSE_MODE ) {
+    m_verbose( VERBOSE_MODE ),
+    m_useCache( USE_CACHE ),
+    m_loadedFromCache( false ) {
     loadFile();
 }
 
@@ -51,15 +57,32 @@ void FileData::loadFile( const bool FORCE_RELOAD ) {
     // File extension check
     // - If we decide to deal with user-defined file, here we should check if we are dealing with one of them or not
 
+    const uint flags = aiProcess_Triangulate           | // This could/should be taken away if we want to deal with mesh types other than trimehses
+                       aiProcess_JoinIdenticalVertices |
+                       aiProcess_GenSmoothNormals      |
+                       aiProcess_SortByPType           |
+                       aiProcess_FixInfacingNormals    |
+                       aiProcess_CalcTangentSpace      |
+                       aiProcess_GenUVCoords;
+
+    // The processed data is reused if the file did not change since it was cached.
+    CacheDataLoader cacheLoader( getFileName(), flags, m_verbose );
+    if( m_useCache ) {
+        std::clock_t startTime = std::clock();
+        if( cacheLoader.loadData( m_geometryData, m_handleData, m_animationData, m_lightData ) ) {
+            m_loadingTime = ( std::clock() - startTime ) / Scalar( CLOCKS_PER_SEC );
+            m_loadedFromCache = true;
+            m_processed = true;
+            if( m_verbose ) {
+                LOG(logINFO) << "File loaded from cache \"" << CacheDataLoader::getCacheFileName( getFileName() ) << "\".";
+                displayInfo();
+            }
+            return;
+        }
+    }
+
     Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile( getFileName(),
-                                              aiProcess_Triangulate           | // This could/should be taken away if we want to deal with mesh types other than trimehses
-                                              aiProcess_JoinIdenticalVertices |
-                                              aiProcess_GenSmoothNormals      |
-                                              aiProcess_SortByPType           |
-                                              aiProcess_FixInfacingNormals    |
-                                              aiProcess_CalcTangentSpace      |
-                                              aiProcess_GenUVCoords );
+    const aiScene* scene = importer.ReadFile( getFileName(), flags );
 
     // File was not loaded
     if( scene == nullptr ) {
@@ -83,8 +106,15 @@ void FileData::loadFile( const bool FORCE_RELOAD ) {
     AssimpAnimationDataLoader animationLoader( m_verbose );
     animationLoader.loadData( scene, m_animationData );
 
+    AssimpLightDataLoader lightLoader( m_verbose );
+    lightLoader.loadData( scene, m_lightData );
+
     m_loadingTime = ( std::clock() - startTime ) / Scalar( CLOCKS_PER_SEC );
 
+    if( m_useCache ) {
+        cacheLoader.saveData( m_geometryData, m_handleData, m_animationData, m_lightData );
+    }
+
     if( m_verbose ) {
         LOG(logINFO) << "File Loading end.";
         displayInfo();
@@ -13,12 +13,14 @@ namespace Asset {
 class GeometryData;
 class HandleData;
 class AnimationData;
+class LightData;
 
 class RA_ENGINE_API FileData {
 public:
     /// CONSTRUCTOR
     FileData( const std::string& filename = "",
-              const bool VERBOSE_MODE = false );
+              const bool VERBOSE_MODE = false,
+              const bool USE_CACHE = false );
 
     FileData( FileData&& data ) = default;
 
@@ -40,16 +42,23 @@ public:
     inline std::vector<  GeometryData* > getGeometryData() const;
     inline std::vector<    HandleData* > getHandleData()   const;
     inline std::vector< AnimationData* > getAnimationData() const;
+    inline std::vector<     LightData* > getLightData()     const;
 
     inline void setVerbose( const bool VERBOSE_MODE );
 
+    /// CACHE
+    inline void setUseCache( const bool USE_CACHE );                // Load from and store to the binary cache of the file (see CacheDataLoader). Off by default, the cache is written next to the file.
+
     /// QUERY
     inline bool isInitialized() const;
     inline bool isProcessed() const;
     inline bool hasGeometry() const;
     inline bool hasHandle() const;
     inline bool hasAnimation() const;
+    inline bool hasLight() const;
     inline bool isVerbose() const;
+    inline bool isUsingCache() const;
+    inline bool isLoadedFromCache() const;
 
     /// RESET
     inline void reset();
@@ -63,8 +72,11 @@ protected:
     std::vector< std::unique_ptr< GeometryData > >  m_geometryData;
     std::vector< std::unique_ptr< HandleData > >    m_handleData;
     std::vector< std::unique_ptr< AnimationData > > m_animationData;
+    std::vector< std::unique_ptr< LightData > >     m_lightData;
     bool                                            m_processed;
     bool                                            m_verbose;
+    bool                                            m_useCache;
+    bool                                            m_loadedFromCache;
 };
 
 } // namespace Asset
@@ -4,6 +4,7 @@
 #include <Engine/Assets/GeometryData.hpp>
 #include <Engine/Assets/HandleData.hpp>
 #include <Engine/Assets/AnimationData.hpp>
+#include <Engine/Assets/LightData.hpp>
 
 namespace Ra {
 namespace Asset {
@@ -51,10 +52,24 @@ inline std::vector< AnimationData* > FileData::getAnimationData() const {
     return list;
 }
 
+inline std::vector< LightData* > FileData::getLightData() const {
+    std::vector< LightData* > list;
+    list.reserve( m_lightData.size() );
+    for( const auto& item : m_lightData ) {
+        list.push_back( item.get() );
+    }
+    return list;
+}
+
 inline void FileData::setVerbose( const bool VERBOSE_MODE ) {
     m_verbose = VERBOSE_MODE;
 }
 
+/// CACHE
+inline void FileData::setUseCache( const bool USE_CACHE ) {
+    m_useCache = USE_CACHE;
+}
+
 /// QUERY
 inline bool FileData::isInitialized() const {
     return ( ( m_filename != "" ) && !m_processed );
@@ -76,10 +91,22 @@ inline bool FileData::hasAnimation() const {
     return ( !m_animationData.empty() );
 }
 
+inline bool FileData::hasLight() const {
+    return ( !m_lightData.empty() );
+}
+
 inline bool FileData::isVerbose() const {
     return m_verbose;
 }
 
+inline bool FileData::isUsingCache() const {
+    return m_useCache;
+}
+
+inline bool FileData::isLoadedFromCache() const {
+    return m_loadedFromCache;
+}
+
 /// RESET
 inline void FileData::reset()
 {
@@ -87,7 +114,9 @@ inline void FileData::reset()
     m_geometryData.clear();
     m_handleData.clear();
     m_animationData.clear();
+    m_lightData.clear();
     m_processed = false;
+    m_loadedFromCache = false;
 }
 
 inline void FileData::displayInfo() const {
@@ -101,6 +130,7 @@ inline void FileData::displayInfo() const {
     LOG(logINFO) << "Total vertex count : " << vtxCount;
     LOG(logINFO) << "Handle loaded      : " << m_handleData.size();
     LOG(logINFO) << "Animation loaded   : " << m_animationData.size();
+    LOG(logINFO) << "Light loaded       : " << m_lightData.size();
     LOG(logINFO) << "Loading Time (sec) : " << m_loadingTime;
 }
 
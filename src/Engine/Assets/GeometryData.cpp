@@ -37,10 +37,10 @@ GeometryData::GeometryData( const std::string&  name,
     m_faces(),
     m_polyhedron(),
     m_normal(),
-    m_tangent(),
-    m_bitangent(),
-    m_texCoord(),
-    m_color(),
+    m_tangent( std::make_shared< Vector3Array >() ),
+    m_bitangent( std::make_shared< Vector3Array >() ),
+    m_texCoord( std::make_shared< Vector3Array >() ),
+    m_color( std::make_shared< ColorArray >() ),
     m_material(),
     m_hasMaterial( false ),
     m_loadDuplicates( false ) { }
@@ -1,6 +1,7 @@
 #ifndef RADIUMENGINE_GEOMETRY_DATA_HPP
 #define RADIUMENGINE_GEOMETRY_DATA_HPP
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -53,6 +54,7 @@ class GeometryData : public AssetData {
 
     /// FRIEND
     friend class AssimpGeometryDataLoader;
+    friend class CacheDataLoader;
 
 public:
     using Vector3Array  = Core::VectorArray<Core::Vector3>  ;
@@ -112,6 +114,14 @@ public:
     inline const WeightArray  & getWeights()    const;
     inline const MaterialData & getMaterial()   const;
 
+    /// SHARED DATA
+    /// The attribute arrays are shared with their users (e.g. display meshes),
+    /// which can keep them without copying them. Shared arrays are never modified.
+    inline std::shared_ptr< const Vector3Array > getSharedTangents()   const;
+    inline std::shared_ptr< const Vector3Array > getSharedBiTangents() const;
+    inline std::shared_ptr< const Vector3Array > getSharedTexCoords()  const;
+    inline std::shared_ptr< const ColorArray   > getSharedColors()     const;
+
     inline const std::map< uint, uint >& getDuplicateTable() const;
 
     /// DUPLICATES
@@ -198,10 +208,10 @@ protected:
     VectorNuArray m_faces;
     VectorNuArray m_polyhedron;
     Vector3Array  m_normal;
-    Vector3Array  m_tangent;
-    Vector3Array  m_bitangent;
-    Vector3Array  m_texCoord;
-    ColorArray    m_color;
+    std::shared_ptr< Vector3Array > m_tangent;   // Never null. Replaced, not modified,
+    std::shared_ptr< Vector3Array > m_bitangent; // once it has been set.
+    std::shared_ptr< Vector3Array > m_texCoord;
+    std::shared_ptr< ColorArray   > m_color;
     WeightArray   m_weights;
 
     MaterialData m_material;
@@ -98,20 +98,40 @@ namespace Ra {
 
         inline const GeometryData::Vector3Array& GeometryData::getTangents() const
         {
-            return m_tangent;
+            return *m_tangent;
         }
 
         inline const GeometryData::Vector3Array& GeometryData::getBiTangents() const
         {
-            return m_bitangent;
+            return *m_bitangent;
         }
 
         inline const GeometryData::Vector3Array& GeometryData::getTexCoords() const
         {
-            return m_texCoord;
+            return *m_texCoord;
         }
 
         inline const GeometryData::ColorArray& GeometryData::getColors() const
+        {
+            return *m_color;
+        }
+
+        inline std::shared_ptr< const GeometryData::Vector3Array > GeometryData::getSharedTangents() const
+        {
+            return m_tangent;
+        }
+
+        inline std::shared_ptr< const GeometryData::Vector3Array > GeometryData::getSharedBiTangents() const
+        {
+            return m_bitangent;
+        }
+
+        inline std::shared_ptr< const GeometryData::Vector3Array > GeometryData::getSharedTexCoords() const
+        {
+            return m_texCoord;
+        }
+
+        inline std::shared_ptr< const GeometryData::ColorArray > GeometryData::getSharedColors() const
         {
             return m_color;
         }
@@ -185,19 +205,19 @@ namespace Ra {
         }
 
         inline bool GeometryData::hasTangents() const {
-            return !m_tangent.empty();
+            return !m_tangent->empty();
         }
 
         inline bool GeometryData::hasBiTangents() const {
-            return !m_bitangent.empty();
+            return !m_bitangent->empty();
         }
 
         inline bool GeometryData::hasTextureCoordinates() const {
-            return !m_texCoord.empty();
+            return !m_texCoord->empty();
         }
 
         inline bool GeometryData::hasColors() const {
-            return !m_color.empty();
+            return !m_color->empty();
         }
 
         inline bool GeometryData::hasWeights() const {
@@ -232,10 +252,10 @@ namespace Ra {
             LOG( logINFO ) << " Edge #         : " << m_edge.size();
             LOG( logINFO ) << " Face #         : " << m_faces.size();
             LOG( logINFO ) << " Normal ?       : " << ( ( m_normal.empty()    ) ? "NO" : "YES" );
-            LOG( logINFO ) << " Tangent ?      : " << ( ( m_tangent.empty()   ) ? "NO" : "YES" );
-            LOG( logINFO ) << " Bitangent ?    : " << ( ( m_bitangent.empty() ) ? "NO" : "YES" );
-            LOG( logINFO ) << " Tex.Coord. ?   : " << ( ( m_texCoord.empty()  ) ? "NO" : "YES" );
-            LOG( logINFO ) << " Color ?        : " << ( ( m_color.empty()     ) ? "NO" : "YES" );
+            LOG( logINFO ) << " Tangent ?      : " << ( ( m_tangent->empty()   ) ? "NO" : "YES" );
+            LOG( logINFO ) << " Bitangent ?    : " << ( ( m_bitangent->empty() ) ? "NO" : "YES" );
+            LOG( logINFO ) << " Tex.Coord. ?   : " << ( ( m_texCoord->empty()  ) ? "NO" : "YES" );
+            LOG( logINFO ) << " Color ?        : " << ( ( m_color->empty()     ) ? "NO" : "YES" );
             LOG( logINFO ) << " Material ?     : " << ( ( !m_hasMaterial      ) ? "NO" : "YES" );
             LOG( logINFO ) << " Has Dup. Vert. : " << ( ( m_duplicateTable.size() == m_vertex.size() ) ? "NO" : "YES" );
 
@@ -352,42 +372,22 @@ namespace Ra {
 
 /// TANGENT
         inline void GeometryData::setTangents( const std::vector< Core::Vector3 >& tangentList ) {
-            const uint size = tangentList.size();
-            m_tangent.resize( size );
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) {
-                m_tangent[i] = tangentList[i];
-            }
+            m_tangent = std::make_shared< Vector3Array >( tangentList.begin(), tangentList.end() );
         }
 
 /// BITANGENT
         inline void GeometryData::setBitangents( const std::vector< Core::Vector3 >& bitangentList ) {
-            const uint size = bitangentList.size();
-            m_bitangent.resize( size );
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) {
-                m_bitangent[i] = bitangentList[i];
-            }
+            m_bitangent = std::make_shared< Vector3Array >( bitangentList.begin(), bitangentList.end() );
         }
 
 /// TEXTURE COORDINATE
         inline void GeometryData::setTextureCoordinates( const std::vector< Core::Vector3 >& texCoordList ) {
-            const uint size = texCoordList.size();
-            m_texCoord.resize( size );
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) {
-                m_texCoord[i] = texCoordList[i];
-            }
+            m_texCoord = std::make_shared< Vector3Array >( texCoordList.begin(), texCoordList.end() );
         }
 
 /// COLOR
         inline void GeometryData::setColors( const std::vector< Core::Color >& colorList ) {
-            const uint size = colorList.size();
-            m_color.resize( size );
-#pragma omp parallel for
-            for( int i = 0; i < int(size); ++i ) {
-                m_color[i] = colorList[i];
-            }
+            m_color = std::make_shared< ColorArray >( colorList.begin(), colorList.end() );
         }
 
 /// WEIGHTS
@@ -25,6 +25,7 @@ class HandleData : public AssetData {
 public:
     /// FRIEND
     friend class AssimpHandleDataLoader;
+    friend class CacheDataLoader;
 
     /// ENUM
     enum HandleType {
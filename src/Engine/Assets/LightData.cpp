@@ -0,0 +1,24 @@
+#include <Engine/Assets/LightData.hpp>
+
+namespace Ra {
+namespace Asset {
+
+/// CONSTRUCTOR
+LightData::LightData( const std::string& name,
+                      const LightType&   type ) :
+    AssetData( name ),
+    m_type( type ),
+    m_color( Core::Color::Ones() ),
+    m_position( Core::Vector3::Zero() ),
+    m_direction( Core::Vector3::UnitZ() ),
+    m_constantAttenuation( 1.0 ),
+    m_linearAttenuation( 0.0 ),
+    m_quadraticAttenuation( 0.0 ),
+    m_innerAngle( 0.0 ),
+    m_outerAngle( 0.0 ) { }
+
+/// DESTRUCTOR
+LightData::~LightData() { }
+
+} // namespace Asset
+} // namespace Ra
@@ -0,0 +1,88 @@
+#ifndef RADIUMENGINE_LIGHT_DATA_HPP
+#define RADIUMENGINE_LIGHT_DATA_HPP
+
+#include <string>
+#include <Core/Math/LinearAlgebra.hpp>
+
+#include <Engine/Assets/AssetData.hpp>
+#include <Engine/Assets/AssimpLightDataLoader.hpp>
+
+namespace Ra {
+namespace Asset {
+
+/*
+* The class LightData stores a light of an asset file, in the frame of the scene, so that
+* the lights can be created without reading the file again (see Engine::Renderer::loadLights()).
+*/
+class LightData : public AssetData {
+public:
+    /// FRIEND
+    friend class AssimpLightDataLoader;
+    friend class CacheDataLoader;
+
+    /// ENUM
+    enum LightType {
+        UNKNOWN     = 1 << 0,
+        DIRECTIONAL = 1 << 1,
+        POINT       = 1 << 2,
+        SPOT        = 1 << 3
+    };
+
+    RA_CORE_ALIGNED_NEW
+
+    /// CONSTRUCTOR
+    LightData( const std::string& name = "",
+               const LightType&   type = UNKNOWN );
+
+    LightData( const LightData& data ) = default;
+
+    /// DESTRUCTOR
+    ~LightData();
+
+    /// TYPE
+    inline LightType getType() const;
+
+    /// COLOR
+    inline Core::Color getColor() const;
+
+    /// FRAME
+    inline Core::Vector3 getPosition() const;                     // Point and spot lights.
+    inline Core::Vector3 getDirection() const;                    // Directional and spot lights, as given by the file.
+
+    /// ATTENUATION
+    inline Scalar getConstantAttenuation() const;
+    inline Scalar getLinearAttenuation() const;
+    inline Scalar getQuadraticAttenuation() const;
+
+    /// CONE
+    inline Scalar getInnerAngle() const;                          // In radians.
+    inline Scalar getOuterAngle() const;                          // In radians.
+
+    /// QUERY
+    inline bool isDirectional() const;
+    inline bool isPoint() const;
+    inline bool isSpot() const;
+
+protected:
+    /// NAME
+    inline void setName( const std::string& name );
+
+protected:
+    /// VARIABLE
+    LightType     m_type;
+    Core::Color   m_color;
+    Core::Vector3 m_position;
+    Core::Vector3 m_direction;
+    Scalar        m_constantAttenuation;
+    Scalar        m_linearAttenuation;
+    Scalar        m_quadraticAttenuation;
+    Scalar        m_innerAngle;
+    Scalar        m_outerAngle;
+};
+
+} // namespace Asset
+} // namespace Ra
+
+#include <Engine/Assets/LightData.inl>
+
+#endif // RADIUMENGINE_LIGHT_DATA_HPP
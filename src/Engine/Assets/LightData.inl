@@ -0,0 +1,66 @@
+#include <Engine/Assets/LightData.hpp>
+
+namespace Ra {
+namespace Asset {
+
+/// TYPE
+inline LightData::LightType LightData::getType() const {
+    return m_type;
+}
+
+/// COLOR
+inline Core::Color LightData::getColor() const {
+    return m_color;
+}
+
+/// FRAME
+inline Core::Vector3 LightData::getPosition() const {
+    return m_position;
+}
+
+inline Core::Vector3 LightData::getDirection() const {
+    return m_direction;
+}
+
+/// ATTENUATION
+inline Scalar LightData::getConstantAttenuation() const {
+    return m_constantAttenuation;
+}
+
+inline Scalar LightData::getLinearAttenuation() const {
+    return m_linearAttenuation;
+}
+
+inline Scalar LightData::getQuadraticAttenuation() const {
+    return m_quadraticAttenuation;
+}
+
+/// CONE
+inline Scalar LightData::getInnerAngle() const {
+    return m_innerAngle;
+}
+
+inline Scalar LightData::getOuterAngle() const {
+    return m_outerAngle;
+}
+
+/// QUERY
+inline bool LightData::isDirectional() const {
+    return ( m_type == DIRECTIONAL );
+}
+
+inline bool LightData::isPoint() const {
+    return ( m_type == POINT );
+}
+
+inline bool LightData::isSpot() const {
+    return ( m_type == SPOT );
+}
+
+/// NAME
+inline void LightData::setName( const std::string& name ) {
+    m_name = name;
+}
+
+} // namespace Asset
+} // namespace Ra
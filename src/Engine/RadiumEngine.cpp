@@ -14,6 +14,8 @@
 #include <Core/Event/EventEnums.hpp>
 #include <Core/Event/KeyEvent.hpp>
 #include <Core/Event/MouseEvent.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Time/Profiler.hpp>
 
 #include <Engine/FrameInfo.hpp>
 #include <Engine/System/System.hpp>
@@ -32,6 +34,10 @@ namespace Ra
     {
 
         RadiumEngine::RadiumEngine()
+            : m_persistentTasks( false )
+            , m_systemsChanged( true )
+            , m_numPersistentTasks( 0 )
+            , m_useFileCache( false )
         {
         }
 
@@ -51,6 +57,13 @@ namespace Ra
 
         void RadiumEngine::cleanup()
         {
+            // Wait for the files being loaded, their data is dropped.
+            for ( auto& file : m_pendingFiles )
+            {
+                file.second.wait();
+            }
+            m_pendingFiles.clear();
+
             m_signalManager->setOn( false );
             m_entityManager.reset();
             m_renderObjectManager.reset();
@@ -74,10 +87,59 @@ namespace Ra
             FrameInfo frameInfo;
             frameInfo.m_dt = dt;
             frameInfo.m_numFrame = frameCounter++;
+
+            auto isPersistent = [this]( const std::shared_ptr<System>& syst )
+            {
+                return m_persistentTasks && syst->hasPersistentTasks();
+            };
+
+            bool rebuild = m_systemsChanged;
+            for ( const auto& syst : m_systems )
+            {
+                rebuild = rebuild || ( isPersistent( syst.second ) && syst.second->hasComponentsChanged() );
+            }
+
+            if ( !rebuild )
+            {
+                // Only the tasks of the systems without persistent tasks are generated again.
+                // Dependencies of the kept tasks on them are resolved again by name.
+                taskQueue->removeTasksFrom( m_numPersistentTasks );
+                for ( auto& syst : m_systems )
+                {
+                    if ( isPersistent( syst.second ) )
+                    {
+                        syst.second->updateTasks( frameInfo );
+                    }
+                    else
+                    {
+                        syst.second->generateTasks( taskQueue, frameInfo );
+                        syst.second->clearComponentsChanged();
+                    }
+                }
+                return;
+            }
+
+            // The tasks of the systems with persistent tasks are registered first, so that
+            // the tasks of the other systems can be removed alone on the next frames.
+            taskQueue->flushTaskQueue();
+            for ( auto& syst : m_systems )
+            {
+                if ( isPersistent( syst.second ) )
+                {
+                    syst.second->generateTasks( taskQueue, frameInfo );
+                    syst.second->clearComponentsChanged();
+                }
+            }
+            m_numPersistentTasks = taskQueue->getNumTasks();
             for ( auto& syst : m_systems )
             {
-                syst.second->generateTasks( taskQueue, frameInfo );
+                if ( !isPersistent( syst.second ) )
+                {
+                    syst.second->generateTasks( taskQueue, frameInfo );
+                    syst.second->clearComponentsChanged();
+                }
             }
+            m_systemsChanged = false;
         }
 
         void RadiumEngine::registerSystem( const std::string& name, System* system )
@@ -86,6 +148,7 @@ namespace Ra
                          "Same system added multiple times." );
 
             m_systems[name] = std::shared_ptr<System> ( system );
+            m_systemsChanged = true;
             LOG(logINFO) << "Loaded : " << name;
         }
 
@@ -104,8 +167,56 @@ namespace Ra
 
         bool RadiumEngine::loadFile( const std::string& filename )
         {
-            Asset::FileData fileData( filename, false );
+            RA_PROFILE_ZONE( "Load file" );
+            reportLoadingProgress( "Importing file", 0, 1 );
+            Asset::FileData fileData( filename, false, m_useFileCache );
+            reportLoadingProgress( "Importing file", 1, 1 );
+
+            createFileEntity( filename, fileData );
+
+            return true;
+        }
+
+        void RadiumEngine::loadFileAsync( const std::string& filename )
+        {
+            // The file is parsed and converted by its own thread. Its conversion loops use the
+            // threads of the task queue of the frames, which only help with them while no tasks
+            // are running, so that the frames never wait for a loop of the loader.
+            const bool useCache = m_useFileCache;
+            auto load = [this, filename, useCache]()
+            {
+                Core::Profiler::getInstance().setThreadName( "File loader" );
+                RA_PROFILE_ZONE( "Import file" );
+                reportLoadingProgress( "Importing file", 0, 1 );
+                std::unique_ptr<Asset::FileData> fileData( new Asset::FileData( filename, false, useCache ) );
+                reportLoadingProgress( "Importing file", 1, 1 );
+                return fileData;
+            };
+            m_pendingFiles.emplace_back( filename, std::async( std::launch::async, load ) );
+        }
+
+        std::vector<std::unique_ptr<Asset::FileData>> RadiumEngine::processLoadedFiles()
+        {
+            std::vector<std::unique_ptr<Asset::FileData>> loadedFiles;
+            for ( auto it = m_pendingFiles.begin(); it != m_pendingFiles.end(); )
+            {
+                if ( it->second.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+                {
+                    ++it;
+                    continue;
+                }
+
+                std::unique_ptr<Asset::FileData> fileData = it->second.get();
+                createFileEntity( it->first, *fileData );
+                loadedFiles.push_back( std::move( fileData ) );
+                it = m_pendingFiles.erase( it );
+            }
+            return loadedFiles;
+        }
 
+        void RadiumEngine::createFileEntity( const std::string& filename, const Asset::FileData& fileData )
+        {
+            RA_PROFILE_ZONE( "Create file entity" );
             std::string entityName = Core::StringUtils::getBaseName( filename, false );
 
             Entity* entity = m_entityManager->createEntity( entityName );
@@ -118,8 +229,21 @@ namespace Ra
             {
                 comp->initialize();
             }
+        }
 
-            return true;
+        void RadiumEngine::setLoadingProgressCallback( const LoadingProgressCallback& callback )
+        {
+            std::lock_guard<std::mutex> lock( m_loadingProgressMutex );
+            m_loadingProgress = callback;
+        }
+
+        void RadiumEngine::reportLoadingProgress( const std::string& step, uint done, uint total )
+        {
+            std::lock_guard<std::mutex> lock( m_loadingProgressMutex );
+            if ( m_loadingProgress )
+            {
+                m_loadingProgress( step, done, total );
+            }
         }
 
         RenderObjectManager* RadiumEngine::getRenderObjectManager() const
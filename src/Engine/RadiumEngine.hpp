@@ -3,6 +3,8 @@
 
 #include <Engine/RaEngine.hpp>
 
+#include <functional>
+#include <future>
 #include <mutex>
 #include <map>
 #include <string>
@@ -31,6 +33,11 @@ namespace Ra
         class Entity;
         class Component;
     }
+
+    namespace Asset
+    {
+        class FileData;
+    }
 }
 
 namespace Ra
@@ -40,6 +47,10 @@ namespace Ra
         class RA_ENGINE_API RadiumEngine
         {
             RA_SINGLETON_INTERFACE(RadiumEngine);
+        public:
+            /// Receives the number of items of a loading step processed so far.
+            typedef std::function<void( const std::string& step, uint done, uint total )> LoadingProgressCallback;
+
         public:
             RadiumEngine();
             ~RadiumEngine();
@@ -47,14 +58,46 @@ namespace Ra
             void initialize();
             void cleanup();
 
+            /// Fills the task queue with the tasks of all the systems for the frame.
+            /// In persistent task mode, the tasks of the systems with persistent tasks are kept
+            /// in the queue and only updated, unless a system or one of their components was
+            /// added or removed. Only the tasks of the other systems are generated again.
             void getTasks( Core::TaskQueue* taskQueue, Scalar dt );
 
+            /// Toggles the reuse of the task graph from one frame to the next.
+            void setPersistentTasks( bool on ) { m_persistentTasks = on; m_systemsChanged = true; }
+
             void registerSystem( const std::string& name,
                                  System* system );
             System* getSystem( const std::string& system ) const;
 
+            /// Reuses the processed data of the loaded files from a binary cache, written
+            /// next to each file (see Asset::CacheDataLoader). Off by default.
+            void setUseFileCache( bool on ) { m_useFileCache = on; }
+
+            /// Loads a file and creates its entity, blocking until it is done.
             bool loadFile( const std::string& file );
 
+            /// Starts loading a file on a background thread, while the frames go on.
+            /// The entity of the file is created by processLoadedFiles() once the file is read.
+            void loadFileAsync( const std::string& file );
+
+            /// Creates the entities of the files whose background loading is over.
+            /// Must be called from the main thread, between two frames.
+            /// Returns the data of the files which were added to the scene, e.g. to add
+            /// their lights to the renderers.
+            std::vector<std::unique_ptr<Asset::FileData>> processLoadedFiles();
+
+            /// Returns true if files are being loaded in the background.
+            bool isLoadingFiles() const { return !m_pendingFiles.empty(); }
+
+            /// Sets the function receiving the progress of loadFile(). It can be called from
+            /// the task queue threads, but never from two threads at once.
+            void setLoadingProgressCallback( const LoadingProgressCallback& callback );
+
+            /// Reports the progress of a loading step. Can be called from any thread.
+            void reportLoadingProgress( const std::string& step, uint done, uint total );
+
             /// Is called at the end of the frame to synchronize any data
             /// that may have been updated during the frame's multithreaded processing.
             void endFrameSync();
@@ -64,12 +107,31 @@ namespace Ra
             EntityManager*        getEntityManager()        const;
             SignalManager*        getSignalManager()        const;
 
+        private:
+            /// Creates the entity of a loaded file and lets the systems create its components.
+            void createFileEntity( const std::string& filename, const Asset::FileData& fileData );
+
         private:
             std::map<std::string, std::shared_ptr<System>> m_systems;
 
+            /// Files being read in the background, with the name of the file.
+            std::vector<std::pair<std::string, std::future<std::unique_ptr<Asset::FileData>>>> m_pendingFiles;
+
             std::unique_ptr<RenderObjectManager> m_renderObjectManager;
             std::unique_ptr<EntityManager>       m_entityManager;
             std::unique_ptr<SignalManager>       m_signalManager;
+
+            /// If true, the task graph is kept across frames.
+            bool m_persistentTasks;
+            /// True if a system was registered since the tasks were generated.
+            bool m_systemsChanged;
+            /// Number of tasks of the systems with persistent tasks, registered before the others.
+            uint m_numPersistentTasks;
+            /// If true, the loaded files use their binary cache.
+            bool m_useFileCache;
+
+            LoadingProgressCallback m_loadingProgress;
+            std::mutex m_loadingProgressMutex;
         };
 
     } // namespace Engine
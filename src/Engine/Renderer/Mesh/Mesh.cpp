@@ -2,16 +2,32 @@
 
 #include <Core/Mesh/MeshUtils.hpp>
 #include <Core/Mesh/HalfEdge.hpp>
+#include <Core/Mesh/VertexPacking.hpp>
+
+#include <algorithm>
+#include <cstring>
 
 namespace Ra {
     namespace Engine {
 
+#ifdef CORE_USE_DOUBLE
+        static const GLenum GL_SCALAR = GL_DOUBLE;
+#else
+        static const GLenum GL_SCALAR = GL_FLOAT;
+#endif
+
         // Dirty is initializes as false so that we do not create the vao while
         // we have no data to send to the gpu.
         Mesh::Mesh( const std::string& name, GLenum renderMode )
             : m_name( name )
             , m_vao( 0 )
             , m_renderMode(renderMode)
+            , m_vertexFormat( VertexFormat::DEFAULT )
+            , m_layoutChanged( false )
+            , m_indexType( GL_UNSIGNED_INT )
+            , m_streaming( false )
+            , m_streamCapacity( 0 )
+            , m_streamIndex( 0 )
             , m_numElements (0)
             , m_isDirty( false )
         {
@@ -19,22 +35,17 @@ namespace Ra {
                       || m_renderMode == GL_LINES_ADJACENCY
                       || m_renderMode == GL_TRIANGLES,
                          "Unsupported render mode" );
+
+            // All the meshes share the same empty arrays until data is added.
+            static const std::shared_ptr<const Core::Vector3Array> emptyV3( new Core::Vector3Array );
+            static const std::shared_ptr<const Core::Vector4Array> emptyV4( new Core::Vector4Array );
+            m_v3Data.fill( emptyV3 );
+            m_v4Data.fill( emptyV4 );
         }
 
         Mesh::~Mesh()
         {
-            if (m_vao != 0)
-            {
-                GL_ASSERT( glDeleteVertexArrays( 1, &m_vao ) );
-
-                for (auto& vbo : m_vbos)
-                {
-                    if (vbo != 0)
-                    {
-                        glDeleteBuffers(1, &vbo);
-                    }
-                }
-            }
+            deleteGLData();
         }
 
         void Mesh::render()
@@ -42,7 +53,17 @@ namespace Ra {
             if ( m_vao != 0 )
             {
                 GL_ASSERT( glBindVertexArray( m_vao ) );
-                GL_ASSERT( glDrawElements( m_renderMode, m_numElements, GL_UNSIGNED_INT, (void*)0 ) );
+                GL_ASSERT( glDrawElements( m_renderMode, m_numElements, m_indexType, (void*)0 ) );
+
+                if ( m_streamCapacity > 0 )
+                {
+                    // Remember when the GPU will be done with the streamed buffer.
+                    if ( m_streamFences[m_streamIndex] != nullptr )
+                    {
+                        GL_ASSERT( glDeleteSync( m_streamFences[m_streamIndex] ) );
+                    }
+                    m_streamFences[m_streamIndex] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+                }
             }
         }
 
@@ -52,12 +73,21 @@ namespace Ra {
             m_numElements = mesh.m_triangles.size() * 3;
             for (uint i = 0; i < MAX_MESH; ++i)
             {
-                m_dataDirty[i] = true;
+                setDataDirty( i );
             }
-            m_isDirty = true;
 
         }
 
+        void Mesh::loadGeometry( Core::TriangleMesh&& mesh )
+        {
+            m_mesh = std::move( mesh );
+            m_numElements = m_mesh.m_triangles.size() * 3;
+            for (uint i = 0; i < MAX_MESH; ++i)
+            {
+                setDataDirty( i );
+            }
+        }
+
         void Mesh::loadGeometry(const Core::Vector3Array &vertices, const std::vector<uint> &indices)
         {
             // TODO : remove this function and force everyone to use triangle mesh.
@@ -80,62 +110,447 @@ namespace Ra {
             // Mark mesh as dirty.
             for (uint i = 0; i < MAX_MESH; ++i)
             {
-                m_dataDirty[i] = true;
+                setDataDirty( i );
             }
-            m_isDirty = true;
 
         }
 
         void Mesh::addData( const Vec3Data& type, const Core::Vector3Array& data )
         {
-            m_v3Data[static_cast<uint>(type)] = data;
-            m_dataDirty[MAX_MESH + static_cast<uint>(type)] = true;
-            m_isDirty = true;
+            addData( type, std::make_shared<const Core::Vector3Array>( data ) );
         }
 
         void Mesh::addData( const Vec4Data& type, const Core::Vector4Array& data )
         {
+            addData( type, std::make_shared<const Core::Vector4Array>( data ) );
+        }
+
+        void Mesh::addData( const Vec3Data& type, Core::Vector3Array&& data )
+        {
+            addData( type, std::make_shared<const Core::Vector3Array>( std::move( data ) ) );
+        }
+
+        void Mesh::addData( const Vec4Data& type, Core::Vector4Array&& data )
+        {
+            addData( type, std::make_shared<const Core::Vector4Array>( std::move( data ) ) );
+        }
+
+        void Mesh::addData( const Vec3Data& type, const std::shared_ptr<const Core::Vector3Array>& data )
+        {
+            CORE_ASSERT( data, "Null vertex data" );
+            m_v3Data[static_cast<uint>(type)] = data;
+            setDataDirty( MAX_MESH + static_cast<uint>(type) );
+        }
+
+        void Mesh::addData( const Vec4Data& type, const std::shared_ptr<const Core::Vector4Array>& data )
+        {
+            CORE_ASSERT( data, "Null vertex data" );
             m_v4Data[static_cast<uint>(type)] = data;
-            m_dataDirty[MAX_MESH + MAX_VEC3 + static_cast<uint>(type)] = true;
-            m_isDirty = true;
+            setDataDirty( MAX_MESH + MAX_VEC3 + static_cast<uint>(type) );
+        }
+
+        void Mesh::setStreaming( bool streaming )
+        {
+#ifndef GL_VERSION_4_4
+            // Persistent mapping is not available, keep uploading the data.
+            streaming = false;
+#endif
+            if ( streaming != m_streaming )
+            {
+                // The buffers are recreated at the next update, in the rendering thread.
+                m_streaming = streaming;
+                setDataDirty( VERTEX_POSITION );
+                setDataDirty( VERTEX_NORMAL );
+
+                if ( m_vertexFormat == VertexFormat::PACKED )
+                {
+                    // Streaming falls back to the default format.
+                    setLayoutChanged();
+                }
+            }
+        }
+
+        void Mesh::setVertexFormat( VertexFormat format )
+        {
+            if ( format != m_vertexFormat )
+            {
+                m_vertexFormat = format;
+                setLayoutChanged();
+            }
+        }
+
+        void Mesh::setLayoutChanged()
+        {
+            if ( m_vao == 0 )
+            {
+                // Nothing was sent yet.
+                return;
+            }
+
+            m_layoutChanged = true;
+            for ( uint i = 0; i < MAX_MESH; ++i )
+            {
+                setDataDirty( i );
+            }
+            for ( uint i = 0; i < MAX_VEC3; ++i )
+            {
+                if ( !m_v3Data[i]->empty() )
+                {
+                    setDataDirty( MAX_MESH + i );
+                }
+            }
+            for ( uint i = 0; i < MAX_VEC4; ++i )
+            {
+                if ( !m_v4Data[i]->empty() )
+                {
+                    setDataDirty( MAX_MESH + MAX_VEC3 + i );
+                }
+            }
+        }
+
+        void Mesh::deleteGLData()
+        {
+            if ( m_vao == 0 )
+            {
+                return;
+            }
+
+            deleteStreamBuffers();
+            for ( uint i = 0; i < MAX_DATA; ++i )
+            {
+                if ( m_vbos[i] != 0 )
+                {
+                    GL_ASSERT( glDeleteBuffers( 1, &m_vbos[i] ) );
+                    m_vbos[i] = 0;
+                }
+                m_vboSizes[i] = 0;
+            }
+            GL_ASSERT( glDeleteVertexArrays( 1, &m_vao ) );
+            m_vao = 0;
+            m_indexType = GL_UNSIGNED_INT;
+        }
+
+        void Mesh::uploadData( GLenum target, const void* data, uint elementSize, uint numElements, uint vboIdx )
+        {
+            const uint size = elementSize * numElements;
+            RangeList& ranges = m_dirtyRanges[vboIdx];
+
+            if ( m_vboSizes[vboIdx] != size )
+            {
+                GL_ASSERT( glBufferData( target, size, data, GL_DYNAMIC_DRAW ) );
+                m_vboSizes[vboIdx] = size;
+            }
+            else if ( ranges.empty() )
+            {
+                GL_ASSERT( glBufferSubData( target, 0, size, data ) );
+            }
+            else
+            {
+                // Merge the ranges so that each element is sent once.
+                std::sort( ranges.begin(), ranges.end() );
+                const char* bytes = static_cast<const char*>( data );
+                auto sendRange = [&]( uint begin, uint end )
+                {
+                    end = std::min( end, numElements );
+                    if ( begin < end )
+                    {
+                        GL_ASSERT( glBufferSubData( target, begin * elementSize, ( end - begin ) * elementSize,
+                                                    bytes + begin * elementSize ) );
+                    }
+                };
+
+                uint begin = ranges[0].first;
+                uint end = ranges[0].second;
+                for ( uint i = 1; i < ranges.size(); ++i )
+                {
+                    if ( ranges[i].first > end )
+                    {
+                        sendRange( begin, end );
+                        begin = ranges[i].first;
+                    }
+                    end = std::max( end, ranges[i].second );
+                }
+                sendRange( begin, end );
+            }
+
+            ranges.clear();
+            m_dataDirty[vboIdx] = false;
         }
 
         // Template parameter must be a Core::VectorNArray
         template< typename VecArray >
         void Mesh::sendGLData( const VecArray& arr, const uint vboIdx )
         {
-
-#ifdef CORE_USE_DOUBLE
-            GLenum type = GL_DOUBLE;
-#else
-            GLenum type = GL_FLOAT;
-#endif
             constexpr GLuint size = VecArray::Vector::RowsAtCompileTime;
             constexpr GLboolean normalized  = GL_FALSE;
             constexpr GLint64 ptr = 0;
 
+            if ( arr.size() == 0 )
+            {
+                return;
+            }
+
             // This vbo has not been created yet
-            if ( m_vbos[vboIdx] == 0 && arr.size() > 0 )
+            if ( m_vbos[vboIdx] == 0 )
             {
                 GL_ASSERT( glGenBuffers( 1, &m_vbos[vboIdx] ) );
                 GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[vboIdx] ) );
-                GL_ASSERT( glBufferData( GL_ARRAY_BUFFER, arr.size() * sizeof( typename VecArray::Vector ),
-                arr.data(), GL_DYNAMIC_DRAW ) );
 
                 // Use (vboIdx - 1) as attribute index because vbo 0 is actually ibo.
-                GL_ASSERT( glVertexAttribPointer( vboIdx - 1, size, type, normalized,
+                GL_ASSERT( glVertexAttribPointer( vboIdx - 1, size, GL_SCALAR, normalized,
                                                   sizeof( typename VecArray::Vector ), (GLvoid*)ptr ) );
 
                 GL_ASSERT( glEnableVertexAttribArray( vboIdx - 1 ) );
 
+                m_vboSizes[vboIdx] = 0;
+                setDataDirty( vboIdx );
             }
 
-            if ( m_dataDirty[vboIdx] == true && m_vbos[vboIdx] != 0 && arr.size() > 0 )
+            if ( m_dataDirty[vboIdx] == true )
             {
                 GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[vboIdx] ) );
-                GL_ASSERT( glBufferData( GL_ARRAY_BUFFER, arr.size() * sizeof( typename VecArray::Vector ),
-                arr.data(), GL_DYNAMIC_DRAW ) );
-                m_dataDirty[vboIdx] = false;
+                uploadData( GL_ARRAY_BUFFER, arr.data(), sizeof( typename VecArray::Vector ), arr.size(), vboIdx );
+            }
+        }
+
+        void Mesh::deleteStreamBuffers()
+        {
+            for ( uint i : { VERTEX_POSITION, VERTEX_NORMAL } )
+            {
+                if ( m_vbos[i] != 0 )
+                {
+                    // Deleting the buffer also unmaps it.
+                    GL_ASSERT( glDeleteBuffers( 1, &m_vbos[i] ) );
+                    m_vbos[i] = 0;
+                }
+                m_vboSizes[i] = 0;
+                m_streamPtr[i] = nullptr;
+            }
+
+            for ( auto& fence : m_streamFences )
+            {
+                if ( fence != nullptr )
+                {
+                    GL_ASSERT( glDeleteSync( fence ) );
+                    fence = nullptr;
+                }
+            }
+
+            m_streamCapacity = 0;
+            m_streamIndex = 0;
+        }
+
+        void Mesh::streamGLData()
+        {
+#ifdef GL_VERSION_4_4
+            if ( !m_dataDirty[VERTEX_POSITION] && !m_dataDirty[VERTEX_NORMAL] )
+            {
+                return;
+            }
+
+            const uint numVertices = m_mesh.m_vertices.size();
+            constexpr uint stride = sizeof( Core::Vector3 );
+            constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+            if ( m_streamCapacity < numVertices )
+            {
+                // Also deletes the VBOs used before streaming.
+                deleteStreamBuffers();
+
+                for ( uint i : { VERTEX_POSITION, VERTEX_NORMAL } )
+                {
+                    const GLsizeiptr bufferSize = NUM_STREAM_BUFFERS * numVertices * stride;
+                    GL_ASSERT( glGenBuffers( 1, &m_vbos[i] ) );
+                    GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[i] ) );
+                    GL_ASSERT( glBufferStorage( GL_ARRAY_BUFFER, bufferSize, nullptr, flags ) );
+                    m_streamPtr[i] = glMapBufferRange( GL_ARRAY_BUFFER, 0, bufferSize, flags );
+                    CORE_ASSERT( m_streamPtr[i] != nullptr, "Could not map the streamed buffer" );
+                    m_vboSizes[i] = bufferSize;
+                }
+                m_streamCapacity = numVertices;
+            }
+
+            // Write in the oldest buffer, once the GPU is done reading it.
+            m_streamIndex = ( m_streamIndex + 1 ) % NUM_STREAM_BUFFERS;
+            if ( m_streamFences[m_streamIndex] != nullptr )
+            {
+                GLenum status;
+                do
+                {
+                    status = glClientWaitSync( m_streamFences[m_streamIndex], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000 );
+                } while ( status == GL_TIMEOUT_EXPIRED );
+
+                GL_ASSERT( glDeleteSync( m_streamFences[m_streamIndex] ) );
+                m_streamFences[m_streamIndex] = nullptr;
+            }
+
+            const uint offset = m_streamIndex * m_streamCapacity * stride;
+            for ( uint i : { VERTEX_POSITION, VERTEX_NORMAL } )
+            {
+                const Core::Vector3Array& arr = ( i == VERTEX_POSITION ) ? m_mesh.m_vertices : m_mesh.m_normals;
+
+                GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[i] ) );
+                if ( arr.size() == numVertices )
+                {
+                    std::memcpy( static_cast<char*>( m_streamPtr[i] ) + offset, arr.data(), numVertices * stride );
+                    GL_ASSERT( glVertexAttribPointer( i - 1, 3, GL_SCALAR, GL_FALSE, stride, (GLvoid*)GLint64( offset ) ) );
+                    GL_ASSERT( glEnableVertexAttribArray( i - 1 ) );
+                }
+                else
+                {
+                    GL_ASSERT( glDisableVertexAttribArray( i - 1 ) );
+                }
+
+                m_dirtyRanges[i].clear();
+                m_dataDirty[i] = false;
+            }
+#endif
+        }
+
+        void Mesh::sendIndices( bool packed )
+        {
+            if ( m_vbos[INDEX] == 0 )
+            {
+                GL_ASSERT( glGenBuffers( 1, &m_vbos[INDEX] ) );
+                m_vboSizes[INDEX] = 0;
+            }
+            if ( !m_dataDirty[INDEX] )
+            {
+                return;
+            }
+
+            const GLenum indexType = ( packed && m_mesh.m_vertices.size() <= 65536 ) ? GL_UNSIGNED_SHORT
+                                                                                      : GL_UNSIGNED_INT;
+            if ( indexType != m_indexType )
+            {
+                // All the indices change size.
+                m_dirtyRanges[INDEX].clear();
+                m_indexType = indexType;
+            }
+
+            // The index buffer binding is part of the VAO state.
+            GL_ASSERT( glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_vbos[INDEX] ) );
+            if ( m_indexType == GL_UNSIGNED_SHORT )
+            {
+                std::vector<ushort> indices( 3 * m_mesh.m_triangles.size() );
+                Core::VertexPacking::packIndices16( m_mesh.m_triangles, indices.data() );
+                uploadData( GL_ELEMENT_ARRAY_BUFFER, indices.data(), 3 * sizeof( ushort ),
+                            m_mesh.m_triangles.size(), INDEX );
+            }
+            else
+            {
+                uploadData( GL_ELEMENT_ARRAY_BUFFER, m_mesh.m_triangles.data(), sizeof( Ra::Core::Triangle ),
+                            m_mesh.m_triangles.size(), INDEX );
+            }
+        }
+
+        void Mesh::sendPackedData()
+        {
+            struct PackedAttribute
+            {
+                uint vboIdx;
+                GLint size;
+                GLenum type;
+                GLboolean normalized;
+                uint bytes;
+                bool present;
+            };
+
+            const uint numVertices = m_mesh.m_vertices.size();
+
+            // An attribute is stored if it has a value for each vertex.
+            const std::array<PackedAttribute, 6> attributes = {{
+                { VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 3 * sizeof( float ), true },
+                { VERTEX_NORMAL, 4, GL_INT_2_10_10_10_REV, GL_TRUE, 4,
+                  m_mesh.m_normals.size() == numVertices },
+                { MAX_MESH + VERTEX_TANGENT, 4, GL_INT_2_10_10_10_REV, GL_TRUE, 4,
+                  m_v3Data[VERTEX_TANGENT]->size() == numVertices },
+                { MAX_MESH + VERTEX_BITANGENT, 4, GL_INT_2_10_10_10_REV, GL_TRUE, 4,
+                  m_v3Data[VERTEX_BITANGENT]->size() == numVertices },
+                { MAX_MESH + VERTEX_TEXCOORD, 2, GL_HALF_FLOAT, GL_FALSE, 4,
+                  m_v3Data[VERTEX_TEXCOORD]->size() == numVertices },
+                { MAX_MESH + MAX_VEC3 + VERTEX_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, 4,
+                  m_v4Data[VERTEX_COLOR]->size() == numVertices }
+            }};
+
+            bool dirty = false;
+            for ( const auto& attrib : attributes )
+            {
+                dirty = dirty || m_dataDirty[attrib.vboIdx];
+            }
+            if ( !dirty )
+            {
+                return;
+            }
+
+            std::array<uint, 6> offsets;
+            uint stride = 0;
+            for ( uint i = 0; i < attributes.size(); ++i )
+            {
+                offsets[i] = stride;
+                stride += attributes[i].present ? attributes[i].bytes : 0;
+            }
+
+            // Any change repacks the whole buffer, by blocks which stay in cache.
+            constexpr uint blockSize = 4096;
+            std::vector<char> data( numVertices * stride );
+            for ( uint begin = 0; begin < numVertices; begin += blockSize )
+            {
+                const uint count = std::min( blockSize, numVertices - begin );
+                char* out = data.data() + begin * stride;
+
+                Core::VertexPacking::packFloat3( &m_mesh.m_vertices[begin], count, out + offsets[0], stride );
+                if ( attributes[1].present )
+                {
+                    Core::VertexPacking::packSnorm1010102( &m_mesh.m_normals[begin], count, out + offsets[1], stride );
+                }
+                if ( attributes[2].present )
+                {
+                    Core::VertexPacking::packSnorm1010102( &( *m_v3Data[VERTEX_TANGENT] )[begin], count,
+                                                           out + offsets[2], stride );
+                }
+                if ( attributes[3].present )
+                {
+                    Core::VertexPacking::packSnorm1010102( &( *m_v3Data[VERTEX_BITANGENT] )[begin], count,
+                                                           out + offsets[3], stride );
+                }
+                if ( attributes[4].present )
+                {
+                    Core::VertexPacking::packHalf2( &( *m_v3Data[VERTEX_TEXCOORD] )[begin], count,
+                                                    out + offsets[4], stride );
+                }
+                if ( attributes[5].present )
+                {
+                    Core::VertexPacking::packUnorm8888( &( *m_v4Data[VERTEX_COLOR] )[begin], count,
+                                                        out + offsets[5], stride );
+                }
+            }
+
+            // The interleaved buffer is the position buffer.
+            if ( m_vbos[VERTEX_POSITION] == 0 )
+            {
+                GL_ASSERT( glGenBuffers( 1, &m_vbos[VERTEX_POSITION] ) );
+                m_vboSizes[VERTEX_POSITION] = 0;
+            }
+            GL_ASSERT( glBindBuffer( GL_ARRAY_BUFFER, m_vbos[VERTEX_POSITION] ) );
+            m_dirtyRanges[VERTEX_POSITION].clear();
+            uploadData( GL_ARRAY_BUFFER, data.data(), stride, numVertices, VERTEX_POSITION );
+
+            for ( uint i = 0; i < attributes.size(); ++i )
+            {
+                const PackedAttribute& attrib = attributes[i];
+                if ( attrib.present )
+                {
+                    GL_ASSERT( glVertexAttribPointer( attrib.vboIdx - 1, attrib.size, attrib.type, attrib.normalized,
+                                                      stride, (GLvoid*)GLint64( offsets[i] ) ) );
+                    GL_ASSERT( glEnableVertexAttribArray( attrib.vboIdx - 1 ) );
+                }
+                else
+                {
+                    GL_ASSERT( glDisableVertexAttribArray( attrib.vboIdx - 1 ) );
+                }
+                m_dirtyRanges[attrib.vboIdx].clear();
+                m_dataDirty[attrib.vboIdx] = false;
             }
         }
 
@@ -150,6 +565,13 @@ namespace Ra {
                 CORE_ASSERT( ! ( m_mesh.m_vertices.empty()|| m_mesh.m_triangles.empty() ),
                              "Either vertices or indices are empty arrays.");
 
+                if ( m_layoutChanged )
+                {
+                    // The vertex format changed : start again from scratch.
+                    deleteGLData();
+                    m_layoutChanged = false;
+                }
+
                 if ( m_vao == 0 )
                 {
                     // Create VAO if it does not exist
@@ -159,32 +581,42 @@ namespace Ra {
                 // Bind it
                 GL_ASSERT( glBindVertexArray( m_vao ) );
 
-                if (m_vbos[INDEX] == 0 )
+                const bool packed = ( m_vertexFormat == VertexFormat::PACKED ) && !m_streaming;
+                sendIndices( packed );
+
+                // Geometry data
+                if ( packed )
+                {
+                    sendPackedData();
+                }
+                else if ( m_streaming )
                 {
-                    GL_ASSERT( glGenBuffers( 1, &m_vbos[INDEX]) );
-                    GL_ASSERT( glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, m_vbos[INDEX]) );
+                    streamGLData();
                 }
-                if (m_dataDirty[INDEX])
+                else
                 {
-                    GL_ASSERT( glBufferData( GL_ELEMENT_ARRAY_BUFFER, m_mesh.m_triangles.size() * sizeof( Ra::Core::Triangle ),
-                                             m_mesh.m_triangles.data(), GL_DYNAMIC_DRAW ) );
-                    m_dataDirty[INDEX] = false;
+                    if ( m_streamCapacity > 0 )
+                    {
+                        // Streaming was disabled, go back to regular VBOs.
+                        deleteStreamBuffers();
+                    }
+                    sendGLData(m_mesh.m_vertices, VERTEX_POSITION);
+                    sendGLData(m_mesh.m_normals,  VERTEX_NORMAL);
+                }
 
+                // Vec3 data and colors are in the interleaved buffer of the packed format.
+                if ( !packed )
+                {
+                    sendGLData(*m_v3Data[VERTEX_TANGENT],   MAX_MESH + VERTEX_TANGENT);
+                    sendGLData(*m_v3Data[VERTEX_BITANGENT], MAX_MESH + VERTEX_BITANGENT);
+                    sendGLData(*m_v3Data[VERTEX_TEXCOORD],  MAX_MESH + VERTEX_TEXCOORD);
+
+                    sendGLData(*m_v4Data[VERTEX_COLOR],     MAX_MESH + MAX_VEC3 + VERTEX_COLOR );
                 }
 
-                // Geometry data
-                sendGLData(m_mesh.m_vertices, VERTEX_POSITION);
-                sendGLData(m_mesh.m_normals,  VERTEX_NORMAL);
-
-                // Vec3 data
-                sendGLData(m_v3Data[VERTEX_TANGENT],   MAX_MESH + VERTEX_TANGENT);
-                sendGLData(m_v3Data[VERTEX_BITANGENT], MAX_MESH + VERTEX_BITANGENT);
-                sendGLData(m_v3Data[VERTEX_TEXCOORD],  MAX_MESH + VERTEX_TEXCOORD);
-
-                // Vec4 data
-                sendGLData(m_v4Data[VERTEX_COLOR],      MAX_MESH + MAX_VEC3 + VERTEX_COLOR );
-                sendGLData(m_v4Data[VERTEX_WEIGHTS],    MAX_MESH + MAX_VEC3 + VERTEX_WEIGHTS);
-                sendGLData(m_v4Data[VERTEX_WEIGHT_IDX], MAX_MESH + MAX_VEC3 + VERTEX_WEIGHT_IDX);
+                // Skinning data
+                sendGLData(*m_v4Data[VERTEX_WEIGHTS],    MAX_MESH + MAX_VEC3 + VERTEX_WEIGHTS);
+                sendGLData(*m_v4Data[VERTEX_WEIGHT_IDX], MAX_MESH + MAX_VEC3 + VERTEX_WEIGHT_IDX);
 
                 GL_ASSERT( glBindVertexArray( 0 ) );
 
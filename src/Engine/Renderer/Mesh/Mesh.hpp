@@ -6,6 +6,7 @@
 #include <vector>
 #include <array>
 #include <map>
+#include <memory>
 
 #include <Engine/Renderer/OpenGL/OpenGL.hpp>
 #include <Core/Math/LinearAlgebra.hpp>
@@ -72,6 +73,29 @@ namespace Ra
             /// Total number of vertex attributes.
             constexpr static uint MAX_DATA = MAX_MESH + MAX_VEC3 + MAX_VEC4;
 
+            /// Number of copies of the streamed buffers, so that the CPU never writes
+            /// in a buffer the GPU is still reading.
+            constexpr static uint NUM_STREAM_BUFFERS = 3;
+
+            /// Above this number of ranges waiting for an upload, the whole data is sent.
+            constexpr static uint MAX_DIRTY_RANGES = 4096;
+
+            /// List of [begin, end) element ranges.
+            typedef std::vector<std::pair<uint, uint>> RangeList;
+
+            /// Storage of the vertex data on the GPU.
+            enum class VertexFormat
+            {
+                /// One buffer per attribute, with the precision of Core::Scalar.
+                DEFAULT,
+                /// A single interleaved buffer : float positions, 10-10-10-2 normals and
+                /// tangents, half float texture coordinates and 8 bits colors, and 16 bits
+                /// indices when there are less than 65536 vertices. The skinning data keeps
+                /// its own buffers. Any change of an interleaved attribute uploads the whole
+                /// buffer, so it is meant for static meshes.
+                PACKED
+            };
+
         public:
             Mesh( const std::string& name, GLenum renderMode = GL_TRIANGLES );
             ~Mesh();
@@ -90,12 +114,22 @@ namespace Ra
             /// Use the given geometry as base for a display mesh. Normals are optionnal.
             void loadGeometry( const Core::TriangleMesh& mesh);
 
+            /// Same as above, taking the arrays of the geometry instead of copying them.
+            void loadGeometry( Core::TriangleMesh&& mesh );
+
             // TODO (val) : remove this function (it is used mostly in the display primitives)
             void loadGeometry( const Core::Vector3Array& vertices, const std::vector<uint>& indices);
 
             /// Load additionnal vertex data.
             void addData( const Vec3Data& type, const Core::Vector3Array& data);
             void addData( const Vec4Data& type, const Core::Vector4Array& data);
+            void addData( const Vec3Data& type, Core::Vector3Array&& data );
+            void addData( const Vec4Data& type, Core::Vector4Array&& data );
+
+            /// Use the given array as additionnal vertex data without copying it. The array is
+            /// shared with its other owners, e.g. the asset it was loaded from.
+            void addData( const Vec3Data& type, const std::shared_ptr<const Core::Vector3Array>& data );
+            void addData( const Vec4Data& type, const std::shared_ptr<const Core::Vector4Array>& data );
 
             /// Access the additionnal data arrays by type.
             inline const Core::Vector3Array& getData( const Vec3Data& type ) const;
@@ -106,10 +140,38 @@ namespace Ra
             inline void setDirty( const Vec3Data& type );
             inline void setDirty( const Vec4Data& type );
 
+            /// Mark the elements [begin, end) of one of the data types as dirty. Only these
+            /// elements are sent to the GPU, unless the whole data is also dirty.
+            inline void setDirty( const MeshData& type, uint begin, uint end );
+            inline void setDirty( const Vec3Data& type, uint begin, uint end );
+            inline void setDirty( const Vec4Data& type, uint begin, uint end );
+
+            /// Narrow the whole data marked dirty by the last setDirty( type ) to the given
+            /// ranges, which are merged with the ranges still waiting for an upload. To be
+            /// used by the only writer of the data, which knows exactly what it changed.
+            inline void setDirtyRanges( const MeshData& type, const RangeList& ranges );
+
+            /// Returns true if the data has changed since the last openGL update.
+            inline bool isDirty( const MeshData& type ) const;
+
+            /// Stream the vertex positions and normals through persistently mapped buffers,
+            /// instead of uploading them with glBufferSubData. Meant for meshes which are
+            /// deformed every frame (e.g. skinned meshes). Requires OpenGL 4.4.
+            void setStreaming( bool streaming );
+            inline bool isStreaming() const;
+
+            /// Select the storage of the vertex data on the GPU. The buffers are
+            /// recreated at the next update. Streamed meshes always use the default format.
+            void setVertexFormat( VertexFormat format );
+            inline VertexFormat getVertexFormat() const;
+
             /// This function is called at the start of the rendering. It will update the
             /// necessary openGL buffers.
             void updateGL();
 
+            /// Returns true once the mesh has been sent to the GPU by updateGL().
+            inline bool isUploaded() const;
+
             /// Draw the mesh.
             void render();
 
@@ -121,6 +183,29 @@ namespace Ra
             template < typename VecArray >
             void sendGLData( const VecArray& arr, const uint vboIdx );
 
+            /// Upload the dirty part of the data to the buffer bound to target,
+            /// reallocating it only if its size changed.
+            void uploadData( GLenum target, const void* data, uint elementSize, uint numElements, uint vboIdx );
+
+            /// Copy the positions and normals in the next streamed buffer.
+            void streamGLData();
+            void deleteStreamBuffers();
+
+            /// Pack the vertex data in the interleaved buffer of the packed format.
+            void sendPackedData();
+
+            /// Send the indices, as 16 bits integers if possible when packed is true.
+            void sendIndices( bool packed );
+
+            /// Recreate the VAO and all the buffers at the next update.
+            void setLayoutChanged();
+
+            /// Delete the VAO and all the buffers.
+            void deleteGLData();
+
+            inline void setDataDirty( uint vboIdx );
+            inline void setDataDirty( uint vboIdx, uint begin, uint end );
+
         private:
             std::string m_name;  /// Name of the mesh.
 
@@ -129,8 +214,9 @@ namespace Ra
 
             Core::TriangleMesh m_mesh; /// Base geometry : vertices, triangles and normals
 
-            std::array<Core::Vector3Array, MAX_VEC3 > m_v3Data; /// Additionnal vertex vector 3 data
-            std::array<Core::Vector4Array, MAX_VEC4 > m_v4Data; /// Additionnal vertex vector 4 data
+            /// Additionnal vertex data. The arrays are never modified, so they can be shared.
+            std::array<std::shared_ptr<const Core::Vector3Array>, MAX_VEC3 > m_v3Data; /// Additionnal vertex vector 3 data
+            std::array<std::shared_ptr<const Core::Vector4Array>, MAX_VEC4 > m_v4Data; /// Additionnal vertex vector 4 data
 
             // Combined arrays store the flags in this order Mesh, then Vec3 then Vec4 data.
             // Following the enum declaration above.
@@ -141,6 +227,23 @@ namespace Ra
 
             std::array<uint, MAX_DATA> m_vbos = {{ 0 }}; /// Indices of our openGL VBOs.
             std::array<bool, MAX_DATA> m_dataDirty = {{ false }}; /// Dirty bits of our vertex data.
+            std::array<RangeList, MAX_DATA> m_dirtyRanges; /// Dirty elements, everything if empty.
+
+            /// Dirty state before the last setDirty(), restored by setDirtyRanges().
+            std::array<bool, MAX_DATA> m_narrowable = {{ false }};
+            std::array<bool, MAX_DATA> m_dataDirtyBefore = {{ false }};
+            std::array<RangeList, MAX_DATA> m_dirtyRangesBefore;
+            std::array<uint, MAX_DATA> m_vboSizes = {{ 0 }}; /// Allocated size of the VBOs in bytes.
+
+            VertexFormat m_vertexFormat; /// Storage of the vertex data on the GPU.
+            bool m_layoutChanged;        /// The buffers must be recreated at the next update.
+            GLenum m_indexType;          /// Type of the indices in the index buffer.
+
+            bool m_streaming;       /// Positions and normals are streamed.
+            uint m_streamCapacity;  /// Number of vertices in each streamed buffer.
+            uint m_streamIndex;     /// Streamed buffer used for the current frame.
+            std::array<void*, MAX_MESH> m_streamPtr = {{ nullptr }}; /// Mapped streamed VBOs.
+            std::array<GLsync, NUM_STREAM_BUFFERS> m_streamFences = {{ nullptr }}; /// Last draw using each buffer.
 
             uint m_numElements; /// number of elements to draw. For triangles this is 3*numTriangles but not for lines.
             // (val) : this is a bit hacky.
@@ -14,22 +14,86 @@ namespace Engine {
         m_renderMode = mode;
     }
 
+    bool Mesh::isUploaded() const { return m_vao != 0; }
+
     const Core::TriangleMesh &Mesh::getGeometry() const { return m_mesh; }
           Core::TriangleMesh &Mesh::getGeometry()       { return m_mesh; }
 
     const Core::Vector3Array &Mesh::getData(const Mesh::Vec3Data &type) const
     {
-        return m_v3Data[static_cast<uint>(type)];
+        return *m_v3Data[static_cast<uint>(type)];
     }
 
     const Core::Vector4Array &Mesh::getData(const Mesh::Vec4Data &type) const
     {
-        return m_v4Data[static_cast<uint>(type)];
+        return *m_v4Data[static_cast<uint>(type)];
+    }
+
+    void Mesh::setDirty(const Mesh::MeshData &type) { setDataDirty( type ); }
+    void Mesh::setDirty(const Mesh::Vec3Data &type) { setDataDirty( MAX_MESH + type ); }
+    void Mesh::setDirty(const Mesh::Vec4Data &type) { setDataDirty( MAX_MESH + MAX_VEC3 + type ); }
+
+    void Mesh::setDirty(const Mesh::MeshData &type, uint begin, uint end) { setDataDirty( type, begin, end ); }
+    void Mesh::setDirty(const Mesh::Vec3Data &type, uint begin, uint end) { setDataDirty( MAX_MESH + type, begin, end ); }
+    void Mesh::setDirty(const Mesh::Vec4Data &type, uint begin, uint end) { setDataDirty( MAX_MESH + MAX_VEC3 + type, begin, end ); }
+
+    void Mesh::setDirtyRanges(const Mesh::MeshData &type, const RangeList &ranges)
+    {
+        // Ranges which were not uploaded yet (e.g. the mesh was culled) are kept, the
+        // whole data is only sent if it was dirty before the last setDirty().
+        if ( m_narrowable[type] && m_dataDirty[type] && m_dirtyRanges[type].empty() )
+        {
+            m_dataDirty[type] = m_dataDirtyBefore[type];
+            m_dirtyRanges[type].swap( m_dirtyRangesBefore[type] );
+        }
+        m_narrowable[type] = false;
+        for ( const auto& range : ranges )
+        {
+            setDataDirty( type, range.first, range.second );
+        }
+        if ( m_dirtyRanges[type].size() > MAX_DIRTY_RANGES )
+        {
+            m_dirtyRanges[type].clear();
+        }
+
+        // Keep the general dirty bit consistent if nothing is dirty anymore.
+        m_isDirty = false;
+        for ( bool dirty : m_dataDirty )
+        {
+            m_isDirty = m_isDirty || dirty;
+        }
     }
 
-    void Mesh::setDirty(const Mesh::MeshData &type) { m_dataDirty[type] = true; m_isDirty = true;}
-    void Mesh::setDirty(const Mesh::Vec3Data &type) { m_dataDirty[MAX_MESH + type] = true; m_isDirty = true;}
-    void Mesh::setDirty(const Mesh::Vec4Data &type) { m_dataDirty[MAX_MESH + MAX_VEC3 + type ] = true ; m_isDirty = true;}
+    bool Mesh::isDirty(const Mesh::MeshData &type) const { return m_dataDirty[type]; }
+
+    bool Mesh::isStreaming() const { return m_streaming; }
+
+    Mesh::VertexFormat Mesh::getVertexFormat() const { return m_vertexFormat; }
+
+    void Mesh::setDataDirty( uint vboIdx )
+    {
+        m_narrowable[vboIdx] = true;
+        m_dataDirtyBefore[vboIdx] = m_dataDirty[vboIdx];
+        m_dirtyRangesBefore[vboIdx].swap( m_dirtyRanges[vboIdx] );
+        m_dataDirty[vboIdx] = true;
+        m_dirtyRanges[vboIdx].clear();
+        m_isDirty = true;
+    }
+
+    void Mesh::setDataDirty( uint vboIdx, uint begin, uint end )
+    {
+        if ( begin >= end )
+        {
+            return;
+        }
+        // An empty range list means the whole data is dirty.
+        if ( !m_dataDirty[vboIdx] || !m_dirtyRanges[vboIdx].empty() )
+        {
+            m_dirtyRanges[vboIdx].push_back( std::make_pair( begin, end ) );
+        }
+        m_dataDirty[vboIdx] = true;
+        m_isDirty = true;
+    }
 
 }
 }
@@ -86,39 +86,25 @@ namespace Ra
             auto displayMesh = Core::make_shared<Ra::Engine::Mesh>(name);
 
             Core::TriangleMesh mesh;
-            Core::Transform T = asset->getFrame();
-            Core::Transform N;
-            N.matrix() = (T.matrix()).inverse().transpose();
-            
-            for (size_t i = 0; i < asset->getVerticesSize(); ++i)
-            {
-                mesh.m_vertices.push_back(T * asset->getVertices()[i]);
-                mesh.m_normals.push_back((N * asset->getNormals()[i]).normalized());
-            }
+            const Core::Transform& T = asset->getFrame();
+            Core::MeshUtils::transformPoints(asset->getVertices(), T, mesh.m_vertices);
+            Core::MeshUtils::transformNormals(asset->getNormals(), T, mesh.m_normals);
 
-            for (const auto& face : asset->getFaces())
+            const auto& faces = asset->getFaces();
+            mesh.m_triangles.resize(faces.size());
+            for (uint i = 0; i < faces.size(); ++i)
             {
-                mesh.m_triangles.push_back(face.head<3>());
+                mesh.m_triangles[i] = faces[i].head<3>();
             }
 
             //Core::Geometry::uniformNormal(mesh.m_vertices, mesh.m_triangles, mesh.m_normals);
-            displayMesh->loadGeometry(mesh);
-
-            Core::Vector3Array tangents;
-            Core::Vector3Array bitangents;
-            Core::Vector3Array texcoords;
-
-            Core::Vector4Array colors;
+            displayMesh->loadGeometry(std::move(mesh));
 
-            for (const auto& v : asset->getTangents())   tangents.push_back(v);
-            for (const auto& v : asset->getBiTangents()) bitangents.push_back(v);
-            for (const auto& v : asset->getTexCoords())  texcoords.push_back(v);
-            for (const auto& v : asset->getColors())     colors.push_back(v);
-
-            displayMesh->addData(Mesh::VERTEX_TANGENT, tangents);
-            displayMesh->addData(Mesh::VERTEX_BITANGENT, bitangents);
-            displayMesh->addData(Mesh::VERTEX_TEXCOORD, texcoords);
-            displayMesh->addData(Mesh::VERTEX_COLOR, colors);
+            // The attribute arrays are shared with the asset.
+            displayMesh->addData(Mesh::VERTEX_TANGENT, asset->getSharedTangents());
+            displayMesh->addData(Mesh::VERTEX_BITANGENT, asset->getSharedBiTangents());
+            displayMesh->addData(Mesh::VERTEX_TEXCOORD, asset->getSharedTexCoords());
+            displayMesh->addData(Mesh::VERTEX_COLOR, asset->getSharedColors());
 
             Material* mat = new Material(name);
 
@@ -380,6 +366,11 @@ namespace Ra
             }
         }
 
+        bool RenderObject::hasLifetime() const
+        {
+            return m_hasLifetime;
+        }
+
         void RenderObject::hasExpired()
         {
             m_component->notifyRenderObjectExpired( idx );
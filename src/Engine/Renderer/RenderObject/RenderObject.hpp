@@ -118,6 +118,9 @@ namespace Ra
             void hasBeenRenderedOnce();
             void hasExpired();
 
+            /// Returns true if the render object has a finite lifetime.
+            bool hasLifetime() const;
+
             virtual void render( const RenderParameters& lightParams, const RenderData& rdata, const ShaderProgram* altShader = nullptr );
 
         private:
@@ -1,14 +1,27 @@
 #include <Engine/Renderer/RenderObject/RenderObjectManager.hpp>
 
 
+#include <Core/Math/Obb.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Component/Component.hpp>
+#include <Engine/Renderer/Mesh/Mesh.hpp>
 
 namespace Ra
 {
     namespace Engine
     {
+        namespace
+        {
+            Core::Aabb getWorldAabb( const Core::Aabb& localAabb, const Core::Transform& transform )
+            {
+                return localAabb.isEmpty() ? localAabb : Core::Obb( localAabb, transform ).toAabb();
+            }
+        }
+
         RenderObjectManager::RenderObjectManager()
+            : m_numCulledObjects( 0 )
         {
         }
 
@@ -36,8 +49,20 @@ namespace Ra
 
             m_renderObjectByType[(int)type].insert( index );
 
-            if (type == RenderObjectType::Fancy)
-                m_fancyBVH.insertLeaf(newRenderObject);
+            if ( type == RenderObjectType::Fancy )
+            {
+                // The object is inserted in the BVH when first culled, once its mesh is set.
+                CullingData data;
+                data.m_renderObject = newRenderObject;
+                data.m_transform = renderObject->getTransform();
+                if ( renderObject->getMesh() )
+                {
+                    data.m_localAabb = Core::MeshUtils::getAabb( renderObject->getMesh()->getGeometry() );
+                }
+                data.m_leaf = Core::BVH<RenderObject>::INVALID_NODE;
+                m_fancyObjectsPos[index] = m_fancyObjects.size();
+                m_fancyObjects.push_back( data );
+            }
 
             Engine::RadiumEngine::getInstance()->getSignalManager()->fireRenderObjectAdded(
                     ItemEntry( renderObject->getComponent()->getEntity(),
@@ -64,6 +89,7 @@ namespace Ra
             m_renderObjects.remove( index );
             auto type = renderObject->getType();
             m_renderObjectByType[(int)type].erase( index );
+            removeFancyObject( index );
             renderObject.reset();
         }
 
@@ -92,13 +118,12 @@ namespace Ra
             // Take the mutex
             std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
 
-            /*if (type == RenderObjectType::Fancy)
+            if ( type == RenderObjectType::Fancy )
             {
-                Core::Matrix4 mvp(renderData.projMatrix * renderData.viewMatrix);
-                m_fancyBVH.update();
-                m_fancyBVH.getInFrustumSlow(objectsOut, Core::Frustum(mvp));
+                Core::Matrix4 mvp( renderData.projMatrix * renderData.viewMatrix );
+                cullFancyObjects( Core::Frustum( mvp ), objectsOut );
             }
-            else*/
+            else
             {
                 //// Copy each element in m_renderObjects
                 for ( const auto& idx : m_renderObjectByType[(int)type] )
@@ -118,10 +143,111 @@ namespace Ra
             auto type = ro->getType();
 
             m_renderObjectByType[(int)type].erase( idx );
+            removeFancyObject( idx );
 
             ro->hasExpired();
 
             ro.reset();
         }
+
+        Core::Aabb RenderObjectManager::getSceneAabb() const
+        {
+            std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
+
+            Core::Aabb aabb;
+            for ( const auto& data : m_fancyObjects )
+            {
+                const RenderObject* ro = data.m_renderObject.get();
+                if ( ro->getMesh() )
+                {
+                    aabb.extend( getWorldAabb( data.m_localAabb, ro->getTransform() ) );
+                }
+            }
+            return aabb;
+        }
+
+        uint RenderObjectManager::getNumCulledObjects() const
+        {
+            std::lock_guard<std::mutex> lock( m_doubleBufferMutex );
+            return m_numCulledObjects;
+        }
+
+        void RenderObjectManager::cullFancyObjects( const Core::Frustum& frustum,
+                                                    std::vector<std::shared_ptr<RenderObject>>& objectsOut ) const
+        {
+            const uint numObjectsBefore = objectsOut.size();
+
+            for ( auto& data : m_fancyObjects )
+            {
+                RenderObject* ro = data.m_renderObject.get();
+                const std::shared_ptr<Mesh>& mesh = ro->getMesh();
+
+                // Objects with a lifetime must be drawn to expire.
+                if ( !mesh || ro->hasLifetime() )
+                {
+                    if ( data.m_leaf != Core::BVH<RenderObject>::INVALID_NODE )
+                    {
+                        m_fancyBVH.removeLeaf( data.m_leaf );
+                        data.m_leaf = Core::BVH<RenderObject>::INVALID_NODE;
+                    }
+                    objectsOut.push_back( data.m_renderObject );
+                    continue;
+                }
+
+                const Core::Transform transform = ro->getTransform();
+                if ( data.m_leaf == Core::BVH<RenderObject>::INVALID_NODE )
+                {
+                    data.m_transform = transform;
+                    if ( data.m_localAabb.isEmpty() )
+                    {
+                        data.m_localAabb = Core::MeshUtils::getAabb( mesh->getGeometry() );
+                    }
+                    data.m_leaf = m_fancyBVH.insertLeaf( data.m_renderObject,
+                                                         getWorldAabb( data.m_localAabb, transform ) );
+                    continue;
+                }
+
+                // Only recompute the box of objects which moved or were deformed.
+                const bool deformed = mesh->isDirty( Mesh::VERTEX_POSITION );
+                if ( deformed )
+                {
+                    data.m_localAabb = Core::MeshUtils::getAabb( mesh->getGeometry() );
+                }
+                if ( deformed || transform.matrix() != data.m_transform.matrix() )
+                {
+                    data.m_transform = transform;
+                    m_fancyBVH.updateLeaf( data.m_leaf, getWorldAabb( data.m_localAabb, transform ) );
+                }
+            }
+
+            m_fancyBVH.getInFrustum( objectsOut, frustum );
+
+            m_numCulledObjects = m_fancyObjects.size() - ( objectsOut.size() - numObjectsBefore );
+        }
+
+        void RenderObjectManager::removeFancyObject( const Core::Index& index )
+        {
+            auto it = m_fancyObjectsPos.find( index );
+            if ( it == m_fancyObjectsPos.end() )
+            {
+                return;
+            }
+
+            const uint pos = it->second;
+            m_fancyObjectsPos.erase( it );
+
+            if ( m_fancyObjects[pos].m_leaf != Core::BVH<RenderObject>::INVALID_NODE )
+            {
+                m_fancyBVH.removeLeaf( m_fancyObjects[pos].m_leaf );
+            }
+
+            // Move the last object in the hole.
+            if ( pos + 1 < m_fancyObjects.size() )
+            {
+                m_fancyObjects[pos] = m_fancyObjects.back();
+                m_fancyObjectsPos[m_fancyObjects[pos].m_renderObject->idx] = pos;
+            }
+            m_fancyObjects.pop_back();
+        }
     }
 } // namespace Ra
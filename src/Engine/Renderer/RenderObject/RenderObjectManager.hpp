@@ -13,6 +13,7 @@
 
 #include <Core/Index/Index.hpp>
 #include <Core/Index/IndexMap.hpp>
+#include <Core/Containers/AlignedStdVector.hpp>
 #include <Core/TreeStructures/BVH.hpp>
 #include <Core/Math/Frustum.hpp>
 #include <Engine/Renderer/RenderObject/RenderObjectTypes.hpp>
@@ -43,9 +44,20 @@ namespace Ra
              */
             void getRenderObjects( std::vector<std::shared_ptr<RenderObject>>& objectsOut) const;
 
+            /**
+             * @brief Get the render objects of the given type. Fancy render objects
+             * outside of the view frustum of renderData are not returned.
+             */
             void getRenderObjectsByType( const RenderData& renderData, std::vector<std::shared_ptr<RenderObject>>& objectsOut,
                                          const RenderObjectType& type ) const;
 
+            /// Returns the box enclosing the Fancy render objects. It is computed from the boxes
+            /// kept for culling, so it does not touch the vertices of the meshes.
+            Core::Aabb getSceneAabb() const;
+
+            /// Number of Fancy render objects rejected by the last call to getRenderObjectsByType().
+            uint getNumCulledObjects() const;
+
             /// Returns true if the index points to a valid render object.
             bool exists( const Core::Index& index) const;
 
@@ -53,10 +65,32 @@ namespace Ra
 
             void renderObjectExpired( const Ra::Core::Index& idx );
 
+        private:
+            /// Culling state of a Fancy render object.
+            struct CullingData
+            {
+                std::shared_ptr<RenderObject> m_renderObject;
+                /// Transform and mesh box the BVH leaf was computed with. The mesh box is
+                /// computed when the object is added, and updated when the mesh is deformed.
+                Core::Transform m_transform;
+                Core::Aabb m_localAabb;
+                /// Leaf in m_fancyBVH, invalid until the object is first culled.
+                uint m_leaf;
+            };
+
+            /// Bring the BVH up to date and append the Fancy objects intersecting the frustum.
+            void cullFancyObjects( const Core::Frustum& frustum, std::vector<std::shared_ptr<RenderObject>>& objectsOut ) const;
+
+            void removeFancyObject( const Core::Index& index );
+
         private:
             Core::IndexMap<std::shared_ptr<RenderObject>> m_renderObjects;
 
             mutable Core::BVH<RenderObject> m_fancyBVH ;
+            mutable Core::AlignedStdVector<CullingData> m_fancyObjects;
+            /// Position of each Fancy render object in m_fancyObjects.
+            std::map<Core::Index, uint> m_fancyObjectsPos;
+            mutable uint m_numCulledObjects;
 
             std::array<std::set<Core::Index>, (int)RenderObjectType::Count> m_renderObjectByType;
 
@@ -1,17 +1,21 @@
 #include <Engine/Renderer/Renderer.hpp>
 
+#include <algorithm>
 #include <iostream>
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
-#include <assimp/postprocess.h>
 
 #include <Core/Log/Log.hpp>
 #include <Core/Math/ColorPresets.hpp>
 #include <Core/Mesh/MeshUtils.hpp>
 #include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Time/Profiler.hpp>
 
 #include <Engine/RadiumEngine.hpp>
+#include <Engine/Assets/FileData.hpp>
+#include <Engine/Assets/LightData.hpp>
+#include <Engine/Assets/AssimpLightDataLoader.hpp>
 #include <Engine/Renderer/OpenGL/OpenGL.hpp>
 #include <Engine/Renderer/OpenGL/FBO.hpp>
 #include <Engine/Renderer/RenderTechnique/ShaderProgramManager.hpp>
@@ -57,6 +61,7 @@ namespace Ra
             , m_drawDebug( true )
             , m_wireframe(false)
             , m_postProcessEnabled(true)
+            , m_uploadTimeBudget( 4 )
         {
         }
 
@@ -159,6 +164,17 @@ namespace Ra
             drawScreenInternal();
             m_timerData.renderEnd = Core::Timer::Clock::now();
 
+            Core::Profiler& profiler = Core::Profiler::getInstance();
+            if ( profiler.isEnabled() )
+            {
+                profiler.record( "Render", m_timerData.renderStart, m_timerData.renderEnd );
+                profiler.record( "Feed render queues", m_timerData.renderStart, m_timerData.feedRenderQueuesEnd );
+                profiler.record( "Update render objects", m_timerData.feedRenderQueuesEnd, m_timerData.updateEnd );
+                profiler.record( "Main render", m_timerData.updateEnd, m_timerData.mainRenderEnd );
+                profiler.record( "Post process", m_timerData.mainRenderEnd, m_timerData.postProcessEnd );
+                profiler.record( "Debug, UI and display", m_timerData.postProcessEnd, m_timerData.renderEnd );
+            }
+
             // 9. Tell renderobjects they have been drawn (to decreaase the counter)
             notifyRenderObjectsRenderingInternal();
         }
@@ -170,7 +186,33 @@ namespace Ra
 
         void Renderer::updateRenderObjectsInternal( const RenderData& renderData )
         {
-            for ( auto& ro : m_fancyRenderObjects ) ro->updateGL();
+            // Meshes sent to the GPU for the first time are uploaded within the time budget,
+            // the others are postponed and not drawn during this frame.
+            const Core::Timer::TimePoint uploadStart = Core::Timer::Clock::now();
+            bool budgetExceeded = false;
+            uint numPendingUploads = 0;
+            for ( auto it = m_fancyRenderObjects.begin(); it != m_fancyRenderObjects.end(); )
+            {
+                const RenderObjectPtr& ro = *it;
+                const bool firstUpload = ro->getMesh() && !ro->getMesh()->isUploaded();
+                if ( firstUpload && budgetExceeded )
+                {
+                    ++numPendingUploads;
+                    it = m_fancyRenderObjects.erase( it );
+                    continue;
+                }
+
+                ro->updateGL();
+
+                if ( firstUpload && m_uploadTimeBudget > 0 )
+                {
+                    const Scalar elapsed = Core::Timer::getIntervalSeconds( uploadStart, Core::Timer::Clock::now() );
+                    budgetExceeded = elapsed * 1000 > m_uploadTimeBudget;
+                }
+                ++it;
+            }
+            m_timerData.numPendingUploads = numPendingUploads;
+
             for ( auto& ro : m_xrayRenderObjects  ) ro->updateGL();
             for ( auto& ro : m_debugRenderObjects ) ro->updateGL();
             for ( auto& ro : m_uiRenderObjects    ) ro->updateGL();
@@ -187,6 +229,10 @@ namespace Ra
             m_roMgr->getRenderObjectsByType( renderData, m_debugRenderObjects, RenderObjectType::Debug );
             m_roMgr->getRenderObjectsByType( renderData, m_uiRenderObjects,    RenderObjectType::UI );
 
+            m_timerData.numCulledObjects = m_roMgr->getNumCulledObjects();
+            m_timerData.numDrawnObjects = std::count_if( m_fancyRenderObjects.begin(), m_fancyRenderObjects.end(),
+                                                         []( const RenderObjectPtr& ro ) { return ro->isVisible(); } );
+
             for ( auto it = m_fancyRenderObjects.begin(); it != m_fancyRenderObjects.end(); )
             {
                 if ( (*it)->isXRay() )
@@ -472,134 +518,68 @@ namespace Ra
         void Renderer::handleFileLoading( const std::string& filename )
         {
             Assimp::Importer importer;
-            const aiScene* scene = importer.ReadFile( filename,
-                                                      aiProcess_Triangulate |
-                                                      aiProcess_JoinIdenticalVertices |
-                                                      aiProcess_GenSmoothNormals |
-                                                      aiProcess_SortByPType |
-                                                      aiProcess_FixInfacingNormals |
-                                                      aiProcess_CalcTangentSpace |
-                                                      aiProcess_GenUVCoords );
-
-            if ( !scene )
+            // Only the lights are used, the meshes do not need any post-processing.
+            const aiScene* scene = importer.ReadFile( filename, 0 );
+
+            std::vector<std::unique_ptr<Asset::LightData>> data;
+            Asset::AssimpLightDataLoader loader;
+            loader.loadData( scene, data );
+
+            for ( const auto& light : data )
             {
-                return;
+                addLight( createLight( *light ) );
             }
+        }
 
-            if ( !scene->HasLights() )
+        void Renderer::loadLights( const Asset::FileData& fileData, std::vector<std::shared_ptr<Light>>& lights )
+        {
+            for ( const Asset::LightData* light : fileData.getLightData() )
             {
-                return;
+                lights.push_back( createLight( *light ) );
             }
+        }
 
-            // Load lights
-            for ( uint lightId = 0; lightId < scene->mNumLights; ++lightId )
+        std::shared_ptr<Light> Renderer::createLight( const Asset::LightData& data )
+        {
+            // The lights shine the opposite way of the direction given by the file.
+            switch ( data.getType() )
             {
-                aiLight* ailight = scene->mLights[lightId];
-
-                aiString name = ailight->mName;
-                aiNode* node = scene->mRootNode->FindNode( name );
-
-                Core::Matrix4 transform( Core::Matrix4::Identity() );
-
-                if ( node != nullptr )
+                case Asset::LightData::DIRECTIONAL:
                 {
-                    Core::Matrix4 t0;
-                    Core::Matrix4 t1;
-
-                    for ( uint i = 0; i < 4; ++i )
-                    {
-                        for ( uint j = 0; j < 4; ++j )
-                        {
-                            t0( i, j ) = scene->mRootNode->mTransformation[i][j];
-                            t1( i, j ) = node->mTransformation[i][j];
-                        }
-                    }
-                    transform = t0 * t1;
+                    auto light = std::shared_ptr<DirectionalLight>( new DirectionalLight() );
+                    light->setColor( data.getColor() );
+                    light->setDirection( -data.getDirection() );
+                    return light;
                 }
 
-                Core::Color color( ailight->mColorDiffuse.r,
-                                   ailight->mColorDiffuse.g,
-                                   ailight->mColorDiffuse.b, 1.0 );
-
-                switch ( ailight->mType )
+                case Asset::LightData::POINT:
                 {
-                    case aiLightSource_DIRECTIONAL:
-                    {
-                        Core::Vector4 dir( ailight->mDirection[0],
-                                           ailight->mDirection[1],
-                                           ailight->mDirection[2], 0.0 );
-                        dir = transform.transpose().inverse() * dir;
-
-                        Core::Vector3 finalDir( dir.x(), dir.y(), dir.z() );
-                        finalDir = -finalDir;
-
-                        auto light = std::shared_ptr<DirectionalLight>( new DirectionalLight() );
-                        light->setColor( color );
-                        light->setDirection( finalDir );
-
-                        addLight( light );
-
-                    }
-                    break;
-
-                    case aiLightSource_POINT:
-                    {
-                        Core::Vector4 pos( ailight->mPosition[0],
-                                           ailight->mPosition[1],
-                                           ailight->mPosition[2], 1.0 );
-                        pos = transform * pos;
-                        pos /= pos.w();
-
-                        auto light = std::shared_ptr<PointLight>( new PointLight() );
-                        light->setColor( color );
-                        light->setPosition( Core::Vector3( pos.x(), pos.y(), pos.z() ) );
-                        light->setAttenuation( ailight->mAttenuationConstant,
-                                               ailight->mAttenuationLinear,
-                                               ailight->mAttenuationQuadratic );
-
-                        addLight( light );
-
-                    }
-                    break;
-
-                    case aiLightSource_SPOT:
-                    {
-                        Core::Vector4 pos( ailight->mPosition[0],
-                                           ailight->mPosition[1],
-                                           ailight->mPosition[2], 1.0 );
-                        pos = transform * pos;
-                        pos /= pos.w();
-
-                        Core::Vector4 dir( ailight->mDirection[0],
-                                           ailight->mDirection[1],
-                                           ailight->mDirection[2], 0.0 );
-                        dir = transform.transpose().inverse() * dir;
-
-                        Core::Vector3 finalDir( dir.x(), dir.y(), dir.z() );
-                        finalDir = -finalDir;
-
-                        auto light = std::shared_ptr<SpotLight>( new SpotLight() );
-                        light->setColor( color );
-                        light->setPosition( Core::Vector3( pos.x(), pos.y(), pos.z() ) );
-                        light->setDirection( finalDir );
-
-                        light->setAttenuation( ailight->mAttenuationConstant,
-                                               ailight->mAttenuationLinear,
-                                               ailight->mAttenuationQuadratic );
-
-                        light->setInnerAngleInRadians( ailight->mAngleInnerCone );
-                        light->setOuterAngleInRadians( ailight->mAngleOuterCone );
-
-                        addLight( light );
+                    auto light = std::shared_ptr<PointLight>( new PointLight() );
+                    light->setColor( data.getColor() );
+                    light->setPosition( data.getPosition() );
+                    light->setAttenuation( data.getConstantAttenuation(),
+                                           data.getLinearAttenuation(),
+                                           data.getQuadraticAttenuation() );
+                    return light;
+                }
 
-                    }
-                    break;
+                case Asset::LightData::SPOT:
+                {
+                    auto light = std::shared_ptr<SpotLight>( new SpotLight() );
+                    light->setColor( data.getColor() );
+                    light->setPosition( data.getPosition() );
+                    light->setDirection( -data.getDirection() );
+                    light->setAttenuation( data.getConstantAttenuation(),
+                                           data.getLinearAttenuation(),
+                                           data.getQuadraticAttenuation() );
+                    light->setInnerAngleInRadians( data.getInnerAngle() );
+                    light->setOuterAngleInRadians( data.getOuterAngle() );
+                    return light;
+                }
 
-                    case aiLightSource_UNDEFINED:
-                    default:
-                    {
-                        //                LOG(ERROR) << "Light " << name.C_Str() << " has undefined type.";
-                    } break;
+                default:
+                {
+                    return nullptr;
                 }
             }
         }
@@ -25,6 +25,12 @@ namespace Ra
 
 namespace Ra
 {
+    namespace Asset
+    {
+        class FileData;
+        class LightData;
+    }
+
     namespace Engine
     {
         class Camera;
@@ -65,6 +71,11 @@ namespace Ra
                 Core::Timer::TimePoint mainRenderEnd;
                 Core::Timer::TimePoint postProcessEnd;
                 Core::Timer::TimePoint renderEnd;
+                /// Fancy render objects drawn and rejected by frustum culling.
+                uint numDrawnObjects;
+                uint numCulledObjects;
+                /// Fancy render objects waiting for their first upload to the GPU.
+                uint numPendingUploads;
             };
 
             struct PickingQuery
@@ -161,6 +172,18 @@ namespace Ra
             // FIXME(Charly): Final ?
             virtual void handleFileLoading( const std::string& filename ) final;
 
+            /// Creates the lights of a loaded file. The file is not read again, the lights
+            /// being stored in its data (see Asset::LightData). Add them with addLight().
+            static void loadLights( const Asset::FileData& fileData, std::vector<std::shared_ptr<Light>>& lights );
+
+            /// Sets the time, in milliseconds, spent each frame to send new meshes to the GPU.
+            /// The meshes which do not fit in the budget are uploaded and drawn on the next
+            /// frames. At least one new mesh is uploaded per frame. Zero removes the limit.
+            virtual void setUploadTimeBudget( Scalar milliseconds ) final
+            {
+                m_uploadTimeBudget = milliseconds;
+            }
+
             virtual void addPickingRequest(const PickingQuery& query)
             {
                 m_pickingQueries.push_back( query );
@@ -274,6 +297,9 @@ namespace Ra
             // 7.
             virtual void notifyRenderObjectsRenderingInternal() final;
 
+            /// Creates the renderer light of a file light.
+            static std::shared_ptr<Light> createLight( const Asset::LightData& data );
+
         protected:
             uint m_width;
             uint m_height;
@@ -311,6 +337,8 @@ namespace Ra
             bool m_wireframe;           // Are we rendering in "real" wireframe mode
             bool m_postProcessEnabled;  // Should we do post processing ?
 
+            Scalar m_uploadTimeBudget;  // Time given to new meshes uploads each frame, in ms.
+
         private:
             // Qt has the nice idea to bind an fbo before giving you the opengl context,
             // this flag is used to save it (and render the final screen on it)
@@ -9,6 +9,7 @@ namespace Ra
     namespace Engine
     {
         System::System()
+            : m_componentsChanged( true )
         {
         }
 
@@ -33,6 +34,7 @@ namespace Ra
 #endif // DEBUG
             m_components.push_back({ ent, component });
             component->setSystem( this );
+            m_componentsChanged = true;
 
         }
 
@@ -47,6 +49,7 @@ namespace Ra
             CORE_ASSERT( pos->first == ent, "Component belongs to a different entity" );
 
             m_components.erase( pos );
+            m_componentsChanged = true;
         }
 
 
@@ -57,6 +60,7 @@ namespace Ra
                 [entity]( const auto& pair ) {return pair.first == entity; } )) != m_components.end())
             {
                 m_components.erase( pos );
+                m_componentsChanged = true;
             }
         }
     }
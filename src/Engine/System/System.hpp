@@ -61,6 +61,21 @@ namespace Ra
              */
             virtual void generateTasks( Core::TaskQueue* taskQueue, const Engine::FrameInfo& frameInfo ) = 0;
 
+            /// Returns true if the tasks created by generateTasks() can be run again on the next
+            /// frames. The engine then only calls updateTasks() until components change.
+            virtual bool hasPersistentTasks() const { return false; }
+
+            /// Called instead of generateTasks() when the tasks of the previous frame are
+            /// run again. Systems update the per-frame parameters of their tasks here.
+            virtual void updateTasks( const Engine::FrameInfo& frameInfo ) {}
+
+            /// Returns true if components were registered or unregistered since the tasks
+            /// were last generated.
+            bool hasComponentsChanged() const { return m_componentsChanged; }
+
+            /// Called by the engine once the tasks have been generated again.
+            void clearComponentsChanged() { m_componentsChanged = false; }
+
 
             /// Registers a component belonging to an entity, making it active within the system.
             void registerComponent( const Entity* entity, Component* component );
@@ -82,6 +97,9 @@ namespace Ra
         protected:
             /// List of active components.
             std::vector<std::pair< const Entity*, Component*> > m_components;
+
+            /// True if the list of components changed since the tasks were generated.
+            bool m_componentsChanged;
         };
 
     } // namespace Engine
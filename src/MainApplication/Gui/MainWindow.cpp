@@ -154,9 +154,13 @@ namespace Ra
         long sumTasks = 0;
         long sumFrame = 0;
         long sumInterFrame = 0;
+        long sumDrawn = 0;
+        long sumCulled = 0;
 
         for (uint i = 0; i < stats.size(); ++i)
         {
+            sumDrawn += stats[i].renderData.numDrawnObjects;
+            sumCulled += stats[i].renderData.numCulledObjects;
             sumEvents += Core::Timer::getIntervalMicro(stats[i].eventsStart, stats[i].eventsEnd);
             sumRender += Core::Timer::getIntervalMicro(stats[i].renderData.renderStart, stats[i].renderData.renderEnd);
             sumTasks += Core::Timer::getIntervalMicro(stats[i].tasksStart, stats[i].tasksEnd);
@@ -180,6 +184,8 @@ namespace Ra
         m_frameTime->setValue(sumFrame / N);
         m_frameUpdates->setValue(T / Scalar(sumFrame));
         m_avgFramerate->setValue((N - 1) * Scalar(1000000.0 / sumInterFrame));
+        m_drawnObjects->setValue(sumDrawn / N);
+        m_culledObjects->setValue(sumCulled / N);
     }
 
     Gui::Viewer* Gui::MainWindow::getViewer()
@@ -6,6 +6,10 @@
 #include <QDir>
 #include <QPluginLoader>
 #include <QCommandLineParser>
+#include <QShortcut>
+
+#include <algorithm>
+#include <thread>
 
 #include <Core/Log/Log.hpp>
 #include <Core/String/StringUtils.hpp>
@@ -14,10 +18,13 @@
 #include <Core/Math/ColorPresets.hpp>
 #include <Core/Tasks/Task.hpp>
 #include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Time/Profiler.hpp>
 #include <Core/String/StringUtils.hpp>
 
 #include <Engine/RadiumEngine.hpp>
 #include <Engine/Entity/Entity.hpp>
+#include <Engine/Assets/FileData.hpp>
 #include <Engine/Managers/SystemDisplay/SystemDisplay.hpp>
 
 #include <Engine/Renderer/Renderer.hpp>
@@ -31,6 +38,7 @@
 #include <Engine/Renderer/RenderTechnique/ShaderConfigFactory.hpp>
 
 #include <MainApplication/Gui/MainWindow.hpp>
+#include <MainApplication/Viewer/OffscreenViewer.hpp>
 #include <MainApplication/Version.hpp>
 
 #include <MainApplication/PluginBase/RadiumPluginInterface.hpp>
@@ -48,7 +56,10 @@ namespace Ra
         , m_viewer( nullptr )
         , m_frameTimer( new QTimer( this ) )
         , m_frameCounter( 0 )
+        , m_frameCountBeforeUpdate( 1 )
         , m_numFrames( 0 )
+        , m_traceStartFrame( 0 )
+        , m_realFrameRate( false )
         , m_isAboutToQuit( false )
         //, m_timerData(TIMER_AVERAGE)
     {
@@ -71,14 +82,40 @@ namespace Ra
         QCommandLineOption pluginOpt(QStringList{"p", "plugins", "pluginsPath"}, "Set the path to the plugin dlls", "../Plugins/bin");
         QCommandLineOption fileOpt(QStringList{"f", "file", "scene"}, "Open a scene file at startup", "foo.bar");
         QCommandLineOption numFramesOpt(QStringList{"n", "numframes"}, "Run for a fixed number of frames", "0");
+        QCommandLineOption traceOpt(QStringList{"t", "trace"}, "Record a profiling trace from startup to exit in the given file, keeping the last 10000 zones of each thread (F12 records a trace at any time)", "trace.json");
+        QCommandLineOption headlessOpt(QStringList{"headless"}, "Run without window, rendering offscreen, as fast as possible and with a fixed time step of 1/fps (for benchmarks). The startup file is loaded before the first frame. Without display, set QT_QPA_PLATFORM=offscreen");
+        QCommandLineOption noRenderOpt(QStringList{"norender"}, "In headless mode, only run the engine tasks");
+        QCommandLineOption statsOpt(QStringList{"s", "stats"}, "Write the durations of each frame (events, tasks, render passes) and their percentiles in the given file, as CSV if its extension is csv and as JSON otherwise", "stats.json");
+        QCommandLineOption cacheOpt(QStringList{"c", "cache"}, "Reuse the processed data of the loaded files from a binary cache, written next to each file (file.radium)");
         // NOTE(Charly): Add other options here
 
-        parser.addOptions({fpsOpt, pluginOpt, fileOpt, numFramesOpt });
+        parser.addOptions({fpsOpt, pluginOpt, fileOpt, numFramesOpt, traceOpt, headlessOpt, noRenderOpt, statsOpt, cacheOpt });
         parser.process(*this);
 
         if (parser.isSet(fpsOpt))       m_targetFPS = parser.value(fpsOpt).toUInt();
         if (parser.isSet(pluginOpt))    pluginsPath = parser.value(pluginOpt).toStdString();
         if (parser.isSet(numFramesOpt)) m_numFrames = parser.value(numFramesOpt).toUInt();
+        if (parser.isSet(statsOpt))     m_statsFile = parser.value(statsOpt).toStdString();
+
+        const bool headless = parser.isSet(headlessOpt);
+        if ( headless && m_numFrames == 0 )
+        {
+            m_numFrames = 1000;
+        }
+        if ( headless && m_targetFPS == 0 )
+        {
+            // The frame rate only gives the time step in headless mode.
+            m_targetFPS = 60;
+        }
+
+        Core::Profiler::getInstance().setThreadName( "Main" );
+        if (parser.isSet(traceOpt))
+        {
+            // Also records the initialization and the loading of the startup file, unless they
+            // were overwritten: the profiler only keeps the last zones of each thread.
+            m_traceFile = parser.value(traceOpt).toStdString();
+            toggleTraceCapture();
+        }
 
         // Boilerplate print.
         LOG( logINFO ) << "*** Radium Engine Main App  ***";
@@ -128,32 +165,70 @@ namespace Ra
         // Create engine
         m_engine.reset(Engine::RadiumEngine::createInstance());
         m_engine->initialize();
+        m_engine->setPersistentTasks( true );
+        m_engine->setUseFileCache( parser.isSet(cacheOpt) );
+        // Log the progress of the loading steps every 10%.
+        m_engine->setLoadingProgressCallback( []( const std::string& step, uint done, uint total )
+        {
+            if ( total > 1 && done > 0 && ( done == total || done * 10 / total != ( done - 1 ) * 10 / total ) )
+            {
+                LOG( logINFO ) << step << " : " << done << " / " << total;
+            }
+        } );
 
-        // Create main window.
-        m_mainWindow.reset( new Gui::MainWindow );
-        m_mainWindow->show();
-
-        addBasicShaders();
+        if ( headless )
+        {
+            addBasicShaders();
 
-        // Allow all events to be processed (thus the viewer should have
-        // initialized the OpenGL context..)
-        processEvents();
+            if ( !parser.isSet(noRenderOpt) )
+            {
+                m_offscreenViewer.reset( new Gui::OffscreenViewer( 800, 600 ) );
+                if ( !m_offscreenViewer->initialize() )
+                {
+                    LOG( logWARNING ) << "Could not create an offscreen OpenGL context, running without rendering.";
+                    m_offscreenViewer.reset();
+                }
+            }
 
-        // Load plugins
-        if ( !loadPlugins( pluginsPath ) )
-        {
-            LOG( logERROR ) << "An error occurred while trying to load plugins.";
+            if ( !loadPlugins( pluginsPath ) )
+            {
+                LOG( logERROR ) << "An error occurred while trying to load plugins.";
+            }
         }
+        else
+        {
+            // Create main window.
+            m_mainWindow.reset( new Gui::MainWindow );
+            m_mainWindow->show();
 
-        m_viewer = m_mainWindow->getViewer();
-        CORE_ASSERT( m_viewer != nullptr, "GUI was not initialized" );
-        CORE_ASSERT( m_viewer->context()->isValid(), "OpenGL was not initialized" );
+            addBasicShaders();
 
-        // Pass the engine to the renderer to complete the initialization process.
-        m_viewer->initRenderer();
+            // Allow all events to be processed (thus the viewer should have
+            // initialized the OpenGL context..)
+            processEvents();
 
-        // Create task queue with N-1 threads (we keep one for rendering).
-        m_taskQueue.reset( new Core::TaskQueue( std::thread::hardware_concurrency() - 1 ) );
+            // Load plugins
+            if ( !loadPlugins( pluginsPath ) )
+            {
+                LOG( logERROR ) << "An error occurred while trying to load plugins.";
+            }
+
+            m_viewer = m_mainWindow->getViewer();
+            CORE_ASSERT( m_viewer != nullptr, "GUI was not initialized" );
+            CORE_ASSERT( m_viewer->context()->isValid(), "OpenGL was not initialized" );
+
+            // Pass the engine to the renderer to complete the initialization process.
+            m_viewer->initRenderer();
+        }
+
+        // Create task queue with N-1 threads (we keep one for rendering), but at least one.
+        // hardware_concurrency() returns 0 when it cannot tell the number of cores.
+        // The main thread runs tasks too while waiting for them in radiumFrame().
+        const uint numThreads = std::max( 2u, std::thread::hardware_concurrency() ) - 1;
+        m_taskQueue.reset( new Core::TaskQueue( numThreads,
+                                                Core::TaskQueue::SchedulingMode::WORK_STEALING ) );
+        // Data-parallel loops of the Core algorithms and plugins share the same threads.
+        Core::setParallelForTaskQueue( m_taskQueue.get() );
 
         createConnections();
 
@@ -164,6 +239,13 @@ namespace Ra
         if (parser.isSet(fileOpt))
         {
             loadFile(parser.value(fileOpt));
+
+            // The benchmarked frames start with the file in the scene.
+            while ( headless && ( m_engine->isLoadingFiles() ) )
+            {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+                processLoadedFiles();
+            }
         }
 
         m_lastFrameStart = Core::Timer::Clock::now();
@@ -171,7 +253,16 @@ namespace Ra
 
     void MainApplication::createConnections()
     {
+        if ( isHeadless() )
+        {
+            return;
+        }
+
         connect( m_mainWindow.get(), &Gui::MainWindow::closed , this, &MainApplication::appNeedsToQuit );
+
+        QShortcut* traceShortcut = new QShortcut( QKeySequence( Qt::Key_F12 ), m_mainWindow.get() );
+        traceShortcut->setContext( Qt::ApplicationShortcut );
+        connect( traceShortcut, &QShortcut::activated, this, &MainApplication::toggleTraceCapture );
     }
 
     void MainApplication::setupScene()
@@ -192,34 +283,48 @@ namespace Ra
     {
         std::string pathStr = path.toLocal8Bit().data();
         LOG(logINFO) << "Loading file " << pathStr << "...";
-        bool res = m_engine->loadFile( pathStr );
-        CORE_UNUSED( res );
-        m_viewer->handleFileLoading( pathStr );
 
-        // Compute new scene aabb
-        Core::Aabb aabb;
+        // The file is read in the background while the frames go on,
+        // it is added to the scene by processLoadedFiles().
+        m_engine->loadFileAsync( pathStr );
+    }
 
-        std::vector<std::shared_ptr<Engine::RenderObject>> ros;
-        m_engine->getRenderObjectManager()->getRenderObjects( ros );
+    void MainApplication::processLoadedFiles()
+    {
+        const std::vector<std::unique_ptr<Asset::FileData>> files = m_engine->processLoadedFiles();
+        if ( files.empty() )
+        {
+            return;
+        }
 
-        for ( auto ro : ros )
+        // The lights were read with the rest of the file, it is not parsed again.
+        for ( const auto& file : files )
         {
-            auto mesh = ro->getMesh();
-            auto pos = mesh->getGeometry().m_vertices;
+            LOG(logINFO) << "File " << file->getFileName() << " loaded.";
 
-            for ( auto& p : pos )
+            std::vector<std::shared_ptr<Engine::Light>> lights;
+            Engine::Renderer::loadLights( *file, lights );
+            if ( m_viewer )
             {
-                p = ro->getLocalTransform() * p;
+                m_viewer->addLights( lights );
+            }
+            else if ( m_offscreenViewer )
+            {
+                m_offscreenViewer->addLights( lights );
             }
-
-            Ra::Core::Vector3 bmin = pos.getMap().rowwise().minCoeff().head<3>();
-            Ra::Core::Vector3 bmax = pos.getMap().rowwise().maxCoeff().head<3>();
-
-            aabb.extend( bmin );
-            aabb.extend( bmax );
         }
 
-        m_viewer->fitCameraToScene( aabb );
+        // The scene box is made of the boxes the render object manager keeps for each
+        // object, the vertices are not read again.
+        const Core::Aabb sceneAabb = m_engine->getRenderObjectManager()->getSceneAabb();
+        if ( m_viewer )
+        {
+            m_viewer->fitCameraToScene( sceneAabb );
+        }
+        else if ( m_offscreenViewer )
+        {
+            m_offscreenViewer->fitCameraToScene( sceneAabb );
+        }
 
         emit loadComplete();
     }
@@ -269,39 +374,57 @@ namespace Ra
 
         timerData.eventsStart = Core::Timer::Clock::now();
         processEvents();
+        processLoadedFiles();
         timerData.eventsEnd = Core::Timer::Clock::now();
 
         // ----------
         // 1. Gather user input and dispatch it.
 
         // Get picking results from last frame and forward it to the selection.
-        m_viewer->processPicking();
+        if ( m_viewer )
+        {
+            m_viewer->processPicking();
+        }
 
 
         // ----------
         // 2. Kickoff rendering
-        m_viewer->startRendering( dt );
+        if ( m_viewer )
+        {
+            m_viewer->startRendering( dt );
+        }
+        else if ( m_offscreenViewer )
+        {
+            m_offscreenViewer->render( dt );
+        }
 
         timerData.tasksStart = Core::Timer::Clock::now();
 
         // ----------
         // 3. Run the engine task queue.
+        // The tasks are kept in the queue until the engine needs to generate them again.
         m_engine->getTasks( m_taskQueue.get(), dt );
 
         // Run one frame of tasks
         m_taskQueue->startTasks();
-        m_taskQueue->waitForTasks();
+        m_taskQueue->waitForTasks( true );
         timerData.taskData = m_taskQueue->getTimerData();
-        m_taskQueue->flushTaskQueue();
 
         timerData.tasksEnd = Core::Timer::Clock::now();
 
         // ----------
         // 4. Wait until frame is fully rendered and display.
-        m_viewer->waitForRendering();
-        m_viewer->update();
+        if ( m_viewer )
+        {
+            m_viewer->waitForRendering();
+            m_viewer->update();
 
-        timerData.renderData = m_viewer->getRenderer()->getTimerData();
+            timerData.renderData = m_viewer->getRenderer()->getTimerData();
+        }
+        else if ( m_offscreenViewer )
+        {
+            timerData.renderData = m_offscreenViewer->getRenderer()->getTimerData();
+        }
 
         // ----------
         // 5. Synchronize whatever needs synchronisation
@@ -312,7 +435,20 @@ namespace Ra
         timerData.frameEnd = Core::Timer::Clock::now();
         timerData.numFrame = m_frameCounter;
 
-        m_timerData.push_back( timerData );
+        Core::Profiler& profiler = Core::Profiler::getInstance();
+        if ( profiler.isEnabled() )
+        {
+            profiler.record( "Frame " + std::to_string( m_frameCounter ), timerData.frameStart, timerData.frameEnd );
+            profiler.record( "Events", timerData.eventsStart, timerData.eventsEnd );
+            profiler.record( "Tasks", timerData.tasksStart, timerData.tasksEnd );
+            profiler.record( "Wait for rendering", timerData.tasksEnd, timerData.frameEnd );
+        }
+
+        if ( !m_statsFile.empty() )
+        {
+            addFrameStats( timerData );
+        }
+
         ++m_frameCounter;
 
         if (m_numFrames > 0  &&  m_frameCounter > m_numFrames )
@@ -320,6 +456,12 @@ namespace Ra
             appNeedsToQuit();
         }
 
+        if ( isHeadless() )
+        {
+            return;
+        }
+
+        m_timerData.push_back( timerData );
         if ( m_frameCounter % m_frameCountBeforeUpdate == 0 )
         {
             emit( updateFrameStats( m_timerData ) );
@@ -329,6 +471,52 @@ namespace Ra
         m_mainWindow->onFrameComplete();
     }
 
+    void MainApplication::addFrameStats( const FrameTimerData& data )
+    {
+        m_frameStats.beginFrame( data.numFrame );
+        m_frameStats.add( "Frame", data.frameStart, data.frameEnd );
+        m_frameStats.add( "Events", data.eventsStart, data.eventsEnd );
+        m_frameStats.add( "Tasks", data.tasksStart, data.tasksEnd );
+
+        // The tasks of a system have the same name, their durations are summed.
+        for ( const auto& task : data.taskData )
+        {
+            m_frameStats.add( "Task: " + task.taskName, task.start, task.end );
+        }
+
+        if ( m_viewer || m_offscreenViewer )
+        {
+            const Engine::Renderer::TimerData& render = data.renderData;
+            m_frameStats.add( "Render", render.renderStart, render.renderEnd );
+            m_frameStats.add( "Render: Feed render queues", render.renderStart, render.feedRenderQueuesEnd );
+            m_frameStats.add( "Render: Update render objects", render.feedRenderQueuesEnd, render.updateEnd );
+            m_frameStats.add( "Render: Main render", render.updateEnd, render.mainRenderEnd );
+            m_frameStats.add( "Render: Post process", render.mainRenderEnd, render.postProcessEnd );
+            m_frameStats.add( "Render: Debug, UI and display", render.postProcessEnd, render.renderEnd );
+        }
+    }
+
+    void MainApplication::writeFrameStats()
+    {
+        if ( m_frameStats.getNumFrames() == 0 )
+        {
+            return;
+        }
+
+        const Core::FrameStats::Summary frame = m_frameStats.getSummary( "Frame" );
+        LOG( logINFO ) << m_frameStats.getNumFrames() << " frames : " << frame.mean << " ms on average, "
+                       << frame.p50 << " ms median, " << frame.p99 << " ms at the 99th percentile.";
+
+        if ( m_frameStats.write( m_statsFile ) )
+        {
+            LOG( logINFO ) << "Frame statistics written in " << m_statsFile << ".";
+        }
+        else
+        {
+            LOG( logERROR ) << "Could not write the frame statistics in " << m_statsFile << ".";
+        }
+    }
+
     void MainApplication::appNeedsToQuit()
     {
         LOG( logDEBUG ) << "About to quit.";
@@ -340,11 +528,52 @@ namespace Ra
        m_realFrameRate = on;
     }
 
+    void MainApplication::toggleTraceCapture()
+    {
+        Core::Profiler& profiler = Core::Profiler::getInstance();
+        if ( !profiler.isEnabled() )
+        {
+            m_traceStart = Core::Timer::Clock::now();
+            m_traceStartFrame = m_frameCounter;
+            profiler.setEnabled( true );
+            LOG( logINFO ) << "Recording a profiling trace from frame " << m_frameCounter << ".";
+            return;
+        }
+
+        profiler.setEnabled( false );
+        std::string filename = m_traceFile;
+        if ( filename.empty() )
+        {
+            filename = "radium_trace_" + std::to_string( m_traceStartFrame ) + "-"
+                       + std::to_string( m_frameCounter ) + ".json";
+        }
+        m_traceFile.clear();
+
+        if ( profiler.writeChromeTrace( filename, m_traceStart, Core::Timer::Clock::now() ) )
+        {
+            LOG( logINFO ) << "Profiling trace of frames " << m_traceStartFrame << " to " << m_frameCounter
+                           << " written in " << filename << ".";
+        }
+        else
+        {
+            LOG( logERROR ) << "Could not write the profiling trace in " << filename << ".";
+        }
+    }
+
     MainApplication::~MainApplication()
     {
         LOG( logINFO ) << "About to quit... Cleaning RadiumEngine memory";
+        if ( Core::Profiler::getInstance().isEnabled() )
+        {
+            // Write the trace being recorded.
+            toggleTraceCapture();
+        }
+        writeFrameStats();
         emit stopping();
-        m_mainWindow->cleanup();
+        if ( m_mainWindow )
+        {
+            m_mainWindow->cleanup();
+        }
         m_engine->cleanup();
     }
 
@@ -362,7 +591,7 @@ namespace Ra
         {
             PluginContext context;
             context.m_engine = m_engine.get();
-            context.m_selectionManager = m_mainWindow->getSelectionManager();
+            context.m_selectionManager = m_mainWindow ? m_mainWindow->getSelectionManager() : nullptr;
 
             std::string ext = Core::StringUtils::getFileExt( filename.toStdString() );
 #if defined( OS_WINDOWS )
@@ -392,7 +621,10 @@ namespace Ra
                     {
                         ++pluginCpt;
                         loadedPlugin->registerPlugin( context );
-                        m_mainWindow->updateUi( loadedPlugin );
+                        if ( m_mainWindow )
+                        {
+                            m_mainWindow->updateUi( loadedPlugin );
+                        }
                     }
                     else
                     {
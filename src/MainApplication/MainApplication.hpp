@@ -4,6 +4,7 @@
 
 #include <QApplication>
 
+#include <Core/Time/FrameStats.hpp>
 #include <Core/Time/Timer.hpp>
 #include <MainApplication/TimerData/FrameTimerData.hpp>
 #include <MainApplication/Viewer/Viewer.hpp>
@@ -30,6 +31,7 @@ namespace Ra
     namespace Gui
     {
         class Viewer;
+        class OffscreenViewer;
         class MainWindow;
     }
 }
@@ -56,6 +58,9 @@ namespace Ra
 
         bool isRunning() const { return !m_isAboutToQuit; }
 
+        /// True if the application runs without window (see the --headless option).
+        bool isHeadless() const { return m_mainWindow == nullptr; }
+
         const Engine::RadiumEngine* getEngine () const { return m_engine.get();}
 
     signals:
@@ -79,6 +84,10 @@ namespace Ra
         void appNeedsToQuit();
         void setRealFrameRate( bool on);
 
+        /// Starts recording a profiling trace, or writes the trace of the frames
+        /// recorded since it was started (Chrome trace format).
+        void toggleTraceCapture();
+
     private:
         /// Create signal / slots connections
         void createConnections();
@@ -91,6 +100,15 @@ namespace Ra
         void setupScene();
         void addBasicShaders();
 
+        /// Adds to the scene the files whose background loading is over.
+        void processLoadedFiles();
+
+        /// Adds the durations of a frame to the statistics written by --stats.
+        void addFrameStats( const FrameTimerData& data );
+
+        /// Writes the statistics of the frames in m_statsFile.
+        void writeFrameStats();
+
 
         // Public variables, accessible through the mainApp singleton.
     public:
@@ -110,6 +128,9 @@ namespace Ra
         /// Pointer to OpenGL Viewer for render call (belongs to MainWindow).
         Gui::Viewer* m_viewer;
 
+        /// Renderer of the headless mode, null if it runs without rendering.
+        std::unique_ptr<Gui::OffscreenViewer> m_offscreenViewer;
+
         /// Timer to wake us up at every frame start.
         QTimer* m_frameTimer;
 
@@ -121,6 +142,16 @@ namespace Ra
         uint m_numFrames;
         std::vector<FrameTimerData> m_timerData;
 
+        /// File of the next profiling trace. Generated from the frame numbers if empty.
+        std::string m_traceFile;
+        /// Start of the profiling trace being recorded.
+        Core::Timer::TimePoint m_traceStart;
+        uint m_traceStartFrame;
+
+        /// File of the frame statistics (JSON or CSV), not written if empty.
+        std::string m_statsFile;
+        Core::FrameStats m_frameStats;
+
         /// If true, use the wall clock to advance the engine. If false, use a fixed time step.
         bool m_realFrameRate;
         bool m_isAboutToQuit;
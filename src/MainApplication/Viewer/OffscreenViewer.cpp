@@ -0,0 +1,129 @@
+#include <MainApplication/Viewer/OffscreenViewer.hpp>
+
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+
+#include <Core/Log/Log.hpp>
+#include <Core/Containers/MakeShared.hpp>
+#include <Core/String/StringUtils.hpp>
+
+#include <Engine/Renderer/OpenGL/OpenGL.hpp>
+#include <Engine/Renderer/Camera/Camera.hpp>
+#include <Engine/Renderer/Light/DirLight.hpp>
+#include <Engine/Renderer/Renderers/ForwardRenderer.hpp>
+
+namespace Ra
+{
+    Gui::OffscreenViewer::OffscreenViewer( uint width, uint height )
+        : m_width( width )
+        , m_height( height )
+    {
+    }
+
+    Gui::OffscreenViewer::~OffscreenViewer()
+    {
+        if ( m_context )
+        {
+            // The GL resources of the renderer are released with the context current.
+            m_context->makeCurrent( m_surface.get() );
+            m_renderer.reset();
+            m_fbo.reset();
+            m_context->doneCurrent();
+        }
+    }
+
+    bool Gui::OffscreenViewer::initialize()
+    {
+        m_surface.reset( new QOffscreenSurface );
+        m_surface->setFormat( QSurfaceFormat::defaultFormat() );
+        m_surface->create();
+
+        m_context.reset( new QOpenGLContext );
+        m_context->setFormat( QSurfaceFormat::defaultFormat() );
+        if ( !m_surface->isValid() || !m_context->create() || !m_context->makeCurrent( m_surface.get() ) )
+        {
+            m_context.reset();
+            m_surface.reset();
+            return false;
+        }
+
+        initializeOpenGLFunctions();
+
+        LOG( logINFO ) << "*** Radium Engine Offscreen Viewer ***";
+        LOG( logINFO ) << "Renderer : " << glGetString( GL_RENDERER );
+        LOG( logINFO ) << "OpenGL   : " << glGetString( GL_VERSION );
+
+#if defined (OS_WINDOWS)
+        glewExperimental = GL_TRUE;
+
+        GLuint result = glewInit();
+        if ( result != GLEW_OK )
+        {
+            std::string errorStr;
+            Ra::Core::StringUtils::stringPrintf( errorStr, " GLEW init failed : %s", glewGetErrorString( result ) );
+            CORE_ERROR( errorStr.c_str() );
+        }
+        glFlushError();
+#endif
+
+        m_fbo.reset( new QOpenGLFramebufferObject( m_width, m_height, QOpenGLFramebufferObject::CombinedDepthStencil ) );
+
+        m_renderer.reset( new Engine::ForwardRenderer( m_width, m_height ) );
+        m_renderer->initialize();
+
+        m_camera.reset( new Engine::Camera( m_height, m_width ) );
+        m_camera->updateProjMatrix();
+
+        m_light = Ra::Core::make_shared<Engine::DirectionalLight>();
+        m_light->setDirection( m_camera->getDirection() );
+        m_renderer->addLight( m_light );
+
+        m_context->doneCurrent();
+        return true;
+    }
+
+    void Gui::OffscreenViewer::fitCameraToScene( const Core::Aabb& aabb )
+    {
+        // Like the trackball camera, look at the whole scene along -Z.
+        const Scalar f = m_camera->getFOV();
+        const Scalar a = m_camera->getAspect();
+
+        const Scalar r = ( aabb.max() - aabb.min() ).norm() / 2.0;
+        const Scalar x = r / std::sin( f / 2.0 );
+        const Scalar y = r / std::sin( f * a / 2.0 );
+        const Scalar d = std::max( std::max( x, y ), Scalar( 0.001 ) );
+
+        m_camera->setPosition( Core::Vector3( aabb.center().x(), aabb.center().y(), aabb.center().z() + d ) );
+        m_camera->setDirection( Core::Vector3( 0, 0, -1 ) );
+        m_camera->setZFar( std::max( Scalar( d + ( aabb.max().z() - aabb.min().z() ) * 2.0 ), m_camera->getZFar() ) );
+
+        m_light->setDirection( m_camera->getDirection() );
+    }
+
+    void Gui::OffscreenViewer::addLights( const std::vector<std::shared_ptr<Engine::Light>>& lights )
+    {
+        for ( const auto& light : lights )
+        {
+            m_renderer->addLight( light );
+        }
+    }
+
+    void Gui::OffscreenViewer::render( Scalar dt )
+    {
+        m_context->makeCurrent( m_surface.get() );
+
+        // The renderer draws its final image in the framebuffer bound when it starts.
+        m_fbo->bind();
+
+        Engine::RenderData data;
+        data.dt = dt;
+        data.projMatrix = m_camera->getProjMatrix();
+        data.viewMatrix = m_camera->getViewMatrix();
+        m_renderer->render( data );
+
+        glFinish();
+        m_fbo->release();
+        m_context->doneCurrent();
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef RADIUMENGINE_OFFSCREEN_VIEWER_HPP
+#define RADIUMENGINE_OFFSCREEN_VIEWER_HPP
+
+#include <Core/CoreMacros.hpp>
+#if defined (OS_WINDOWS)
+#include <Engine/Renderer/OpenGL/glew.h>
+#endif
+
+#include <memory>
+#include <vector>
+
+#include <QOpenGLFunctions>
+
+#include <Core/Math/LinearAlgebra.hpp>
+
+class QOffscreenSurface;
+class QOpenGLContext;
+class QOpenGLFramebufferObject;
+
+namespace Ra
+{
+    namespace Engine
+    {
+        class Camera;
+        class DirectionalLight;
+        class Light;
+        class Renderer;
+    }
+}
+
+namespace Ra
+{
+    namespace Gui
+    {
+        /// Renders the scene in an offscreen framebuffer, without window, for the
+        /// headless mode of the application.
+        /// It owns its OpenGL context, a forward renderer and a camera looking at the
+        /// scene along -Z, like the trackball camera of the Viewer after fitting the scene.
+        /// Rendering is synchronous, on the main thread.
+        class OffscreenViewer : protected QOpenGLFunctions
+        {
+        public:
+            OffscreenViewer( uint width, uint height );
+            ~OffscreenViewer();
+
+            /// Creates the OpenGL context and the renderer. Returns false if no OpenGL
+            /// context could be created (e.g. no display nor offscreen platform).
+            bool initialize();
+
+            void fitCameraToScene( const Core::Aabb& aabb );
+
+            void addLights( const std::vector<std::shared_ptr<Engine::Light>>& lights );
+
+            /// Renders a frame and waits for the GPU to finish it.
+            void render( Scalar dt );
+
+            const Engine::Renderer* getRenderer() const
+            {
+                return m_renderer.get();
+            }
+
+        private:
+            uint m_width;
+            uint m_height;
+
+            std::unique_ptr<QOffscreenSurface> m_surface;
+            std::unique_ptr<QOpenGLContext> m_context;
+            /// Framebuffer of the final image, the "screen" of the renderer.
+            std::unique_ptr<QOpenGLFramebufferObject> m_fbo;
+
+            std::unique_ptr<Engine::Renderer> m_renderer;
+            std::unique_ptr<Engine::Camera> m_camera;
+            /// Light following the camera.
+            std::shared_ptr<Engine::DirectionalLight> m_light;
+        };
+    }
+}
+
+#endif // RADIUMENGINE_OFFSCREEN_VIEWER_HPP
@@ -389,6 +389,17 @@ namespace Ra
         }
     }
 
+    void Gui::Viewer::addLights( const std::vector<std::shared_ptr<Engine::Light>>& lights )
+    {
+        for ( auto& renderer : m_renderers )
+        {
+            for ( const auto& light : lights )
+            {
+                renderer->addLight( light );
+            }
+        }
+    }
+
     void Gui::Viewer::processPicking()
     {
         CORE_ASSERT( m_currentRenderer->getPickingQueries().size() == m_currentRenderer->getPickingResults().size(),
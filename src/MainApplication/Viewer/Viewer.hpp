@@ -36,6 +36,7 @@ namespace Ra
     namespace Engine
     {
         class Renderer;
+        class Light;
     }
 }
 
@@ -107,6 +108,9 @@ namespace Ra
             ///
             void handleFileLoading( const std::string& file );
 
+            /// Adds lights read with Engine::Renderer::loadLights() to all the renderers.
+            void addLights( const std::vector<std::shared_ptr<Engine::Light>>& lights );
+
             /// Emits signals corresponding to picking requests.
             void processPicking();
 
@@ -9,7 +9,8 @@ int main( int argc, char** argv )
     Ra::MainApplication app( argc, argv );
 
     const uint& fpsMax = app.m_targetFPS;
-    const Scalar deltaTime( fpsMax == 0 ? 0.f : 1.f / Scalar( fpsMax ) );
+    // Headless runs are benchmarks, their frames are not paced.
+    const Scalar deltaTime( fpsMax == 0 || app.isHeadless() ? 0.f : 1.f / Scalar( fpsMax ) );
 
     Ra::Core::Timer::TimePoint t0, t1;
 
@@ -0,0 +1,92 @@
+#ifndef RADIUM_ANIMATION_BENCHMARK_HPP_
+#define RADIUM_ANIMATION_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Animation/Animation.hpp>
+#include <Core/Animation/Pose/PoseOperation.hpp>
+
+#include <cmath>
+
+namespace RaBenchmarks {
+
+/// Time to sample a playback of animations of increasing length: the former linear
+/// search of the keys with interpolatePoses(), the binary search and the cursor.
+class AnimationBenchmark : public Benchmark
+{
+    std::string getName() const override { return "Animation"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+        const uint numBones = 60;
+        const uint numSamples = 500;
+
+        printf("%8s %14s %14s %14s\n", "keys", "linear (us)", "binary (us)", "cursor (us)");
+        for (uint numKeys : { 30u, 300u, 3000u })
+        {
+            std::vector<KeyPose> keys;
+            Ra::Core::Animation::Animation anim;
+            for (uint k = 0; k < numKeys; ++k)
+            {
+                Pose pose( numBones );
+                for (uint b = 0; b < numBones; ++b)
+                {
+                    pose[b] = Transform::Identity();
+                    pose[b].rotate( AngleAxis( 0.01f * k + 0.1f * b, Vector3::UnitY() ) );
+                    pose[b].translation() = Vector3( 0, Scalar( b ), 0.01f * k );
+                }
+                keys.push_back( KeyPose( k / 30.f, pose ) );
+                anim.addKeyPose( pose, k / 30.f );
+            }
+            // The playback covers the whole animation.
+            const Scalar dt = anim.getDuration() / numSamples;
+
+            volatile Scalar sink = 0;
+            const auto linear = bestTimeOf( 3, [&]()
+            {
+                for (uint s = 0; s < numSamples; ++s)
+                {
+                    const Scalar time = s * dt;
+                    for (uint i = 0; i + 1 < keys.size(); ++i)
+                    {
+                        if ( time >= keys[i].first && time <= keys[i + 1].first )
+                        {
+                            const Scalar t = ( time - keys[i].first ) / ( keys[i + 1].first - keys[i].first );
+                            const Pose pose = interpolatePoses( keys[i].second, keys[i + 1].second, t );
+                            sink = sink + pose[0](0, 0);
+                            break;
+                        }
+                    }
+                }
+            } );
+
+            Pose pose;
+            const auto binary = bestTimeOf( 3, [&]()
+            {
+                for (uint s = 0; s < numSamples; ++s)
+                {
+                    anim.getPose( s * dt, pose );
+                    sink = sink + pose[0](0, 0);
+                }
+            } );
+
+            const auto cursor = bestTimeOf( 3, [&]()
+            {
+                AnimationCursor c;
+                for (uint s = 0; s < numSamples; ++s)
+                {
+                    anim.getPose( s * dt, c, pose );
+                    sink = sink + pose[0](0, 0);
+                }
+            } );
+
+            printf("%8u %14lld %14lld %14lld\n", numKeys, (long long)linear, (long long)binary, (long long)cursor);
+        }
+    }
+};
+
+RA_BENCHMARK_CLASS(AnimationBenchmark);
+}
+
+#endif // RADIUM_ANIMATION_BENCHMARK_HPP_
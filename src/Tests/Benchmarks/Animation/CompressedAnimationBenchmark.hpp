@@ -0,0 +1,120 @@
+#ifndef RADIUM_COMPRESSED_ANIMATION_BENCHMARK_HPP_
+#define RADIUM_COMPRESSED_ANIMATION_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Animation/CompressedAnimation.hpp>
+
+#include <cmath>
+
+namespace RaBenchmarks {
+
+/// Memory and sampling time of a motion capture like clip (120 Hz, most bones only
+/// rotating) stored as an Animation and as a CompressedAnimation, and time to
+/// sample a crowd of characters playing it.
+class CompressedAnimationBenchmark : public Benchmark
+{
+    std::string getName() const override { return "CompressedAnimation"; }
+
+    /// Memory used by the key poses of an Animation, and the rotations and
+    /// translations it extracts from them.
+    static size_t animationSize( uint numKeys, uint numBones )
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+        return numKeys * ( sizeof( KeyPose ) + numBones * sizeof( Transform ) + sizeof( Scalar )
+                           + sizeof( AlignedStdVector<Quaternion> ) + numBones * sizeof( Quaternion )
+                           + sizeof( Vector3Array ) + numBones * sizeof( Vector3 ) );
+    }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+        const uint numBones = 60;
+        const uint numKeys = 1200;
+        const uint numCharacters = 300;
+
+        Ra::Core::Animation::Animation anim;
+        for (uint k = 0; k < numKeys; ++k)
+        {
+            const Scalar time = k / 120.f;
+            Pose pose( numBones, Transform::Identity() );
+            // The root moves, the other bones have a fixed offset from their parent.
+            pose[0].translation() = Vector3( std::sin( 0.5f * time ), 0.1f * std::sin( 6.f * time ), time );
+            for (uint b = 0; b < numBones; ++b)
+            {
+                if ( b > 0 )
+                {
+                    pose[b].translation() = Vector3( 0.f, 0.1f * ( b % 7 ), 0.f );
+                }
+                // A tenth of the bones (e.g. fingers) do not move.
+                if ( b % 10 != 9 )
+                {
+                    const Scalar phase = 0.3f * b;
+                    pose[b].rotate( AngleAxis( 0.5f * std::sin( 2.f * time + phase ),
+                                               Vector3( std::sin( phase ), 1.f, std::cos( phase ) ).normalized() ) );
+                }
+            }
+            anim.addKeyPose( pose, time );
+        }
+
+        CompressedAnimation compressed;
+        const auto compression = bestTimeOf( 1, [&]() { compressed.compress( anim ); } );
+
+        const size_t original = animationSize( numKeys, numBones );
+        printf( "%d bones, %d keys, compressed in %lld ms\n", numBones, numKeys, (long long)compression / 1000 );
+        printf( "%14s %14s %8s %14s %16s\n", "memory (kB)", "compressed", "ratio", "track keys", "constant tracks" );
+        printf( "%14.1f %14.1f %8.1f %14u %16u\n", original / 1024.f, compressed.getMemorySize() / 1024.f,
+                float( original ) / compressed.getMemorySize(), compressed.getNumTrackKeys(),
+                compressed.getNumConstantTracks() );
+
+        // Playback of the whole clip by one character.
+        const uint numSamples = 1000;
+        const Scalar dt = anim.getDuration() / numSamples;
+        volatile Scalar sink = 0;
+        Pose pose;
+        const auto animTime = bestTimeOf( 3, [&]()
+        {
+            AnimationCursor c;
+            for (uint s = 0; s < numSamples; ++s)
+            {
+                anim.getPose( s * dt, c, pose );
+                sink = sink + pose[0]( 0, 0 );
+            }
+        } );
+        const auto compressedTime = bestTimeOf( 3, [&]()
+        {
+            CompressedAnimationCursor c;
+            for (uint s = 0; s < numSamples; ++s)
+            {
+                compressed.getPose( s * dt, c, pose );
+                sink = sink + pose[0]( 0, 0 );
+            }
+        } );
+
+        // A frame of a crowd, each character at its own time.
+        std::vector<Pose> poses( numCharacters );
+        std::vector<AnimationCursor> cursors( numCharacters );
+        std::vector<CompressedAnimationCursor> compressedCursors( numCharacters );
+        std::vector<AnimationSample> samples;
+        std::vector<CompressedAnimationSample> compressedSamples;
+        for (uint i = 0; i < numCharacters; ++i)
+        {
+            AnimationSample s = { &anim, 0.037f * i, &cursors[i], &poses[i] };
+            samples.push_back( s );
+            CompressedAnimationSample cs = { &compressed, 0.037f * i, &compressedCursors[i], &poses[i] };
+            compressedSamples.push_back( cs );
+        }
+        const auto animCrowd = bestTimeOf( 10, [&]() { samplePoses( samples ); } );
+        const auto compressedCrowd = bestTimeOf( 10, [&]() { samplePoses( compressedSamples ); } );
+
+        printf( "%14s %14s %14s\n", "", "pose (us)", "crowd (us)" );
+        printf( "%14s %14.2f %14lld\n", "Animation", float( animTime ) / numSamples, (long long)animCrowd );
+        printf( "%14s %14.2f %14lld\n", "Compressed", float( compressedTime ) / numSamples, (long long)compressedCrowd );
+    }
+};
+
+RA_BENCHMARK_CLASS(CompressedAnimationBenchmark);
+}
+
+#endif // RADIUM_COMPRESSED_ANIMATION_BENCHMARK_HPP_
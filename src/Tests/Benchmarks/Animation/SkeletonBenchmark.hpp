@@ -0,0 +1,92 @@
+#ifndef RADIUM_SKELETON_BENCHMARK_HPP_
+#define RADIUM_SKELETON_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Animation/Handle/Skeleton.hpp>
+#include <Core/Animation/Pose/PoseOperation.hpp>
+
+namespace RaBenchmarks {
+
+/// Time to compute the model and skinning poses of a skeleton from its local pose:
+/// the former traversal of the children lists followed by relativePose(), the
+/// single pass over the parents, and the batched update of a crowd.
+class SkeletonBenchmark : public Benchmark
+{
+    std::string getName() const override { return "Skeleton"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+        const uint numBones = 60;
+        const uint numRuns = 1000;
+        const uint numCharacters = 300;
+
+        // A spine with arms and legs of 5 bones.
+        Skeleton skel;
+        Pose local;
+        for (uint i = 0; i < numBones; ++i)
+        {
+            Transform t = Transform::Identity();
+            t.rotate( AngleAxis( 0.1f * i, Vector3::UnitY() ) );
+            t.translation() = Vector3( 0.f, 0.1f, 0.f );
+            local.push_back( t );
+            skel.addBone( i == 0 ? -1 : ( i % 5 == 0 ? int( i / 10 ) : int( i - 1 ) ), t, Handle::SpaceType::LOCAL );
+        }
+        const Pose rest = skel.getPose( Handle::SpaceType::MODEL );
+        const Pose inverseRest = inversePose( rest );
+        const Graph::AdjacencyList& graph = skel.m_graph;
+
+        volatile Scalar sink = 0;
+        Pose model( numBones );
+        Pose rel;
+        const auto traversal = bestTimeOf( 3, [&]()
+        {
+            for (uint r = 0; r < numRuns; ++r)
+            {
+                for (uint i = 0; i < graph.size(); ++i)
+                {
+                    if ( graph.isRoot( i ) )
+                    {
+                        model[i] = local[i];
+                    }
+                    for (const auto& child : graph.m_child[i])
+                    {
+                        model[child] = model[i] * local[child];
+                    }
+                }
+                rel = relativePose( model, rest );
+                sink = sink + rel[numBones - 1]( 0, 3 );
+            }
+        } );
+
+        const auto onePass = bestTimeOf( 3, [&]()
+        {
+            for (uint r = 0; r < numRuns; ++r)
+            {
+                localToModelPose( graph.m_parent, local, inverseRest, model, rel );
+                sink = sink + rel[numBones - 1]( 0, 3 );
+            }
+        } );
+
+        std::vector<Pose> models( numCharacters );
+        std::vector<Pose> rels( numCharacters );
+        std::vector<HierarchyPoses> poses;
+        for (uint i = 0; i < numCharacters; ++i)
+        {
+            HierarchyPoses p = { &local, &models[i], &rels[i] };
+            poses.push_back( p );
+        }
+        const auto crowd = bestTimeOf( 10, [&]() { localToModelPoses( graph.m_parent, inverseRest, poses ); } );
+
+        printf( "%d bones, model and skinning poses\n", numBones );
+        printf( "%20s %10.3f us\n", "graph traversal", float( traversal ) / numRuns );
+        printf( "%20s %10.3f us\n", "one pass", float( onePass ) / numRuns );
+        printf( "%20s %10lld us\n", "crowd of 300", (long long)crowd );
+    }
+};
+
+RA_BENCHMARK_CLASS(SkeletonBenchmark);
+}
+
+#endif // RADIUM_SKELETON_BENCHMARK_HPP_
@@ -0,0 +1,226 @@
+#ifndef RADIUM_SKINNING_BENCHMARK_HPP_
+#define RADIUM_SKINNING_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Animation/Skinning/DualQuaternionSkinning.hpp>
+#include <Core/Animation/Skinning/LinearBlendSkinning.hpp>
+#include <Core/Animation/Skinning/PackedWeights.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+namespace RaBenchmarks {
+
+/// Builds a mesh of numVertices random vertices, each influenced by influences
+/// consecutive bones out of numBones, and a random pose.
+/// If coherent is true, the first bone of a vertex grows with the vertex index, as
+/// in real meshes where neighbour vertices tend to be stored together. Otherwise it is random.
+inline void makeSkinningData( uint numVertices, uint numBones, uint influences,
+                              Ra::Core::Vector3Array& vertices,
+                              Ra::Core::Animation::WeightMatrix& weights,
+                              Ra::Core::Animation::Pose& pose,
+                              bool coherent = false )
+{
+    using namespace Ra::Core;
+    std::mt19937 gen( 7 );
+    std::uniform_int_distribution<uint> boneDist( 0, numBones - 1 );
+
+    vertices.resize( numVertices );
+    std::vector<Eigen::Triplet<Scalar>> triplets;
+    triplets.reserve( numVertices * influences );
+    for (uint i = 0; i < numVertices; ++i)
+    {
+        vertices[i] = Vector3::Random();
+        const uint firstBone = coherent ? uint( ( uint64_t( i ) * numBones ) / numVertices ) : boneDist( gen );
+        for (uint k = 0; k < influences; ++k)
+        {
+            triplets.push_back( Eigen::Triplet<Scalar>( i, ( firstBone + k ) % numBones, Scalar( 1 ) / influences ) );
+        }
+    }
+    weights.resize( numVertices, numBones );
+    weights.setFromTriplets( triplets.begin(), triplets.end() );
+
+    pose.resize( numBones );
+    for (uint j = 0; j < numBones; ++j)
+    {
+        pose[j] = Transform::Identity();
+        pose[j].rotate( AngleAxis( Scalar( j ) * 0.1f, Vector3::UnitY() ) );
+        pose[j].translation() = Vector3( 0, Scalar( j ), 0 );
+    }
+}
+
+/// Compares the serial skinning on the sparse weight matrix with the packed
+/// kernel on an increasing number of threads.
+class SkinningBenchmark : public Benchmark
+{
+    std::string getName() const override { return "Skinning"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+
+        const uint numBones = 64;
+        const uint maxThreads = std::max( 1u, std::thread::hardware_concurrency() );
+
+        printf("%10s %6s %8s %14s %14s\n", "vertices", "infl", "threads", "sparse (us)", "packed (us)");
+        for (uint numVertices : { 100000u, 1000000u })
+        {
+            for (uint influences : { 4u, 8u })
+            {
+                Vector3Array input;
+                Vector3Array output;
+                WeightMatrix weights;
+                Pose pose;
+                makeSkinningData( numVertices, numBones, influences, input, weights, pose );
+
+                PackedWeights packed;
+                packWeights( weights, influences, packed );
+
+                const auto sparse = bestTimeOf( 5, [&]() { linearBlendSkinning( input, pose, weights, output ); } );
+
+                for (uint numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+                {
+                    // The calling thread helps, so numThreads - 1 workers are enough.
+                    TaskQueue queue( std::max( 1u, numThreads - 1 ), TaskQueue::SchedulingMode::WORK_STEALING );
+                    setParallelForTaskQueue( numThreads > 1 ? &queue : nullptr );
+
+                    const auto fast = bestTimeOf( 5, [&]() { linearBlendSkinning( input, pose, packed, output ); } );
+
+                    printf("%10u %6u %8u %14ld %14ld\n", numVertices, influences, numThreads,
+                           long( sparse ), long( fast ));
+                    setParallelForTaskQueue( nullptr );
+                }
+            }
+        }
+    }
+};
+
+RA_BENCHMARK_CLASS(SkinningBenchmark);
+
+/// Compares dual quaternion skinning of vertices and normals with the per vertex
+/// dual quaternion list and with the SoA kernel. Reports the time per vertex.
+class DualQuaternionSkinningBenchmark : public Benchmark
+{
+    std::string getName() const override { return "DualQuaternionSkinning"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+
+        const uint numBones = 64;
+        const uint maxThreads = std::max( 1u, std::thread::hardware_concurrency() );
+
+        printf("%10s %6s %8s %14s %14s\n", "vertices", "infl", "threads", "list (ns/v)", "soa (ns/v)");
+        for (uint numVertices : { 100000u, 1000000u })
+        {
+            for (uint influences : { 4u, 8u })
+            {
+                Vector3Array input;
+                Vector3Array normals;
+                Vector3Array output;
+                Vector3Array outputNormals;
+                WeightMatrix weights;
+                Pose pose;
+                makeSkinningData( numVertices, numBones, influences, input, weights, pose );
+                normals.resize( numVertices, Vector3::UnitZ() );
+
+                PackedWeights packed;
+                packWeights( weights, influences, packed );
+
+                for (uint numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+                {
+                    TaskQueue queue( std::max( 1u, numThreads - 1 ), TaskQueue::SchedulingMode::WORK_STEALING );
+                    setParallelForTaskQueue( numThreads > 1 ? &queue : nullptr );
+
+                    DQList DQ;
+                    const auto list = bestTimeOf( 5, [&]()
+                    {
+                        computeDQ( pose, weights, DQ );
+                        dualQuaternionSkinning( input, DQ, output );
+                        outputNormals.resize( numVertices );
+                        for (uint i = 0; i < numVertices; ++i)
+                        {
+                            outputNormals[i] = DQ[i].rotate( normals[i] );
+                        }
+                    } );
+                    const auto soa = bestTimeOf( 5, [&]()
+                    {
+                        dualQuaternionSkinning( input, normals, pose, packed, output, outputNormals );
+                    } );
+
+                    printf("%10u %6u %8u %14.2f %14.2f\n", numVertices, influences, numThreads,
+                           1000.0 * list / numVertices, 1000.0 * soa / numVertices);
+                    setParallelForTaskQueue( nullptr );
+                }
+            }
+        }
+    }
+};
+
+RA_BENCHMARK_CLASS(DualQuaternionSkinningBenchmark);
+
+/// Compares the full dual quaternion skinning with the incremental skinning of
+/// the vertices influenced by a few moving bones, including the search of these vertices.
+class IncrementalSkinningBenchmark : public Benchmark
+{
+    std::string getName() const override { return "IncrementalSkinning"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+
+        const uint numVertices = 1000000;
+        const uint numBones = 64;
+        const uint influences = 4;
+
+        Vector3Array input;
+        Vector3Array normals;
+        Vector3Array output;
+        Vector3Array outputNormals;
+        WeightMatrix weights;
+        Pose pose;
+        makeSkinningData( numVertices, numBones, influences, input, weights, pose, true );
+        normals.resize( numVertices, Vector3::UnitZ() );
+        PackedWeights packed;
+        packWeights( weights, influences, packed );
+        dualQuaternionSkinning( input, normals, pose, packed, output, outputNormals );
+
+        printf("%8s %10s %14s %14s %10s\n", "moved", "dirty", "full (us)", "incr (us)", "speedup");
+        for (uint numMoved : { 1u, 4u, 16u, 64u })
+        {
+            Pose newPose = pose;
+            for (uint j = 0; j < numMoved; ++j)
+            {
+                newPose[j].translate( Vector3( 0, 0.1f, 0 ) );
+            }
+
+            const auto full = bestTimeOf( 5, [&]()
+            {
+                dualQuaternionSkinning( input, normals, newPose, packed, output, outputNormals );
+            } );
+
+            std::vector<uint> changed;
+            VertexRangeList ranges;
+            const auto incremental = bestTimeOf( 5, [&]()
+            {
+                getChangedHandles( pose, newPose, changed );
+                getInfluencedRanges( weights, changed, 64, ranges );
+                dualQuaternionSkinning( input, normals, newPose, packed, ranges, output, outputNormals );
+            } );
+
+            printf("%8u %10u %14ld %14ld %10.1f\n", numMoved, getRangesSize( ranges ),
+                   long( full ), long( incremental ), incremental > 0 ? double( full ) / incremental : 0.0);
+        }
+    }
+};
+
+RA_BENCHMARK_CLASS(IncrementalSkinningBenchmark);
+}
+
+#endif // RADIUM_SKINNING_BENCHMARK_HPP_
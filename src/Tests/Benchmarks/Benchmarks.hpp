@@ -0,0 +1,54 @@
+#ifndef RADIUM_BENCHMARKS_HPP_
+#define RADIUM_BENCHMARKS_HPP_
+#include <Core/CoreMacros.hpp>
+#include <Core/Time/Timer.hpp>
+#include <Tests/Benchmarks/Manager.hpp>
+
+#include <string>
+
+namespace RaBenchmarks {
+/// Base class for all benchmarks.
+class Benchmark
+{
+public:
+    Benchmark()
+    {
+        if (!BenchmarkManager::getInstance())
+        {
+            BenchmarkManager::createInstance();
+        }
+        BenchmarkManager::getInstance()->add(this);
+    }
+
+    /// Name used for filtering and reporting.
+    virtual std::string getName() const = 0;
+
+    virtual void run() = 0;
+
+    virtual ~Benchmark() {};
+};
+
+// Poor man's singleton to automatically instantiate a benchmark.
+#define RA_BENCHMARK_CLASS( TYPE ) namespace TYPE##NS { TYPE benchmark_instance;}
+
+/// Runs FUNC numRuns times and returns the best time in microseconds.
+template <typename FUNC>
+inline Ra::Core::Timer::MicroSeconds bestTimeOf( uint numRuns, const FUNC& func )
+{
+    Ra::Core::Timer::MicroSeconds best = -1;
+    for (uint i = 0; i < numRuns; ++i)
+    {
+        const auto start = Ra::Core::Timer::Clock::now();
+        func();
+        const auto end = Ra::Core::Timer::Clock::now();
+        const auto t = Ra::Core::Timer::getIntervalMicro(start, end);
+        if (best < 0 || t < best)
+        {
+            best = t;
+        }
+    }
+    return best;
+}
+
+}
+#endif // RADIUM_BENCHMARKS_HPP_
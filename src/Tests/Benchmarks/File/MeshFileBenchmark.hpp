@@ -0,0 +1,246 @@
+#ifndef RADIUM_MESH_FILE_BENCHMARK_HPP_
+#define RADIUM_MESH_FILE_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Utils/File/OBJFileManager.hpp>
+#include <Core/Utils/File/OFFFileManager.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+namespace RaBenchmarks {
+
+/// The former OBJ importer and exporter, going through streams and strings.
+class StreamOBJFileManager : public Ra::Core::FileManager<Ra::Core::TriangleMesh>
+{
+protected:
+    std::string fileExtension() const override { return "obj"; }
+
+    bool importData( std::ifstream& file, Ra::Core::TriangleMesh& data ) override
+    {
+        using namespace Ra::Core;
+        data = TriangleMesh();
+        std::string line;
+        while ( std::getline( file, line ) )
+        {
+            std::istringstream iss( line );
+            std::string token;
+            iss >> token;
+            if ( token == "v" )
+            {
+                Vector3 v;
+                iss >> v[0] >> v[1] >> v[2];
+                data.m_vertices.push_back( v );
+            }
+            if ( token == "vn" )
+            {
+                Vector3 n;
+                iss >> n[0] >> n[1] >> n[2];
+                data.m_normals.push_back( n );
+            }
+            if ( token == "f" )
+            {
+                Triangle f;
+                iss >> f[0] >> f[1] >> f[2];
+                f -= Triangle::Ones();
+                data.m_triangles.push_back( f );
+            }
+        }
+        return !data.m_vertices.empty();
+    }
+
+    /// The former OBJ exporter, building the whole file in a string.
+    bool exportData( std::ofstream& file, const Ra::Core::TriangleMesh& data ) override
+    {
+        using namespace Ra::Core;
+        std::string content = "";
+        for ( uint i = 0; i < data.m_vertices.size(); ++i )
+        {
+            const Vector3 v = data.m_vertices.at( i );
+            content += "v " + std::to_string( v[0] ) + " " + std::to_string( v[1] ) + " " + std::to_string( v[2] ) + "\n";
+        }
+        for ( uint i = 0; i < data.m_normals.size(); ++i )
+        {
+            const Vector3 n = data.m_normals.at( i );
+            content += "vn " + std::to_string( n[0] ) + " " + std::to_string( n[1] ) + " " + std::to_string( n[2] ) + "\n";
+        }
+        for ( uint i = 0; i < data.m_triangles.size(); ++i )
+        {
+            const Triangle f = data.m_triangles.at( i );
+            content += "f " + std::to_string( f[0] + 1 ) + " " + std::to_string( f[1] + 1 ) + " " +
+                       std::to_string( f[2] + 1 ) + "\n";
+        }
+        file << content;
+        return true;
+    }
+};
+
+/// Loading time of large OBJ and OFF files (a noisy grid of quads), against the former
+/// stream based importer.
+class MeshFileBenchmark : public Benchmark
+{
+    std::string getName() const override { return "MeshFile"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        const std::string objName = "radium_benchmark.obj";
+        const std::string offName = "radium_benchmark.off";
+
+        // The chunks of the files are parsed on the threads of parallelFor().
+        TaskQueue queue( std::max( 2u, std::thread::hardware_concurrency() ) - 1 );
+        setParallelForTaskQueue( &queue );
+
+        printf("%10s %10s %10s %12s %12s %12s\n", "vertices", "obj (MB)", "off (MB)", "stream (ms)", "obj (ms)", "off (ms)");
+        for (uint n : { 250u, 500u, 1000u })
+        {
+            const std::pair<long, long> sizes = writeGrid( n, objName, offName );
+
+            TriangleMesh streamMesh;
+            TriangleMesh objMesh;
+            TriangleMesh offMesh;
+            StreamOBJFileManager streamManager;
+            OBJFileManager objManager;
+            OFFFileManager offManager;
+
+            const auto stream = bestTimeOf( 1, [&]() { streamManager.load( objName, streamMesh ); } );
+            const auto obj = bestTimeOf( 3, [&]() { objManager.load( objName, objMesh ); } );
+            const auto off = bestTimeOf( 3, [&]() { offManager.load( offName, offMesh ); } );
+
+            if ( objMesh.m_triangles.size() != 2 * n * n || offMesh.m_triangles != objMesh.m_triangles )
+            {
+                printf("Wrong mesh loaded\n");
+            }
+
+            printf("%10u %10.1f %10.1f %12.1f %12.1f %12.1f\n", ( n + 1 ) * ( n + 1 ), sizes.first / 1e6, sizes.second / 1e6,
+                   stream / 1000.0, obj / 1000.0, off / 1000.0);
+        }
+
+        std::remove( objName.c_str() );
+        std::remove( offName.c_str() );
+        setParallelForTaskQueue( nullptr );
+    }
+
+    /// Write the n x n grid and return the sizes of the files.
+    static std::pair<long, long> writeGrid( uint n, const std::string& objName, const std::string& offName )
+    {
+        FILE* obj = std::fopen( objName.c_str(), "w" );
+        FILE* off = std::fopen( offName.c_str(), "w" );
+        fprintf( off, "OFF\n%u %u 0\n", ( n + 1 ) * ( n + 1 ), n * n );
+        for (uint j = 0; j <= n; ++j)
+        {
+            for (uint i = 0; i <= n; ++i)
+            {
+                const float z = 0.01f * ( ( i * 7919 + j * 104729 ) % 1000 );
+                fprintf( obj, "v %f %f %f\n", i / float( n ), j / float( n ), z );
+                fprintf( off, "%f %f %f\n", i / float( n ), j / float( n ), z );
+            }
+        }
+        for (uint j = 0; j <= n; ++j)
+        {
+            for (uint i = 0; i <= n; ++i)
+            {
+                fprintf( obj, "vn %f %f %f\n", 0.f, 0.f, 1.f );
+            }
+        }
+        for (uint j = 0; j < n; ++j)
+        {
+            for (uint i = 0; i < n; ++i)
+            {
+                const uint v = j * ( n + 1 ) + i + 1;
+                fprintf( obj, "f %u//%u %u//%u %u//%u %u//%u\n", v, v, v + 1, v + 1, v + n + 2, v + n + 2, v + n + 1, v + n + 1 );
+                fprintf( off, "4 %u %u %u %u\n", v - 1, v, v + n + 1, v + n );
+            }
+        }
+        const std::pair<long, long> sizes( std::ftell( obj ), std::ftell( off ) );
+        std::fclose( obj );
+        std::fclose( off );
+        return sizes;
+    }
+};
+
+/// Saving time of large OBJ files, against the former exporter and against writing
+/// the same bytes from memory.
+class MeshExportBenchmark : public Benchmark
+{
+    std::string getName() const override { return "MeshExport"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        const std::string name = "radium_benchmark_export";
+
+        // The blocks of the parallel export are formatted on the threads of parallelFor().
+        TaskQueue queue( std::max( 2u, std::thread::hardware_concurrency() ) - 1 );
+        setParallelForTaskQueue( &queue );
+
+        printf("%10s %10s %10s %12s %12s %14s %12s\n", "triangles", "obj (MB)", "write (ms)", "former (ms)",
+               "serial (ms)", "parallel (ms)", "off (ms)");
+        for (uint n : { 500u, 1000u, 2000u })
+        {
+            TriangleMesh mesh;
+            for (uint j = 0; j <= n; ++j)
+            {
+                for (uint i = 0; i <= n; ++i)
+                {
+                    mesh.m_vertices.push_back( Vector3( i / Scalar( n ), j / Scalar( n ), 0.01f * ( ( i * 7919 + j * 104729 ) % 1000 ) ) );
+                    mesh.m_normals.push_back( Vector3( 0, 0, 1 ) );
+                }
+            }
+            for (uint j = 0; j < n; ++j)
+            {
+                for (uint i = 0; i < n; ++i)
+                {
+                    const uint v = j * ( n + 1 ) + i;
+                    mesh.m_triangles.push_back( Triangle( v, v + 1, v + n + 2 ) );
+                    mesh.m_triangles.push_back( Triangle( v, v + n + 2, v + n + 1 ) );
+                }
+            }
+
+            OBJFileManager objManager;
+            OFFFileManager offManager;
+            StreamOBJFileManager formerManager;
+
+            // The former exporter is too slow for the largest mesh.
+            const auto former = ( n <= 1000 ) ? bestTimeOf( 1, [&]() { formerManager.save( name, mesh ); } ) : 0;
+            objManager.setParallelExport( false );
+            const auto serial = bestTimeOf( 3, [&]() { objManager.save( name, mesh ); } );
+            objManager.setParallelExport( true );
+            const auto parallel = bestTimeOf( 3, [&]() { objManager.save( name, mesh ); } );
+            const auto off = bestTimeOf( 3, [&]() { offManager.save( name, mesh ); } );
+
+            // Time to write the bytes of the file.
+            std::string content;
+            {
+                std::ifstream file( name + ".obj", std::ios_base::binary );
+                content.assign( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+            }
+            const auto write = bestTimeOf( 3, [&]()
+            {
+                std::ofstream file( name + ".obj", std::ios_base::binary | std::ios_base::trunc );
+                file.write( content.data(), content.size() );
+            } );
+
+            printf("%10u %10.1f %10.1f %12.1f %12.1f %14.1f %12.1f\n", uint( mesh.m_triangles.size() ), content.size() / 1e6,
+                   write / 1000.0, former / 1000.0, serial / 1000.0, parallel / 1000.0, off / 1000.0);
+        }
+
+        std::remove( ( name + ".obj" ).c_str() );
+        std::remove( ( name + ".off" ).c_str() );
+        setParallelForTaskQueue( nullptr );
+    }
+};
+
+RA_BENCHMARK_CLASS(MeshFileBenchmark);
+RA_BENCHMARK_CLASS(MeshExportBenchmark);
+}
+
+#endif // RADIUM_MESH_FILE_BENCHMARK_HPP_
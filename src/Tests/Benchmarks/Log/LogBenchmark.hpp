@@ -0,0 +1,96 @@
+#ifndef RADIUM_LOG_BENCHMARK_HPP_
+#define RADIUM_LOG_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Log/Log.hpp>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace RaBenchmarks {
+
+/// Cost of a LOG() call seen by the logging threads, against formatting the
+/// message with its time and writing it synchronously (the former implementation).
+class LogBenchmark : public Benchmark
+{
+    std::string getName() const override { return "Log"; }
+
+    void run() override
+    {
+        FILE* devNull = std::fopen( "/dev/null", "w" );
+        if ( !devNull )
+        {
+            printf("Cannot open /dev/null\n");
+            return;
+        }
+
+        FILE* previous = Output2FILE::Stream();
+        Output2FILE::Stream() = devNull;
+
+        const uint numMessages = 20000;
+
+        printf("%8s %14s %14s %14s %10s\n", "threads", "sync (ns/msg)", "async (ns/msg)", "+flush (ns/msg)", "dropped");
+        for (uint numThreads : { 1u, 2u, 4u, 8u })
+        {
+            const uint total = numThreads * numMessages;
+
+            const auto sync = runThreads( numThreads, [devNull, numMessages]()
+            {
+                for (uint i = 0; i < numMessages; ++i)
+                {
+                    std::ostringstream os;
+                    os << "- " << NowTime() << " INFO: " << "Message " << i << " value " << 0.5f * i << std::endl;
+                    fprintf( devNull, "%s", os.str().c_str() );
+                    fflush( devNull );
+                }
+            } );
+
+            Ra::Core::LogQueue& queue = Ra::Core::LogQueue::getInstance();
+            queue.flush();
+            const uint dropped = queue.getNumDropped();
+
+            Ra::Core::Timer::MicroSeconds async = 0;
+            const auto flushed = bestTimeOf( 1, [&]()
+            {
+                async = runThreads( numThreads, [numMessages]()
+                {
+                    for (uint i = 0; i < numMessages; ++i)
+                    {
+                        LOG( logINFO ) << "Message " << i << " value " << 0.5f * i;
+                    }
+                } );
+                queue.flush();
+            } );
+
+            printf("%8u %14.1f %14.1f %14.1f %10u\n", numThreads, 1000.0 * sync / total, 1000.0 * async / total,
+                   1000.0 * flushed / total, queue.getNumDropped() - dropped);
+        }
+
+        Output2FILE::Stream() = previous;
+        std::fclose( devNull );
+    }
+
+    /// Runs func on numThreads threads and returns the time until they all finish.
+    template <typename FUNC>
+    static Ra::Core::Timer::MicroSeconds runThreads( uint numThreads, const FUNC& func )
+    {
+        return bestTimeOf( 1, [&]()
+        {
+            std::vector<std::thread> threads;
+            for (uint t = 0; t < numThreads; ++t)
+            {
+                threads.emplace_back( func );
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        } );
+    }
+};
+
+RA_BENCHMARK_CLASS(LogBenchmark);
+}
+
+#endif // RADIUM_LOG_BENCHMARK_HPP_
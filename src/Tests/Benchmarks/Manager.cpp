@@ -0,0 +1,28 @@
+#include <Tests/Benchmarks/Manager.hpp>
+#include <Tests/Benchmarks/Benchmarks.hpp>
+
+namespace RaBenchmarks {
+
+    RA_SINGLETON_IMPLEMENTATION( BenchmarkManager );
+
+    void BenchmarkManager::add(Benchmark* benchmark)
+    {
+        m_benchmarks.push_back(benchmark);
+    }
+
+    int BenchmarkManager::run()
+    {
+        int numRun = 0;
+        for (auto b : m_benchmarks)
+        {
+            if (m_options.m_filter.empty() || b->getName().find(m_options.m_filter) != std::string::npos)
+            {
+                printf("=== %s ===\n", b->getName().c_str());
+                b->run();
+                ++numRun;
+            }
+        }
+        printf("Result : %i benchmarks run\n", numRun);
+        return numRun;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef RADIUM_BENCHMARKS_MANAGER_HPP_
+#define RADIUM_BENCHMARKS_MANAGER_HPP_
+#include <Core/Utils/Singleton.hpp>
+
+#include <string>
+#include <vector>
+
+namespace RaBenchmarks {
+
+class Benchmark;
+
+/// Singleton class responsible for running the benchmarks.
+class BenchmarkManager {
+
+    RA_SINGLETON_INTERFACE(BenchmarkManager);
+public:
+    /// Options regarding the benchmark behavior.
+    struct Options
+    {
+        Options() : m_filter() {}
+        /// If not empty, only the benchmarks whose name contains this string are run.
+        std::string m_filter;
+    };
+
+    /// Empty constructor.
+    BenchmarkManager() {}
+
+    /// Register one benchmark into the manager.
+    void add(Benchmark* benchmark);
+
+    /// Run all benchmarks. Returns the number of benchmarks run.
+    int run();
+
+public:
+    Options m_options; /// Options of the benchmarks.
+    std::vector<Benchmark*> m_benchmarks; /// Storage for the benchmark instances.
+};
+
+}
+
+#endif // RADIUM_BENCHMARKS_MANAGER_HPP_
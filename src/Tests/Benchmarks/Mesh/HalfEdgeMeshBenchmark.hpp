@@ -0,0 +1,98 @@
+#ifndef RADIUM_HALFEDGE_MESH_BENCHMARK_HPP_
+#define RADIUM_HALFEDGE_MESH_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/Wrapper/Convert.hpp>
+#include <Core/Mesh/DCEL/Dcel.hpp>
+#include <Core/Mesh/DCEL/Vertex.hpp>
+#include <Core/Mesh/DCEL/FullEdge.hpp>
+#include <Core/Mesh/DCEL/HalfEdgeMesh.hpp>
+#include <Core/Mesh/DCEL/Iterator/Vertex/VVIterator.hpp>
+#include <Core/Mesh/DCEL/Operations/EdgeSplit.hpp>
+
+namespace RaBenchmarks {
+
+/// Topology operations on a closed mesh stored in the Dcel (elements allocated one by one
+/// and linked by shared pointers) and in the HalfEdgeMesh (arrays of indices):
+/// conversion from a TriangleMesh, traversal of the 1-ring of all the vertices and split
+/// of all the edges.
+class HalfEdgeMeshBenchmark : public Benchmark
+{
+    std::string getName() const override { return "HalfEdgeMesh"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        const TriangleMesh torus = MeshUtils::makeParametricTorus<128, 64>( 1.f, 0.3f );
+
+        Dcel dcel;
+        HalfEdgeMesh hem;
+        const auto dcelConvert = bestTimeOf( 1, [&]() { convert( torus, dcel ); } );
+        const auto hemConvert = bestTimeOf( 3, [&]() { convert( torus, hem ); } );
+
+        // Centroid of the neighbors of each vertex, as in a smoothing step.
+        Vector3Array centroids( torus.m_vertices.size() );
+        const auto dcelRing = bestTimeOf( 3, [&]()
+        {
+            for (uint i = 0; i < dcel.m_vertex.size(); ++i)
+            {
+                Vertex_ptr v = dcel.m_vertex.at( i );
+                const VertexList ring = VVIterator( v ).list();
+                Vector3 c = Vector3::Zero();
+                for (const auto& n : ring)
+                {
+                    c += n->P();
+                }
+                centroids[i] = c / Scalar( ring.size() );
+            }
+        } );
+        const auto hemRing = bestTimeOf( 3, [&]()
+        {
+            for (VertexIdx v = 0; v < hem.getVertexCapacity(); ++v)
+            {
+                Vector3 c = Vector3::Zero();
+                uint n = 0;
+                for (VertexIdx w : hem.vertexVertices( v ))
+                {
+                    c += hem.getPosition( w );
+                    ++n;
+                }
+                centroids[v] = c / Scalar( n );
+            }
+        } );
+
+        // Split of all the edges, each structure being split once.
+        std::vector<Index> fulledges;
+        for (const auto& fe : dcel.m_fulledge)
+        {
+            fulledges.push_back( fe->idx );
+        }
+        const auto dcelSplit = bestTimeOf( 1, [&]()
+        {
+            for (const auto& e : fulledges)
+            {
+                DcelOperations::splitEdge( dcel, e, 0.5f );
+            }
+        } );
+        const uint numEdges = hem.getEdgeCapacity();
+        const auto hemSplit = bestTimeOf( 1, [&]()
+        {
+            for (EdgeIdx e = 0; e < numEdges; ++e)
+            {
+                DcelOperations::splitEdge( hem, e, 0.5f );
+            }
+        } );
+
+        printf( "%u vertices, %u triangles, %s\n", uint( torus.m_vertices.size() ), uint( torus.m_triangles.size() ),
+                hem.checkConsistency() ? "consistent" : "INCONSISTENT" );
+        printf( "%14s %14s %14s %14s\n", "", "convert (us)", "1-ring (us)", "split (us)" );
+        printf( "%14s %14lld %14lld %14lld\n", "Dcel", (long long)dcelConvert, (long long)dcelRing, (long long)dcelSplit );
+        printf( "%14s %14lld %14lld %14lld\n", "HalfEdgeMesh", (long long)hemConvert, (long long)hemRing, (long long)hemSplit );
+    }
+};
+
+RA_BENCHMARK_CLASS(HalfEdgeMeshBenchmark);
+}
+
+#endif // RADIUM_HALFEDGE_MESH_BENCHMARK_HPP_
@@ -0,0 +1,184 @@
+#ifndef RADIUM_MESH_HANDOFF_BENCHMARK_HPP_
+#define RADIUM_MESH_HANDOFF_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/Mesh/TriangleMesh.hpp>
+
+#include <memory>
+
+namespace RaBenchmarks {
+
+/// Hands the data of a large imported mesh to a display mesh, as done by
+/// FancyMeshComponent::handleMeshLoading(), and reports the time and the peak memory
+/// used by the vertex arrays.
+/// The copy path builds the geometry by push_back, transforms it and copies it in the
+/// display mesh, and copies each attribute twice. The shared path transforms the
+/// geometry in a single pass, moves it in the display mesh and shares the attributes.
+class MeshHandoffBenchmark : public Benchmark
+{
+    /// Imported mesh data, as stored in a GeometryData.
+    struct SourceMesh
+    {
+        Ra::Core::Vector3Array m_vertices;
+        Ra::Core::Vector3Array m_normals;
+        std::vector<Ra::Core::VectorNui> m_faces;
+        Ra::Core::Transform m_frame;
+        std::shared_ptr<Ra::Core::Vector3Array> m_attribs[3];
+        std::shared_ptr<Ra::Core::Vector4Array> m_colors;
+    };
+
+    /// Data owned by a display mesh, as stored in an Engine::Mesh.
+    struct DisplayMesh
+    {
+        Ra::Core::TriangleMesh m_geometry;
+        std::shared_ptr<const Ra::Core::Vector3Array> m_attribs[3];
+        std::shared_ptr<const Ra::Core::Vector4Array> m_colors;
+    };
+
+    std::string getName() const override { return "MeshHandoff"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        printf("%10s %12s %12s %12s %12s\n", "vertices", "copy (us)", "shared (us)", "copy (MB)", "shared (MB)");
+        for (uint level : { 5u, 7u, 8u })
+        {
+            SourceMesh source;
+            makeSource( level, source );
+
+            size_t copyPeak = 0;
+            size_t sharedPeak = 0;
+            const auto copy = bestTimeOf( 3, [&]()
+            {
+                DisplayMesh display;
+                copyPeak = handoffCopy( source, display );
+            } );
+            const auto shared = bestTimeOf( 3, [&]()
+            {
+                DisplayMesh display;
+                sharedPeak = handoffShared( source, display );
+            } );
+
+            const size_t sourceBytes = getBytes( source );
+            printf("%10u %12lld %12lld %12.1f %12.1f\n", uint( source.m_vertices.size() ),
+                   (long long)copy, (long long)shared,
+                   double( sourceBytes + copyPeak ) / ( 1 << 20 ), double( sourceBytes + sharedPeak ) / ( 1 << 20 ));
+        }
+    }
+
+    static void makeSource( uint level, SourceMesh& source )
+    {
+        using namespace Ra::Core;
+        const TriangleMesh sphere = MeshUtils::makeGeodesicSphere( 1.f, level );
+        source.m_vertices = sphere.m_vertices;
+        source.m_normals = sphere.m_normals;
+        for (const auto& t : sphere.m_triangles)
+        {
+            source.m_faces.push_back( t.cast<uint>() );
+        }
+        source.m_frame = Transform::Identity();
+        source.m_frame.translate( Vector3( 1, 2, 3 ) );
+        source.m_frame.scale( Scalar( 0.5 ) );
+        for (auto& attrib : source.m_attribs)
+        {
+            attrib = std::make_shared<Vector3Array>( sphere.m_normals );
+        }
+        source.m_colors = std::make_shared<Vector4Array>( sphere.m_vertices.size(), Vector4::Ones() );
+    }
+
+    /// Former path. Returns the bytes of the arrays allocated by the hand-off.
+    static size_t handoffCopy( const SourceMesh& source, DisplayMesh& display )
+    {
+        using namespace Ra::Core;
+        TriangleMesh mesh;
+        Transform N;
+        N.matrix() = source.m_frame.matrix().inverse().transpose();
+        for (size_t i = 0; i < source.m_vertices.size(); ++i)
+        {
+            mesh.m_vertices.push_back( source.m_frame * source.m_vertices[i] );
+            mesh.m_normals.push_back( ( N * source.m_normals[i] ).normalized() );
+        }
+        for (const auto& f : source.m_faces)
+        {
+            mesh.m_triangles.push_back( f.head<3>() );
+        }
+        display.m_geometry = mesh;
+
+        Vector3Array attribs[3];
+        Vector4Array colors;
+        for (uint k = 0; k < 3; ++k)
+        {
+            for (const auto& v : *source.m_attribs[k])
+            {
+                attribs[k].push_back( v );
+            }
+            display.m_attribs[k] = std::make_shared<Vector3Array>( attribs[k] );
+        }
+        for (const auto& c : *source.m_colors)
+        {
+            colors.push_back( c );
+        }
+        display.m_colors = std::make_shared<Vector4Array>( colors );
+
+        // Everything is alive at the end of the scope.
+        size_t bytes = getBytes( mesh ) + getBytes( display.m_geometry ) + getBytes( colors ) + getBytes( *display.m_colors );
+        for (uint k = 0; k < 3; ++k)
+        {
+            bytes += getBytes( attribs[k] ) + getBytes( *display.m_attribs[k] );
+        }
+        return bytes;
+    }
+
+    /// Current path. Returns the bytes of the arrays allocated by the hand-off.
+    static size_t handoffShared( const SourceMesh& source, DisplayMesh& display )
+    {
+        using namespace Ra::Core;
+        TriangleMesh mesh;
+        MeshUtils::transformPoints( source.m_vertices, source.m_frame, mesh.m_vertices );
+        MeshUtils::transformNormals( source.m_normals, source.m_frame, mesh.m_normals );
+        mesh.m_triangles.resize( source.m_faces.size() );
+        for (uint i = 0; i < source.m_faces.size(); ++i)
+        {
+            mesh.m_triangles[i] = source.m_faces[i].head<3>();
+        }
+        display.m_geometry = std::move( mesh );
+
+        for (uint k = 0; k < 3; ++k)
+        {
+            display.m_attribs[k] = source.m_attribs[k];
+        }
+        display.m_colors = source.m_colors;
+
+        return getBytes( display.m_geometry );
+    }
+
+    template <typename ARRAY>
+    static size_t getBytes( const ARRAY& array )
+    {
+        return array.capacity() * sizeof( typename ARRAY::value_type );
+    }
+
+    static size_t getBytes( const Ra::Core::TriangleMesh& mesh )
+    {
+        return getBytes( mesh.m_vertices ) + getBytes( mesh.m_normals ) + getBytes( mesh.m_triangles );
+    }
+
+    static size_t getBytes( const SourceMesh& source )
+    {
+        size_t bytes = getBytes( source.m_vertices ) + getBytes( source.m_normals )
+                       + getBytes( source.m_faces ) + getBytes( *source.m_colors );
+        for (const auto& attrib : source.m_attribs)
+        {
+            bytes += getBytes( *attrib );
+        }
+        return bytes;
+    }
+};
+
+RA_BENCHMARK_CLASS(MeshHandoffBenchmark);
+}
+
+#endif // RADIUM_MESH_HANDOFF_BENCHMARK_HPP_
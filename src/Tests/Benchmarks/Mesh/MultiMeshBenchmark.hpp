@@ -0,0 +1,97 @@
+#ifndef RADIUM_MULTIMESH_BENCHMARK_HPP_
+#define RADIUM_MULTIMESH_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace RaBenchmarks {
+
+/// Builds the display geometry of scenes made of many small meshes, as done when
+/// a file is loaded : copy of the imported arrays and transform to world space.
+/// Compares building the meshes one by one and building each mesh in its own task.
+class MultiMeshBenchmark : public Benchmark
+{
+    /// Imported mesh data, as stored in a GeometryData.
+    struct SourceMesh
+    {
+        Ra::Core::Vector3Array m_vertices;
+        Ra::Core::Vector3Array m_normals;
+        std::vector<Ra::Core::VectorNui> m_faces;
+        Ra::Core::Transform m_frame;
+    };
+
+    std::string getName() const override { return "MultiMesh"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        const uint numThreads = std::max( 1u, std::thread::hardware_concurrency() );
+        TaskQueue queue( numThreads, TaskQueue::SchedulingMode::WORK_STEALING );
+
+        printf("%10s %10s %14s %14s %10s\n", "meshes", "triangles", "serial (us)", "tasks (us)", "speedup");
+        for (uint level : { 0u, 1u, 2u })
+        {
+            const TriangleMesh sphere = MeshUtils::makeGeodesicSphere( 1.f, level );
+            for (uint numMeshes : { 256u, 4096u })
+            {
+                std::vector<SourceMesh> sources( numMeshes );
+                for (uint i = 0; i < numMeshes; ++i)
+                {
+                    SourceMesh& source = sources[i];
+                    source.m_vertices = sphere.m_vertices;
+                    source.m_normals = sphere.m_normals;
+                    for (const auto& t : sphere.m_triangles)
+                    {
+                        source.m_faces.push_back( t.cast<uint>() );
+                    }
+                    source.m_frame = Transform::Identity();
+                    source.m_frame.translate( Vector3( Scalar( i ), 0, 0 ) );
+                    source.m_frame.scale( Scalar( 0.5 ) );
+                }
+
+                std::vector<TriangleMesh> meshes( numMeshes );
+                auto build = [&]( uint begin, uint end )
+                {
+                    for (uint i = begin; i < end; ++i)
+                    {
+                        buildMesh( sources[i], meshes[i] );
+                    }
+                };
+
+                setParallelForTaskQueue( nullptr );
+                const auto serial = bestTimeOf( 5, [&]() { build( 0, numMeshes ); } );
+
+                setParallelForTaskQueue( &queue );
+                const auto tasks = bestTimeOf( 5, [&]() { parallelFor( 0, numMeshes, 1, build ); } );
+                setParallelForTaskQueue( nullptr );
+
+                printf("%10u %10u %14lld %14lld %9.2fx\n", numMeshes, uint( sphere.m_triangles.size() ),
+                       (long long)serial, (long long)tasks, tasks > 0 ? double( serial ) / tasks : 0.0);
+            }
+        }
+    }
+
+    static void buildMesh( const SourceMesh& source, Ra::Core::TriangleMesh& mesh )
+    {
+        Ra::Core::MeshUtils::transformPoints( source.m_vertices, source.m_frame, mesh.m_vertices );
+        Ra::Core::MeshUtils::transformNormals( source.m_normals, source.m_frame, mesh.m_normals );
+        mesh.m_triangles.resize( source.m_faces.size() );
+        for (uint i = 0; i < source.m_faces.size(); ++i)
+        {
+            mesh.m_triangles[i] = source.m_faces[i].head<3>();
+        }
+    }
+};
+
+RA_BENCHMARK_CLASS(MultiMeshBenchmark);
+}
+
+#endif // RADIUM_MULTIMESH_BENCHMARK_HPP_
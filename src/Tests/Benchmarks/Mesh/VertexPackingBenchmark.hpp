@@ -0,0 +1,82 @@
+#ifndef RADIUM_VERTEX_PACKING_BENCHMARK_HPP_
+#define RADIUM_VERTEX_PACKING_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/TriangleMesh.hpp>
+#include <Core/Mesh/VertexPacking.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace RaBenchmarks {
+
+/// Size of the vertex buffers of a mesh with all the vertex attributes of a loaded
+/// mesh, in the default and in the packed vertex format of Engine::Mesh, and time
+/// spent preparing them on the CPU. The default format uploads the arrays as they
+/// are, which is modeled by a copy.
+class VertexPackingBenchmark : public Benchmark
+{
+    std::string getName() const override { return "VertexPacking"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        printf("%10s %12s %12s %12s %12s\n", "vertices", "default (MB)", "packed (MB)", "copy (us)", "pack (us)");
+        for (uint level : { 4u, 6u, 8u })
+        {
+            const TriangleMesh mesh = MeshUtils::makeGeodesicSphere( 1.f, level );
+            const Vector3Array& attrib = mesh.m_normals;
+            const Vector4Array colors( mesh.m_vertices.size(), Vector4( 0.2f, 0.4f, 0.6f, 1.f ) );
+            const uint numVertices = mesh.m_vertices.size();
+            const uint numTriangles = mesh.m_triangles.size();
+
+            // Positions, normals, tangents, bitangents, texture coordinates and colors.
+            const size_t defaultVertex = 5 * sizeof( Vector3 ) + sizeof( Vector4 );
+            const size_t packedVertex = 3 * sizeof( float ) + 5 * sizeof( uint );
+            const size_t indexSize = numVertices <= 65536 ? sizeof( ushort ) : sizeof( uint );
+            const size_t defaultBytes = numVertices * defaultVertex + numTriangles * sizeof( Triangle );
+            const size_t packedBytes = numVertices * packedVertex + numTriangles * 3 * indexSize;
+
+            std::vector<char> buffer( numVertices * defaultVertex );
+            const auto copy = bestTimeOf( 5, [&]()
+            {
+                char* out = buffer.data();
+                for (const Vector3Array* arr : { &mesh.m_vertices, &mesh.m_normals, &attrib, &attrib, &attrib })
+                {
+                    std::memcpy( out, arr->data(), arr->size() * sizeof( Vector3 ) );
+                    out += arr->size() * sizeof( Vector3 );
+                }
+                std::memcpy( out, colors.data(), colors.size() * sizeof( Vector4 ) );
+            } );
+
+            const uint stride = packedVertex;
+            const auto pack = bestTimeOf( 5, [&]()
+            {
+                const uint blockSize = 4096;
+                for (uint begin = 0; begin < numVertices; begin += blockSize)
+                {
+                    const uint count = std::min( blockSize, numVertices - begin );
+                    char* out = buffer.data() + begin * stride;
+                    VertexPacking::packFloat3( &mesh.m_vertices[begin], count, out, stride );
+                    VertexPacking::packSnorm1010102( &mesh.m_normals[begin], count, out + 12, stride );
+                    VertexPacking::packSnorm1010102( &attrib[begin], count, out + 16, stride );
+                    VertexPacking::packSnorm1010102( &attrib[begin], count, out + 20, stride );
+                    VertexPacking::packHalf2( &attrib[begin], count, out + 24, stride );
+                    VertexPacking::packUnorm8888( &colors[begin], count, out + 28, stride );
+                }
+            } );
+
+            printf("%10u %12.1f %12.1f %12lld %12lld\n", numVertices,
+                   double( defaultBytes ) / ( 1 << 20 ), double( packedBytes ) / ( 1 << 20 ),
+                   (long long)copy, (long long)pack);
+        }
+    }
+};
+
+RA_BENCHMARK_CLASS(VertexPackingBenchmark);
+}
+
+#endif // RADIUM_VERTEX_PACKING_BENCHMARK_HPP_
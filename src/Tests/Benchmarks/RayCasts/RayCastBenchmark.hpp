@@ -0,0 +1,82 @@
+#ifndef RADIUM_RAYCAST_BENCHMARK_HPP_
+#define RADIUM_RAYCAST_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/TreeStructures/TriangleMeshBVH.hpp>
+
+#include <random>
+
+namespace RaBenchmarks {
+
+/// Casts random rays on dense spheres, with the linear MeshUtils::castRay()
+/// and with a TriangleMeshBVH (closest hit and any hit).
+class RayCastBenchmark : public Benchmark
+{
+    std::string getName() const override { return "RayCast"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        const uint numRays = 1000000;
+        const uint numLinearRays = 100;
+
+        printf("%10s %12s %12s %14s %14s %14s\n", "triangles", "build (ms)", "refit (ms)",
+               "linear (r/s)", "closest (r/s)", "any (r/s)");
+        for (uint level : { 5u, 7u, 8u })
+        {
+            const TriangleMesh mesh = MeshUtils::makeGeodesicSphere( 1.f, level );
+
+            // Random rays from around the sphere to points inside, half of them missing.
+            std::mt19937 gen( 3 );
+            std::uniform_real_distribution<Scalar> dist( -1.f, 1.f );
+            std::vector<Ray> rays;
+            rays.reserve( numRays );
+            for (uint i = 0; i < numRays; ++i)
+            {
+                const Vector3 origin = 3.f * Vector3( dist( gen ), dist( gen ), dist( gen ) ).normalized();
+                const Vector3 target = 1.4f * Vector3( dist( gen ), dist( gen ), dist( gen ) );
+                rays.push_back( Ray( origin, ( target - origin ).normalized() ) );
+            }
+
+            TriangleMeshBVH bvh;
+            const auto build = bestTimeOf( 1, [&]() { bvh.build( mesh ); } );
+            const auto refit = bestTimeOf( 3, [&]() { bvh.refit( mesh ); } );
+
+            volatile int sink = 0;
+            const auto linear = bestTimeOf( 1, [&]()
+            {
+                for (uint i = 0; i < numLinearRays; ++i)
+                {
+                    sink = sink + MeshUtils::castRay( mesh, rays[i] ).m_hitTriangle;
+                }
+            } );
+            const auto closest = bestTimeOf( 1, [&]()
+            {
+                for (const auto& ray : rays)
+                {
+                    sink = sink + MeshUtils::castRay( mesh, bvh, ray ).m_hitTriangle;
+                }
+            } );
+            const auto any = bestTimeOf( 1, [&]()
+            {
+                for (const auto& ray : rays)
+                {
+                    sink = sink + int( bvh.anyHit( mesh, ray ) );
+                }
+            } );
+
+            auto perSecond = []( uint n, long us ) { return us > 0 ? 1e6 * n / us : 0.0; };
+            printf("%10u %12.1f %12.1f %14.0f %14.0f %14.0f\n", uint( mesh.m_triangles.size() ),
+                   build / 1000.0, refit / 1000.0, perSecond( numLinearRays, linear ),
+                   perSecond( numRays, closest ), perSecond( numRays, any ));
+        }
+    }
+};
+
+RA_BENCHMARK_CLASS(RayCastBenchmark);
+}
+
+#endif // RADIUM_RAYCAST_BENCHMARK_HPP_
@@ -0,0 +1,93 @@
+#ifndef RADIUM_TASKQUEUE_BENCHMARK_HPP_
+#define RADIUM_TASKQUEUE_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Tasks/Task.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace RaBenchmarks {
+
+/// A small task doing a fixed amount of arithmetic.
+class SpinTask : public Ra::Core::Task
+{
+public:
+    SpinTask( uint work, volatile Scalar* sink ) : m_work( work ), m_sink( sink ) {}
+
+    virtual std::string getName() const override { return "SpinTask"; }
+
+    virtual void process() override
+    {
+        Scalar x = 1.f;
+        for (uint i = 0; i < m_work; ++i)
+        {
+            x = x * 0.999f + 0.001f;
+        }
+        *m_sink = x;
+    }
+
+private:
+    uint m_work;
+    volatile Scalar* m_sink;
+};
+
+/// Compares the shared queue and the work-stealing scheduler on frames made of many
+/// small tasks, from one thread to the hardware concurrency.
+/// Half of the tasks depend on another one to exercise the dependency counters.
+class TaskQueueBenchmark : public Benchmark
+{
+    std::string getName() const override { return "TaskQueue"; }
+
+    void run() override
+    {
+        const uint numTasks = 1024;
+        const uint numFrames = 50;
+        const uint maxThreads = std::max( 1u, std::thread::hardware_concurrency() );
+
+        printf("%8s %14s %10s %14s %14s\n", "threads", "mode", "work", "frame (us)", "tasks/s");
+        for (uint work : { 0u, 2000u })
+        {
+            for (uint numThreads = 1; numThreads <= maxThreads; ++numThreads)
+            {
+                runMode( Ra::Core::TaskQueue::SchedulingMode::SHARED_QUEUE, "shared", numThreads, numTasks, numFrames, work );
+                runMode( Ra::Core::TaskQueue::SchedulingMode::WORK_STEALING, "stealing", numThreads, numTasks, numFrames, work );
+            }
+        }
+    }
+
+    void runMode( Ra::Core::TaskQueue::SchedulingMode mode, const char* modeName,
+                  uint numThreads, uint numTasks, uint numFrames, uint work )
+    {
+        Ra::Core::TaskQueue queue( numThreads, mode );
+        volatile Scalar sink = 0.f;
+
+        auto frame = [&]()
+        {
+            for (uint i = 0; i < numTasks; i += 2)
+            {
+                auto first = queue.registerTask( new SpinTask( work, &sink ) );
+                auto second = queue.registerTask( new SpinTask( work, &sink ) );
+                queue.addDependency( first, second );
+            }
+            queue.startTasks();
+            queue.waitForTasks();
+            queue.flushTaskQueue();
+        };
+
+        Ra::Core::Timer::MicroSeconds total = 0;
+        for (uint f = 0; f < numFrames; ++f)
+        {
+            total += bestTimeOf( 1, frame );
+        }
+        const double frameTime = double( total ) / numFrames;
+        printf("%8u %14s %10u %14.1f %14.0f\n", numThreads, modeName, work, frameTime,
+               frameTime > 0 ? 1e6 * numTasks / frameTime : 0.0);
+    }
+};
+
+RA_BENCHMARK_CLASS(TaskQueueBenchmark);
+}
+
+#endif // RADIUM_TASKQUEUE_BENCHMARK_HPP_
@@ -0,0 +1,44 @@
+#ifndef RADIUM_PROFILER_BENCHMARK_HPP_
+#define RADIUM_PROFILER_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/Time/Profiler.hpp>
+
+namespace RaBenchmarks {
+
+/// Cost of a profiling zone when the profiler is disabled and enabled.
+class ProfilerBenchmark : public Benchmark
+{
+    std::string getName() const override { return "Profiler"; }
+
+    void run() override
+    {
+        using Ra::Core::Profiler;
+        const uint numZones = 1000000;
+        volatile uint sink = 0;
+        auto zones = [&]()
+        {
+            for (uint i = 0; i < numZones; ++i)
+            {
+                RA_PROFILE_ZONE( "Benchmark zone" );
+                sink = sink + i;
+            }
+        };
+
+        Profiler& profiler = Profiler::getInstance();
+        const bool wasEnabled = profiler.isEnabled();
+        printf("%10s %16s\n", "profiler", "ns per zone");
+        for (bool enabled : { false, true })
+        {
+            profiler.setEnabled( enabled );
+            const auto t = bestTimeOf( 5, zones );
+            printf("%10s %16.1f\n", enabled ? "enabled" : "disabled", 1000.0 * t / numZones);
+        }
+        profiler.setEnabled( wasEnabled );
+    }
+};
+
+RA_BENCHMARK_CLASS(ProfilerBenchmark);
+}
+
+#endif // RADIUM_PROFILER_BENCHMARK_HPP_
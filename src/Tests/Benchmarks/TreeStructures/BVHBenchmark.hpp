@@ -0,0 +1,121 @@
+#ifndef RADIUM_BVH_BENCHMARK_HPP_
+#define RADIUM_BVH_BENCHMARK_HPP_
+
+#include <Tests/Benchmarks/Benchmarks.hpp>
+#include <Core/TreeStructures/BVH.hpp>
+
+#include <random>
+
+namespace RaBenchmarks {
+
+struct BVHBenchmarkObject
+{
+    Ra::Core::Aabb m_aabb;
+    uint m_leaf;
+};
+
+/// Frustum culling of a scene of random boxes where a few objects move each
+/// frame, against testing every box.
+class BVHBenchmark : public Benchmark
+{
+    std::string getName() const override { return "BVH"; }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        typedef std::shared_ptr<BVHBenchmarkObject> ObjectPtr;
+
+        // Perspective camera at the origin, looking towards -z.
+        Matrix4 proj = Matrix4::Zero();
+        proj( 0, 0 ) = proj( 1, 1 ) = 1.f / std::tan( 0.4f );
+        proj( 2, 2 ) = -101.f / 99.f;
+        proj( 2, 3 ) = -200.f / 99.f;
+        proj( 3, 2 ) = -1.f;
+        const Frustum frustum( proj );
+
+        const uint numFrames = 100;
+
+        printf("%10s %10s %12s %14s %14s\n", "objects", "visible", "insert (ms)", "linear (us/f)", "bvh (us/f)");
+        for (uint numObjects : { 1000u, 10000u, 100000u })
+        {
+            std::mt19937 gen( 5 );
+            std::uniform_real_distribution<Scalar> dist( -100.f, 100.f );
+            std::uniform_real_distribution<Scalar> small( -0.1f, 0.1f );
+            std::vector<ObjectPtr> objects;
+            for (uint i = 0; i < numObjects; ++i)
+            {
+                ObjectPtr o( new BVHBenchmarkObject );
+                const Vector3 c( dist( gen ), dist( gen ), dist( gen ) );
+                o->m_aabb = Aabb( c - Vector3::Ones(), c + Vector3::Ones() );
+                objects.push_back( o );
+            }
+
+            BVH<BVHBenchmarkObject> bvh;
+            const auto insert = bestTimeOf( 1, [&]()
+            {
+                for (const auto& o : objects)
+                {
+                    o->m_leaf = bvh.insertLeaf( o, o->m_aabb );
+                }
+            } );
+
+            // Each frame, 5% of the objects move a little.
+            std::vector<ObjectPtr> visible;
+            const auto culled = bestTimeOf( 1, [&]()
+            {
+                for (uint f = 0; f < numFrames; ++f)
+                {
+                    for (uint i = f % 20; i < numObjects; i += 20)
+                    {
+                        objects[i]->m_aabb.translate( Vector3( small( gen ), small( gen ), small( gen ) ) );
+                        bvh.updateLeaf( objects[i]->m_leaf, objects[i]->m_aabb );
+                    }
+                    visible.clear();
+                    bvh.getInFrustum( visible, frustum );
+                }
+            } );
+
+            std::vector<ObjectPtr> linearVisible;
+            const auto linear = bestTimeOf( 1, [&]()
+            {
+                for (uint f = 0; f < numFrames; ++f)
+                {
+                    linearVisible.clear();
+                    for (const auto& o : objects)
+                    {
+                        if ( isInFrustum( o->m_aabb, frustum ) )
+                        {
+                            linearVisible.push_back( o );
+                        }
+                    }
+                }
+            } );
+
+            printf("%10u %10u %12.2f %14.1f %14.1f\n", numObjects, uint( visible.size() ), insert / 1000.0,
+                   double( linear ) / numFrames, double( culled ) / numFrames);
+        }
+    }
+
+    static bool isInFrustum( const Ra::Core::Aabb& aabb, const Ra::Core::Frustum& frustum )
+    {
+        for (uint i = 0; i < 6; ++i)
+        {
+            bool outside = true;
+            for (int c = 0; c < 8 && outside; ++c)
+            {
+                const Ra::Core::Vector3 p = aabb.corner( static_cast<Ra::Core::Aabb::CornerType>( c ) );
+                outside = frustum.getPlane( i ).dot( Ra::Core::Vector4( p.x(), p.y(), p.z(), 1.f ) ) < 0;
+            }
+            if ( outside )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+RA_BENCHMARK_CLASS(BVHBenchmark);
+}
+
+#endif // RADIUM_BVH_BENCHMARK_HPP_
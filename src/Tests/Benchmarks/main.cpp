@@ -0,0 +1,27 @@
+#include <Tests/Benchmarks/Benchmarks.hpp>
+
+#include <Tests/Benchmarks/Animation/AnimationBenchmark.hpp>
+#include <Tests/Benchmarks/Animation/CompressedAnimationBenchmark.hpp>
+#include <Tests/Benchmarks/Animation/SkeletonBenchmark.hpp>
+#include <Tests/Benchmarks/Animation/SkinningBenchmark.hpp>
+#include <Tests/Benchmarks/File/MeshFileBenchmark.hpp>
+#include <Tests/Benchmarks/Log/LogBenchmark.hpp>
+#include <Tests/Benchmarks/Mesh/HalfEdgeMeshBenchmark.hpp>
+#include <Tests/Benchmarks/Mesh/MeshHandoffBenchmark.hpp>
+#include <Tests/Benchmarks/Mesh/MultiMeshBenchmark.hpp>
+#include <Tests/Benchmarks/Mesh/VertexPackingBenchmark.hpp>
+#include <Tests/Benchmarks/RayCasts/RayCastBenchmark.hpp>
+#include <Tests/Benchmarks/Tasks/TaskQueueBenchmark.hpp>
+#include <Tests/Benchmarks/Time/ProfilerBenchmark.hpp>
+#include <Tests/Benchmarks/TreeStructures/BVHBenchmark.hpp>
+
+int main(int argc, char** argv)
+{
+    if (! RaBenchmarks::BenchmarkManager::getInstance()) {RaBenchmarks::BenchmarkManager::createInstance();}
+    if (argc > 1)
+    {
+        RaBenchmarks::BenchmarkManager::getInstance()->m_options.m_filter = argv[1];
+    }
+    RaBenchmarks::BenchmarkManager::getInstance()->run();
+    return 0;
+}
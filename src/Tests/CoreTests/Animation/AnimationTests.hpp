@@ -0,0 +1,129 @@
+#ifndef RADIUM_ANIMATION_TESTS_HPP_
+#define RADIUM_ANIMATION_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Animation/Animation.hpp>
+#include <Core/Animation/Pose/PoseOperation.hpp>
+
+#include <cmath>
+#include <random>
+
+namespace RaTests {
+
+class AnimationTests : public Test
+{
+    /// Pose of an animation at a time in [0, duration] computed by a linear search.
+    static Ra::Core::Animation::Pose referencePose( const std::vector<Ra::Core::Animation::KeyPose>& keys, Scalar time )
+    {
+        if ( time <= keys.front().first )
+        {
+            return keys.front().second;
+        }
+        for (uint i = 0; i + 1 < keys.size(); ++i)
+        {
+            if ( time >= keys[i].first && time <= keys[i + 1].first )
+            {
+                const Scalar t = ( time - keys[i].first ) / ( keys[i + 1].first - keys[i].first );
+                return Ra::Core::Animation::interpolatePoses( keys[i].second, keys[i + 1].second, t );
+            }
+        }
+        return keys.back().second;
+    }
+
+    static bool samePoses( const Ra::Core::Animation::Pose& a, const Ra::Core::Animation::Pose& b )
+    {
+        bool same = a.size() == b.size();
+        for (uint i = 0; same && i < a.size(); ++i)
+        {
+            same = ( a[i].matrix() - b[i].matrix() ).cwiseAbs().maxCoeff() < 1e-4f;
+        }
+        return same;
+    }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+        std::mt19937 gen( 3 );
+        std::uniform_real_distribution<Scalar> dist( -1.f, 1.f );
+
+        // Keys at irregular times, added out of order.
+        const uint numBones = 10;
+        std::vector<KeyPose> keys;
+        Scalar time = 0.f;
+        for (uint k = 0; k < 50; ++k)
+        {
+            Pose pose( numBones );
+            for (uint b = 0; b < numBones; ++b)
+            {
+                pose[b] = Transform::Identity();
+                pose[b].rotate( AngleAxis( 3.f * dist( gen ), Vector3( dist( gen ), dist( gen ), 1.f ).normalized() ) );
+                pose[b].translation() = Vector3( dist( gen ), dist( gen ), dist( gen ) );
+            }
+            keys.push_back( KeyPose( time, pose ) );
+            time += 0.01f + 0.1f * ( dist( gen ) + 1.f );
+        }
+        const Scalar duration = keys.back().first;
+
+        Ra::Core::Animation::Animation anim;
+        for (uint k = 0; k < keys.size(); ++k)
+        {
+            anim.addKeyPose( keys[( k * 7 ) % keys.size()] );
+        }
+        anim.normalize();
+        RA_UNIT_TEST( anim.getNumKeys() == 50 && anim.getDuration() == duration, "Wrong keys" );
+
+        // Random times, by binary search.
+        bool same = true;
+        Pose pose;
+        for (uint i = 0; i < 200; ++i)
+        {
+            const Scalar t = ( dist( gen ) + 1.f ) * duration;
+            const Scalar local = duration - std::abs( std::fmod( t, 2 * duration ) - duration );
+            anim.getPose( t, pose );
+            same = same && samePoses( pose, referencePose( keys, local ) );
+        }
+        RA_UNIT_TEST( same, "Sampled pose differs from the interpolation of the keys" );
+        RA_UNIT_TEST( samePoses( anim.getPose( 0.f ), keys.front().second ), "Wrong first pose" );
+        RA_UNIT_TEST( samePoses( anim.getPose( duration ), keys.back().second ), "Wrong last pose" );
+
+        // Playback forward then backward (ping pong) with a cursor, and a jump.
+        AnimationCursor cursor;
+        same = true;
+        for (Scalar t = 0.f; t < 2.f * duration; t += 0.016f)
+        {
+            anim.getPose( t, cursor, pose );
+            same = same && samePoses( pose, anim.getPose( t ) );
+        }
+        anim.getPose( 0.3f * duration, cursor, pose );
+        same = same && samePoses( pose, anim.getPose( 0.3f * duration ) );
+        RA_UNIT_TEST( same, "Cursor playback differs from the binary search" );
+
+        // Many instances at once.
+        std::vector<Pose> poses( 20 );
+        std::vector<AnimationCursor> cursors( 20 );
+        std::vector<AnimationSample> samples;
+        for (uint i = 0; i < poses.size(); ++i)
+        {
+            AnimationSample s = { &anim, 0.1f * i, i % 2 == 0 ? &cursors[i] : nullptr, &poses[i] };
+            samples.push_back( s );
+        }
+        samplePoses( samples );
+        same = true;
+        for (uint i = 0; i < poses.size(); ++i)
+        {
+            same = same && samePoses( poses[i], anim.getPose( 0.1f * i ) );
+        }
+        RA_UNIT_TEST( same, "Batch sampling differs from single sampling" );
+
+        // A single key is a still pose.
+        Ra::Core::Animation::Animation still;
+        still.addKeyPose( keys[3].second, 0.f );
+        RA_UNIT_TEST( samePoses( still.getPose( 1.f ), keys[3].second ), "Wrong pose of a single key animation" );
+    }
+};
+
+RA_TEST_CLASS(AnimationTests);
+}
+
+#endif // RADIUM_ANIMATION_TESTS_HPP_
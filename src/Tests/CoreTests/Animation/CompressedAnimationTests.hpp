@@ -0,0 +1,129 @@
+#ifndef RADIUM_COMPRESSED_ANIMATION_TESTS_HPP_
+#define RADIUM_COMPRESSED_ANIMATION_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Animation/CompressedAnimation.hpp>
+
+#include <cmath>
+
+namespace RaTests {
+
+class CompressedAnimationTests : public Test
+{
+    /// Largest rotation, translation and scale errors between two poses.
+    static Ra::Core::Vector3 poseErrors( const Ra::Core::Animation::Pose& a, const Ra::Core::Animation::Pose& b )
+    {
+        using namespace Ra::Core;
+        Vector3 errors = Vector3::Zero();
+        for (uint i = 0; i < a.size(); ++i)
+        {
+            Matrix3 rotA;
+            Matrix3 scaleA;
+            Matrix3 rotB;
+            Matrix3 scaleB;
+            a[i].computeRotationScaling( &rotA, &scaleA );
+            b[i].computeRotationScaling( &rotB, &scaleB );
+            const Quaternion d = Quaternion( rotA ).conjugate() * Quaternion( rotB );
+            errors = errors.cwiseMax( Vector3( 2.f * std::atan2( d.vec().norm(), std::abs( d.w() ) ),
+                                               ( a[i].translation() - b[i].translation() ).norm(),
+                                               ( scaleA.diagonal() - scaleB.diagonal() ).cwiseAbs().maxCoeff() ) );
+        }
+        return errors;
+    }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+
+        // Bone 0 does not move, bone 1 moves at constant speed, bone 2 turns and bone 3
+        // turns, moves and scales along a curve.
+        const uint numKeys = 120;
+        Ra::Core::Animation::Animation anim;
+        for (uint k = 0; k < numKeys; ++k)
+        {
+            const Scalar time = k / 30.f;
+            Pose pose( 4, Transform::Identity() );
+            pose[0].translation() = Vector3( 1.f, 2.f, 3.f );
+            pose[1].translation() = Vector3( time, 0.f, -2.f * time );
+            pose[2].rotate( AngleAxis( 2.f * std::sin( time ), Vector3( 1.f, 1.f, 0.f ).normalized() ) );
+            pose[3].translate( Vector3( std::cos( 3.f * time ), std::sin( 2.f * time ), 0.f ) );
+            pose[3].rotate( AngleAxis( 4.f * time, Vector3::UnitZ() ) );
+            pose[3].scale( Vector3( 1.f + 0.5f * std::sin( time ), 1.f, 2.f ) );
+            anim.addKeyPose( pose, time );
+        }
+
+        CompressionSettings settings;
+        CompressedAnimation compressed;
+        compressed.compress( anim, settings );
+        RA_UNIT_TEST( compressed.getNumBones() == 4 && compressed.getNumKeys() == numKeys
+                      && compressed.getDuration() == anim.getDuration(), "Wrong compressed animation" );
+
+        // The tracks of bone 0, the rotation and scale of bone 1, the translation and scale of bone 2.
+        RA_UNIT_TEST( compressed.getNumConstantTracks() == 7, "Constant tracks were not eliminated" );
+        RA_UNIT_TEST( compressed.getNumTrackKeys() < 4 * numKeys, "Keys were not reduced" );
+
+        const size_t animSize = numKeys * 4 * sizeof( Transform );
+        RA_UNIT_TEST( compressed.getMemorySize() * 4 < animSize, "Compressed animation is too big" );
+
+        // The key poses are within the error bound.
+        const Vector3 bound( settings.m_rotationError, settings.m_translationError, settings.m_scaleError );
+        Vector3 errors = Vector3::Zero();
+        Pose pose;
+        for (uint k = 0; k < numKeys; ++k)
+        {
+            const KeyPose& key = anim.getKeyPose( k );
+            compressed.getPose( key.first, pose );
+            errors = errors.cwiseMax( poseErrors( pose, key.second ) );
+        }
+        RA_UNIT_TEST( ( errors.array() <= bound.array() * 1.01f ).all(), "Compression error is out of bounds" );
+
+        // Playback with a cursor.
+        CompressedAnimationCursor cursor;
+        bool same = true;
+        Pose other;
+        for (Scalar t = 0.f; t < 2.f * compressed.getDuration(); t += 0.016f)
+        {
+            compressed.getPose( t, cursor, pose );
+            compressed.getPose( t, other );
+            same = same && poseErrors( pose, other ).maxCoeff() == 0.f;
+        }
+        RA_UNIT_TEST( same, "Cursor playback differs from the binary search" );
+
+        // Between the keys, close to the slerp of the source animation.
+        errors = Vector3::Zero();
+        for (uint k = 0; k + 1 < numKeys; ++k)
+        {
+            const Scalar t = ( k + 0.5f ) / 30.f;
+            compressed.getPose( t, pose );
+            Pose source = anim.getPose( t );
+            for (uint b = 0; b < 3; ++b)
+            {
+                errors = errors.cwiseMax( poseErrors( Pose( 1, pose[b] ), Pose( 1, source[b] ) ) );
+            }
+        }
+        RA_UNIT_TEST( errors.maxCoeff() < 2e-3f, "Interpolated poses are wrong" );
+
+        // A linear translation only keeps its first and last keys.
+        Ra::Core::Animation::Animation linear;
+        for (uint k = 0; k < numKeys; ++k)
+        {
+            linear.addKeyPose( Pose( 1, anim.getKeyPose( k ).second[1] ), anim.getKeyPose( k ).first );
+        }
+        compressed.compress( linear );
+        RA_UNIT_TEST( compressed.getNumTrackKeys() == 4, "Linear track was not reduced" );
+
+        // A single key is a still pose.
+        Ra::Core::Animation::Animation still;
+        still.addKeyPose( anim.getKeyPose( 10 ) );
+        compressed.compress( still );
+        compressed.getPose( 1.f, pose );
+        RA_UNIT_TEST( poseErrors( pose, anim.getKeyPose( 10 ).second ).maxCoeff() < 1e-3f,
+                      "Wrong pose of a single key animation" );
+    }
+};
+
+RA_TEST_CLASS(CompressedAnimationTests);
+}
+
+#endif // RADIUM_COMPRESSED_ANIMATION_TESTS_HPP_
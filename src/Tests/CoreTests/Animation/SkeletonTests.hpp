@@ -0,0 +1,119 @@
+#ifndef RADIUM_SKELETON_TESTS_HPP_
+#define RADIUM_SKELETON_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Animation/Handle/Skeleton.hpp>
+#include <Core/Animation/Pose/PoseOperation.hpp>
+
+#include <random>
+
+namespace RaTests {
+
+class SkeletonTests : public Test
+{
+    /// Model space transform of a bone, computed from the root.
+    static Ra::Core::Transform referenceModel( const Ra::Core::Animation::Skeleton& skel,
+                                               const Ra::Core::Animation::Pose& local, int i )
+    {
+        const int parent = skel.m_graph.m_parent[i];
+        return parent < 0 ? local[i] : referenceModel( skel, local, parent ) * local[i];
+    }
+
+    static bool samePoses( const Ra::Core::Animation::Pose& a, const Ra::Core::Animation::Pose& b )
+    {
+        bool same = a.size() == b.size();
+        for (uint i = 0; same && i < a.size(); ++i)
+        {
+            same = ( a[i].matrix() - b[i].matrix() ).cwiseAbs().maxCoeff() < 1e-4f;
+        }
+        return same;
+    }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+        std::mt19937 gen( 5 );
+        std::uniform_real_distribution<Scalar> dist( -1.f, 1.f );
+        auto randomTransform = [&]()
+        {
+            Transform t = Transform::Identity();
+            t.rotate( AngleAxis( 3.f * dist( gen ), Vector3( dist( gen ), dist( gen ), 1.f ).normalized() ) );
+            t.translation() = Vector3( dist( gen ), dist( gen ), dist( gen ) );
+            return t;
+        };
+
+        // Two roots and branches, each bone having a random earlier parent.
+        Skeleton skel;
+        Pose local;
+        for (uint i = 0; i < 40; ++i)
+        {
+            const int parent = ( i == 0 || i == 20 ) ? -1 : int( gen() % i );
+            local.push_back( randomTransform() );
+            skel.addBone( parent, local.back(), Handle::SpaceType::LOCAL );
+        }
+
+        Pose reference( local.size() );
+        for (uint i = 0; i < local.size(); ++i)
+        {
+            reference[i] = referenceModel( skel, local, i );
+        }
+        RA_UNIT_TEST( samePoses( skel.getPose( Handle::SpaceType::MODEL ), reference ), "Wrong model pose of the added bones" );
+
+        for (auto& t : local)
+        {
+            t = randomTransform();
+        }
+        for (uint i = 0; i < local.size(); ++i)
+        {
+            reference[i] = referenceModel( skel, local, i );
+        }
+        skel.setPose( local, Handle::SpaceType::LOCAL );
+        RA_UNIT_TEST( samePoses( skel.getPose( Handle::SpaceType::MODEL ), reference ), "Wrong model pose" );
+
+        const Pose model = reference;
+        skel.setPose( model, Handle::SpaceType::MODEL );
+        RA_UNIT_TEST( samePoses( skel.getPose( Handle::SpaceType::LOCAL ), local ), "Wrong local pose" );
+
+        // Model and skinning poses in one pass.
+        Pose rest( local.size() );
+        for (auto& t : rest)
+        {
+            t = randomTransform();
+        }
+        const Pose inverseRest = inversePose( rest );
+        Pose modelPose;
+        Pose relPose;
+        localToModelPose( skel.m_graph.m_parent, local, inverseRest, modelPose, relPose );
+        RA_UNIT_TEST( samePoses( modelPose, model ), "Wrong model pose of the fused update" );
+        RA_UNIT_TEST( samePoses( relPose, relativePose( model, rest ) ), "Wrong skinning pose" );
+        Pose fromInverse;
+        relativePoseFromInverse( model, inverseRest, fromInverse );
+        RA_UNIT_TEST( samePoses( fromInverse, relativePose( model, rest ) ), "Wrong relative pose" );
+
+        // Many instances of the skeleton.
+        std::vector<Pose> locals( 10, local );
+        std::vector<Pose> models( 10 );
+        std::vector<Pose> rels( 10 );
+        std::vector<HierarchyPoses> poses;
+        for (uint i = 0; i < locals.size(); ++i)
+        {
+            locals[i][0] = randomTransform();
+            HierarchyPoses p = { &locals[i], &models[i], i % 2 == 0 ? &rels[i] : nullptr };
+            poses.push_back( p );
+        }
+        localToModelPoses( skel.m_graph.m_parent, inverseRest, poses );
+        bool same = true;
+        for (uint i = 0; i < locals.size(); ++i)
+        {
+            localToModelPose( skel.m_graph.m_parent, locals[i], inverseRest, modelPose, relPose );
+            same = same && samePoses( models[i], modelPose ) && ( rels[i].empty() || samePoses( rels[i], relPose ) );
+        }
+        RA_UNIT_TEST( same, "Batched update differs from the single update" );
+    }
+};
+
+RA_TEST_CLASS(SkeletonTests);
+}
+
+#endif // RADIUM_SKELETON_TESTS_HPP_
@@ -0,0 +1,301 @@
+#ifndef RADIUM_SKINNING_TESTS_HPP_
+#define RADIUM_SKINNING_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Animation/Skinning/DualQuaternionSkinning.hpp>
+#include <Core/Animation/Skinning/LinearBlendSkinning.hpp>
+#include <Core/Animation/Skinning/PackedWeights.hpp>
+#include <Core/Geometry/Normal/Normal.hpp>
+
+#include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+
+#include <random>
+
+namespace RaTests {
+
+/// Random normalized weights with 1 to 6 influences per vertex, a random pose and random vertices.
+inline void makeSkinningData( uint numVertices, uint numBones,
+                              Ra::Core::Animation::WeightMatrix& weights,
+                              Ra::Core::Animation::Pose& pose,
+                              Ra::Core::Vector3Array& input )
+{
+    using namespace Ra::Core;
+    std::mt19937 gen( 42 );
+    std::uniform_int_distribution<uint> boneDist( 0, numBones - 1 );
+    std::uniform_int_distribution<uint> countDist( 1, 6 );
+    std::uniform_real_distribution<Scalar> weightDist( 0.05f, 1.f );
+
+    std::vector<Eigen::Triplet<Scalar>> triplets;
+    for (uint i = 0; i < numVertices; ++i)
+    {
+        const uint count = countDist( gen );
+        std::vector<Scalar> w( count );
+        Scalar sum = 0;
+        for (uint k = 0; k < count; ++k)
+        {
+            w[k] = weightDist( gen );
+            sum += w[k];
+        }
+        const uint firstBone = boneDist( gen );
+        for (uint k = 0; k < count; ++k)
+        {
+            triplets.push_back( Eigen::Triplet<Scalar>( i, ( firstBone + k ) % numBones, w[k] / sum ) );
+        }
+    }
+    weights.resize( numVertices, numBones );
+    weights.setFromTriplets( triplets.begin(), triplets.end() );
+
+    pose.resize( numBones );
+    for (uint j = 0; j < numBones; ++j)
+    {
+        pose[j] = Transform::Identity();
+        pose[j].rotate( AngleAxis( Scalar( j ) * 0.3f, Vector3( 1, Scalar( j ), 2 ).normalized() ) );
+        pose[j].translation() = Vector3( Scalar( j ), -1, Scalar( j ) * 0.5f );
+    }
+
+    input.resize( numVertices );
+    for (uint i = 0; i < numVertices; ++i)
+    {
+        input[i] = Vector3::Random();
+    }
+}
+
+/// Largest distance between two arrays of vectors.
+inline Scalar maxError( const Ra::Core::Vector3Array& a, const Ra::Core::Vector3Array& b )
+{
+    if ( a.size() != b.size() )
+    {
+        return 1e10f;
+    }
+    Scalar err = 0;
+    for (uint i = 0; i < a.size(); ++i)
+    {
+        err = std::max( err, ( a[i] - b[i] ).norm() );
+    }
+    return err;
+}
+
+class SkinningTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+
+        const uint numVertices = 5000;
+        WeightMatrix weights;
+        Pose pose;
+        Vector3Array input;
+        makeSkinningData( numVertices, 20, weights, pose, input );
+
+        // Reference: sum of the weighted transformed positions.
+        Vector3Array expected( numVertices, Vector3::Zero() );
+        for (int k = 0; k < weights.outerSize(); ++k)
+        {
+            for (WeightMatrix::InnerIterator it( weights, k ); it; ++it)
+            {
+                expected[it.row()] += it.value() * ( pose[it.col()] * input[it.row()] );
+            }
+        }
+
+        TaskQueue queue( 3, TaskQueue::SchedulingMode::WORK_STEALING );
+        setParallelForTaskQueue( &queue );
+
+        Vector3Array output;
+        linearBlendSkinning( input, pose, weights, output );
+        RA_UNIT_TEST( maxError( expected, output ) < 1e-4f, "Sparse LBS gives a wrong result" );
+
+        PackedWeights packed;
+        packWeights( weights, 8, packed );
+        RA_UNIT_TEST( packed.m_width == 6, "Packed width should be the largest number of influences" );
+        RA_UNIT_TEST( packed.m_numVertices == numVertices, "Wrong number of packed vertices" );
+
+        output.clear();
+        linearBlendSkinning( input, pose, packed, output );
+        RA_UNIT_TEST( maxError( expected, output ) < 1e-4f, "Packed LBS gives a wrong result" );
+
+        // Truncated influences must keep the partition of unity.
+        packWeights( weights, 2, packed );
+        RA_UNIT_TEST( packed.m_width == 2, "Packed width should be limited by maxInfluences" );
+        bool unity = true;
+        for (uint i = 0; i < numVertices; ++i)
+        {
+            unity = unity && std::abs( packed.m_weights[2 * i] + packed.m_weights[2 * i + 1] - 1.f ) < 1e-5f;
+        }
+        RA_UNIT_TEST( unity, "Truncated weights should sum to 1" );
+
+        setParallelForTaskQueue( nullptr );
+    }
+};
+
+RA_TEST_CLASS(SkinningTests);
+
+class DualQuaternionSkinningTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+
+        const uint numVertices = 5000;
+        WeightMatrix weights;
+        Pose pose;
+        Vector3Array input;
+        makeSkinningData( numVertices, 20, weights, pose, input );
+        Vector3Array normals( numVertices );
+        for (uint i = 0; i < numVertices; ++i)
+        {
+            normals[i] = Vector3::Random().normalized();
+        }
+
+        // Reference: blended dual quaternions applied one vertex at a time.
+        DQList DQ;
+        computeDQ_naive( pose, weights, DQ );
+        Vector3Array expected;
+        Vector3Array expectedNormals( numVertices );
+        dualQuaternionSkinning( input, DQ, expected );
+        for (uint i = 0; i < numVertices; ++i)
+        {
+            expectedNormals[i] = DQ[i].rotate( normals[i] );
+        }
+
+        TaskQueue queue( 3, TaskQueue::SchedulingMode::WORK_STEALING );
+        setParallelForTaskQueue( &queue );
+
+        PackedWeights packed;
+        packWeights( weights, 8, packed );
+        Vector3Array output;
+        Vector3Array outputNormals;
+        dualQuaternionSkinning( input, normals, pose, packed, output, outputNormals );
+        RA_UNIT_TEST( maxError( expected, output ) < 1e-4f, "SoA DQS gives wrong positions" );
+        RA_UNIT_TEST( maxError( expectedNormals, outputNormals ) < 1e-4f, "SoA DQS gives wrong normals" );
+
+        // Normals are optional.
+        output.clear();
+        outputNormals.clear();
+        dualQuaternionSkinning( input, Vector3Array(), pose, packed, output, outputNormals );
+        RA_UNIT_TEST( maxError( expected, output ) < 1e-4f, "SoA DQS without normals gives wrong positions" );
+        RA_UNIT_TEST( outputNormals.empty(), "Normals should not be computed" );
+
+        setParallelForTaskQueue( nullptr );
+    }
+};
+
+RA_TEST_CLASS(DualQuaternionSkinningTests);
+
+class IncrementalSkinningTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::Animation;
+
+        const uint numVertices = 5000;
+        const uint numBones = 20;
+        WeightMatrix weights;
+        Pose pose;
+        Vector3Array input;
+        makeSkinningData( numVertices, numBones, weights, pose, input );
+        Vector3Array normals( numVertices, Vector3::UnitX() );
+        PackedWeights packed;
+        packWeights( weights, 8, packed );
+
+        // Move one bone.
+        const uint moved = 7;
+        Pose newPose = pose;
+        newPose[moved].translate( Vector3( 0.5f, 0, 0 ) );
+
+        std::vector<uint> changed;
+        getChangedHandles( pose, newPose, changed );
+        RA_UNIT_TEST( changed.size() == 1 && changed[0] == moved, "Wrong changed handles" );
+
+        VertexRangeList ranges;
+        getInfluencedRanges( weights, changed, 0, ranges );
+        bool sorted = true;
+        for (uint r = 0; r < ranges.size(); ++r)
+        {
+            sorted = sorted && ranges[r].first < ranges[r].second;
+            sorted = sorted && ( r == 0 || ranges[r - 1].second < ranges[r].first );
+        }
+        RA_UNIT_TEST( sorted, "Ranges should be sorted and disjoint" );
+        bool covered = true;
+        for (WeightMatrix::InnerIterator it( weights, moved ); it; ++it)
+        {
+            bool inRange = false;
+            for (const auto& r : ranges)
+            {
+                inRange = inRange || ( uint( it.row() ) >= r.first && uint( it.row() ) < r.second );
+            }
+            covered = covered && inRange;
+        }
+        RA_UNIT_TEST( covered, "Influenced vertices should be in the ranges" );
+        RA_UNIT_TEST( getRangesSize( ranges ) == uint( weights.col( moved ).nonZeros() ),
+                      "Ranges should only contain influenced vertices" );
+
+        VertexRangeList merged;
+        getInfluencedRanges( weights, changed, 100, merged );
+        RA_UNIT_TEST( merged.size() <= ranges.size() && getRangesSize( merged ) >= getRangesSize( ranges ),
+                      "Merged ranges should be fewer and larger" );
+
+        TaskQueue queue( 3, TaskQueue::SchedulingMode::WORK_STEALING );
+        setParallelForTaskQueue( &queue );
+
+        // Skinning the ranges of the previous result gives the full skinning.
+        Vector3Array expected;
+        Vector3Array expectedNormals;
+        Vector3Array output;
+        Vector3Array outputNormals;
+        linearBlendSkinning( input, newPose, packed, expected );
+        linearBlendSkinning( input, pose, packed, output );
+        linearBlendSkinning( input, newPose, packed, merged, output );
+        RA_UNIT_TEST( maxError( expected, output ) < 1e-5f, "Incremental LBS differs from full LBS" );
+
+        dualQuaternionSkinning( input, normals, newPose, packed, expected, expectedNormals );
+        dualQuaternionSkinning( input, normals, pose, packed, output, outputNormals );
+        dualQuaternionSkinning( input, normals, newPose, packed, merged, output, outputNormals );
+        RA_UNIT_TEST( maxError( expected, output ) < 1e-5f, "Incremental DQS differs from full DQS" );
+        RA_UNIT_TEST( maxError( expectedNormals, outputNormals ) < 1e-5f, "Incremental DQS normals differ" );
+
+        // Updating the dual quaternions of the ranges gives the full computation.
+        DQList expectedDQ;
+        DQList outputDQ;
+        computeDQ( newPose, weights, expectedDQ );
+        computeDQ( pose, weights, outputDQ );
+        computeDQ( newPose, packed, merged, outputDQ );
+        Scalar dqError = 0;
+        for (uint i = 0; i < numVertices; ++i)
+        {
+            dqError = std::max( dqError, ( expectedDQ[i].getQ0().coeffs() - outputDQ[i].getQ0().coeffs() ).cwiseAbs().maxCoeff() );
+            dqError = std::max( dqError, ( expectedDQ[i].getQe().coeffs() - outputDQ[i].getQe().coeffs() ).cwiseAbs().maxCoeff() );
+        }
+        RA_UNIT_TEST( dqError < 1e-5f, "Incremental dual quaternions differ" );
+
+        // Updating the normals around the ranges gives the normals of the whole mesh. Triangles
+        // join each vertex to the next one and to a far one (some of them are degenerate).
+        VectorArray<Triangle> triangles;
+        for (uint i = 0; i + 1 < numVertices; ++i)
+        {
+            triangles.push_back( Triangle( i, i + 1, ( i * 7919 ) % numVertices ) );
+        }
+        const Geometry::TVAdj adj = Geometry::triangleUniformAdjacency( input, triangles );
+        VertexRangeList normalRanges;
+        getNormalRanges( adj, triangles, ranges, 0, normalRanges );
+        RA_UNIT_TEST( getRangesSize( normalRanges ) > getRangesSize( ranges ), "Normal ranges should include the neighbors" );
+
+        linearBlendSkinning( input, newPose, packed, expected );
+        Geometry::uniformNormal( expected, triangles, expectedNormals );
+        linearBlendSkinning( input, pose, packed, output );
+        Geometry::uniformNormal( output, triangles, outputNormals );
+        linearBlendSkinning( input, newPose, packed, ranges, output );
+        uniformNormal( output, triangles, adj, normalRanges, outputNormals );
+        RA_UNIT_TEST( maxError( expectedNormals, outputNormals ) < 1e-5f, "Incremental normals differ from full normals" );
+
+        setParallelForTaskQueue( nullptr );
+    }
+};
+
+RA_TEST_CLASS(IncrementalSkinningTests);
+}
+
+#endif // RADIUM_SKINNING_TESTS_HPP_
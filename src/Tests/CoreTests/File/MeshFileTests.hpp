@@ -0,0 +1,253 @@
+#ifndef RADIUM_MESH_FILE_TESTS_HPP_
+#define RADIUM_MESH_FILE_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Utils/File/OBJFileManager.hpp>
+#include <Core/Utils/File/OFFFileManager.hpp>
+#include <Core/Utils/File/TextParsing.hpp>
+#include <Core/Utils/File/TextWriting.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace RaTests {
+
+class TextParsingTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::TextParsing;
+
+        const char* numbers[] = { "0", "1", "-2.5", "+3.25", "0.001", ".5", "7.", "1e3", "-1.5E-2",
+                                  "123456.789", "3.14159265358979", "1e-30", "6.02214e23", "00012" };
+        for ( const char* n : numbers )
+        {
+            const char* p = n;
+            Scalar value;
+            const bool ok = parseScalar( p, n + std::strlen( n ), value );
+            const Scalar expected = Scalar( std::strtod( n, nullptr ) );
+            RA_UNIT_TEST( ok && p == n + std::strlen( n ), "Number not parsed." );
+            RA_UNIT_TEST( std::abs( value - expected ) <= 1e-6f * std::abs( expected ), "Wrong number." );
+        }
+
+        // Numbers stop at the end of the line.
+        const std::string line = " 1 \t-2\r\n3";
+        const char* p = line.data();
+        const char* end = p + line.size();
+        int a;
+        int b;
+        int c;
+        RA_UNIT_TEST( parseInt( p, end, a ) && parseInt( p, end, b ) && !parseInt( p, end, c ), "Wrong line parsing." );
+        RA_UNIT_TEST( a == 1 && b == -2 && *p == '\n', "Wrong integers." );
+        skipLine( p, end );
+        RA_UNIT_TEST( parseInt( p, end, c ) && c == 3 && p == end, "Wrong next line." );
+
+        Scalar s;
+        const std::string words = "abc - .";
+        p = words.data();
+        RA_UNIT_TEST( !parseScalar( p, p + words.size(), s ) && p == words.data(), "Not a number." );
+
+        // Chunks cover the text and end on line boundaries.
+        std::string text;
+        for ( uint i = 0; i < 1000; ++i )
+        {
+            text += std::string( i % 17, 'x' ) + "\n";
+        }
+        const std::vector<Range> chunks = splitLines( text.data(), text.data() + text.size(), 100 );
+        bool covered = chunks.front().first == text.data() && chunks.back().second == text.data() + text.size();
+        for ( uint i = 0; i < chunks.size(); ++i )
+        {
+            covered = covered && *( chunks[i].second - 1 ) == '\n' && chunks[i].second - chunks[i].first >= 100;
+            covered = covered && ( i == 0 || chunks[i].first == chunks[i - 1].second );
+        }
+        RA_UNIT_TEST( chunks.size() > 10 && covered, "Wrong chunks." );
+    }
+};
+
+class MeshFileTests : public Test
+{
+    /// OBJ and OFF files of a grid of n x n quads, large enough to be parsed in several chunks.
+    static void writeGrids( uint n, const std::string& objName, const std::string& offName )
+    {
+        std::ofstream obj( objName );
+        std::ofstream off( offName );
+        off << "OFF\n" << ( n + 1 ) * ( n + 1 ) << " " << n * n << " 0\n";
+        for ( uint j = 0; j <= n; ++j )
+        {
+            for ( uint i = 0; i <= n; ++i )
+            {
+                obj << "v " << i << " " << j << " 0.5\n";
+                off << i << " " << j << " 0.5\n";
+            }
+        }
+        obj << "vn 0 0 1\n";
+        for ( uint j = 0; j < n; ++j )
+        {
+            for ( uint i = 0; i < n; ++i )
+            {
+                const uint v = j * ( n + 1 ) + i;
+                obj << "f " << v + 1 << "//1 " << v + 2 << "//1 " << v + n + 3 << "//1 " << v + n + 2 << "//1\n";
+                off << "4 " << v << " " << v + 1 << " " << v + n + 2 << " " << v + n + 1 << "\n";
+            }
+        }
+    }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        const std::string objName = "radium_mesh_file_test.obj";
+        const std::string offName = "radium_mesh_file_test.off";
+
+        // Polygons, relative indices, texture coordinates, comments and CRLF line ends.
+        {
+            std::ofstream obj( objName );
+            obj << "# test\r\n"
+                   "v 0 0 0\r\nv 1 0 0\r\nv 1 1 0\r\nv 0 1 0\r\nv 0.5 2 0 # apex\r\n"
+                   "vt 0 0\r\nvt 1 0\r\nvt 1 1\r\nvt 0 1\r\n"
+                   "vn 0 0 1\r\n"
+                   "\r\n"
+                   "f 1/1/1 2/2/1 3/3/1 4/4/1\r\n"
+                   "f -2/-1/-1 -3/-2/-1 -1/-2/-1\r\n";
+        }
+        OBJFileManager objManager;
+        TriangleMesh mesh;
+        RA_UNIT_TEST( objManager.load( objName, mesh ), "OBJ file not loaded." );
+        RA_UNIT_TEST( mesh.m_vertices.size() == 5 && mesh.m_triangles.size() == 3, "Wrong OBJ sizes." );
+        RA_UNIT_TEST( mesh.m_triangles[0] == Triangle( 0, 1, 2 ) && mesh.m_triangles[1] == Triangle( 0, 2, 3 ),
+                      "Quad not triangulated." );
+        RA_UNIT_TEST( mesh.m_triangles[2] == Triangle( 3, 2, 4 ), "Wrong relative indices." );
+        RA_UNIT_TEST( mesh.m_vertices[4].isApprox( Vector3( 0.5f, 2.f, 0.f ) ), "Wrong vertex." );
+        RA_UNIT_TEST( mesh.m_normals.size() == 5 && mesh.m_normals[2] == Vector3( 0, 0, 1 ), "Wrong normals." );
+        RA_UNIT_TEST( objManager.texCoords().size() == 5 && objManager.texCoords()[2] == Vector3( 1, 1, 0 ),
+                      "Wrong texture coordinates." );
+
+        {
+            std::ofstream obj( objName );
+            obj << "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 4\n";
+        }
+        RA_UNIT_TEST( !objManager.load( objName, mesh ), "Invalid OBJ index not detected." );
+
+        {
+            std::ofstream off( offName );
+            off << "OFF\n# comment\n4 2 0\n0 0 0\n1 0 0\n1 1 0\n0 1 0\n4 0 1 2 3\n3 0 2 3 255 0 0\n";
+        }
+        OFFFileManager offManager;
+        RA_UNIT_TEST( offManager.load( offName, mesh ), "OFF file not loaded." );
+        RA_UNIT_TEST( mesh.m_vertices.size() == 4 && mesh.m_triangles.size() == 3, "Wrong OFF sizes." );
+        RA_UNIT_TEST( mesh.m_triangles[1] == Triangle( 0, 2, 3 ) && mesh.m_triangles[2] == Triangle( 0, 2, 3 ),
+                      "Wrong OFF faces." );
+
+        {
+            std::ofstream off( offName );
+            off << "OFF\n4 2 0\n0 0 0\n1 0 0\n1 1 0\n0 1 0\n3 0 1 2\n";
+        }
+        RA_UNIT_TEST( !offManager.load( offName, mesh ), "Missing OFF face not detected." );
+
+        // Files parsed in several chunks.
+        const uint n = 150;
+        writeGrids( n, objName, offName );
+        TriangleMesh objMesh;
+        TriangleMesh offMesh;
+        RA_UNIT_TEST( objManager.load( objName, objMesh ), "Large OBJ file not loaded." );
+        RA_UNIT_TEST( offManager.load( offName, offMesh ), "Large OFF file not loaded." );
+        RA_UNIT_TEST( objMesh.m_vertices.size() == ( n + 1 ) * ( n + 1 ) && objMesh.m_triangles.size() == 2 * n * n,
+                      "Wrong OBJ grid sizes." );
+        RA_UNIT_TEST( offMesh.m_vertices == objMesh.m_vertices && offMesh.m_triangles == objMesh.m_triangles,
+                      "OBJ and OFF grids differ." );
+        const uint last = 2 * n * n - 1;
+        const uint lastVertex = n * ( n + 1 ) - 2;
+        RA_UNIT_TEST( objMesh.m_triangles[last] == Triangle( lastVertex, lastVertex + n + 2, lastVertex + n + 1 ),
+                      "Wrong last triangle." );
+        RA_UNIT_TEST( objMesh.m_vertices.back() == Vector3( n, n, 0.5f ), "Wrong last vertex." );
+        RA_UNIT_TEST( objMesh.m_normals.size() == objMesh.m_vertices.size(), "Wrong grid normals." );
+
+        std::remove( objName.c_str() );
+        std::remove( offName.c_str() );
+    }
+};
+
+class MeshExportTests : public Test
+{
+    static std::string readFile( const std::string& name )
+    {
+        std::ifstream file( name );
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::TextWriting;
+
+        const std::pair<Scalar, std::string> numbers[] = {
+            { 0.f, "0" }, { 1.f, "1" }, { -2.5f, "-2.5" }, { 0.1234567f, "0.123457" }, { -1e-7f, "0" },
+            { 0.9999999f, "1" }, { 123456.f, "123456" }, { 0.001f, "0.001" }, { 1e13f, "1e+13" } };
+        for ( const auto& n : numbers )
+        {
+            char buffer[MAX_NUMBER_SIZE];
+            char* end = writeScalar( buffer, n.first );
+            RA_UNIT_TEST( std::string( buffer, end ) == n.second, ( "Wrong text for " + n.second ).c_str() );
+        }
+        char buffer[MAX_NUMBER_SIZE];
+        RA_UNIT_TEST( std::string( buffer, writeUint( buffer, 0 ) ) == "0", "Wrong text for 0." );
+        RA_UNIT_TEST( std::string( buffer, writeUint( buffer, 4294967295u ) ) == "4294967295", "Wrong uint text." );
+
+        // A mesh large enough to be written in several blocks.
+        TriangleMesh mesh;
+        const uint n = 200;
+        for ( uint i = 0; i < n * n; ++i )
+        {
+            mesh.m_vertices.push_back( Vector3( Scalar( i % n ) / 7, Scalar( i / n ) / 3, -0.25f * i ) );
+            mesh.m_normals.push_back( Vector3( 0, 0, 1 ) );
+        }
+        for ( uint i = 0; i + n + 1 < n * n; ++i )
+        {
+            mesh.m_triangles.push_back( Triangle( i, i + 1, i + n + 1 ) );
+        }
+
+        const std::string name = "radium_mesh_export_test";
+        OBJFileManager objManager;
+        OFFFileManager offManager;
+        RA_UNIT_TEST( objManager.save( name, mesh ) && offManager.save( name, mesh ), "Mesh not saved." );
+        const std::string objText = readFile( name + ".obj" );
+        const std::string offText = readFile( name + ".off" );
+
+        TriangleMesh objMesh;
+        TriangleMesh offMesh;
+        RA_UNIT_TEST( objManager.load( name + ".obj", objMesh ) && offManager.load( name + ".off", offMesh ),
+                      "Saved mesh not loaded." );
+        bool same = objMesh.m_vertices.size() == mesh.m_vertices.size() && objMesh.m_triangles == mesh.m_triangles &&
+                    offMesh.m_vertices.size() == mesh.m_vertices.size() && offMesh.m_triangles == mesh.m_triangles &&
+                    objMesh.m_normals == mesh.m_normals;
+        for ( uint i = 0; same && i < mesh.m_vertices.size(); ++i )
+        {
+            same = ( objMesh.m_vertices[i] - mesh.m_vertices[i] ).norm() < 1e-3f &&
+                   ( offMesh.m_vertices[i] - mesh.m_vertices[i] ).norm() < 1e-3f;
+        }
+        RA_UNIT_TEST( same, "Saved mesh differs." );
+
+        // The text does not depend on the number of threads.
+        objManager.setParallelExport( false );
+        offManager.setParallelExport( false );
+        RA_UNIT_TEST( objManager.save( name, mesh ) && offManager.save( name, mesh ), "Mesh not saved." );
+        RA_UNIT_TEST( readFile( name + ".obj" ) == objText && readFile( name + ".off" ) == offText,
+                      "Serial and parallel exports differ." );
+
+        std::remove( ( name + ".obj" ).c_str() );
+        std::remove( ( name + ".off" ).c_str() );
+    }
+};
+
+RA_TEST_CLASS(TextParsingTests);
+RA_TEST_CLASS(MeshFileTests);
+RA_TEST_CLASS(MeshExportTests);
+}
+
+#endif // RADIUM_MESH_FILE_TESTS_HPP_
@@ -0,0 +1,151 @@
+#ifndef RADIUM_LOG_TESTS_HPP_
+#define RADIUM_LOG_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Log/LogQueue.hpp>
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RaTests {
+
+class LogQueueTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        const uint numThreads = 4;
+        const uint numMessages = 2000;
+
+        FILE* file = std::tmpfile();
+        RA_UNIT_TEST( file != nullptr, "Cannot create a temporary file." );
+        if ( !file )
+        {
+            return;
+        }
+
+        // A small queue, so that some messages are dropped.
+        uint numPushed = 0;
+        {
+            LogQueue queue( 64 );
+            std::vector<std::thread> threads;
+            std::vector<uint> pushed( numThreads, 0 );
+            for ( uint t = 0; t < numThreads; ++t )
+            {
+                threads.emplace_back( [&queue, &pushed, file, t, numMessages]()
+                {
+                    char text[32];
+                    for ( uint i = 0; i < numMessages; ++i )
+                    {
+                        const int length = std::snprintf( text, sizeof( text ), "T%u %u\n", t, i );
+                        pushed[t] += queue.push( file, text, length ) ? 1 : 0;
+                    }
+                } );
+            }
+            for ( auto& thread : threads )
+            {
+                thread.join();
+            }
+            queue.flush();
+
+            for ( uint t = 0; t < numThreads; ++t )
+            {
+                numPushed += pushed[t];
+            }
+            RA_UNIT_TEST( numPushed + queue.getNumDropped() == numThreads * numMessages,
+                          "Messages must be either queued or dropped." );
+        }
+
+        // Read back the file : each line is "- time T<thread> <index>".
+        std::rewind( file );
+        std::vector<int> lastIndex( numThreads, -1 );
+        uint numRead = 0;
+        bool ordered = true;
+        char line[256];
+        while ( std::fgets( line, sizeof( line ), file ) )
+        {
+            const char* msg = std::strstr( line, " T" );
+            uint t;
+            uint i;
+            if ( msg && std::sscanf( msg, " T%u %u", &t, &i ) == 2 && t < numThreads )
+            {
+                ordered = ordered && int( i ) > lastIndex[t];
+                lastIndex[t] = i;
+                ++numRead;
+            }
+        }
+        std::fclose( file );
+
+        RA_UNIT_TEST( numRead == numPushed, "All the queued messages must be written." );
+        RA_UNIT_TEST( ordered, "Messages of a thread must be written in order." );
+
+        // Messages longer than a slot are written whole.
+        file = std::tmpfile();
+        RA_UNIT_TEST( file != nullptr, "Cannot create a temporary file." );
+        if ( !file )
+        {
+            return;
+        }
+        const std::string longText = std::string( 3 * LogQueue::SLOT_SIZE, 'a' ) + "\n" + std::string( 10, 'b' ) + "\n";
+        {
+            LogQueue queue( 4 );
+            RA_UNIT_TEST( queue.push( file, "short\n", 6 ), "Message dropped." );
+            RA_UNIT_TEST( queue.push( file, longText.data(), uint( longText.size() ) ), "Message dropped." );
+            queue.flush();
+        }
+        std::string written( 8 * LogQueue::SLOT_SIZE, '\0' );
+        std::rewind( file );
+        written.resize( std::fread( &written[0], 1, written.size(), file ) );
+        std::fclose( file );
+        RA_UNIT_TEST( written.find( longText ) != std::string::npos, "Long message must not be cut." );
+        RA_UNIT_TEST( written.find( "short\n" ) != std::string::npos, "Short message must be written." );
+    }
+};
+
+class LogLineTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        LogLine* line = LogLine::acquire();
+        line->stream() << "value " << 42 << ' ' << std::hex << 255;
+        line->finish();
+        RA_UNIT_TEST( std::string( line->data(), line->size() ) == "value 42 ff\n", "Wrong message." );
+        LogLine::release( line );
+
+        // Lines are reused with the default format.
+        line = LogLine::acquire();
+        line->stream() << 255;
+        line->finish();
+        RA_UNIT_TEST( std::string( line->data(), line->size() ) == "255\n", "Manipulators must be reset." );
+
+        // A message logged while another one is formatted uses another line.
+        LogLine* other = LogLine::acquire();
+        RA_UNIT_TEST( other != line, "Lines must not be shared." );
+        LogLine::release( other );
+        LogLine::release( line );
+
+        // Long messages are kept whole, and the line goes back to its buffer afterwards.
+        const std::string longText = std::string( 2 * LogQueue::SLOT_SIZE, 'a' ) + "\n" + std::string( 100, 'b' );
+        line = LogLine::acquire();
+        line->stream() << longText << 42;
+        line->finish();
+        RA_UNIT_TEST( std::string( line->data(), line->size() ) == longText + "42\n", "Long message must not be cut." );
+        LogLine::release( line );
+        line = LogLine::acquire();
+        line->stream() << "short";
+        line->finish();
+        RA_UNIT_TEST( std::string( line->data(), line->size() ) == "short\n", "Wrong message after a long one." );
+        LogLine::release( line );
+    }
+};
+
+RA_TEST_CLASS(LogQueueTests);
+RA_TEST_CLASS(LogLineTests);
+}
+
+#endif // RADIUM_LOG_TESTS_HPP_
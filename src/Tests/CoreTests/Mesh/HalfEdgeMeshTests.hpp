@@ -0,0 +1,181 @@
+#ifndef RADIUM_HALFEDGE_MESH_TESTS_HPP_
+#define RADIUM_HALFEDGE_MESH_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Mesh/DCEL/HalfEdgeMesh.hpp>
+#include <Core/Mesh/DCEL/Operations/EdgeSplit.hpp>
+#include <Core/Mesh/Wrapper/Convert.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Algorithm/Subdivision/FullEdgeOperation.hpp>
+
+namespace RaTests {
+
+class HalfEdgeMeshTests : public Test
+{
+    /// Euler characteristic of the mesh, 2 for a sphere and 1 for a disk.
+    static int euler( const Ra::Core::HalfEdgeMesh& mesh )
+    {
+        return int( mesh.getNumVertices() ) - int( mesh.getNumEdges() ) + int( mesh.getNumFaces() );
+    }
+
+    /// Return true if the circulators give the same elements as the links of the halfedges.
+    static bool checkCirculators( const Ra::Core::HalfEdgeMesh& mesh )
+    {
+        using namespace Ra::Core;
+        bool ok = true;
+        uint valences = 0;
+        for (VertexIdx v = 0; v < mesh.getVertexCapacity(); ++v)
+        {
+            if ( mesh.isDeletedVertex( v ) )
+            {
+                continue;
+            }
+            valences += mesh.valence( v );
+            for (HalfEdgeIdx he : mesh.vertexHalfEdges( v ))
+            {
+                ok = ok && ( mesh.getVertex( he ) == v );
+            }
+            auto it = mesh.vertexVertices( v ).begin();
+            for (FaceIdx f : mesh.vertexFaces( v ))
+            {
+                ok = ok && ( *it == mesh.getEndVertex( it.halfEdge() ) ) && ( f == mesh.getFace( it.halfEdge() ) );
+                ++it;
+            }
+        }
+        for (FaceIdx f = 0; f < mesh.getFaceCapacity(); ++f)
+        {
+            if ( mesh.isDeletedFace( f ) )
+            {
+                continue;
+            }
+            auto it = mesh.faceVertices( f ).begin();
+            for (HalfEdgeIdx he : mesh.faceHalfEdges( f ))
+            {
+                ok = ok && ( mesh.getFace( he ) == f ) && ( *it == mesh.getVertex( he ) );
+                ++it;
+            }
+        }
+        return ok && ( valences == 2 * mesh.getNumEdges() );
+    }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        // Closed mesh, and round trip.
+        const TriangleMesh sphere = MeshUtils::makeGeodesicSphere( 1.f, 0 );
+        HalfEdgeMesh mesh;
+        convert( sphere, mesh );
+        RA_UNIT_TEST( mesh.checkConsistency(), "Inconsistent mesh" );
+        RA_UNIT_TEST( mesh.getNumVertices() == sphere.m_vertices.size(), "Wrong number of vertices" );
+        RA_UNIT_TEST( mesh.getNumFaces() == sphere.m_triangles.size(), "Wrong number of faces" );
+        RA_UNIT_TEST( 2 * mesh.getNumEdges() == 3 * mesh.getNumFaces(), "Edges not paired" );
+        RA_UNIT_TEST( euler( mesh ) == 2, "Wrong topology of the sphere" );
+        RA_UNIT_TEST( checkCirculators( mesh ), "Wrong circulation" );
+
+        TriangleMesh back;
+        convert( mesh, back );
+        RA_UNIT_TEST( back.m_vertices == sphere.m_vertices && back.m_triangles == sphere.m_triangles, "Round trip changed the mesh" );
+
+        // Split all the edges once: the triangles are divided in 4.
+        const uint numEdges = mesh.getEdgeCapacity();
+        const uint numVertices = mesh.getNumVertices();
+        const uint numFaces = mesh.getNumFaces();
+        for (EdgeIdx e = 0; e < numEdges; ++e)
+        {
+            const VertexIdx v = fulledgeSplit( mesh, e );
+            RA_UNIT_TEST( v == numVertices + e, "New vertex not appended" );
+            RA_UNIT_TEST( mesh.getEndVertex( mesh.getEdgeHalfEdge( e, 0 ) ) == v, "Wrong vertex of the split edge" );
+        }
+        RA_UNIT_TEST( mesh.checkConsistency(), "Inconsistent mesh after the splits" );
+        RA_UNIT_TEST( mesh.getNumFaces() == 4 * numFaces, "Wrong number of faces after the splits" );
+        RA_UNIT_TEST( euler( mesh ) == 2, "Splits changed the topology" );
+        RA_UNIT_TEST( checkCirculators( mesh ), "Wrong circulation after the splits" );
+
+        // Collapses, the deleted elements being reused.
+        const uint before = mesh.getNumVertices();
+        const EdgeIdx e = 0;
+        const VertexIdx removed = mesh.getEndVertex( mesh.getEdgeHalfEdge( e, 0 ) );
+        RA_UNIT_TEST( fulledgeCollapse( mesh, e ), "Collapse rejected" );
+        RA_UNIT_TEST( mesh.checkConsistency(), "Inconsistent mesh after the collapse" );
+        RA_UNIT_TEST( mesh.getNumVertices() == before - 1 && mesh.isDeletedVertex( removed ), "Vertex not deleted" );
+        RA_UNIT_TEST( euler( mesh ) == 2, "Collapse changed the topology" );
+        RA_UNIT_TEST( checkCirculators( mesh ), "Wrong circulation after the collapse" );
+        uint collapsed = 1;
+        for (EdgeIdx i = 1; i < mesh.getEdgeCapacity() && collapsed < 50; i += 7)
+        {
+            if ( !mesh.isDeletedEdge( i ) && fulledgeCollapse( mesh, i ) )
+            {
+                ++collapsed;
+            }
+        }
+        RA_UNIT_TEST( mesh.checkConsistency() && euler( mesh ) == 2, "Inconsistent mesh after the collapses" );
+        RA_UNIT_TEST( mesh.getNumVertices() == before - collapsed, "Wrong number of vertices after the collapses" );
+        const uint capacity = mesh.getVertexCapacity();
+        EdgeIdx live = 0;
+        while ( mesh.isDeletedEdge( live ) )
+        {
+            ++live;
+        }
+        const VertexIdx reused = fulledgeSplit( mesh, live );
+        RA_UNIT_TEST( reused < capacity && mesh.getVertexCapacity() == capacity, "Deleted vertex not reused" );
+        RA_UNIT_TEST( mesh.checkConsistency() && euler( mesh ) == 2, "Inconsistent mesh after reusing the elements" );
+
+        convert( mesh, back );
+        RA_UNIT_TEST( back.m_vertices.size() == mesh.getNumVertices() && back.m_triangles.size() == mesh.getNumFaces(),
+                      "Deleted elements converted" );
+
+        // Open mesh: border loops and operations on the border.
+        const TriangleMesh grid = MeshUtils::makePlaneGrid( 4, 4 );
+        convert( grid, mesh );
+        RA_UNIT_TEST( mesh.checkConsistency(), "Inconsistent open mesh" );
+        RA_UNIT_TEST( euler( mesh ) == 1, "Wrong topology of the grid" );
+        RA_UNIT_TEST( checkCirculators( mesh ), "Wrong circulation on the grid" );
+        uint borderEdges = 0;
+        uint borderVertices = 0;
+        for (EdgeIdx i = 0; i < mesh.getEdgeCapacity(); ++i)
+        {
+            borderEdges += mesh.isBoundaryEdge( i ) ? 1 : 0;
+        }
+        for (VertexIdx v = 0; v < mesh.getVertexCapacity(); ++v)
+        {
+            borderVertices += mesh.isBoundaryVertex( v ) ? 1 : 0;
+        }
+        RA_UNIT_TEST( borderEdges == borderVertices && borderEdges == 16, "Wrong border of the grid" );
+
+        for (EdgeIdx i = 0; i < mesh.getEdgeCapacity(); ++i)
+        {
+            if ( mesh.isBoundaryEdge( i ) )
+            {
+                const uint faces = mesh.getNumFaces();
+                const VertexIdx v = fulledgeSplit( mesh, i );
+                RA_UNIT_TEST( mesh.isBoundaryVertex( v ) && mesh.getNumFaces() == faces + 1, "Wrong split of a border edge" );
+                break;
+            }
+        }
+        RA_UNIT_TEST( mesh.checkConsistency() && euler( mesh ) == 1, "Inconsistent grid after the split" );
+
+        // A quad: the diagonal joins two border vertices. Collapsing a border edge leaves a
+        // triangle, whose edges cannot be collapsed.
+        convert( MeshUtils::makePlaneGrid( 1, 1 ), mesh );
+        EdgeIdx diagonal = 0;
+        while ( mesh.isBoundaryEdge( diagonal ) )
+        {
+            ++diagonal;
+        }
+        RA_UNIT_TEST( !fulledgeCollapse( mesh, diagonal ), "Collapse of the diagonal should be rejected" );
+        RA_UNIT_TEST( fulledgeCollapse( mesh, ( diagonal + 1 ) % 5 ), "Collapse of a border edge rejected" );
+        RA_UNIT_TEST( mesh.checkConsistency() && mesh.getNumFaces() == 1 && mesh.getNumEdges() == 3, "Wrong triangle" );
+        bool rejected = true;
+        for (EdgeIdx i = 0; i < mesh.getEdgeCapacity(); ++i)
+        {
+            rejected = rejected && ( mesh.isDeletedEdge( i ) || !fulledgeCollapse( mesh, i ) );
+        }
+        RA_UNIT_TEST( rejected && mesh.checkConsistency() && mesh.getNumFaces() == 1, "Collapse should be rejected" );
+    }
+};
+
+RA_TEST_CLASS(HalfEdgeMeshTests);
+}
+
+#endif // RADIUM_HALFEDGE_MESH_TESTS_HPP_
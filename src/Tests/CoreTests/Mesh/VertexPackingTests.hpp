@@ -0,0 +1,88 @@
+#ifndef RADIUM_VERTEX_PACKING_TESTS_HPP_
+#define RADIUM_VERTEX_PACKING_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Mesh/VertexPacking.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace RaTests {
+
+class VertexPackingTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Core::VertexPacking;
+
+        std::mt19937 gen( 5 );
+        std::uniform_real_distribution<Scalar> dist( -1.f, 1.f );
+
+        // Unit vectors are kept within the precision of 10 bits.
+        Vector3Array normals;
+        for (uint i = 0; i < 1000; ++i)
+        {
+            normals.push_back( Vector3( dist( gen ), dist( gen ), dist( gen ) ).normalized() );
+        }
+        normals.push_back( Vector3( 1, -1, 0 ) );
+
+        bool normalsOk = true;
+        for (const auto& n : normals)
+        {
+            normalsOk = normalsOk && ( unpackSnorm1010102( packSnorm1010102( n ) ) - n ).cwiseAbs().maxCoeff() <= 0.51f / 511;
+        }
+        RA_UNIT_TEST( normalsOk, "10-10-10-2 packing error too large" );
+        RA_UNIT_TEST( unpackSnorm1010102( packSnorm1010102( Vector3( 2, -2, 0 ) ) ).isApprox( Vector3( 1, -1, 0 ) ),
+                      "10-10-10-2 packing does not clamp" );
+        RA_UNIT_TEST( ( packSnorm1010102( Vector3::Zero(), -1 ) >> 30 ) == 3, "Wrong w component" );
+
+        // Half floats : exact for small integers and dyadic fractions, 11 bits of precision otherwise.
+        bool halfOk = true;
+        for (float f : { 0.f, 1.f, -2.f, 0.5f, 0.25f, 1024.f, 65504.f })
+        {
+            halfOk = halfOk && unpackHalf( packHalf( f ) ) == f;
+        }
+        for (uint i = 0; i < 1000; ++i)
+        {
+            const float f = 10.f * float( dist( gen ) );
+            halfOk = halfOk && std::abs( unpackHalf( packHalf( f ) ) - f ) <= std::abs( f ) / 2048;
+        }
+        RA_UNIT_TEST( halfOk, "Half float conversion error too large" );
+        RA_UNIT_TEST( std::isinf( unpackHalf( packHalf( 1e6f ) ) ), "Large values should become infinity" );
+        RA_UNIT_TEST( unpackHalf( packHalf( 1e-6f ) ) == 0.f, "Tiny values should be flushed to zero" );
+
+        const Vector4 color( 0.f, 1.f, 0.5f, 0.2f );
+        RA_UNIT_TEST( ( unpackUnorm8888( packUnorm8888( color ) ) - color ).cwiseAbs().maxCoeff() <= 0.51f / 255,
+                      "8 bits color packing error too large" );
+
+        // The array versions write the same values in an interleaved buffer.
+        const uint stride = 12;
+        std::vector<char> buffer( normals.size() * stride );
+        packSnorm1010102( normals.data(), normals.size(), buffer.data() + 4, stride );
+        packHalf2( normals.data(), normals.size(), buffer.data() + 8, stride );
+        bool arraysOk = true;
+        for (uint i = 0; i < normals.size(); ++i)
+        {
+            uint p;
+            ushort h[2];
+            std::memcpy( &p, buffer.data() + i * stride + 4, sizeof( p ) );
+            std::memcpy( h, buffer.data() + i * stride + 8, sizeof( h ) );
+            arraysOk = arraysOk && p == packSnorm1010102( normals[i] )
+                       && h[0] == packHalf( float( normals[i].x() ) ) && h[1] == packHalf( float( normals[i].y() ) );
+        }
+        RA_UNIT_TEST( arraysOk, "Array packing differs from single values" );
+
+        VectorArray<Triangle> triangles;
+        triangles.push_back( Triangle( 0, 1, 65535 ) );
+        ushort indices[3];
+        packIndices16( triangles, indices );
+        RA_UNIT_TEST( indices[0] == 0 && indices[1] == 1 && indices[2] == 65535, "Wrong 16 bits indices" );
+    }
+};
+
+RA_TEST_CLASS(VertexPackingTests);
+}
+
+#endif // RADIUM_VERTEX_PACKING_TESTS_HPP_
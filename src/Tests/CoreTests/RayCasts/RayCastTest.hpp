@@ -3,6 +3,11 @@
 
 #include <Tests/CoreTests/Tests.hpp>
 #include <Core/Math/RayCast.hpp>
+#include <Core/Mesh/MeshPrimitives.hpp>
+#include <Core/Mesh/MeshUtils.hpp>
+#include <Core/TreeStructures/TriangleMeshBVH.hpp>
+
+#include <random>
 
 namespace RaTests {
 
@@ -80,6 +85,92 @@ class RayCastAabbTests : public Test
     }
 };
     RA_TEST_CLASS(RayCastAabbTests);
+
+class RayCastMeshTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+
+        // Two overlapping spheres, so that rays can hit several triangles.
+        TriangleMesh mesh = MeshUtils::makeGeodesicSphere( 1.f, 4 );
+        const TriangleMesh other = MeshUtils::makeGeodesicSphere( 0.5f, 3 );
+        const uint offset = mesh.m_vertices.size();
+        for (const auto& v : other.m_vertices)
+        {
+            mesh.m_vertices.push_back( v + Vector3( 0.8f, 0, 0 ) );
+        }
+        for (const auto& t : other.m_triangles)
+        {
+            mesh.m_triangles.push_back( t + Triangle( offset, offset, offset ) );
+        }
+
+        TriangleMeshBVH bvh;
+        bvh.build( mesh );
+        RA_UNIT_TEST( !bvh.isEmpty() && bvh.getNumTriangles() == mesh.m_triangles.size(), "BVH not built" );
+        checkRays( mesh, bvh );
+
+        // Move the vertices and refit the hierarchy.
+        for (auto& v : mesh.m_vertices)
+        {
+            v = v * 1.5f + Vector3( 0, 2, 0 );
+        }
+        bvh.refit( mesh );
+        checkRays( mesh, bvh );
+    }
+
+    void checkRays( const Ra::Core::TriangleMesh& mesh, const Ra::Core::TriangleMeshBVH& bvh )
+    {
+        using namespace Ra::Core;
+        const Vector3 center = MeshUtils::getAabb( mesh ).center();
+        std::mt19937 gen( 17 );
+        std::uniform_real_distribution<Scalar> dist( -1.f, 1.f );
+
+        bool sameHits = true;
+        bool sameAnyHits = true;
+        bool shortAnyHits = true;
+        for (uint i = 0; i < 500; ++i)
+        {
+            const Vector3 origin = center + 4.f * Vector3( dist( gen ), dist( gen ), dist( gen ) ).normalized();
+            const Vector3 target = center + 1.5f * Vector3( dist( gen ), dist( gen ), dist( gen ) );
+            const Ray ray( origin, ( target - origin ).normalized() );
+
+            const MeshUtils::RayCastResult linear = MeshUtils::castRay( mesh, ray );
+            const MeshUtils::RayCastResult fast = MeshUtils::castRay( mesh, bvh, ray );
+
+            // Both should hit the same triangle, or triangles at the same distance (shared edges).
+            Scalar tLinear = -1;
+            Scalar tFast = -1;
+            if ( linear.m_hitTriangle >= 0 && fast.m_hitTriangle >= 0 )
+            {
+                tLinear = hitDistance( mesh, ray, linear.m_hitTriangle );
+                tFast = hitDistance( mesh, ray, fast.m_hitTriangle );
+            }
+            sameHits = sameHits && ( linear.m_hitTriangle == fast.m_hitTriangle
+                                     || ( linear.m_hitTriangle >= 0 && fast.m_hitTriangle >= 0
+                                          && std::abs( tLinear - tFast ) < 1e-4f ) );
+
+            sameAnyHits = sameAnyHits && ( bvh.anyHit( mesh, ray ) == ( linear.m_hitTriangle >= 0 ) );
+            if ( fast.m_hitTriangle >= 0 )
+            {
+                shortAnyHits = shortAnyHits && !bvh.anyHit( mesh, ray, tFast * 0.99f );
+            }
+        }
+        RA_UNIT_TEST( sameHits, "BVH closest hit differs from the linear ray cast" );
+        RA_UNIT_TEST( sameAnyHits, "BVH any hit differs from the linear ray cast" );
+        RA_UNIT_TEST( shortAnyHits, "BVH any hit should ignore hits beyond maxT" );
+    }
+
+    static Scalar hitDistance( const Ra::Core::TriangleMesh& mesh, const Ra::Core::Ray& ray, int triangle )
+    {
+        std::array<Ra::Core::Vector3, 3> v;
+        Ra::Core::MeshUtils::getTriangleVertices( mesh, triangle, v );
+        std::vector<Scalar> hits;
+        Ra::Core::RayCast::vsTriangle( ray, v[0], v[1], v[2], hits );
+        return hits.empty() ? -1 : hits[0];
+    }
+};
+    RA_TEST_CLASS(RayCastMeshTests);
 }
 
 
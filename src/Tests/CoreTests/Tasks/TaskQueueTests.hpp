@@ -0,0 +1,321 @@
+#ifndef RADIUM_TASKQUEUE_TESTS_HPP_
+#define RADIUM_TASKQUEUE_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Tasks/Task.hpp>
+#include <Core/Tasks/TaskQueue.hpp>
+#include <Core/Tasks/ParallelFor.hpp>
+#include <Core/Tasks/ParallelForTask.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace RaTests {
+
+/// Records the order in which it has been executed.
+class OrderTask : public Ra::Core::Task
+{
+public:
+    OrderTask( std::atomic<uint>* counter, uint* order ) : m_counter( counter ), m_order( order ) {}
+    virtual std::string getName() const override { return "OrderTask"; }
+    virtual void process() override { *m_order = (*m_counter)++; }
+
+private:
+    std::atomic<uint>* m_counter;
+    uint* m_order;
+};
+
+/// Runs a function, under a given name.
+class FunctionTask : public Ra::Core::Task
+{
+public:
+    FunctionTask( const std::string& name, const std::function<void()>& func ) : m_name( name ), m_func( func ) {}
+    virtual std::string getName() const override { return m_name; }
+    virtual void process() override { m_func(); }
+
+private:
+    std::string m_name;
+    std::function<void()> m_func;
+};
+
+class TaskQueueTests : public Test
+{
+    void run() override
+    {
+        using Ra::Core::TaskQueue;
+        for (auto mode : { TaskQueue::SchedulingMode::SHARED_QUEUE, TaskQueue::SchedulingMode::WORK_STEALING })
+        {
+            TaskQueue queue( 4, mode );
+            const uint numChains = 64;
+            std::atomic<uint> counter( 0 );
+            std::vector<uint> order( 3 * numChains, uint( -1 ) );
+            for (uint frame = 0; frame < 20; ++frame)
+            {
+                // Build a new graph every 5 frames, run the same one otherwise.
+                if ( frame % 5 == 0 )
+                {
+                    queue.flushTaskQueue();
+                    for (uint i = 0; i < numChains; ++i)
+                    {
+                        auto a = queue.registerTask( new OrderTask( &counter, &order[3 * i] ) );
+                        auto b = queue.registerTask( new OrderTask( &counter, &order[3 * i + 1] ) );
+                        auto c = queue.registerTask( new OrderTask( &counter, &order[3 * i + 2] ) );
+                        queue.addDependency( a, b );
+                        queue.addDependency( a, c );
+                        queue.addDependency( b, c );
+                    }
+                }
+                counter = 0;
+                queue.startTasks();
+                // Let the calling thread help on odd frames.
+                queue.waitForTasks( frame % 2 == 1 );
+
+                RA_UNIT_TEST( counter == 3 * numChains, "Not all tasks were executed" );
+                bool ordered = true;
+                for (uint i = 0; i < numChains; ++i)
+                {
+                    ordered = ordered && ( order[3 * i] < order[3 * i + 1] ) && ( order[3 * i + 1] < order[3 * i + 2] );
+                }
+                RA_UNIT_TEST( ordered, "Dependencies were not respected" );
+            }
+        }
+    }
+};
+
+class ParallelForTests : public Test
+{
+    void run() override
+    {
+        using Ra::Core::TaskQueue;
+        for (auto mode : { TaskQueue::SchedulingMode::SHARED_QUEUE, TaskQueue::SchedulingMode::WORK_STEALING })
+        {
+            TaskQueue queue( 4, mode );
+            const uint size = 10000;
+            std::vector<uint> values( size, 0 );
+            auto increment = [&values]( uint begin, uint end )
+            {
+                for (uint i = begin; i < end; ++i)
+                {
+                    ++values[i];
+                }
+            };
+
+            // From the thread owning the queue.
+            queue.parallelFor( 0, size, 64, increment );
+
+            // From inside tasks, with a task depending on the loops.
+            std::atomic<uint> counter( 0 );
+            uint order = 0;
+            // The tasks use their own queue, whatever the queue of Core::parallelFor().
+            auto first = queue.registerTask( new Ra::Core::ParallelForTask( "loop", &queue, 0, size / 2, 64, increment ) );
+            auto second = queue.registerTask( new Ra::Core::ParallelForTask( "loop", &queue, size / 2, size, 64, increment ) );
+            auto last = queue.registerTask( new OrderTask( &counter, &order ) );
+            queue.addDependency( first, last );
+            queue.addDependency( second, last );
+
+            queue.startTasks();
+            queue.waitForTasks( true );
+
+            bool allTwo = true;
+            for (uint v : values)
+            {
+                allTwo = allTwo && ( v == 2 );
+            }
+            RA_UNIT_TEST( allTwo, "Each element should have been processed exactly once per loop" );
+            RA_UNIT_TEST( counter == 1, "The task depending on the loops was not executed" );
+        }
+
+        // Without a task queue, the loop runs on the calling thread with the same chunk sizes.
+        uint processed = 0;
+        uint largestChunk = 0;
+        Ra::Core::parallelFor( 3, 1000, 64, [&]( uint begin, uint end )
+        {
+            processed += end - begin;
+            largestChunk = std::max( largestChunk, end - begin );
+        } );
+        RA_UNIT_TEST( processed == 997, "The whole range should be processed" );
+        RA_UNIT_TEST( largestChunk == 64, "Chunks should not be larger than the grain size" );
+    }
+};
+
+/// A loop started by another thread, like a file loader, must not be run by the thread
+/// waiting for the tasks of a frame, its chunks could stall the frame.
+class ForeignParallelForTests : public Test
+{
+    void run() override
+    {
+        using Ra::Core::TaskQueue;
+        for (auto mode : { TaskQueue::SchedulingMode::SHARED_QUEUE, TaskQueue::SchedulingMode::WORK_STEALING })
+        {
+            TaskQueue queue( 1, mode );
+            const uint numChunks = 8;
+            std::vector<std::thread::id> chunkThreads( numChunks );
+            std::atomic<bool> slowStarted( false );
+            std::atomic<bool> loaderStarted( false );
+            std::atomic<uint> counter( 0 );
+
+            // The worker runs a slow task, leaving the waiting thread idle while the other
+            // thread starts its loop. The loop of the next task must still be helped with.
+            auto slow = queue.registerTask( new FunctionTask( "slow", [&]()
+            {
+                slowStarted = true;
+                while ( !loaderStarted )
+                {
+                    std::this_thread::yield();
+                }
+                std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+            } ) );
+            auto loop = queue.registerTask( new Ra::Core::ParallelForTask( "loop", &queue, 0, 256, 16, [&counter]( uint begin, uint end )
+            {
+                counter += end - begin;
+            } ) );
+            queue.addDependency( slow, loop );
+            queue.startTasks();
+            while ( !slowStarted )
+            {
+                std::this_thread::yield();
+            }
+
+            std::thread loader( [&]()
+            {
+                queue.parallelFor( 0, numChunks, 1, [&]( uint begin, uint end )
+                {
+                    loaderStarted = true;
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+                    for (uint i = begin; i < end; ++i)
+                    {
+                        chunkThreads[i] = std::this_thread::get_id();
+                    }
+                } );
+            } );
+            queue.waitForTasks( true );
+            loader.join();
+
+            bool allProcessed = true;
+            bool foreignHelped = false;
+            for (const auto& id : chunkThreads)
+            {
+                allProcessed = allProcessed && ( id != std::thread::id() );
+                foreignHelped = foreignHelped || ( id == std::this_thread::get_id() );
+            }
+            RA_UNIT_TEST( allProcessed, "The loop of the other thread was not processed" );
+            RA_UNIT_TEST( !foreignHelped, "waitForTasks() ran a chunk of a loop started by another thread" );
+            RA_UNIT_TEST( counter == 256, "The loop of the task was not processed" );
+            queue.flushTaskQueue();
+        }
+    }
+};
+
+class ScopedDependencyTests : public Test
+{
+    void run() override
+    {
+        using Ra::Core::TaskQueue;
+        for (auto mode : { TaskQueue::SchedulingMode::SHARED_QUEUE, TaskQueue::SchedulingMode::WORK_STEALING })
+        {
+            TaskQueue queue( 2, mode );
+            const int scopeA = 0;
+            const int scopeB = 0;
+            const int scopeC = 0;
+            std::atomic<uint> counter( 0 );
+            uint producedA = 0;
+            uint producedB = 0;
+            uint consumedA = 0;
+            uint consumedB = 0;
+            uint consumedC = 0;
+            std::atomic<bool> consumerARan( false );
+            bool producerBWaited = false;
+
+            // The consumers are registered first, their producers are found when the tasks start.
+            auto consumerA = queue.registerTask( new FunctionTask( "Consumer", [&]() { consumedA = counter++; consumerARan = true; } ), &scopeA );
+            auto consumerB = queue.registerTask( new FunctionTask( "Consumer", [&]() { consumedB = counter++; } ), &scopeB );
+            auto consumerC = queue.registerTask( new FunctionTask( "Consumer", [&]() { consumedC = counter++; } ), &scopeC );
+            queue.addPendingScopedDependency( "Producer", consumerA );
+            queue.addPendingScopedDependency( "Producer", consumerB );
+            // Scope C has no producer.
+            queue.addPendingScopedDependency( "Producer", consumerC );
+
+            queue.registerTask( new FunctionTask( "Producer", [&]() { producedA = counter++; } ), &scopeA );
+            // The producer of B waits for the consumer of A, which would never happen if the
+            // consumers waited for all the producers.
+            queue.registerTask( new FunctionTask( "Producer", [&]()
+            {
+                const auto start = Ra::Core::Timer::Clock::now();
+                while ( !consumerARan && Ra::Core::Timer::getIntervalSeconds( start, Ra::Core::Timer::Clock::now() ) < 2.f )
+                {
+                    std::this_thread::yield();
+                }
+                producerBWaited = consumerARan;
+                producedB = counter++;
+            } ), &scopeB );
+
+            queue.startTasks();
+            queue.waitForTasks( true );
+
+            RA_UNIT_TEST( counter == 5, "Not all tasks were executed" );
+            RA_UNIT_TEST( producedA < consumedA && producedB < consumedB, "Scoped dependencies were not respected" );
+            RA_UNIT_TEST( producerBWaited, "A consumer waited for the producer of another scope" );
+            queue.flushTaskQueue();
+        }
+    }
+};
+
+class RemoveTasksTests : public Test
+{
+    void run() override
+    {
+        using Ra::Core::TaskQueue;
+        for (auto mode : { TaskQueue::SchedulingMode::SHARED_QUEUE, TaskQueue::SchedulingMode::WORK_STEALING })
+        {
+            TaskQueue queue( 2, mode );
+            const int scope = 0;
+            std::atomic<uint> counter( 0 );
+            uint setupOrder = 0;
+            uint producedOrder = 0;
+            uint keptOrder = 0;
+
+            // The kept tasks wait for a kept task and for the producer of each frame.
+            queue.registerTask( new FunctionTask( "Setup", [&]() { setupOrder = counter++; } ), &scope );
+            auto kept = queue.registerTask( new FunctionTask( "Kept", [&]() { keptOrder = counter++; } ), &scope );
+            queue.addPendingScopedDependency( "Setup", kept );
+            queue.addPendingScopedDependency( "Producer", kept );
+            const TaskQueue::TaskId first = queue.getNumTasks();
+
+            for (uint frame = 0; frame < 6; ++frame)
+            {
+                if ( frame > 0 )
+                {
+                    queue.removeTasksFrom( first );
+                }
+                counter = 0;
+
+                // The last frame has no producer, the kept task must not wait for the removed one.
+                const bool hasProducer = frame < 5;
+                if ( hasProducer )
+                {
+                    queue.registerTask( new FunctionTask( "Producer", [&]() { producedOrder = counter++; } ), &scope );
+                }
+
+                queue.startTasks();
+                queue.waitForTasks( true );
+
+                RA_UNIT_TEST( queue.getNumTasks() == first + ( hasProducer ? 1 : 0 ), "Removed tasks were kept" );
+                RA_UNIT_TEST( counter == ( hasProducer ? 3u : 2u ), "Not all tasks were executed" );
+                RA_UNIT_TEST( setupOrder < keptOrder, "A dependency between kept tasks was lost" );
+                RA_UNIT_TEST( !hasProducer || producedOrder < keptOrder, "A dependency on a new task was not resolved" );
+            }
+            queue.flushTaskQueue();
+        }
+    }
+};
+
+RA_TEST_CLASS(TaskQueueTests);
+RA_TEST_CLASS(ParallelForTests);
+RA_TEST_CLASS(ForeignParallelForTests);
+RA_TEST_CLASS(ScopedDependencyTests);
+RA_TEST_CLASS(RemoveTasksTests);
+}
+
+#endif // RADIUM_TASKQUEUE_TESTS_HPP_
@@ -0,0 +1,69 @@
+#ifndef RADIUM_FRAME_STATS_TESTS_HPP_
+#define RADIUM_FRAME_STATS_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Time/FrameStats.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace RaTests {
+
+class FrameStatsTests : public Test
+{
+    void run() override
+    {
+        using Ra::Core::FrameStats;
+
+        std::vector<double> values = { 5.0, 1.0, 4.0, 2.0, 3.0 };
+        RA_UNIT_TEST( FrameStats::percentile( values, 0.0 ) == 1.0, "Wrong minimum" );
+        RA_UNIT_TEST( FrameStats::percentile( values, 50.0 ) == 3.0, "Wrong median" );
+        RA_UNIT_TEST( FrameStats::percentile( values, 100.0 ) == 5.0, "Wrong maximum" );
+        RA_UNIT_TEST( std::abs( FrameStats::percentile( values, 90.0 ) - 4.6 ) < 1e-9, "Percentiles are not interpolated" );
+
+        // 100 frames, "Tasks" takes f ms and has two parts, "Render" only exists in even frames.
+        FrameStats stats;
+        for (uint f = 0; f < 100; ++f)
+        {
+            stats.beginFrame( f + 10 );
+            stats.add( "Tasks", 0.25 * f );
+            stats.add( "Tasks", 0.75 * f );
+            if ( f % 2 == 0 )
+            {
+                stats.add( "Render, final", 1.0 );
+            }
+        }
+        RA_UNIT_TEST( stats.getNumFrames() == 100 && stats.getSeries().size() == 2, "Wrong number of frames or series" );
+
+        const FrameStats::Summary tasks = stats.getSummary( "Tasks" );
+        RA_UNIT_TEST( tasks.count == 100 && tasks.min == 0.0 && tasks.max == 99.0, "Durations of a frame are not summed" );
+        RA_UNIT_TEST( std::abs( tasks.mean - 49.5 ) < 1e-9 && std::abs( tasks.p50 - 49.5 ) < 1e-9
+                      && std::abs( tasks.p99 - 98.01 ) < 1e-9, "Wrong statistics" );
+        RA_UNIT_TEST( stats.getSummary( "Render, final" ).count == 50, "Missing durations are counted" );
+        RA_UNIT_TEST( stats.getSummary( "Physics" ).count == 0, "Unknown series has durations" );
+
+        std::ostringstream csv;
+        stats.writeCsv( csv );
+        std::istringstream lines( csv.str() );
+        std::string header;
+        std::string first;
+        std::string second;
+        std::getline( lines, header );
+        std::getline( lines, first );
+        std::getline( lines, second );
+        RA_UNIT_TEST( header == "frame,Tasks,\"Render, final\"", "Wrong CSV header" );
+        RA_UNIT_TEST( first == "10,0,1" && second == "11,1,", "Wrong CSV rows" );
+
+        std::ostringstream json;
+        stats.writeJson( json );
+        RA_UNIT_TEST( json.str().find( "\"Tasks\":{\"count\":100,\"min\":0," ) != std::string::npos, "Wrong JSON summary" );
+        RA_UNIT_TEST( json.str().find( "{\"frame\":11,\"Tasks\":1}" ) != std::string::npos, "Wrong JSON frames" );
+    }
+};
+
+RA_TEST_CLASS(FrameStatsTests);
+}
+
+#endif // RADIUM_FRAME_STATS_TESTS_HPP_
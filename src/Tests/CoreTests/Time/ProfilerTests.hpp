@@ -0,0 +1,120 @@
+#ifndef RADIUM_PROFILER_TESTS_HPP_
+#define RADIUM_PROFILER_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/Time/Profiler.hpp>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace RaTests {
+
+class ProfilerTests : public Test
+{
+    void run() override
+    {
+        using Ra::Core::Profiler;
+        namespace Timer = Ra::Core::Timer;
+
+        Profiler profiler( 64 );
+        const Timer::TimePoint origin = Timer::Clock::now();
+        auto at = [origin]( int us ) { return origin + std::chrono::microseconds( us ); };
+
+        // Each thread records 100 zones, only the 64 last ones are kept. The threads
+        // wait for each other so that their ids (and buffers) are not reused.
+        const uint numThreads = 4;
+        std::atomic<uint> done( 0 );
+        std::vector<std::thread> threads;
+        for (uint t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back( [&, t]()
+            {
+                profiler.setThreadName( "Worker " + std::to_string( t ) );
+                for (int i = 0; i < 100; ++i)
+                {
+                    profiler.record( "Zone " + std::to_string( i ), at( 1000 * i ), at( 1000 * i + 10 * ( t + 1 ) ) );
+                }
+                ++done;
+                while ( done < numThreads )
+                {
+                    std::this_thread::yield();
+                }
+            } );
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        std::vector<Profiler::Event> events;
+        profiler.getEvents( at( 0 ), at( 1000000 ), events );
+        RA_UNIT_TEST( events.size() == 64 * numThreads, "Ring buffers do not keep the last events" );
+
+        const long long originUs = std::chrono::duration_cast<std::chrono::microseconds>( origin.time_since_epoch() ).count();
+        bool sorted = true;
+        bool recent = true;
+        std::vector<uint> perThread( numThreads, 0 );
+        for (uint i = 0; i < events.size(); ++i)
+        {
+            sorted = sorted && ( i == 0 || events[i - 1].m_start <= events[i].m_start );
+            recent = recent && events[i].m_start - originUs >= 36000;
+            if ( events[i].m_thread < numThreads )
+            {
+                ++perThread[events[i].m_thread];
+            }
+        }
+        RA_UNIT_TEST( sorted, "Events are not sorted by start time" );
+        RA_UNIT_TEST( recent, "Overwritten events were returned" );
+        bool balanced = true;
+        for (uint count : perThread)
+        {
+            balanced = balanced && count == 64;
+        }
+        RA_UNIT_TEST( balanced, "Events have wrong thread indices" );
+
+        // Only the zones overlapping the window are returned.
+        events.clear();
+        profiler.getEvents( at( 50000 ), at( 59999 ), events );
+        RA_UNIT_TEST( events.size() == 10 * numThreads, "Wrong events in the time window" );
+
+        // Long names are truncated, and names are escaped in the trace.
+        const std::string longName( 2 * Profiler::NAME_SIZE, 'a' );
+        profiler.record( longName, at( 200000 ), at( 200001 ) );
+        profiler.record( "Quote \" and \\", at( 200002 ), at( 200003 ) );
+        events.clear();
+        profiler.getEvents( at( 200000 ), at( 200003 ), events );
+        RA_UNIT_TEST( events.size() == 2 && std::string( events[0].m_name ) == longName.substr( 0, Profiler::NAME_SIZE - 1 ),
+                      "Long names are not truncated" );
+
+        std::ostringstream trace;
+        profiler.writeChromeTrace( trace, at( 200000 ), at( 200003 ) );
+        const std::string json = trace.str();
+        RA_UNIT_TEST( json.find( "\"traceEvents\"" ) != std::string::npos, "Trace has no events array" );
+        RA_UNIT_TEST( json.find( "\"Quote \\\" and \\\\\"" ) != std::string::npos, "Names are not escaped" );
+        // The calling thread took over the buffer of the first worker.
+        RA_UNIT_TEST( json.find( "\"Worker 1\"" ) != std::string::npos, "Thread names are missing" );
+        RA_UNIT_TEST( json.find( "\"ts\":2,\"dur\":1" ) != std::string::npos, "Times are not relative to the window" );
+
+        // Short-lived threads reuse the buffers of the threads which exited.
+        for (int i = 0; i < 3; ++i)
+        {
+            std::thread( [&profiler, &at, i]() { profiler.record( "Loader", at( 300000 + i ), at( 300000 + i ) ); } ).join();
+        }
+        events.clear();
+        profiler.getEvents( at( 300000 ), at( 300002 ), events );
+        bool reused = events.size() == 3;
+        for (const auto& event : events)
+        {
+            reused = reused && event.m_thread < numThreads;
+        }
+        RA_UNIT_TEST( reused, "The buffers of the threads which exited are not reused" );
+    }
+};
+
+RA_TEST_CLASS(ProfilerTests);
+}
+
+#endif // RADIUM_PROFILER_TESTS_HPP_
@@ -0,0 +1,145 @@
+#ifndef RADIUM_BVH_TESTS_HPP_
+#define RADIUM_BVH_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Core/TreeStructures/BVH.hpp>
+
+#include <algorithm>
+#include <random>
+
+namespace RaTests {
+
+/// A dummy object to store in the BVH.
+struct BVHTestObject
+{
+    Ra::Core::Aabb m_aabb;
+    uint m_leaf;
+};
+
+class BVHFrustumTests : public Test
+{
+    void run() override
+    {
+        using namespace Ra::Core;
+        typedef std::shared_ptr<BVHTestObject> ObjectPtr;
+
+        // Camera at the origin looking towards -z.
+        const Frustum frustum( makePerspective( 1.f, 1.f, 20.f ) );
+
+        std::mt19937 gen( 11 );
+        std::uniform_real_distribution<Scalar> dist( -30.f, 30.f );
+        std::uniform_real_distribution<Scalar> size( 0.1f, 2.f );
+        auto randomBox = [&]()
+        {
+            const Vector3 c( dist( gen ), dist( gen ), dist( gen ) );
+            const Vector3 s( size( gen ), size( gen ), size( gen ) );
+            return Aabb( c - s, c + s );
+        };
+
+        BVH<BVHTestObject> bvh;
+        std::vector<ObjectPtr> objects;
+        for (uint i = 0; i < 1000; ++i)
+        {
+            ObjectPtr o( new BVHTestObject );
+            o->m_aabb = randomBox();
+            o->m_leaf = bvh.insertLeaf( o, o->m_aabb );
+            objects.push_back( o );
+        }
+        RA_UNIT_TEST( bvh.getNumLeaves() == objects.size(), "Wrong number of leaves" );
+        RA_UNIT_TEST( checkQuery( bvh, objects, frustum ), "Frustum query differs from brute force" );
+
+        // Move half the objects, some of them slightly, and remove some others.
+        std::uniform_real_distribution<Scalar> small( -0.05f, 0.05f );
+        for (uint i = 0; i < objects.size(); i += 2)
+        {
+            const Vector3 t = ( i % 4 == 0 ) ? Vector3( small( gen ), small( gen ), small( gen ) )
+                                             : Vector3( dist( gen ), dist( gen ), dist( gen ) );
+            objects[i]->m_aabb.translate( t );
+            bvh.updateLeaf( objects[i]->m_leaf, objects[i]->m_aabb );
+        }
+        for (uint i = 1; i < objects.size(); i += 6)
+        {
+            bvh.removeLeaf( objects[i]->m_leaf );
+            objects[i].reset();
+        }
+        objects.erase( std::remove( objects.begin(), objects.end(), nullptr ), objects.end() );
+
+        RA_UNIT_TEST( bvh.getNumLeaves() == objects.size(), "Wrong number of leaves after removal" );
+        RA_UNIT_TEST( checkQuery( bvh, objects, frustum ), "Frustum query differs after updates" );
+
+        // Removed leaves are reused by the new objects.
+        for (uint i = 0; i < 100; ++i)
+        {
+            ObjectPtr o( new BVHTestObject );
+            o->m_aabb = randomBox();
+            o->m_leaf = bvh.insertLeaf( o, o->m_aabb );
+            objects.push_back( o );
+        }
+        RA_UNIT_TEST( checkQuery( bvh, objects, frustum ), "Frustum query differs after insertion" );
+
+        for (const auto& o : objects)
+        {
+            bvh.removeLeaf( o->m_leaf );
+        }
+        RA_UNIT_TEST( bvh.isEmpty() && bvh.getNumLeaves() == 0, "BVH should be empty" );
+        std::vector<ObjectPtr> result;
+        bvh.getInFrustum( result, frustum );
+        RA_UNIT_TEST( result.empty(), "Empty BVH should not return objects" );
+    }
+
+    static Ra::Core::Matrix4 makePerspective( Scalar fovy, Scalar zNear, Scalar zFar )
+    {
+        Ra::Core::Matrix4 proj = Ra::Core::Matrix4::Zero();
+        const Scalar f = 1.f / std::tan( fovy / 2.f );
+        proj( 0, 0 ) = f;
+        proj( 1, 1 ) = f;
+        proj( 2, 2 ) = ( zFar + zNear ) / ( zNear - zFar );
+        proj( 2, 3 ) = 2.f * zFar * zNear / ( zNear - zFar );
+        proj( 3, 2 ) = -1.f;
+        return proj;
+    }
+
+    /// A box is kept unless all its corners are behind one of the planes.
+    static bool isInFrustum( const Ra::Core::Aabb& aabb, const Ra::Core::Frustum& frustum )
+    {
+        for (uint i = 0; i < 6; ++i)
+        {
+            bool outside = true;
+            for (int c = 0; c < 8 && outside; ++c)
+            {
+                const Ra::Core::Vector3 p = aabb.corner( static_cast<Ra::Core::Aabb::CornerType>( c ) );
+                outside = frustum.getPlane( i ).dot( Ra::Core::Vector4( p.x(), p.y(), p.z(), 1.f ) ) < 0;
+            }
+            if ( outside )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool checkQuery( const Ra::Core::BVH<BVHTestObject>& bvh,
+                            const std::vector<std::shared_ptr<BVHTestObject>>& objects,
+                            const Ra::Core::Frustum& frustum )
+    {
+        std::vector<std::shared_ptr<BVHTestObject>> result;
+        bvh.getInFrustum( result, frustum );
+
+        std::vector<std::shared_ptr<BVHTestObject>> expected;
+        for (const auto& o : objects)
+        {
+            if ( isInFrustum( o->m_aabb, frustum ) )
+            {
+                expected.push_back( o );
+            }
+        }
+
+        std::sort( result.begin(), result.end() );
+        std::sort( expected.begin(), expected.end() );
+        return !expected.empty() && result == expected;
+    }
+};
+    RA_TEST_CLASS(BVHFrustumTests);
+}
+
+#endif // RADIUM_BVH_TESTS_HPP_
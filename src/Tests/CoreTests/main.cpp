@@ -1,8 +1,20 @@
 #include <Tests/CoreTests/Tests.hpp>
 
 #include <Tests/CoreTests/Algebra/AlgebraTests.hpp>
+#include <Tests/CoreTests/Animation/AnimationTests.hpp>
+#include <Tests/CoreTests/Animation/CompressedAnimationTests.hpp>
+#include <Tests/CoreTests/Animation/SkeletonTests.hpp>
+#include <Tests/CoreTests/Animation/SkinningTests.hpp>
+#include <Tests/CoreTests/File/MeshFileTests.hpp>
 #include <Tests/CoreTests/Geometry/GeometryTests.hpp>
+#include <Tests/CoreTests/Log/LogTests.hpp>
+#include <Tests/CoreTests/Mesh/HalfEdgeMeshTests.hpp>
+#include <Tests/CoreTests/Mesh/VertexPackingTests.hpp>
 #include <Tests/CoreTests/RayCasts/RayCastTest.hpp>
+#include <Tests/CoreTests/Tasks/TaskQueueTests.hpp>
+#include <Tests/CoreTests/Time/FrameStatsTests.hpp>
+#include <Tests/CoreTests/Time/ProfilerTests.hpp>
+#include <Tests/CoreTests/TreeStructures/BVHTests.hpp>
 
 int main()
 {
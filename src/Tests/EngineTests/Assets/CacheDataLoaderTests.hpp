@@ -0,0 +1,169 @@
+#ifndef RADIUM_CACHE_DATA_LOADER_TESTS_HPP_
+#define RADIUM_CACHE_DATA_LOADER_TESTS_HPP_
+
+#include <Tests/CoreTests/Tests.hpp>
+#include <Engine/Assets/CacheDataLoader.hpp>
+#include <Engine/Assets/GeometryData.hpp>
+#include <Engine/Assets/HandleData.hpp>
+#include <Engine/Assets/AnimationData.hpp>
+#include <Engine/Assets/LightData.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace RaTests {
+
+/// Geometry whose data can be set by the tests.
+class CacheGeometryData : public Ra::Asset::GeometryData
+{
+public:
+    CacheGeometryData() : GeometryData( "triangles", TRI_MESH ) {}
+    using GeometryData::setVertices;
+    using GeometryData::setFaces;
+};
+
+class CacheDataLoaderTests : public Test
+{
+    typedef std::vector< std::unique_ptr< Ra::Asset::GeometryData > >  GeometryList;
+    typedef std::vector< std::unique_ptr< Ra::Asset::HandleData > >    HandleList;
+    typedef std::vector< std::unique_ptr< Ra::Asset::AnimationData > > AnimationList;
+    typedef std::vector< std::unique_ptr< Ra::Asset::LightData > >     LightList;
+
+    /// Offset of the size of Scalar in the header of the cache file.
+    static const uint SCALAR_SIZE_OFFSET = 32;
+
+    static void writeFile( const std::string& name, const std::string& content )
+    {
+        std::ofstream file( name, std::ios_base::binary | std::ios_base::trunc );
+        file << content;
+    }
+
+    static std::string readFile( const std::string& name )
+    {
+        std::ifstream file( name, std::ios_base::binary );
+        return std::string( std::istreambuf_iterator<char>( file ), std::istreambuf_iterator<char>() );
+    }
+
+    /// Loads the cache of the source file, returns false if it was not valid.
+    static bool load( const std::string& source, GeometryList& geometry, LightList& light )
+    {
+        HandleList handle;
+        AnimationList animation;
+        Ra::Asset::CacheDataLoader loader( source, 0 );
+        return loader.loadData( geometry, handle, animation, light );
+    }
+
+    void run() override
+    {
+        using namespace Ra::Core;
+        using namespace Ra::Asset;
+
+        const std::string source = "radium_cache_test.obj";
+        const std::string cache  = CacheDataLoader::getCacheFileName( source );
+        writeFile( source, "# Any content, only its hash and size are used by the cache.\n" );
+
+        std::vector< Vector3 > vertices;
+        std::vector< VectorNui > faces;
+        for ( uint i = 0; i < 300; ++i )
+        {
+            vertices.push_back( Vector3( Scalar( i ), Scalar( 2 * i ), Scalar( -1 ) ) );
+        }
+        for ( uint i = 0; i < 100; ++i )
+        {
+            VectorNui face( 3 );
+            face << 3 * i, 3 * i + 1, 3 * i + 2;
+            faces.push_back( face );
+        }
+        CacheGeometryData* triangles = new CacheGeometryData();
+        triangles->setVertices( vertices );
+        triangles->setFaces( faces );
+
+        GeometryList geometry;
+        geometry.emplace_back( triangles );
+        LightList light;
+        light.emplace_back( new LightData( "sun", LightData::DIRECTIONAL ) );
+
+        // Write / read round-trip.
+        {
+            CacheDataLoader loader( source, 0 );
+            RA_UNIT_TEST( loader.saveData( geometry, HandleList(), AnimationList(), light ), "Cache not written." );
+
+            GeometryList loadedGeometry;
+            LightList loadedLight;
+            RA_UNIT_TEST( load( source, loadedGeometry, loadedLight ), "Cache not read." );
+            RA_UNIT_TEST( loadedGeometry.size() == 1 && loadedLight.size() == 1, "Wrong number of data." );
+            if ( loadedGeometry.size() == 1 && loadedLight.size() == 1 )
+            {
+                const GeometryData& g = *loadedGeometry[0];
+                bool same = g.getName() == "triangles" && g.getType() == GeometryData::TRI_MESH;
+                same = same && g.getVertices().size() == vertices.size() && g.getFaces().size() == faces.size();
+                for ( uint i = 0; same && i < vertices.size(); ++i )
+                {
+                    same = g.getVertices()[i] == vertices[i];
+                }
+                for ( uint i = 0; same && i < faces.size(); ++i )
+                {
+                    same = g.getFaces()[i] == faces[i];
+                }
+                RA_UNIT_TEST( same, "Wrong geometry read from the cache." );
+                RA_UNIT_TEST( loadedLight[0]->getName() == "sun" && loadedLight[0]->isDirectional(), "Wrong light read from the cache." );
+            }
+        }
+
+        const std::string valid = readFile( cache );
+
+        // Truncated and corrupted caches are rejected.
+        {
+            GeometryList loadedGeometry;
+            LightList loadedLight;
+            writeFile( cache, valid.substr( 0, 10 ) );
+            RA_UNIT_TEST( !load( source, loadedGeometry, loadedLight ), "Cache with a truncated header read." );
+            writeFile( cache, valid.substr( 0, valid.size() / 2 ) );
+            RA_UNIT_TEST( !load( source, loadedGeometry, loadedLight ), "Truncated cache read." );
+            RA_UNIT_TEST( loadedGeometry.empty() && loadedLight.empty(), "Data of an invalid cache returned." );
+
+            std::string corrupted = valid;
+            corrupted[0] = 'X';
+            writeFile( cache, corrupted );
+            RA_UNIT_TEST( !load( source, loadedGeometry, loadedLight ), "Cache with a wrong magic number read." );
+        }
+
+        // A cache written with another Scalar type is rejected.
+        {
+            GeometryList loadedGeometry;
+            LightList loadedLight;
+            std::string other = valid;
+            const uint32_t scalarSize = sizeof( Scalar ) == 4 ? 8 : 4;
+            other.replace( SCALAR_SIZE_OFFSET, sizeof( scalarSize ), reinterpret_cast< const char* >( &scalarSize ), sizeof( scalarSize ) );
+            writeFile( cache, other );
+            RA_UNIT_TEST( !load( source, loadedGeometry, loadedLight ), "Cache with another Scalar size read." );
+
+            writeFile( cache, valid );
+            RA_UNIT_TEST( load( source, loadedGeometry, loadedLight ), "Restored cache not read." );
+        }
+
+        // The cache is stale once the source changes, with the same size or not.
+        {
+            GeometryList loadedGeometry;
+            LightList loadedLight;
+            std::string content = readFile( source );
+            content[0] = '%';
+            writeFile( source, content );
+            RA_UNIT_TEST( !load( source, loadedGeometry, loadedLight ), "Stale cache read after a change of the source." );
+            writeFile( source, content + "\n" );
+            RA_UNIT_TEST( !load( source, loadedGeometry, loadedLight ), "Stale cache read after a change of the source size." );
+        }
+
+        std::remove( source.c_str() );
+        std::remove( cache.c_str() );
+    }
+};
+
+RA_TEST_CLASS(CacheDataLoaderTests);
+
+}
+
+#endif // RADIUM_CACHE_DATA_LOADER_TESTS_HPP_
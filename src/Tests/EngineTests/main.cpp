@@ -0,0 +1,10 @@
+#include <Tests/CoreTests/Tests.hpp>
+
+#include <Tests/EngineTests/Assets/CacheDataLoaderTests.hpp>
+
+int main()
+{
+    if (! RaTests::TestManager::getInstance()) {RaTests::TestManager::createInstance();}
+    RaTests::TestManager::getInstance()->m_options.m_breakOnFailure = true;
+    return RaTests::TestManager::getInstance()->run();
+}